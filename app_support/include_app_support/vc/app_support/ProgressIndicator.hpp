@@ -2,8 +2,11 @@
 
 /** @file */
 
+#include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <string>
 
 #include <indicators/cursor_control.hpp>
 #include <indicators/progress_bar.hpp>
@@ -36,6 +39,33 @@ inline auto NewProgressBar(size_t maxProg, std::string label = "")
     // clang-format on
 }
 
+/**
+ * Make a thread-safe callback which advances a new ProgressBar by one
+ * iteration each time it is called. Use this instead of ProgressWrap when the
+ * iterations are run in parallel.
+ *
+ * @ingroup Support
+ */
+inline auto NewProgressCallback(std::size_t numIters, std::string label = "")
+    -> std::function<void()>
+{
+    auto bar = NewProgressBar(numIters, std::move(label));
+    auto mutex = std::make_shared<std::mutex>();
+    auto count = std::make_shared<std::size_t>(0);
+    return [bar, mutex, count, numIters]() {
+        using indicators::option::PostfixText;
+        std::unique_lock<std::mutex> lock(*mutex);
+        ++(*count);
+        auto post = std::to_string(*count) + "/" + std::to_string(numIters);
+        bar->set_option(PostfixText{post});
+        if (*count < numIters) {
+            bar->set_progress(*count);
+        } else {
+            bar->tick();
+        }
+    };
+}
+
 template <class Iterable>
 inline auto ProgressWrap(
     Iterable&& it, std::string label = "", bool useColors = false);
@@ -0,0 +1,23 @@
+#pragma once
+
+/** @file */
+
+#include <boost/program_options.hpp>
+
+#include "vc/core/io/TIFFIO.hpp"
+
+/**
+ * @brief Get the tiled TIFF compression from the parsed command line options
+ *
+ * Reads the `compression` option as a TIFF compression scheme. Only
+ * uncompressed (1), Adobe Deflate (8), and Deflate (32946) are supported by
+ * tiled TIFFs. If `compression` is not provided, returns Adobe Deflate.
+ *
+ * Because tiled rendering always writes TIFFs, an explicitly provided
+ * `image-format` option must be `tif` or `tiff`.
+ *
+ * @throws std::invalid_argument if the compression scheme or image format is
+ * not supported for tiled rendering
+ */
+auto GetTiledCompression(const boost::program_options::variables_map& parsed)
+    -> volcart::tiffio::Compression;
@@ -14,7 +14,10 @@ auto GetGeneralOpts() -> po::options_description
         ("progress", po::value<bool>()->default_value(true),
             "When enabled, show algorithm progress bars.")
         ("log-level", po::value<std::string>()->default_value("info"),
-         "Options: off, critical, error, warn, info, debug");
+         "Options: off, critical, error, warn, info, debug")
+        ("trace", po::value<std::string>(), "Write a trace of where time is "
+            "spent to this path, in the Chrome trace JSON format. Open it "
+            "with chrome://tracing or https://ui.perfetto.dev.");
     // clang-format on
 
     return opts;
@@ -0,0 +1,41 @@
+#include "vc/app_support/TiledRenderOptions.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "vc/core/util/String.hpp"
+
+namespace po = boost::program_options;
+namespace tio = volcart::tiffio;
+
+auto GetTiledCompression(const po::variables_map& parsed) -> tio::Compression
+{
+    // Tiled renders are always TIFFs
+    if (parsed.count("image-format") > 0 and
+        not parsed["image-format"].defaulted()) {
+        auto fmt = volcart::to_lower_copy(
+            parsed["image-format"].as<std::string>());
+        if (fmt != "tif" and fmt != "tiff") {
+            throw std::invalid_argument(
+                "Tiled rendering only writes TIFF images. Unsupported image "
+                "format: " +
+                fmt);
+        }
+    }
+
+    if (parsed.count("compression") == 0) {
+        return tio::Compression::ADOBE_DEFLATE;
+    }
+    auto c = parsed["compression"].as<int>();
+    switch (static_cast<tio::Compression>(c)) {
+        case tio::Compression::NONE:
+        case tio::Compression::ADOBE_DEFLATE:
+        case tio::Compression::DEFLATE:
+            return static_cast<tio::Compression>(c);
+        default:
+            throw std::invalid_argument(
+                "Unsupported compression for tiled rendering: " +
+                std::to_string(c) +
+                ". Options: 1 (none), 8 (Adobe Deflate), 32946 (Deflate)");
+    }
+}
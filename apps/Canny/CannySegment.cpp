@@ -2,19 +2,13 @@
 #pragma ide diagnostic ignored "readability-identifier-length"
 #pragma clang diagnostic ignored "-Wunknown-pragmas"
 #pragma ide diagnostic ignored "cppcoreguidelines-avoid-magic-numbers"
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
 #include <QApplication>
 #include <boost/program_options.hpp>
 #include <opencv2/imgcodecs.hpp>
-#include <vtkAppendPolyData.h>
-#include <vtkCleanPolyData.h>
-#include <vtkCutter.h>
-#include <vtkLine.h>
-#include <vtkPointData.h>
-#include <vtkProbeFilter.h>
-#include <vtkSmartPointer.h>
 
 #include "CannyViewerWindow.hpp"
 #include "vc/app_support/ProgressIndicator.hpp"
@@ -26,8 +20,9 @@
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/ImageConversion.hpp"
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Parallel.hpp"
 #include "vc/core/util/String.hpp"
-#include "vc/meshing/ITK2VTK.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
 
 namespace fs = volcart::filesystem;
 namespace po = boost::program_options;
@@ -48,7 +43,10 @@ auto main(int argc, char* argv[]) -> int
         ("volume", po::value<std::string>(),
            "Volume to use for segmentation. Default: First volume")
         ("output-file,o", po::value<std::string>()->required(),
-           "Output mesh path (PLY)");
+           "Output mesh path (PLY)")
+        ("threads,j", po::value<std::size_t>()->default_value(0),
+           "Number of slices to segment in parallel. If 0, uses the number "
+           "of hardware threads.");
 
     po::options_description segOpts("Segmentation Options");
     segOpts.add_options()
@@ -93,6 +91,7 @@ auto main(int argc, char* argv[]) -> int
     // Get options
     const fs::path volpkgPath = parsed["volpkg"].as<std::string>();
     const fs::path outputPath = parsed["output-file"].as<std::string>();
+    const auto numThreads = parsed["threads"].as<std::size_t>();
 
     cannySettings.blurSize = parsed["blur-size"].as<int>();
     cannySettings.minThreshold = parsed["threshold-min"].as<int>();
@@ -154,41 +153,18 @@ auto main(int argc, char* argv[]) -> int
 
     // Get meshes
     std::cout << "Loading meshes..." << std::endl;
-    std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+    std::vector<vc::ITKMesh::Pointer> meshes;
     for (const auto& meshPath : cannySettings.fromMeshes) {
-        auto meshFile = vc::ReadMesh(meshPath);
-        auto vtkMesh = vcm::ITK2VTK(meshFile.mesh);
-        meshes.push_back(vtkMesh);
+        meshes.push_back(vc::ReadMesh(meshPath).mesh);
     }
 
-    // Combine meshes if we have multiple
-    vtkSmartPointer<vtkPolyData> vtkMesh;
-    if (meshes.size() > 1) {
-        // Append all the meshes into a single polydata
-        auto append = vtkSmartPointer<vtkAppendPolyData>::New();
-        for (const auto& mesh : meshes) {
-            append->AddInputData(mesh);
-        }
-        append->Update();
-
-        // Clean it up
-        auto cleaner = vtkSmartPointer<vtkCleanPolyData>::New();
-        cleaner->SetInputConnection(append->GetOutputPort());
-        cleaner->Update();
-
-        vtkMesh = cleaner->GetOutput();
-    } else if (meshes.size() == 1) {
-        vtkMesh = meshes[0];
-    }
-
-    vtkSmartPointer<vtkCutter> cutter;
-    vtkSmartPointer<vtkPlane> plane;
-    if (vtkMesh != nullptr) {
-        cutter = vtkSmartPointer<vtkCutter>::New();
-        plane = vtkSmartPointer<vtkPlane>::New();
-
-        auto zMin = static_cast<int>(std::floor(vtkMesh->GetBounds()[4]));
-        auto zMax = static_cast<int>(std::ceil(vtkMesh->GetBounds()[5]));
+    // Index the faces by z so that each slice only intersects the faces which
+    // cross it
+    const vcm::MeshSlicer slicer(meshes);
+    const auto haveMesh = slicer.size() > 0;
+    if (haveMesh) {
+        auto zMin = static_cast<int>(std::floor(slicer.zMin()));
+        auto zMax = static_cast<int>(std::ceil(slicer.zMax()));
 
         // Bounds checks
         if (zMin < 0) {
@@ -203,17 +179,6 @@ auto main(int argc, char* argv[]) -> int
 
         cannySettings.zMin = zMin;
         cannySettings.zMax = zMax;
-
-        plane->SetOrigin(
-            static_cast<double>(volume->sliceWidth()) / 2,
-            static_cast<double>(volume->sliceHeight()) / 2,
-            0
-        );
-        plane->SetNormal(0, 0, 1);
-
-        cutter->SetInputData(vtkMesh);
-        cutter->SetCutFunction(plane);
-        cutter->Update();
     }
     /**************************************************************************/
 
@@ -229,23 +194,30 @@ auto main(int argc, char* argv[]) -> int
     }
 
     // check that if project from is 'M' or 'I' that we have a mesh
-    if ((cannySettings.projectionFrom == 'M' ||
-         cannySettings.projectionFrom == 'I') &&
-        vtkMesh == nullptr) {
+    const auto fromMesh = cannySettings.projectionFrom == 'M' ||
+                          cannySettings.projectionFrom == 'I';
+    if (fromMesh && !haveMesh) {
         std::cerr << "ERROR: projection-from=[M,I] requires --from-mesh to be "
                      "specified\n";
         return EXIT_FAILURE;
     }
+    if (fromMesh && !slicer.hasNormals()) {
+        std::cerr << "Error: Input mesh has no normals\n";
+        return EXIT_FAILURE;
+    }
 
-    // Segment
+    // Segment each slice in parallel. Each worker reads and segments one slice
+    // at a time, so at most numThreads slices are in memory.
     std::cout << "Segmenting surface..." << std::endl;
-    auto mesh = vc::ITKMesh::New();
-    cv::Vec3d first;
-    cv::Vec3d middle;
-    cv::Vec3d last;
-    auto zMin = static_cast<int>(cannySettings.zMin);
-    auto zMax = static_cast<int>(cannySettings.zMax);
-    for (const auto& z : ProgressWrap(range(zMin, zMax), "Slice:")) {
+    const auto zMin = static_cast<int>(cannySettings.zMin);
+    const auto zMax = static_cast<int>(cannySettings.zMax);
+    const auto numSlices = static_cast<std::size_t>(std::max(zMax - zMin, 0));
+    std::vector<std::vector<cv::Vec3d>> slicePoints(numSlices);
+    auto progress = vc::NewProgressCallback(numSlices, "Slice:");
+    auto segmentSlice = [&](std::size_t sliceIdx) {
+        const auto z = zMin + static_cast<int>(sliceIdx);
+        auto& points = slicePoints[sliceIdx];
+
         // Get the slice
         auto slice =
             vc::QuantizeImage(volume->getSliceDataCopy(z), CV_8UC1, false);
@@ -258,13 +230,13 @@ auto main(int argc, char* argv[]) -> int
                 const auto& x = pt.second;
                 const auto& y = pt.first;
                 if (processed.at<uint8_t>(y, x) > 0) {
-                    middle = {
+                    points.emplace_back(
                         static_cast<double>(x), static_cast<double>(y),
-                        static_cast<double>(z)};
-                    mesh->SetPoint(mesh->GetNumberOfPoints(), middle.val);
+                        static_cast<double>(z));
                 }
             }
-            continue;
+            progress();
+            return;
         }
 
         // Build the set of rays that will be projected to find the edges
@@ -291,95 +263,41 @@ auto main(int argc, char* argv[]) -> int
                 rayOrigins.push_back({static_cast<double>(x), static_cast<double>(processed.rows - 1)});
                 rayBases.push_back({0, -1});
             }
-        } else if (cannySettings.projectionFrom == 'M' || cannySettings.projectionFrom == 'I') {
-            if (plane == nullptr || cutter == nullptr) {
-                std::cerr << "Error: Projection from mesh requested but mesh "
-                             "cutter not initialized\n";
-                return EXIT_FAILURE;
-            }
-            // update plane Z
-            plane->SetOrigin(0, 0, static_cast<double>(z));
-            cutter->Update();
-
-            // get cutter output
-            const vtkSmartPointer<vtkPolyData> cutterOutput =
-                cutter->GetOutput();
-
-            // vtk list of points
-            auto points = vtkSmartPointer<vtkPoints>::New();
-
-            // go through line segments
-            for (auto i = 0; i < cutterOutput->GetNumberOfCells(); ++i) {
-                // get cell
-                const vtkSmartPointer<vtkCell> cell = cutterOutput->GetCell(i);
-
-                // get points as cv::Vec3d
-                const cv::Vec3d p0{cell->GetPoints()->GetPoint(0)};
-                const cv::Vec3d p1{cell->GetPoints()->GetPoint(1)};
-
-                const auto length = cv::norm(p1 - p0);
-                const cv::Vec3d step = (p1 - p0) / length;
-
-                for (auto t = 0; t < static_cast<int>(length); ++t) {
-                    auto p = p0 + step * t;
-                    points->InsertNextPoint(p.val);
-                }
-            }
-
-            // if zero points, skip
-            if (points->GetNumberOfPoints() == 0) {
-                continue;
-            }
-
-            // create polydata
-            const auto pointsPolyData = vtkSmartPointer<vtkPolyData>::New();
-            pointsPolyData->SetPoints(points);
-
-            // use probe filter
-            const auto probeFilter = vtkSmartPointer<vtkProbeFilter>::New();
-            probeFilter->SetInputData(pointsPolyData);
-            probeFilter->SetSourceData(vtkMesh);
-            probeFilter->Update();
-
-            // get probe output
-            const vtkSmartPointer<vtkDataSet> probeOutput =
-                probeFilter->GetOutput();
-
-            // get normal vectors
-            const vtkSmartPointer<vtkDataArray> normals =
-                probeOutput->GetPointData()->GetNormals();
-
-            // check if normals exist
-            if (normals == nullptr) {
-                std::cerr << "Error: Input mesh has no normals\n";
-                return EXIT_FAILURE;
-            }
-
-            // go through points and normals
-            for (auto i = 0; i < probeOutput->GetNumberOfPoints(); ++i) {
-                // get point
-                cv::Vec3d p{probeOutput->GetPoint(i)};
-                // get normal
-                cv::Vec3d n{normals->GetTuple(i)};
-                // check if normal is all zeros
-                if (n[0] == 0 && n[1] == 0 && n[2] == 0) {
-                    continue;
+        } else if (fromMesh) {
+            // Cast a ray from every voxel along the mesh's intersection with
+            // the slice, in the direction of the mesh normal
+            for (const auto& s : slicer.intersect(z)) {
+                const auto length = cv::norm(s.p1 - s.p0);
+                const auto steps = std::max(static_cast<int>(length), 1);
+                for (auto t = 0; t < steps; ++t) {
+                    // Interpolate the point and normal along the segment
+                    auto a = length > 0 ? t / length : 0.0;
+                    cv::Vec3d p = s.p0 + a * (s.p1 - s.p0);
+                    cv::Vec3d n = s.n0 + a * (s.n1 - s.n0);
+
+                    // project normal to xy plane
+                    n[2] = 0;
+                    // check if normal is all zeros
+                    const auto norm = cv::norm(n);
+                    if (norm == 0) {
+                        continue;
+                    }
+                    // normalize
+                    n = n / norm;
+                    // invert normal if needed
+                    if (cannySettings.projectionFrom == 'I') {
+                        n = -n;
+                    }
+                    // add point to ray origins after converting to 2d
+                    rayOrigins.push_back({p[0], p[1]});
+                    // add normal to ray bases after converting to 2d
+                    rayBases.push_back({n[0], n[1]});
                 }
-                // project normal to xy plane
-                n[2] = 0;
-                // normalize
-                n = n / cv::norm(n);
-                // invert normal if needed
-                if (cannySettings.projectionFrom == 'I') {
-                    n = -n;
-                }
-                // add point to ray origins after converting to 2d
-                rayOrigins.push_back({p[0], p[1]});
-                // add normal to ray bases after converting to 2d
-                rayBases.push_back({n[0], n[1]});
             }
         }
 
+        cv::Vec3d first;
+        cv::Vec3d last;
         for (auto r : range(rayBases.size())) {
             const auto& rayBasis = rayBases[r];
             const auto& rayOrigin = rayOrigins[r];
@@ -423,8 +341,17 @@ auto main(int argc, char* argv[]) -> int
                 continue;
             }
 
-            middle = (first + last) / 2;
-            mesh->SetPoint(mesh->GetNumberOfPoints(), middle.val);
+            points.push_back((first + last) / 2);
+        }
+        progress();
+    };
+    vc::ParallelFor(numSlices, segmentSlice, numThreads);
+
+    // Collect the points in slice order
+    auto mesh = vc::ITKMesh::New();
+    for (const auto& points : slicePoints) {
+        for (const auto& p : points) {
+            mesh->SetPoint(mesh->GetNumberOfPoints(), p.val);
         }
     }
 
@@ -2,9 +2,11 @@
 #pragma clang diagnostic ignored "-Wunknown-pragmas"
 #pragma ide diagnostic ignored "cppcoreguidelines-avoid-magic-numbers"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <map>
+#include <sstream>
 
 #include <QApplication>
 #include <boost/program_options.hpp>
@@ -24,9 +26,10 @@
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/io/MeshIO.hpp"
 #include "vc/core/types/VolumePkg.hpp"
-#include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/core/util/Parallel.hpp"
 #include "vc/meshing/ITK2VTK.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
 
 namespace po = boost::program_options;
 namespace fs = volcart::filesystem;
@@ -47,7 +50,10 @@ auto main(int argc, char* argv[]) -> int
         ("volume", po::value<std::string>(),
              "Volume to use for texturing. Default: First volume")
         ("output-dir,o", po::value<std::string>()->required(),
-             "Output directory");
+             "Output directory")
+        ("threads,j", po::value<std::size_t>()->default_value(0),
+             "Number of slices to project in parallel. If 0, uses the number "
+             "of hardware threads.");
 
     po::options_description visOptions("Visualization Options");
     visOptions.add_options()
@@ -90,6 +96,7 @@ auto main(int argc, char* argv[]) -> int
     auto meshPaths = parsed["input-mesh"].as<std::vector<std::string>>();
     fs::path volpkgPath = parsed["volpkg"].as<std::string>();
     fs::path outputDir = parsed["output-dir"].as<std::string>();
+    auto numThreads = parsed["threads"].as<std::size_t>();
     projectionSettings.intersectOnly = parsed.count("intersect-only") > 0;
     projectionSettings.thickness = parsed["thickness"].as<int>();
     if (parsed.count("visualize-ppm-intersection") > 0) {
@@ -149,42 +156,24 @@ auto main(int argc, char* argv[]) -> int
 
     // Get meshes
     std::cout << "Loading meshes..." << std::endl;
-    std::vector<vtkSmartPointer<vtkPolyData>> meshes;
+    std::vector<vc::ITKMesh::Pointer> meshes;
     for (const auto& meshPath : meshPaths) {
-        auto meshFile = vc::ReadMesh(meshPath);
-        auto vtkMesh = vcm::ITK2VTK(meshFile.mesh);
-        meshes.push_back(vtkMesh);
+        meshes.push_back(vc::ReadMesh(meshPath).mesh);
     }
 
-    // Combine meshes if we have multiple
-    vtkSmartPointer<vtkPolyData> vtkMesh;
-    if (meshes.size() > 1) {
-        // Append all of the meshes into a single polydata
-        auto append = vtkSmartPointer<vtkAppendPolyData>::New();
-        for (auto& mesh : meshes) {
-            append->AddInputData(mesh);
-        }
-        append->Update();
-
-        // Clean it up
-        auto cleaner = vtkSmartPointer<vtkCleanPolyData>::New();
-        cleaner->SetInputConnection(append->GetOutputPort());
-        cleaner->Update();
+    // Index the faces by z so that each slice only intersects the faces which
+    // cross it
+    const vcm::MeshSlicer slicer(meshes);
+    projectionSettings.zMin = static_cast<int>(std::floor(slicer.zMin()));
+    projectionSettings.zMax = static_cast<int>(std::ceil(slicer.zMax()));
 
-        vtkMesh = cleaner->GetOutput();
-    } else {
-        vtkMesh = meshes[0];
+    // Make sure the meshes overlap the volume
+    if (slicer.size() == 0 or slicer.zMax() < 0 or
+        slicer.zMin() > volume->numSlices() - 1) {
+        vc::Logger()->error("Meshes do not overlap the volume's slices");
+        return EXIT_FAILURE;
     }
 
-    // Setup intersection plane
-    vtkSmartPointer<vtkPlane> cutPlane = vtkSmartPointer<vtkPlane>::New();
-    cutPlane->SetOrigin(width / 2.0, height / 2.0, 0);
-    cutPlane->SetNormal(0, 0, 1);
-    projectionSettings.zMin =
-        static_cast<int>(std::floor(vtkMesh->GetBounds()[4]));
-    projectionSettings.zMax =
-        static_cast<int>(std::ceil(vtkMesh->GetBounds()[5]));
-
     // Bounds checks
     if (projectionSettings.zMin < 0) {
         projectionSettings.zMin = 0;
@@ -196,15 +185,40 @@ auto main(int argc, char* argv[]) -> int
         projectionSettings.zMax += 1;
     }
 
-    // Setup cutting and stripping pipeline
-    auto cutter = vtkSmartPointer<vtkCutter>::New();
-    cutter->SetCutFunction(cutPlane);
-    cutter->SetInputData(vtkMesh);
+    if (parsed.count("visualize") > 0) {
+        // Combine meshes if we have multiple
+        vtkSmartPointer<vtkPolyData> vtkMesh;
+        if (meshes.size() > 1) {
+            // Append all of the meshes into a single polydata
+            auto append = vtkSmartPointer<vtkAppendPolyData>::New();
+            for (auto& mesh : meshes) {
+                append->AddInputData(vcm::ITK2VTK(mesh));
+            }
+            append->Update();
 
-    auto stripper = vtkSmartPointer<vtkStripper>::New();
-    stripper->SetInputConnection(cutter->GetOutputPort());
+            // Clean it up
+            auto cleaner = vtkSmartPointer<vtkCleanPolyData>::New();
+            cleaner->SetInputConnection(append->GetOutputPort());
+            cleaner->Update();
+
+            vtkMesh = cleaner->GetOutput();
+        } else {
+            vtkMesh = vcm::ITK2VTK(meshes[0]);
+        }
+
+        // Setup intersection plane
+        auto cutPlane = vtkSmartPointer<vtkPlane>::New();
+        cutPlane->SetOrigin(width / 2.0, height / 2.0, 0);
+        cutPlane->SetNormal(0, 0, 1);
+
+        // Setup cutting and stripping pipeline
+        auto cutter = vtkSmartPointer<vtkCutter>::New();
+        cutter->SetCutFunction(cutPlane);
+        cutter->SetInputData(vtkMesh);
+
+        auto stripper = vtkSmartPointer<vtkStripper>::New();
+        stripper->SetInputConnection(cutter->GetOutputPort());
 
-    if (parsed.count("visualize") > 0) {
         QApplication app(argc, argv);
         QGuiApplication::setApplicationDisplayName(
             ProjectionViewerWindow::tr("Projection Viewer"));
@@ -214,20 +228,21 @@ auto main(int argc, char* argv[]) -> int
         QApplication::exec();
     }
 
-    // Iterate over every z-index in the range between zMin and zMax
-    // Cut the mesh and draw its corresponding intersection onto a new output
-    // image
-    cv::Mat outputImg;
-    std::vector<cv::Point> contour;
-    for (const auto& zIdx : vc::ProgressWrap(
-             vc::range(projectionSettings.zMin, projectionSettings.zMax),
-             "vc::projection::Projecting:")) {
-        // Cut the mesh and get the intersection
-        cutPlane->SetOrigin(width / 2.0, height / 2.0, zIdx);
-        stripper->Update();
-        auto* intersection = stripper->GetOutput();
+    // Intersect the mesh with every z-index in the range between zMin and
+    // zMax and draw the intersection onto a new output image. Each worker
+    // reads, draws, and encodes one slice at a time, so at most numThreads
+    // slices are in memory, and encoding overlaps with the other workers'
+    // reads and intersections.
+    const auto zMin = projectionSettings.zMin;
+    const auto numSlices = static_cast<std::size_t>(
+        std::max(projectionSettings.zMax - zMin, 0));
+    auto progress =
+        vc::NewProgressCallback(numSlices, "vc::projection::Projecting:");
+    auto projectSlice = [&](std::size_t i) {
+        auto zIdx = zMin + static_cast<int>(i);
 
         // Setup the output image
+        cv::Mat outputImg;
         if (projectionSettings.intersectOnly) {
             outputImg = cv::Mat::zeros(height, width, CV_8UC3);
         } else {
@@ -237,20 +252,13 @@ auto main(int argc, char* argv[]) -> int
         }
 
         // Draw the intersections
-        for (auto cId = 0; cId < intersection->GetNumberOfCells(); ++cId) {
-            auto* inputCell = intersection->GetCell(cId);
-
-            contour.clear();
-            for (auto pIt = 0; pIt < inputCell->GetNumberOfPoints(); ++pIt) {
-                auto pId = inputCell->GetPointId(pIt);
-                contour.emplace_back(cv::Point(
-                    static_cast<int>(intersection->GetPoint(pId)[0]),
-                    static_cast<int>(intersection->GetPoint(pId)[1])));
-            }
-
-            cv::polylines(
-                outputImg, contour, false, projectionSettings.color,
-                projectionSettings.thickness, cv::LINE_AA);
+        for (const auto& s : slicer.intersect(zIdx)) {
+            cv::line(
+                outputImg,
+                {static_cast<int>(s.p0[0]), static_cast<int>(s.p0[1])},
+                {static_cast<int>(s.p1[0]), static_cast<int>(s.p1[1])},
+                projectionSettings.color, projectionSettings.thickness,
+                cv::LINE_AA);
         }
 
         // Save the output to the provided directory
@@ -258,7 +266,9 @@ auto main(int argc, char* argv[]) -> int
         filename << std::setw(padding) << std::setfill('0') << zIdx << ".png";
         auto path = outputDir / filename.str();
         vc::WriteImage(path, outputImg);
-    }
+        progress();
+    };
+    vc::ParallelFor(numSlices, projectSlice, numThreads);
 
     return EXIT_SUCCESS;
 }
@@ -3,6 +3,8 @@
 #include "CVolumeViewer.hpp"
 #include "HBase.hpp"
 
+#include <QSettings>
+
 using namespace ChaoVis;
 
 // Constructor
@@ -18,6 +20,8 @@ CVolumeViewer::CVolumeViewer(QWidget* parent)
     , fPrevBtn(nullptr)
     , fImgQImage(nullptr)
     , fBaseImageItem(nullptr)
+    , fTiledImageItem(nullptr)
+    , fTiledMode(true)
     , fScaleFactor(1.0)
     , fImageIndex(0)
 {
@@ -35,8 +39,6 @@ CVolumeViewer::CVolumeViewer(QWidget* parent)
         fImageIndexEdit, SIGNAL(SendSignalOnTextChanged()), this,
         SLOT(OnImageIndexEditTextChanged()));
 
-    fBaseImageItem = new QGraphicsPixmapItem();
-
     // Create graphics view
     fGraphicsView = new QGraphicsView(this);
     fGraphicsView->setRenderHint(QPainter::Antialiasing);
@@ -47,6 +49,13 @@ CVolumeViewer::CVolumeViewer(QWidget* parent)
     // Set the scene
     fGraphicsView->setScene(fScene);
 
+    // Large slices are drawn as tiles unless disabled in the settings
+    fTiledImageItem = new TiledImageItem();
+    fTiledImageItem->setZValue(-1);
+    fScene->addItem(fTiledImageItem);
+    QSettings settings;
+    fTiledMode = settings.value("volumeViewer/tiledRendering", true).toBool();
+
     fGraphicsView->viewport()->installEventFilter(this);
 
     fButtonsLayout = new QHBoxLayout;
@@ -104,21 +113,36 @@ void CVolumeViewer::SetImage(const QImage& nSrc)
         *fImgQImage = nSrc;
     }
 
-    // Create a QPixmap from the QImage
-    QPixmap pixmap = QPixmap::fromImage(*fImgQImage);
-
-    // Add the QPixmap to the scene as a QGraphicsPixmapItem
-    if(fBaseImageItem) {
-        // If the item already exists, remove it from the scene
+    // Remove the old QGraphicsPixmapItem, if any
+    if (fBaseImageItem && fBaseImageItem != fTiledImageItem) {
         fScene->removeItem(fBaseImageItem);
-        delete fBaseImageItem; // Delete the old item
+        delete fBaseImageItem;
+    }
+
+    if (fTiledMode) {
+        // Only the visible tiles are generated and drawn
+        fTiledImageItem->setImage(*fImgQImage);
+        fBaseImageItem = fTiledImageItem;
+    } else {
+        // Add the whole image to the scene as a QGraphicsPixmapItem
+        fTiledImageItem->setImage(QImage());
+        QPixmap pixmap = QPixmap::fromImage(*fImgQImage);
+        fBaseImageItem = fScene->addPixmap(pixmap);
+        fBaseImageItem->setZValue(-1);
     }
-    fBaseImageItem = fScene->addPixmap(pixmap);
 
     UpdateButtons();
     update();
 }
 
+void CVolumeViewer::SetTiledMode(bool b)
+{
+    fTiledMode = b;
+    if (fImgQImage != nullptr) {
+        SetImage(*fImgQImage);
+    }
+}
+
 
 
 bool CVolumeViewer::eventFilter(QObject* watched, QEvent* event)
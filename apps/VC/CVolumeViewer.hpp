@@ -8,6 +8,7 @@
 #include <opencv2/opencv.hpp>
 
 #include "CSimpleNumEditBox.hpp"
+#include "TiledImageItem.hpp"
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
@@ -29,6 +30,7 @@ public:
     virtual void setButtonsEnabled(bool state);
 
     virtual void SetImage(const QImage& nSrc);
+    void SetTiledMode(bool b);
     void SetImageIndex(int nImageIndex)
     {
         fImageIndex = nImageIndex;
@@ -78,7 +80,10 @@ protected:
     double fScaleFactor;
     int fImageIndex;
 
-    QGraphicsPixmapItem* fBaseImageItem;
+    QGraphicsItem* fBaseImageItem;
+    // draws only the visible tiles at the zoom's level of detail
+    TiledImageItem* fTiledImageItem;
+    bool fTiledMode;
 
 
 
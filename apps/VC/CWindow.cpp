@@ -86,8 +86,7 @@ CWindow::CWindow()
     , fPathListWidget(nullptr)
     , fPenTool(nullptr)
     , fSegTool(nullptr)
-    , stopPrefetching(false)
-    ,  prefetchSliceIndex(-1)
+    , fSliceCache(nullptr)
     , fSegStruct()
 {
 
@@ -144,8 +143,8 @@ CWindow::CWindow()
 // Destructor
 CWindow::~CWindow(void)
 {
-    stopPrefetching.store(true);
-    cv.notify_one();  // Wake up the thread if it's waitings
+    // Stop the slice decoders before the window is torn down
+    delete fSliceCache;
     worker_thread_.quit();
     worker_thread_.wait();
     SDL_Quit();
@@ -198,6 +197,12 @@ void CWindow::CreateWidgets(void)
         fVolumeViewerWidget, SIGNAL(SendSignalPathChanged()), this,
         SLOT(OnPathChanged()));
 
+    // Slices are decoded in the background and displayed once they are ready
+    fSliceCache = new SliceImageCache(this);
+    connect(
+        fSliceCache, &SliceImageCache::sliceReady, this,
+        &CWindow::OnSliceReady);
+
     // new path button
     QPushButton* aBtnNewPath = this->findChild<QPushButton*>("btnNewPath");
     QPushButton* aBtnRemovePath =
@@ -1122,93 +1127,72 @@ void CWindow::SetCurrentCurve(int nCurrentSliceIndex)
     }
 }
 
-void CWindow::prefetchSlices(void) {
-  while (true) {
-    std::unique_lock<std::mutex> lk(cv_m);
-    cv.wait(lk, [this]{return prefetchSliceIndex != -1;});
-
-    if (stopPrefetching.load()) {
-      break;
+// Open slice
+void CWindow::OpenSlice(void)
+{
+    if (fVpkg == nullptr or currentVolume == nullptr) {
+        fSliceCache->setVolume(nullptr);
+        QImage blank(10, 10, QImage::Format_Grayscale8);
+        blank.fill(0);
+        ShowSlice(blank);
+        return;
     }
 
-    int prefetchWindow = 100;
-    int currentSliceIndex = prefetchSliceIndex.load();
-    int start = std::max(0, currentSliceIndex - prefetchWindow);
-    int end = std::min(currentVolume->numSlices()-1, currentSliceIndex + prefetchWindow);
-
-    int n = 5;  // Number Fetching Threads
-    // fetching from index outwards
-    for (int offset = 0; offset <= prefetchWindow; offset = offset + n) {
-        std::vector<std::thread> threads;
-
-        for (int i = 0; i <= n; i++) {
-            // Fetch the slice data on the right side
-            // Fetch the slice data on the right side
-            if (currentSliceIndex + offset + i <= end) {
-                threads.emplace_back(&volcart::Volume::getSliceData, currentVolume, currentSliceIndex + offset + i);
-            }
-            // Fetch the slice data on the left side
-            if (currentSliceIndex - offset - i >= start) {
-                threads.emplace_back(&volcart::Volume::getSliceData, currentVolume, currentSliceIndex - offset - i);
-            }
-        }
-
-        for (auto& t : threads) {
-            t.join();
-        }
-
-        // Check if prefetching was stopped or slice index changed
-        if (stopPrefetching.load() || prefetchSliceIndex.load() != currentSliceIndex) {
-            break;
-        }
+    // Cancel stale requests and prefetch the slices around this one. The
+    // segmentation tool also warms the volume's slice cache.
+    if (fSliceCache->volume() != currentVolume) {
+        fSliceCache->setVolume(currentVolume);
     }
+    auto warmRadius =
+        fWindowState == EWindowState::WindowStateSegmentation
+            ? SEGMENTATION_PREFETCH_RADIUS
+            : 0;
+    fSliceCache->request(fPathOnSliceIndex, warmRadius);
+    fVolumeViewerWidget->SetImageIndex(fPathOnSliceIndex);
 
-    prefetchSliceIndex = -1;
-  }
-}
-
-// Function to start prefetching around a certain slice
-void CWindow::startPrefetching(int index) {
-  prefetchSliceIndex = index;
-  cv.notify_one();
+    // Otherwise OnSliceReady() displays the slice once it has been decoded
+    if (auto image = fSliceCache->get(fPathOnSliceIndex)) {
+        ShowSlice(*image);
+    }
 }
 
-// Open slice
-void CWindow::OpenSlice(void)
+// Display a decoded slice image
+void CWindow::ShowSlice(const QImage& image)
 {
-    cv::Mat aImgMat;
-    if (fVpkg != nullptr) {
-        // Stop prefetching
-        prefetchSliceIndex = -1;
-        cv.notify_one();
+    if (not image.isNull()) {
+        fVolumeViewerWidget->SetImage(image);
+        fVolumeViewerWidget->SetImageIndex(fPathOnSliceIndex);
+        return;
+    }
 
-        aImgMat = currentVolume->getSliceDataCopy(fPathOnSliceIndex);
-        aImgMat.convertTo(aImgMat, CV_8UC1, 1.0 / 256.0);
-        //        cvtColor(aImgMat, aImgMat, cv::COLOR_GRAY2BGR);
-    } else {
-        aImgMat = cv::Mat::zeros(10, 10, CV_8UC1);
-    }
-
-    if (aImgMat.empty()) {
-        auto h = currentVolume->sliceHeight();
-        auto w = currentVolume->sliceWidth();
-        aImgMat = cv::Mat::zeros(h, w, CV_8UC3);
-        aImgMat = vc::color::RED;
-        const std::string msg{"FILE MISSING"};
-        auto params = CalculateOptimalTextParams(msg, w, h);
-        auto originX = (w - params.size.width) / 2;
-        auto originY = params.size.height + (h - params.size.height) / 2;
-        cv::Point origin{originX, originY};
-        cv::putText(
-            aImgMat, msg, origin, params.font, params.scale, vc::color::WHITE,
-            params.thickness, params.baseline);
-    }
-
-    auto aImgQImage = Mat2QImage(aImgMat);
-    fVolumeViewerWidget->SetImage(aImgQImage);
+    auto h = currentVolume->sliceHeight();
+    auto w = currentVolume->sliceWidth();
+    cv::Mat aImgMat = cv::Mat::zeros(h, w, CV_8UC3);
+    aImgMat = vc::color::RED;
+    const std::string msg{"FILE MISSING"};
+    auto params = CalculateOptimalTextParams(msg, w, h);
+    auto originX = (w - params.size.width) / 2;
+    auto originY = params.size.height + (h - params.size.height) / 2;
+    cv::Point origin{originX, originY};
+    cv::putText(
+        aImgMat, msg, origin, params.font, params.scale, vc::color::WHITE,
+        params.thickness, params.baseline);
+
+    fVolumeViewerWidget->SetImage(Mat2QImage(aImgMat));
     fVolumeViewerWidget->SetImageIndex(fPathOnSliceIndex);
 }
 
+// Display a slice once it has been decoded, if it is still current
+void CWindow::OnSliceReady(int nSliceIndex)
+{
+    if (fVpkg == nullptr or nSliceIndex != fPathOnSliceIndex) {
+        return;
+    }
+    if (auto image = fSliceCache->get(nSliceIndex)) {
+        ShowSlice(*image);
+    }
+}
+
 // Initialize path list
 void CWindow::InitPathList(void)
 {
@@ -1803,14 +1787,10 @@ void CWindow::TogglePenTool(void)
 void CWindow::ToggleSegmentationTool(void)
 {
     if (fSegTool->isChecked()) {
-        // If the prefetching worker is not yet running, start it
-        if (!prefetchWorker.joinable()) {
-            prefetchWorker = std::thread(&CWindow::prefetchSlices, this);
-        }
-        // Start prefetching around the current slice
-        startPrefetching(fPathOnSliceIndex);
-
         fWindowState = EWindowState::WindowStateSegmentation;
+
+        // Start prefetching around the current slice
+        OpenSlice();
         fUpperPart.reset();
         fStartingPath.clear();
         SplitCloud();
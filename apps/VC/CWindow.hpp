@@ -17,6 +17,7 @@
 #include "MathUtils.hpp"
 #include "ui_VCMain.h"
 #include "SegmentationStruct.hpp"
+#include "SliceImageCache.hpp"
 
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/segmentation/ChainSegmentationAlgorithm.hpp"
@@ -126,9 +127,8 @@ private:
     void SetUpCurves(void);
     void SetCurrentCurve(int nCurrentSliceIndex);
 
-    void prefetchSlices(void);
-    void startPrefetching(int index);
     void OpenSlice(void);
+    void ShowSlice(const QImage& image);
 
     void InitPathList(void);
 
@@ -182,6 +182,7 @@ private slots:
     void OnEdtImpactRange(int nImpactRange);
 
     void OnLoadAnySlice(int nSliceIndex);
+    void OnSliceReady(int nSliceIndex);
     void OnLoadNextSlice(void);
     void OnLoadPrevSlice(void);
     void OnLoadNextSliceShift(int shift);
@@ -206,6 +207,10 @@ private:
     volcart::Segmentation::Pointer fSegmentation;
     volcart::Volume::Pointer currentVolume;
 
+    // Number of slices on each side of the current slice which are loaded
+    // into the volume's slice cache while segmenting
+    static const int SEGMENTATION_PREFETCH_RADIUS = 100;
+
     static const int AMPLITUDE = 28000;
     static const int FREQUENCY = 44100;
 
@@ -303,12 +308,8 @@ private:
     QLabel* progressLabel_;
     QProgressBar* progressBar_;
 
-    // Prefetching worker
-    std::thread prefetchWorker;
-    std::condition_variable cv;
-    std::mutex cv_m;
-    std::atomic<bool> stopPrefetching;
-    std::atomic<int> prefetchSliceIndex;
+    // Display-ready slice images
+    SliceImageCache* fSliceCache;
 };  // class CWindow
 
 class VolPkgBackend : public QObject
@@ -0,0 +1,267 @@
+// SliceImageCache.cpp
+#include "SliceImageCache.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+using namespace ChaoVis;
+
+namespace vc = volcart;
+
+SliceImageCache::SliceImageCache(QObject* parent, std::size_t numThreads)
+    : QObject(parent)
+{
+    setWindow(0, 65535);
+
+    if (numThreads == 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency() / 2);
+    }
+    for (std::size_t i = 0; i < numThreads; i++) {
+        workers_.emplace_back(&SliceImageCache::run_, this);
+    }
+}
+
+SliceImageCache::~SliceImageCache()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void SliceImageCache::setVolume(vc::Volume::Pointer volume)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    volume_ = std::move(volume);
+    reset_();
+}
+
+auto SliceImageCache::volume() const -> vc::Volume::Pointer
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return volume_;
+}
+
+void SliceImageCache::setWindow(std::uint16_t low, std::uint16_t high)
+{
+    if (low >= high) {
+        throw std::invalid_argument("Window low must be less than high");
+    }
+
+    auto lut = std::make_shared<LUT>(vc::WindowLUT16U(low, high));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    lut_ = std::move(lut);
+    reset_();
+}
+
+void SliceImageCache::setCapacity(std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    capacity_ = bytes;
+    while (size_ > capacity_ and not lru_.empty()) {
+        auto it = images_.find(lru_.back());
+        size_ -= image_bytes_(it->second.image);
+        images_.erase(it);
+        lru_.pop_back();
+    }
+}
+
+auto SliceImageCache::get(int index) -> std::optional<QImage>
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = images_.find(index);
+    if (it == images_.end()) {
+        return std::nullopt;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.image;
+}
+
+void SliceImageCache::request(int index, int warmRadius)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.clear();
+    generation_++;
+    if (not volume_ or index < 0 or index >= volume_->numSlices()) {
+        return;
+    }
+
+    // Only prefetch as many slices as fit in the cache
+    auto sliceBytes = std::max<std::size_t>(
+        1, static_cast<std::size_t>(volume_->sliceWidth()) *
+               static_cast<std::size_t>(volume_->sliceHeight()));
+    auto fit = static_cast<int>(std::min<std::size_t>(
+        capacity_ / sliceBytes, 2 * MAX_PREFETCH_RADIUS + 1));
+    auto radius = std::max(0, (fit - 1) / 2);
+
+    // Mark the cached slices near the requested slice as recently used so
+    // they are not evicted by the new images
+    auto inRange = [&](int i) { return i >= 0 and i < volume_->numSlices(); };
+    for (int d = radius; d >= 0; d--) {
+        for (auto i : {index + d, index - d}) {
+            auto it = images_.find(i);
+            if (it != images_.end()) {
+                lru_.splice(lru_.begin(), lru_, it->second.lru);
+            }
+        }
+    }
+
+    // Queue the missing slices in order of their distance from the requested
+    // slice, followed by the slices which are only warmed
+    for (int d = 0; d <= std::max(radius, warmRadius); d++) {
+        auto display = d <= radius;
+        for (auto i : {index + d, index - d}) {
+            if (inRange(i) and (i != index or d == 0) and
+                (not display or images_.count(i) == 0)) {
+                queue_.push_back({i, display, generation_});
+            }
+            if (d == 0) {
+                break;
+            }
+        }
+    }
+    lock.unlock();
+    cv_.notify_all();
+}
+
+void SliceImageCache::cancel()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.clear();
+    generation_++;
+}
+
+void SliceImageCache::run_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stop_ or not queue_.empty(); });
+        if (stop_) {
+            return;
+        }
+        auto req = queue_.front();
+        queue_.pop_front();
+        if (req.generation != generation_) {
+            continue;
+        }
+
+        // Skip slices which are cached or being decoded by another worker
+        auto epoch = epoch_;
+        if (req.display) {
+            auto busy = inFlight_.find(req.index);
+            if (images_.count(req.index) > 0 or
+                (busy != inFlight_.end() and busy->second == epoch)) {
+                continue;
+            }
+            inFlight_[req.index] = epoch;
+        }
+        auto volume = volume_;
+        auto lut = lut_;
+        lock.unlock();
+
+        // Decode without holding the lock
+        QImage image;
+        try {
+            if (req.display) {
+                image = decode_(volume, req.index, *lut);
+            } else {
+                volume->getSliceData(req.index);
+            }
+        } catch (const std::exception&) {
+            // Unreadable slices are cached as null images
+        }
+
+        lock.lock();
+        if (not req.display) {
+            continue;
+        }
+        auto busy = inFlight_.find(req.index);
+        if (busy != inFlight_.end() and busy->second == epoch) {
+            inFlight_.erase(busy);
+        }
+        // Discard images decoded with an old volume or window
+        if (epoch != epoch_) {
+            continue;
+        }
+        insert_(req.index, std::move(image));
+        lock.unlock();
+        emit sliceReady(req.index);
+        lock.lock();
+    }
+}
+
+auto SliceImageCache::decode_(
+    const vc::Volume::Pointer& volume, int index, const LUT& lut) -> QImage
+{
+    auto slice = volume->getSliceData(index);
+    if (slice.empty()) {
+        return {};
+    }
+    if (slice.channels() > 1) {
+        cv::cvtColor(slice, slice, cv::COLOR_BGR2GRAY);
+    }
+
+    // Window the slice straight into the QImage's buffer
+    QImage image(slice.cols, slice.rows, QImage::Format_Grayscale8);
+    if (image.isNull()) {
+        return {};
+    }
+    cv::Mat out(
+        image.height(), image.width(), CV_8UC1, image.bits(),
+        static_cast<std::size_t>(image.bytesPerLine()));
+    if (slice.depth() == CV_16U) {
+        // Slices are already decoded in parallel by the worker threads
+        vc::ApplyLUT16U(slice, lut, out, 1);
+    } else {
+        slice.convertTo(out, CV_8U);
+    }
+    return image;
+}
+
+void SliceImageCache::insert_(int index, QImage image)
+{
+    auto it = images_.find(index);
+    if (it != images_.end()) {
+        size_ -= image_bytes_(it->second.image);
+        lru_.erase(it->second.lru);
+        images_.erase(it);
+    }
+
+    size_ += image_bytes_(image);
+    lru_.push_front(index);
+    images_[index] = {std::move(image), lru_.begin()};
+
+    // Evict the least recently used images, but always keep the new one
+    while (size_ > capacity_ and lru_.size() > 1) {
+        auto last = images_.find(lru_.back());
+        size_ -= image_bytes_(last->second.image);
+        images_.erase(last);
+        lru_.pop_back();
+    }
+}
+
+void SliceImageCache::reset_()
+{
+    queue_.clear();
+    generation_++;
+    epoch_++;
+    images_.clear();
+    lru_.clear();
+    size_ = 0;
+}
+
+auto SliceImageCache::image_bytes_(const QImage& image) -> std::size_t
+{
+    return static_cast<std::size_t>(image.sizeInBytes());
+}
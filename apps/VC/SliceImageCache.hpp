@@ -0,0 +1,173 @@
+// SliceImageCache.hpp
+#pragma once
+
+#include <QImage>
+#include <QObject>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/util/ImageConversion.hpp"
+
+namespace ChaoVis
+{
+
+/**
+ * @brief Byte-bounded cache of display-ready slice images
+ *
+ * Slices are decoded by a persistent pool of worker threads, windowed to
+ * 8-bit, and written directly into the buffer of a grayscale QImage. Cached
+ * images are implicitly shared with Qt, so displaying a slice never copies
+ * its pixels.
+ *
+ * Each call to request() cancels the requests which have not been started
+ * yet, so scrolling quickly through a volume only decodes the slices which
+ * are still near the current slice. sliceReady() is emitted from a worker
+ * thread whenever a requested image has been added to the cache.
+ */
+class SliceImageCache : public QObject
+{
+    Q_OBJECT
+
+public:
+    /** Default maximum size of the cached images in bytes */
+    static constexpr std::size_t DEFAULT_CAPACITY{std::size_t{1} << 30};
+
+    /** Maximum number of slices which request() prefetches on each side */
+    static constexpr int MAX_PREFETCH_RADIUS{16};
+
+    /**
+     * @brief Constructor
+     *
+     * If `numThreads` is 0, uses half of the hardware threads.
+     */
+    explicit SliceImageCache(
+        QObject* parent = nullptr, std::size_t numThreads = 0);
+
+    /** Destructor. Stops the worker threads. */
+    ~SliceImageCache() override;
+
+    /**
+     * @brief Set the volume
+     *
+     * Purges the cache and cancels all pending requests.
+     */
+    void setVolume(volcart::Volume::Pointer volume);
+
+    /** @brief Get the volume */
+    auto volume() const -> volcart::Volume::Pointer;
+
+    /**
+     * @brief Set the intensity window which is mapped to [0, 255]
+     *
+     * Values outside of the window are clamped. The default window maps the
+     * full 16-bit range to 8-bit. Purges the cache and cancels all pending
+     * requests.
+     */
+    void setWindow(std::uint16_t low, std::uint16_t high);
+
+    /**
+     * @brief Set the maximum size of the cached images in bytes
+     *
+     * Least recently used images are evicted once the cache is full.
+     */
+    void setCapacity(std::size_t bytes);
+
+    /**
+     * @brief Get a cached slice image
+     *
+     * Returns an empty optional if the slice is not cached. A cached null
+     * QImage indicates that the slice could not be loaded.
+     */
+    auto get(int index) -> std::optional<QImage>;
+
+    /**
+     * @brief Request a slice and the slices around it
+     *
+     * Pending requests are cancelled. `index` is queued first, followed by
+     * the neighboring slices in order of their distance from `index`, up to
+     * the number of slices which fit in the cache. Slices from the remaining
+     * `warmRadius` are only loaded into the volume's slice cache.
+     */
+    void request(int index, int warmRadius = 0);
+
+    /** @brief Cancel all pending requests */
+    void cancel();
+
+signals:
+    /** @brief Emitted when a requested slice has been added to the cache */
+    void sliceReady(int index);
+
+private:
+    /** Pending request */
+    struct Request {
+        int index;
+        bool display;
+        std::uint64_t generation;
+    };
+
+    /** Cache entry */
+    struct Entry {
+        QImage image;
+        std::list<int>::iterator lru;
+    };
+
+    /** Intensity lookup table */
+    using LUT = volcart::LUT16U;
+
+    /** Worker thread loop */
+    void run_();
+    /** Decode and window a slice */
+    static auto decode_(
+        const volcart::Volume::Pointer& volume, int index, const LUT& lut)
+        -> QImage;
+    /** Insert an image, evicting the LRU images as needed */
+    void insert_(int index, QImage image);
+    /** Purge the cache and cancel pending requests */
+    void reset_();
+    /** Size of an image in bytes */
+    static auto image_bytes_(const QImage& image) -> std::size_t;
+
+    /** Protects all of the following members */
+    mutable std::mutex mutex_;
+    /** Signals new requests and shutdown to the workers */
+    std::condition_variable cv_;
+    /** Decoder threads */
+    std::vector<std::thread> workers_;
+    /** Pending requests */
+    std::deque<Request> queue_;
+    /** Incremented whenever pending requests are cancelled */
+    std::uint64_t generation_{0};
+    /** Incremented whenever the cached images are invalidated */
+    std::uint64_t epoch_{0};
+    /** Slices being decoded and the epoch they were requested in */
+    std::unordered_map<int, std::uint64_t> inFlight_;
+    /** Shut down the workers */
+    bool stop_{false};
+
+    /** Volume */
+    volcart::Volume::Pointer volume_;
+    /** Intensity lookup table for the current window */
+    std::shared_ptr<const LUT> lut_;
+
+    /** Cached images */
+    std::unordered_map<int, Entry> images_;
+    /** Cached slice indices, most recently used first */
+    std::list<int> lru_;
+    /** Total size of the cached images */
+    std::size_t size_{0};
+    /** Maximum size of the cached images */
+    std::size_t capacity_{DEFAULT_CAPACITY};
+};
+
+}  // namespace ChaoVis
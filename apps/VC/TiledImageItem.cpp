@@ -0,0 +1,281 @@
+// TiledImageItem.cpp
+#include "TiledImageItem.hpp"
+
+#include <QMetaObject>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include <opencv2/core.hpp>
+#include <opencv2/imgproc.hpp>
+
+using namespace ChaoVis;
+
+TiledImageItem::TiledImageItem(QGraphicsItem* parent) : QGraphicsObject(parent)
+{
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+    pool_.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+}
+
+TiledImageItem::~TiledImageItem()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        generation_++;
+    }
+    pool_.clear();
+    pool_.waitForDone();
+}
+
+void TiledImageItem::setImage(const QImage& image)
+{
+    // Tiles are box-filtered with OpenCV, which needs 8-bit pixels
+    auto src = image;
+    if (not src.isNull() and src.format() != QImage::Format_Grayscale8 and
+        src.format() != QImage::Format_RGB888) {
+        src = src.convertToFormat(
+            src.isGrayscale() ? QImage::Format_Grayscale8
+                              : QImage::Format_RGB888);
+    }
+
+    if (src.size() != image_.size()) {
+        prepareGeometryChange();
+    }
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        image_ = std::move(src);
+        epoch_++;
+        purge_();
+    }
+    update();
+}
+
+void TiledImageItem::setCapacity(std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    capacity_ = bytes;
+    while (size_ > capacity_ and not lru_.empty()) {
+        auto it = tiles_.find(lru_.back());
+        size_ -= static_cast<std::size_t>(it->second.tile.sizeInBytes());
+        tiles_.erase(it);
+        lru_.pop_back();
+    }
+}
+
+auto TiledImageItem::boundingRect() const -> QRectF
+{
+    return {QPointF(0, 0), QSizeF(image_.size())};
+}
+
+void TiledImageItem::paint(
+    QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget*)
+{
+    auto bounds = QRect(QPoint(0, 0), image_.size());
+    auto exposed = option->exposedRect.toAlignedRect() & bounds;
+    if (image_.isNull() or exposed.isEmpty()) {
+        return;
+    }
+
+    // Pick the level whose resolution is closest to, but not lower than, the
+    // view's resolution
+    auto lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(
+        painter->worldTransform());
+    auto level = 0;
+    if (lod > 0 and lod < 1) {
+        level = static_cast<int>(std::floor(std::log2(1.0 / lod)));
+        level = std::min(level, max_level_());
+    }
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, lod < 1);
+
+    // The source image is already at full resolution
+    if (level == 0) {
+        painter->drawImage(exposed, image_, exposed);
+        return;
+    }
+
+    // Draw the cached tiles and request the others
+    auto span = TILE_SIZE << level;
+    std::vector<QPoint> missing;
+    for (auto ty = exposed.top() / span; ty <= exposed.bottom() / span; ty++) {
+        for (auto tx = exposed.left() / span; tx <= exposed.right() / span;
+             tx++) {
+            auto region = tile_rect_(level, tx, ty);
+            QImage tile;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                tile = find_(key_(level, tx, ty));
+            }
+            if (not tile.isNull()) {
+                painter->drawImage(QRectF(region), tile);
+            } else {
+                missing.emplace_back(tx, ty);
+                draw_fallback_(painter, level, region);
+            }
+        }
+    }
+    request_(level, missing);
+}
+
+auto TiledImageItem::key_(int level, int x, int y) -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(level) << 48) |
+           (static_cast<std::uint64_t>(x) << 24) |
+           static_cast<std::uint64_t>(y);
+}
+
+auto TiledImageItem::tile_rect_(int level, int x, int y) const -> QRect
+{
+    auto span = TILE_SIZE << level;
+    return QRect(x * span, y * span, span, span) &
+           QRect(QPoint(0, 0), image_.size());
+}
+
+auto TiledImageItem::max_level_() const -> int
+{
+    auto level = 0;
+    auto size = std::max(image_.width(), image_.height());
+    while ((TILE_SIZE << level) < size) {
+        level++;
+    }
+    return level;
+}
+
+auto TiledImageItem::find_(std::uint64_t key) -> QImage
+{
+    auto it = tiles_.find(key);
+    if (it == tiles_.end()) {
+        return {};
+    }
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    return it->second.tile;
+}
+
+void TiledImageItem::draw_fallback_(
+    QPainter* painter, int level, const QRect& region)
+{
+    for (auto l = level + 1; l <= max_level_(); l++) {
+        auto span = TILE_SIZE << l;
+        auto tx = region.left() / span;
+        auto ty = region.top() / span;
+        QImage tile;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            tile = find_(key_(l, tx, ty));
+        }
+        if (tile.isNull()) {
+            continue;
+        }
+
+        // Map the region into the coarse tile's pixels
+        auto origin = tile_rect_(l, tx, ty).topLeft();
+        auto scale = 1.0 / static_cast<double>(1 << l);
+        QRectF src(
+            (region.left() - origin.x()) * scale,
+            (region.top() - origin.y()) * scale, region.width() * scale,
+            region.height() * scale);
+        painter->drawImage(QRectF(region), tile, src);
+        return;
+    }
+
+    // No coarser tiles are cached (e.g. right after the image changed), so
+    // scale the source image. Slower than drawing a tile, but avoids
+    // flashing an empty region until the tiles are ready.
+    painter->drawImage(QRectF(region), image_, QRectF(region));
+}
+
+void TiledImageItem::request_(int level, const std::vector<QPoint>& tiles)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    // Jobs which have not started are dropped unless they are requested again
+    generation_++;
+    for (const auto& t : tiles) {
+        auto key = key_(level, t.x(), t.y());
+        auto it = inFlight_.find(key);
+        if (it != inFlight_.end()) {
+            it->second = generation_;
+            continue;
+        }
+        inFlight_[key] = generation_;
+        pool_.start([this, level, t]() { generate_(level, t.x(), t.y()); });
+    }
+}
+
+void TiledImageItem::generate_(int level, int x, int y)
+{
+    auto key = key_(level, x, y);
+    QImage src;
+    QRect region;
+    std::uint64_t epoch{0};
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto it = inFlight_.find(key);
+        if (it == inFlight_.end()) {
+            return;
+        }
+        if (it->second != generation_) {
+            inFlight_.erase(it);
+            return;
+        }
+        src = image_;
+        region = tile_rect_(level, x, y);
+        epoch = epoch_;
+    }
+
+    // Box filter the tile's region into a new image
+    auto scale = 1 << level;
+    QImage tile(
+        (region.width() + scale - 1) / scale,
+        (region.height() + scale - 1) / scale, src.format());
+    if (not region.isEmpty() and not tile.isNull()) {
+        auto type =
+            src.format() == QImage::Format_Grayscale8 ? CV_8UC1 : CV_8UC3;
+        auto* bits = const_cast<uchar*>(src.constBits());
+        const cv::Mat in(
+            src.height(), src.width(), type, bits,
+            static_cast<std::size_t>(src.bytesPerLine()));
+        cv::Mat out(
+            tile.height(), tile.width(), type, tile.bits(),
+            static_cast<std::size_t>(tile.bytesPerLine()));
+        cv::resize(
+            in(cv::Rect(region.x(), region.y(), region.width(),
+                        region.height())),
+            out, out.size(), 0, 0, cv::INTER_AREA);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        inFlight_.erase(key);
+        if (epoch == epoch_) {
+            insert_(key, std::move(tile));
+        }
+    }
+    QMetaObject::invokeMethod(
+        this, [this]() { update(); }, Qt::QueuedConnection);
+}
+
+void TiledImageItem::insert_(std::uint64_t key, QImage tile)
+{
+    size_ += static_cast<std::size_t>(tile.sizeInBytes());
+    lru_.push_front(key);
+    tiles_[key] = {std::move(tile), lru_.begin()};
+
+    // Evict the least recently used tiles, but always keep the new one
+    while (size_ > capacity_ and lru_.size() > 1) {
+        auto last = tiles_.find(lru_.back());
+        size_ -= static_cast<std::size_t>(last->second.tile.sizeInBytes());
+        tiles_.erase(last);
+        lru_.pop_back();
+    }
+}
+
+void TiledImageItem::purge_()
+{
+    tiles_.clear();
+    lru_.clear();
+    size_ = 0;
+}
@@ -0,0 +1,122 @@
+// TiledImageItem.hpp
+#pragma once
+
+#include <QGraphicsObject>
+#include <QImage>
+#include <QThreadPool>
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ChaoVis
+{
+
+/**
+ * @brief Graphics item which draws a large image as level-of-detail tiles
+ *
+ * The item only draws the tiles which intersect the exposed area of the
+ * view, at the pyramid level which matches the view's zoom factor. Level `L`
+ * tiles are box-filtered from the source image at 1/2^L resolution on a
+ * background thread pool and are kept in a byte-bounded LRU cache. Tiles
+ * which are not ready yet are drawn from a coarser cached level, or scaled
+ * from the source image if no coarser tile is cached, until they have been
+ * generated. At full resolution, the visible part of the source image is
+ * drawn directly.
+ *
+ * The cost of drawing the item depends on the size of the viewport and not on
+ * the size of the image. The item's coordinate system is the image's pixel
+ * coordinates.
+ */
+class TiledImageItem : public QGraphicsObject
+{
+    Q_OBJECT
+
+public:
+    /** Edge length of a tile in pixels */
+    static constexpr int TILE_SIZE{256};
+
+    /** Default maximum size of the cached tiles in bytes */
+    static constexpr std::size_t DEFAULT_CAPACITY{std::size_t{256} << 20};
+
+    /** Constructor */
+    explicit TiledImageItem(QGraphicsItem* parent = nullptr);
+
+    /** Destructor. Waits for the running tile jobs. */
+    ~TiledImageItem() override;
+
+    /**
+     * @brief Set the source image
+     *
+     * The image is shared, not copied, unless it has to be converted to
+     * 8-bit grayscale or RGB. Purges the tile cache.
+     */
+    void setImage(const QImage& image);
+
+    /** @brief Set the maximum size of the cached tiles in bytes */
+    void setCapacity(std::size_t bytes);
+
+    /** @brief Get the bounds of the image */
+    auto boundingRect() const -> QRectF override;
+
+    /** @brief Draw the visible tiles */
+    void paint(
+        QPainter* painter,
+        const QStyleOptionGraphicsItem* option,
+        QWidget* widget) override;
+
+private:
+    /** Cache entry */
+    struct Entry {
+        QImage tile;
+        std::list<std::uint64_t>::iterator lru;
+    };
+
+    /** Pack a tile's level and position into a cache key */
+    static auto key_(int level, int x, int y) -> std::uint64_t;
+    /** Region of the source image covered by a tile */
+    auto tile_rect_(int level, int x, int y) const -> QRect;
+    /** Coarsest pyramid level */
+    auto max_level_() const -> int;
+    /** Get a cached tile, or a null image. Requires the lock. */
+    auto find_(std::uint64_t key) -> QImage;
+    /**
+     * Draw a region from the finest cached tile of a coarser level, or from
+     * the source image if there is none
+     */
+    void draw_fallback_(QPainter* painter, int level, const QRect& region);
+    /** Queue jobs for the missing tiles, cancelling unstarted stale jobs */
+    void request_(int level, const std::vector<QPoint>& tiles);
+    /** Generate a tile. Runs on the thread pool. */
+    void generate_(int level, int x, int y);
+    /** Insert a tile, evicting the LRU tiles as needed. Requires the lock. */
+    void insert_(std::uint64_t key, QImage tile);
+    /** Purge the tile cache. Requires the lock. */
+    void purge_();
+
+    /** Tile generators */
+    QThreadPool pool_;
+    /** Protects all of the following members */
+    std::mutex mutex_;
+    /** Source image */
+    QImage image_;
+    /** Incremented whenever the source image changes */
+    std::uint64_t epoch_{0};
+    /** Incremented whenever tiles are requested */
+    std::uint64_t generation_{0};
+    /** Tiles being generated and the generation they were last requested in */
+    std::unordered_map<std::uint64_t, std::uint64_t> inFlight_;
+    /** Cached tiles */
+    std::unordered_map<std::uint64_t, Entry> tiles_;
+    /** Cached tile keys, most recently used first */
+    std::list<std::uint64_t> lru_;
+    /** Total size of the cached tiles */
+    std::size_t size_{0};
+    /** Maximum size of the cached tiles */
+    std::size_t capacity_{DEFAULT_CAPACITY};
+};
+
+}  // namespace ChaoVis
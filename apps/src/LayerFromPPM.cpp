@@ -1,19 +1,22 @@
+#include <cstdint>
 #include <sstream>
 
 #include <boost/program_options.hpp>
 #include <opencv2/opencv.hpp>
 
 #include "vc/app_support/GetMemorySize.hpp"
+#include "vc/app_support/TiledRenderOptions.hpp"
 #include "vc/core/filesystem.hpp"
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/neighborhood/LineGenerator.hpp"
 #include "vc/core/types/PerPixelMap.hpp"
 #include "vc/core/types/VolumePkg.hpp"
-#include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
+#include "vc/core/util/Parallel.hpp"
 #include "vc/core/util/String.hpp"
 #include "vc/texturing/LayerTexture.hpp"
+#include "vc/texturing/TiledRenderer.hpp"
 
 namespace vc = volcart;
 namespace fs = volcart::filesystem;
@@ -22,8 +25,6 @@ namespace po = boost::program_options;
 // Volpkg version required by this app
 static constexpr int VOLPKG_SUPPORTED_VERSION = 6;
 
-using volcart::enumerate;
-
 auto main(int argc, char* argv[]) -> int
 {
     ///// Parse the command line options /////
@@ -43,7 +44,22 @@ auto main(int argc, char* argv[]) -> int
             "that maps to the layer subvolume.")
         ("image-format,f", po::value<std::string>()->default_value("png"),
             "Image format for layer images. Default: png")
-        ("compression", po::value<int>(), "Image compression level");
+        ("compression", po::value<int>(), "Image compression level. For "
+            "TIFF images, the TIFF compression scheme. Tiled renders support "
+            "1 (none), 8 (Adobe Deflate, default), and 32946 (Deflate).");
+
+    po::options_description tileOptions("Tiled Rendering Options");
+    tileOptions.add_options()
+        ("tile-size", po::value<std::uint32_t>(),
+            "If provided, render the layers in square tiles of this size and "
+            "write them as tiled TIFFs. Peak memory use is bounded by a few "
+            "tiles rather than the full image size. Must be a multiple of 16. "
+            "Requires a TIFF image format.")
+        ("multi-page", "When rendering in tiles, write all layers as the "
+            "pages of a single TIFF file, layers.tif, in the output directory")
+        ("threads", po::value<std::size_t>()->default_value(0),
+            "Number of tiles to render or layers to write in parallel. If 0, "
+            "use the number of hardware threads.");
 
     po::options_description filterOptions("Generic Filtering Options");
     filterOptions.add_options()
@@ -71,6 +87,7 @@ auto main(int argc, char* argv[]) -> int
 
     po::options_description all("Usage");
     all.add(required)
+        .add(tileOptions)
         .add(filterOptions)
         .add(ppmOptions)
         .add(performanceOptions);
@@ -116,6 +133,17 @@ auto main(int argc, char* argv[]) -> int
         }
     }
 
+    // Tiled renders are written as tiled TIFFs
+    auto tiledCompression = vc::tiffio::Compression::ADOBE_DEFLATE;
+    if (parsed.count("tile-size") > 0) {
+        try {
+            tiledCompression = GetTiledCompression(parsed);
+        } catch (const std::exception& e) {
+            vc::Logger()->error(e.what());
+            return EXIT_FAILURE;
+        }
+    }
+
     ///// Load the volume package /////
     vc::VolumePkg vpkg(volpkgPath);
     if (vpkg.version() != VOLPKG_SUPPORTED_VERSION) {
@@ -181,22 +209,59 @@ auto main(int argc, char* argv[]) -> int
     line->setSamplingInterval(interval);
     line->setSamplingDirection(direction);
 
-    // Layer texture
-    std::cout << "Generating layers..." << std::endl;
-    vc::texturing::LayerTexture s;
-    s.setVolume(volume);
-    s.setPerPixelMap(ppm);
-    s.setGenerator(line);
-    auto texture = s.compute();
-
-    std::cout << "Writing layers..." << std::endl;
-    const auto numChars =
-        static_cast<int>(std::to_string(texture.size()).size());
-    fs::path filepath;
-    for (const auto [i, image] : enumerate(texture)) {
-        auto fileName = vc::to_padded_string(i, numChars) + "." + imgFmt;
-        filepath = outputPath / fileName;
-        vc::WriteImage(filepath, image, writeOpts);
+    // Tiled rendering: Generate and write the layers one tile at a time
+    auto numThreads = parsed["threads"].as<std::size_t>();
+    auto numLayers = line->extents()[0];
+    if (parsed.count("tile-size") > 0) {
+        std::cout << "Generating layers in tiles..." << std::endl;
+        vc::texturing::TiledRenderer renderer;
+        renderer.setPerPixelMap(ppm);
+        renderer.setTileFunction([&](const vc::PerPixelMap::Pointer& tile) {
+            vc::texturing::LayerTexture layers;
+            layers.setVolume(volume);
+            layers.setPerPixelMap(tile);
+            layers.setGenerator(line);
+            return layers.compute();
+        });
+        renderer.setTileSize(parsed["tile-size"].as<std::uint32_t>());
+        renderer.setNumThreads(numThreads);
+        if (parsed.count("multi-page") > 0) {
+            renderer.setMultiPage(true);
+            renderer.setOutputPath(outputPath / "layers.tif");
+        } else {
+            renderer.setMultiPage(false);
+            renderer.setOutputPath(outputPath);
+        }
+        renderer.setCompression(tiledCompression);
+        try {
+            renderer.compute();
+        } catch (const std::exception& e) {
+            vc::Logger()->error(e.what());
+            return EXIT_FAILURE;
+        }
+    }
+    // Full-size rendering
+    else {
+        std::cout << "Generating layers..." << std::endl;
+        vc::texturing::LayerTexture s;
+        s.setVolume(volume);
+        s.setPerPixelMap(ppm);
+        s.setGenerator(line);
+        auto texture = s.compute();
+        numLayers = texture.size();
+
+        // Encode the layers in parallel
+        std::cout << "Writing layers..." << std::endl;
+        const auto numChars =
+            static_cast<int>(std::to_string(texture.size()).size());
+        vc::ParallelFor(
+            texture.size(),
+            [&](auto i) {
+                auto fileName =
+                    vc::to_padded_string(i, numChars) + "." + imgFmt;
+                vc::WriteImage(outputPath / fileName, texture[i], writeOpts);
+            },
+            numThreads);
     }
 
     if (parsed.count("output-ppm") > 0) {
@@ -210,7 +275,7 @@ auto main(int argc, char* argv[]) -> int
         newPPM.setMask(ppm->mask());
 
         // Fill new PPM
-        auto z = static_cast<double>(texture.size() - 1) / 2.0;
+        auto z = static_cast<double>(numLayers - 1) / 2.0;
         auto normal = (parsed.count("negative-normal") > 0) ? -1.0 : 1.0;
         for (size_t y = 0; y < height; y++) {
             for (size_t x = 0; x < width; x++) {
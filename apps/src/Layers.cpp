@@ -6,6 +6,7 @@
 #include <opencv2/opencv.hpp>
 
 #include "vc/app_support/GetMemorySize.hpp"
+#include "vc/app_support/TiledRenderOptions.hpp"
 #include "vc/core/filesystem.hpp"
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/io/OBJWriter.hpp"
@@ -22,6 +23,7 @@
 #include "vc/texturing/AngleBasedFlattening.hpp"
 #include "vc/texturing/LayerTexture.hpp"
 #include "vc/texturing/PPMGenerator.hpp"
+#include "vc/texturing/TiledRenderer.hpp"
 
 namespace fs = volcart::filesystem;
 namespace po = boost::program_options;
@@ -55,7 +57,22 @@ auto main(int argc, char* argv[]) -> int
             "Output directory for layer images.")
         ("image-format,f", po::value<std::string>()->default_value("png"),
             "Image format for layer images. Default: png")
-        ("compression", po::value<int>(), "Image compression level");
+        ("compression", po::value<int>(), "Image compression level. For "
+            "TIFF images, the TIFF compression scheme. Tiled renders support "
+            "1 (none), 8 (Adobe Deflate, default), and 32946 (Deflate).");
+
+    po::options_description tileOptions("Tiled Rendering Options");
+    tileOptions.add_options()
+        ("tile-size", po::value<std::uint32_t>(),
+            "If provided, render the layers in square tiles of this size and "
+            "write them as tiled TIFFs. Peak memory use is bounded by a few "
+            "tiles rather than the full image size. Must be a multiple of 16. "
+            "Requires a TIFF image format.")
+        ("multi-page", "When rendering in tiles, write all layers as the "
+            "pages of a single TIFF file, layers.tif, in the output directory")
+        ("threads", po::value<std::size_t>()->default_value(0),
+            "Number of tiles to render in parallel. If 0, use the number of "
+            "hardware threads.");
 
     po::options_description filterOptions("Generic Filtering Options");
     filterOptions.add_options()
@@ -70,7 +87,7 @@ auto main(int argc, char* argv[]) -> int
                 "  1 = Positive");
 
     po::options_description all("Usage");
-    all.add(required).add(filterOptions);
+    all.add(required).add(filterOptions).add(tileOptions);
     // clang-format on
 
     // Parse the cmd line
@@ -113,6 +130,17 @@ auto main(int argc, char* argv[]) -> int
         }
     }
 
+    // Tiled renders are written as tiled TIFFs
+    auto tiledCompression = vc::tiffio::Compression::ADOBE_DEFLATE;
+    if (parsed.count("tile-size") > 0) {
+        try {
+            tiledCompression = GetTiledCompression(parsed);
+        } catch (const std::exception& e) {
+            vc::Logger()->error(e.what());
+            return EXIT_FAILURE;
+        }
+    }
+
     ///// Load the volume package /////
     vc::VolumePkg vpkg(volpkgPath);
     if (vpkg.version() != VOLPKG_SUPPORTED_VERSION) {
@@ -206,13 +234,11 @@ auto main(int argc, char* argv[]) -> int
     auto width = static_cast<size_t>(std::ceil(uvMap->ratio().width));
     auto height = static_cast<size_t>(std::ceil(uvMap->ratio().height));
 
-    // Generate the PPM
-    std::cout << "Generating PPM..." << std::endl;
-    vc::texturing::PPMGenerator ppmGen;
-    ppmGen.setMesh(itkACVD);
-    ppmGen.setUVMap(uvMap);
-    ppmGen.setDimensions(height, width);
-    auto ppm = ppmGen.compute();
+    // Setup the PPM generator
+    auto ppmGen = std::make_shared<vc::texturing::PPMGenerator>();
+    ppmGen->setMesh(itkACVD);
+    ppmGen->setUVMap(uvMap);
+    ppmGen->setDimensions(height, width);
 
     // Setup line generator
     auto line = vc::LineGenerator::New();
@@ -220,6 +246,41 @@ auto main(int argc, char* argv[]) -> int
     line->setSamplingInterval(interval);
     line->setSamplingDirection(direction);
 
+    // Tiled rendering: Generate the PPM and layers one tile at a time
+    if (parsed.count("tile-size") > 0) {
+        std::cout << "Generating layers in tiles..." << std::endl;
+        vc::texturing::TiledRenderer renderer;
+        renderer.setPPMGenerator(ppmGen);
+        renderer.setTileFunction([&](const vc::PerPixelMap::Pointer& ppm) {
+            vc::texturing::LayerTexture layers;
+            layers.setVolume(volume);
+            layers.setPerPixelMap(ppm);
+            layers.setGenerator(line);
+            return layers.compute();
+        });
+        renderer.setTileSize(parsed["tile-size"].as<std::uint32_t>());
+        renderer.setNumThreads(parsed["threads"].as<std::size_t>());
+        if (parsed.count("multi-page") > 0) {
+            renderer.setMultiPage(true);
+            renderer.setOutputPath(outputPath / "layers.tif");
+        } else {
+            renderer.setMultiPage(false);
+            renderer.setOutputPath(outputPath);
+        }
+        renderer.setCompression(tiledCompression);
+        try {
+            renderer.compute();
+        } catch (const std::exception& e) {
+            vc::Logger()->error(e.what());
+            return EXIT_FAILURE;
+        }
+        return EXIT_SUCCESS;
+    }
+
+    // Generate the PPM
+    std::cout << "Generating PPM..." << std::endl;
+    auto ppm = ppmGen->compute();
+
     // Layer texture
     std::cout << "Generating layers..." << std::endl;
     vc::texturing::LayerTexture s;
@@ -1,19 +1,26 @@
 #include <algorithm>
+#include <array>
+#include <fstream>
+#include <functional>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <regex>
 
 #include <boost/program_options.hpp>
+#include <nlohmann/json.hpp>
 
 #include "vc/app_support/ProgressIndicator.hpp"
 #include "vc/apps/packager/SliceImage.hpp"
 #include "vc/core/filesystem.hpp"
 #include "vc/core/io/FileExtensionFilter.hpp"
 #include "vc/core/io/SkyscanMetadataIO.hpp"
+#include "vc/core/io/TIFFIO.hpp"
 #include "vc/core/types/Metadata.hpp"
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/FormatStrToRegexStr.hpp"
-#include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Parallel.hpp"
 #include "vc/core/util/String.hpp"
 
 using PathStringList = std::vector<std::string>;
@@ -22,6 +29,7 @@ namespace fs = volcart::filesystem;
 namespace po = boost::program_options;
 namespace vc = volcart;
 namespace vci = volcart::io;
+namespace tio = volcart::tiffio;
 
 enum class Flip { None, Horizontal, Vertical, ZFlip, Both, All };
 
@@ -44,10 +52,19 @@ struct VolumeInfo {
     bool compress{false};
 };
 
+// Number of bins in the volume intensity histogram
+static constexpr std::size_t HISTOGRAM_BINS = 256;
+
 static bool DoAnalyze{true};
+static std::size_t NumThreads{0};
+static tio::Layout SliceLayout;
 
 auto GetVolumeInfo(const fs::path& slicePath) -> VolumeInfo;
 void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info);
+auto CheckConsistent(bool consistent, const std::vector<fs::path>& mismatches)
+    -> bool;
+auto Histogram16(const cv::Mat& image)
+    -> std::array<std::size_t, HISTOGRAM_BINS>;
 
 auto main(int argc, char* argv[]) -> int
 {
@@ -73,9 +90,21 @@ auto main(int argc, char* argv[]) -> int
         ("name", po::value<std::string>(),
             "Set a descriptive name for the VolumePkg. Default: Filename "
             "specified by --volpkg");
+
+    po::options_description perfOpts("Performance");
+    perfOpts.add_options()
+        ("threads,j", po::value<std::size_t>()->default_value(0),
+            "Number of threads used to decode, analyze, and encode slices. "
+            "If 0, uses the number of hardware threads.")
+        ("rows-per-strip", po::value<std::uint32_t>(),
+            "Write converted slices as TIFFs with this many rows per strip. "
+            "Default: One strip per slice")
+        ("tile-size", po::value<std::uint32_t>(),
+            "Write converted slices as tiled TIFFs with square tiles of this "
+            "size. Must be a multiple of 16.");
     // clang-format on
     po::options_description helpOpts("Usage");
-    helpOpts.add(options).add(extras);
+    helpOpts.add(options).add(extras).add(perfOpts);
 
     po::options_description all("Usage");
     all.add(helpOpts).add_options()(
@@ -99,8 +128,21 @@ auto main(int argc, char* argv[]) -> int
         return EXIT_FAILURE;
     }
 
-    // Set global opt
+    // Set global opts
     DoAnalyze = parsed["analyze"].as<bool>();
+    NumThreads = parsed["threads"].as<std::size_t>();
+    if (parsed.count("rows-per-strip") > 0) {
+        SliceLayout.rowsPerStrip = parsed["rows-per-strip"].as<std::uint32_t>();
+    }
+    if (parsed.count("tile-size") > 0) {
+        auto tileSize = parsed["tile-size"].as<std::uint32_t>();
+        if (tileSize == 0 or tileSize % 16 != 0) {
+            std::cerr << "ERROR: --tile-size must be a multiple of 16.\n";
+            return EXIT_FAILURE;
+        }
+        SliceLayout.tileWidth = tileSize;
+        SliceLayout.tileHeight = tileSize;
+    }
 
     ///// New VolumePkg /////
     // Get the output volpkg path
@@ -319,56 +361,64 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
     std::cout << "Slice images found: " << slices.size() << std::endl;
 
     ///// Analyze the slices /////
+    // The first slice defines the expected properties of the volume
+    if (not slices.front().analyze()) {
+        std::cerr << "ERROR: Failed to read slice: " << slices.front().path
+                  << std::endl;
+        return;
+    }
+    const auto first = slices.front();
+
+    // Slices which need to be rescaled must all be analyzed before any can be
+    // converted. Otherwise, statistics are gathered while slices are written.
+    auto analyzeFirst = DoAnalyze and first.needsScale();
+    auto analyzeInPass = DoAnalyze and not first.needsScale();
+
     auto consistent = true;
     auto volMin = std::numeric_limits<double>::max();
     auto volMax = std::numeric_limits<double>::lowest();
     std::vector<fs::path> mismatches;
-    if (DoAnalyze) {
-        for (auto& slice : vc::ProgressWrap(slices, "Analyzing slices")) {
-            // Skip if we can't analyze
-            if (!slice.analyze()) {
-                continue;
-            }
-
-            // Compare all slices to the properties of the first slice
-            // Don't quit yet so we can get a list of the problematic files
-            if (slice != *slices.begin()) {
-                consistent = false;
-                mismatches.push_back(slice.path.filename());
-                continue;
-            }
-
-            // Update the volume's min and max
-            if (slice.min() < volMin) {
-                volMin = slice.min();
-            }
-
-            if (slice.max() > volMax) {
-                volMax = slice.max();
-            }
+    std::mutex statsMutex;
+
+    // Record a slice's statistics. Returns false if it doesn't match the first
+    // slice.
+    auto updateStats = [&](const vc::SliceImage& slice) {
+        std::unique_lock<std::mutex> lock(statsMutex);
+        // Compare all slices to the properties of the first slice
+        // Don't quit yet so we can get a list of the problematic files
+        if (slice != first) {
+            consistent = false;
+            mismatches.push_back(slice.path.filename());
+            return false;
         }
-    } else {
-        // Make sure the first slice is analyzed
-        slices.front().analyze();
+
+        // Update the volume's min and max
+        volMin = std::min(volMin, slice.min());
+        volMax = std::max(volMax, slice.max());
+        return true;
+    };
+
+    if (analyzeFirst) {
+        auto progress =
+            vc::NewProgressCallback(slices.size(), "Analyzing slices");
+        vc::ParallelFor(
+            slices.size(),
+            [&](auto idx) {
+                auto& slice = slices[idx];
+                // Skip if we can't analyze
+                if (slice.analyze()) {
+                    updateStats(slice);
+                }
+                progress();
+            },
+            NumThreads);
+    } else if (not DoAnalyze) {
         volMin = MIN_16BPC;
         volMax = MAX_16BPC;
     }
 
-    // Report mismatched slices
-    if (not mismatches.empty()) {
-        std::cerr << "Found " << mismatches.size();
-        std::cerr << " files which did not match the initial slice:";
-        std::cerr << std::endl;
-        for (const auto& p : mismatches) {
-            std::cerr << "\t" << p << std::endl;
-        }
-    }
-
-    // Quit if the volume isn't consistent
-    if (!consistent) {
-        std::cerr << "ERROR: Slices in slice directory do not have matching "
-                     "properties (width/height/depth)."
-                  << std::endl;
+    // Report mismatched slices and quit if the volume isn't consistent
+    if (not CheckConsistent(consistent, mismatches)) {
         return;
     }
 
@@ -376,18 +426,9 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
     // Metadata
     auto volume = volpkg->newVolume(info.name);
     volume->setNumberOfSlices(slices.size());
-    volume->setSliceWidth(slices.front().width());
-    volume->setSliceHeight(slices.front().height());
+    volume->setSliceWidth(first.width());
+    volume->setSliceHeight(first.height());
     volume->setVoxelSize(info.voxelsize);
-
-    // Scale min/max values
-    if (slices.begin()->needsScale()) {
-        volume->setMin(MIN_16BPC);
-        volume->setMax(MAX_16BPC);
-    } else {
-        volume->setMin(volMin);
-        volume->setMax(volMax);
-    }
     volume->saveMetadata();
 
     if (info.flipOption == Flip::ZFlip or info.flipOption == Flip::All) {
@@ -400,34 +441,55 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
                      info.flipOption == Flip::Both ||
                      info.flipOption == Flip::All;
 
-    // Move the slices into the VolPkg
-    using vc::enumerate;
-    using vc::ProgressWrap;
-    for (auto pair : ProgressWrap(enumerate(slices), "Saving to volpkg")) {
-        const auto& idx = pair.first;
-        auto& slice = pair.second;
+    // Do we need to change the TIFF layout?
+    auto needsLayout =
+        SliceLayout.rowsPerStrip > 0 or SliceLayout.tileWidth > 0;
+
+    // Histogram of the 16-bit output intensities
+    std::array<std::size_t, HISTOGRAM_BINS> histogram{};
+
+    // Decode, analyze, convert, and encode each slice in parallel
+    auto progress = vc::NewProgressCallback(slices.size(), "Saving to volpkg");
+    auto processSlice = [&](std::size_t idx) {
+        auto& slice = slices[idx];
+
+        // Decode and analyze the slice
+        cv::Mat image;
+        if (analyzeInPass) {
+            image = slice.read();
+            slice.analyze(image);
+            if (not updateStats(slice)) {
+                progress();
+                return;
+            }
+        }
+
         // Convert or flip
         if (slice.needsConvert() || slice.needsScale() || needsFlip ||
-            info.compress) {
+            info.compress || needsLayout) {
             // Override slice min/max with volume min/max
             if (slice.needsScale()) {
                 slice.setScale(volMax, volMin);
             }
 
             // Get slice
-            auto tmp = slice.conformedImage();
+            if (image.empty()) {
+                image = slice.conformedImage();
+            } else {
+                image = slice.conform(image);
+            }
 
             // Apply flips
             switch (info.flipOption) {
                 case Flip::All:
                 case Flip::Both:
-                    cv::flip(tmp, tmp, -1);
+                    cv::flip(image, image, -1);
                     break;
                 case Flip::Vertical:
-                    cv::flip(tmp, tmp, 0);
+                    cv::flip(image, image, 0);
                     break;
                 case Flip::Horizontal:
-                    cv::flip(tmp, tmp, 1);
+                    cv::flip(image, image, 1);
                     break;
                 case Flip::ZFlip:
                 case Flip::None:
@@ -436,12 +498,95 @@ void AddVolume(vc::VolumePkg::Pointer& volpkg, const VolumeInfo& info)
             }
 
             // Add to volume
-            volume->setSliceData(idx, tmp, info.compress);
+            tio::WriteTIFF(
+                volume->getSlicePath(static_cast<int>(idx)), image,
+                (info.compress) ? tio::Compression::LZW
+                                : tio::Compression::NONE,
+                SliceLayout);
         }
 
         // Just copy to the volume
         else {
-            fs::copy_file(slice.path, volume->getSlicePath(idx));
+            fs::copy_file(
+                slice.path, volume->getSlicePath(static_cast<int>(idx)));
+        }
+
+        // Accumulate the histogram
+        if (DoAnalyze and image.type() == CV_16UC1) {
+            auto local = Histogram16(image);
+            std::unique_lock<std::mutex> lock(statsMutex);
+            for (std::size_t b = 0; b < HISTOGRAM_BINS; b++) {
+                histogram[b] += local[b];
+            }
+        }
+        progress();
+    };
+    vc::ParallelFor(slices.size(), processSlice, NumThreads);
+
+    // Report mismatched slices found while writing and remove the incomplete
+    // volume
+    if (not CheckConsistent(consistent, mismatches)) {
+        fs::remove_all(volume->path());
+        return;
+    }
+
+    // Scale min/max values
+    if (first.needsScale()) {
+        volume->setMin(MIN_16BPC);
+        volume->setMax(MAX_16BPC);
+    } else {
+        volume->setMin(volMin);
+        volume->setMax(volMax);
+    }
+    volume->saveMetadata();
+
+    // Save the histogram alongside the volume metadata
+    if (DoAnalyze) {
+        nlohmann::json hist;
+        hist["bins"] = HISTOGRAM_BINS;
+        hist["min"] = MIN_16BPC;
+        hist["max"] = MAX_16BPC;
+        hist["counts"] = histogram;
+        std::ofstream out((volume->path() / "histogram.json").string());
+        out << hist.dump() << std::endl;
+    }
+}
+
+auto CheckConsistent(bool consistent, const std::vector<fs::path>& mismatches)
+    -> bool
+{
+    // Report mismatched slices
+    if (not mismatches.empty()) {
+        std::cerr << "Found " << mismatches.size();
+        std::cerr << " files which did not match the initial slice:";
+        std::cerr << std::endl;
+        for (const auto& p : mismatches) {
+            std::cerr << "\t" << p << std::endl;
+        }
+    }
+
+    // Quit if the volume isn't consistent
+    if (!consistent) {
+        std::cerr << "ERROR: Slices in slice directory do not have matching "
+                     "properties (width/height/depth)."
+                  << std::endl;
+    }
+    return consistent;
+}
+
+auto Histogram16(const cv::Mat& image)
+    -> std::array<std::size_t, HISTOGRAM_BINS>
+{
+    constexpr auto shift = 8;
+    static_assert(
+        (std::size_t{1} << (16 - shift)) == HISTOGRAM_BINS,
+        "Histogram bins do not evenly divide the 16-bit range");
+    std::array<std::size_t, HISTOGRAM_BINS> hist{};
+    for (int y = 0; y < image.rows; y++) {
+        const auto* row = image.ptr<std::uint16_t>(y);
+        for (int x = 0; x < image.cols; x++) {
+            hist[row[x] >> shift]++;
         }
     }
+    return hist;
 }
@@ -13,6 +13,7 @@
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
 #include "vc/core/util/String.hpp"
+#include "vc/core/util/Trace.hpp"
 #include "vc/graph.hpp"
 
 namespace vc = volcart;
@@ -42,8 +43,26 @@ static auto GetGeneralOpts() -> po::options_description
         ("cache-memory-limit", po::value<std::string>(),
          "Maximum size of the slice cache in bytes. Accepts the suffixes: "
          "(K|M|G|T)(B). Default: 50% of the total system memory.")
+        ("result-cache", po::value<std::string>(),
+         "Directory of a content-addressed cache of intermediate results "
+         "(meshes, UV maps, PPMs, textures). Renders whose inputs and "
+         "parameters match a cache entry reuse the cached result instead of "
+         "recomputing it. The cache can be shared between renders and "
+         "volume packages. Must be a new or empty directory, or an existing "
+         "result cache.")
+        ("result-cache-limit", po::value<std::string>(),
+         "Maximum size of the result cache in bytes. Least recently used "
+         "entries are evicted when the cache exceeds this size. Accepts the "
+         "suffixes: (K|M|G|T)(B). Default: 50GB")
+        ("graph-threads", po::value<std::size_t>()->default_value(2),
+         "Number of threads used to write output files concurrently with "
+         "the rest of the graph. Other nodes still run one at a time in "
+         "graph order. If 0, output files are written sequentially.")
         ("log-level", po::value<std::string>()->default_value("info"),
-         "Options: off, critical, error, warn, info, debug");
+         "Options: off, critical, error, warn, info, debug")
+        ("trace", po::value<std::string>(), "Write a trace of where time is "
+            "spent to this path, in the Chrome trace JSON format. Open it "
+            "with chrome://tracing or https://ui.perfetto.dev.");
     // clang-format on
     return opts;
 }
@@ -282,8 +301,35 @@ auto main(int argc, char* argv[]) -> int
     to_lower(logLevel);
     logging::SetLogLevel(logLevel);
 
+    // Start tracing
+    std::unique_ptr<trace::Session> traceSession;
+    if (parsed.count("trace") > 0) {
+        traceSession =
+            std::make_unique<trace::Session>(parsed["trace"].as<std::string>());
+    }
+
     // Register VC graph nodes
     vc::RegisterNodes();
+    SetGraphThreads(parsed["graph-threads"].as<std::size_t>());
+
+    // Setup the result cache
+    if (parsed.count("result-cache") > 0) {
+        auto resultCacheBytes = ResultCache::DEFAULT_CAPACITY;
+        if (parsed.count("result-cache-limit") > 0) {
+            auto opt = parsed["result-cache-limit"].as<std::string>();
+            resultCacheBytes = MemorySizeStringParser(opt);
+        }
+        fs::path resultCachePath = parsed["result-cache"].as<std::string>();
+        try {
+            SetResultCache(ResultCache::New(resultCachePath, resultCacheBytes));
+        } catch (const std::exception& e) {
+            Logger()->critical(e.what());
+            return EXIT_FAILURE;
+        }
+        Logger()->info(
+            "Using result cache: {}",
+            fs::weakly_canonical(resultCachePath).string());
+    }
 
     ///// Load the volume package /////
     fs::path volpkgPath = parsed["volpkg"].as<std::string>();
@@ -307,9 +353,11 @@ auto main(int argc, char* argv[]) -> int
 
     //// Create the graph pipeline ////
     std::shared_ptr<smgl::Graph> graph;
+    fs::path graphPath;
     if (parsed["save-graph"].as<bool>()) {
         auto render = vpkg->newRender();
         graph = render->graph();
+        graphPath = render->path() / "graph.json";
         vc::Logger()->info(
             "Created new Render graph in VolPkg: {}", render->id());
     } else {
@@ -750,8 +798,20 @@ auto main(int argc, char* argv[]) -> int
     // Update the graph
     try {
         graph->update();
+        WaitForGraphTasks();
     } catch (const std::exception& e) {
         Logger()->error(e.what());
         return EXIT_FAILURE;
     }
+
+    // Record per-node timings in the graph
+    projectInfo[vc::ProjectInfo::Name()]["timings"] = GetNodeTimings();
+    graph->setProjectMetadata(projectInfo);
+    if (not graphPath.empty()) {
+        try {
+            smgl::Graph::Save(graphPath, *graph, true);
+        } catch (const std::exception& e) {
+            Logger()->error("Failed to save node timings: {}", e.what());
+        }
+    }
 }
@@ -1,7 +1,12 @@
 // render.cpp
 // Abigail Coleman Feb. 2015
 
+#include <cstdint>
 #include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <boost/program_options.hpp>
 #include <opencv2/imgcodecs.hpp>
@@ -17,10 +22,16 @@
 #include "vc/core/neighborhood/LineGenerator.hpp"
 #include "vc/core/types/PerPixelMap.hpp"
 #include "vc/core/types/VolumePkg.hpp"
+#include "vc/core/util/ImageConversion.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
+#include "vc/core/util/String.hpp"
+#include "vc/core/util/Trace.hpp"
 #include "vc/texturing/CompositeTexture.hpp"
+#include "vc/texturing/FusedTexture.hpp"
+#include "vc/texturing/IncrementalRenderer.hpp"
 #include "vc/texturing/IntegralTexture.hpp"
 #include "vc/texturing/IntersectionTexture.hpp"
+#include "vc/texturing/LayerTexture.hpp"
 #include "vc/texturing/ThicknessTexture.hpp"
 
 namespace fs = volcart::filesystem;
@@ -31,6 +42,15 @@ namespace vct = volcart::texturing;
 // Volpkg version required by this app
 static constexpr int VOLPKG_SUPPORTED_VERSION = 6;
 
+// Composite filters selectable by name for fused outputs
+static const std::map<std::string, vct::CompositeTexture::Filter>
+    FUSED_FILTERS{
+        {"min", vct::CompositeTexture::Filter::Minimum},
+        {"max", vct::CompositeTexture::Filter::Maximum},
+        {"median", vct::CompositeTexture::Filter::Median},
+        {"mean", vct::CompositeTexture::Filter::Mean},
+        {"median-mean", vct::CompositeTexture::Filter::MedianAverage}};
+
 // Globals
 po::variables_map parsed_;
 /** Unused globals that need to be here */
@@ -53,7 +73,28 @@ int main(int argc, char* argv[])
         ("output-file,o", po::value<std::string>()->required(),
             "Output image file path.")
         ("tiff-floating-point", "When outputting to the TIFF format, save a "
-            "floating-point image.");
+            "floating-point image.")
+        ("fused-output", po::value<std::vector<std::string>>()->multitoken(),
+            "Additional outputs rendered in the same pass over the PPM as the "
+            "main output. Each neighborhood is sampled once and shared by "
+            "every output. Formatted as <method>=<path>, where <method> is "
+            "one of: intersection, min, max, median, mean, median-mean, "
+            "integral, layers. Integral outputs use the Integral Texture "
+            "options. Layer images are written to <path> with the layer "
+            "number appended to the file name and require the Line "
+            "neighborhood shape. Not supported by the Thickness method.")
+        ("previous-ppm", po::value<std::string>(),
+            "PPM of a previous render of this segmentation. Only the tiles "
+            "of the output whose mappings differ from this PPM are "
+            "re-textured, and every other pixel is copied from the previous "
+            "texture. Requires --previous-texture. Not supported by fused "
+            "outputs, the Integral method, or normalized Thickness outputs.")
+        ("previous-texture", po::value<std::string>(),
+            "Texture image of the previous render. Must have been rendered "
+            "with the same texturing options.")
+        ("tile-size", po::value<std::uint32_t>()->default_value(
+            vct::IncrementalRenderer::DEFAULT_TILE_SIZE),
+            "Edge length of the tiles compared with --previous-ppm.");
 
     po::options_description all("Usage");
     all.add(GetGeneralOpts())
@@ -81,12 +122,69 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // Start tracing
+    std::unique_ptr<vc::trace::Session> traceSession;
+    if (parsed_.count("trace") > 0) {
+        traceSession = std::make_unique<vc::trace::Session>(
+            parsed_["trace"].as<std::string>());
+    }
+
     // Get the parsed_ options
     fs::path volpkgPath = parsed_["volpkg"].as<std::string>();
     fs::path inputPPMPath = parsed_["ppm"].as<std::string>();
     Method method = static_cast<Method>(parsed_["method"].as<int>());
     fs::path outputPath = parsed_["output-file"].as<std::string>();
 
+    // Parse the fused outputs
+    std::vector<std::pair<std::string, fs::path>> fusedOutputs;
+    if (parsed_.count("fused-output") > 0) {
+        if (method == Method::Thickness) {
+            std::cerr << "ERROR: Fused outputs are not supported by the "
+                         "Thickness method."
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+        for (const auto& opt :
+             parsed_["fused-output"].as<std::vector<std::string>>()) {
+            auto pos = opt.find('=');
+            auto name = opt.substr(0, pos);
+            if (pos == std::string::npos or
+                (name != "intersection" and name != "integral" and
+                 name != "layers" and FUSED_FILTERS.count(name) == 0)) {
+                std::cerr << "ERROR: Invalid fused output: " << opt
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+            auto shape =
+                static_cast<Shape>(parsed_["neighborhood-shape"].as<int>());
+            if (name == "layers" and shape != Shape::Line) {
+                std::cerr << "ERROR: Fused layers outputs require the Line "
+                             "neighborhood shape."
+                          << std::endl;
+                return EXIT_FAILURE;
+            }
+            fusedOutputs.emplace_back(name, opt.substr(pos + 1));
+        }
+    }
+
+    // Check the incremental render options
+    if (parsed_.count("previous-ppm") > 0) {
+        if (parsed_.count("previous-texture") == 0) {
+            std::cerr << "ERROR: --previous-ppm requires --previous-texture."
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (not fusedOutputs.empty() or method == Method::Integral or
+            (method == Method::Thickness and
+             parsed_["normalize-output"].as<bool>())) {
+            std::cerr << "ERROR: Incremental renders are not supported by "
+                         "fused outputs, the Integral method, or normalized "
+                         "Thickness outputs."
+                      << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
     ///// Load the volume package /////
     vc::VolumePkg vpkg(volpkgPath);
     if (vpkg.version() != VOLPKG_SUPPORTED_VERSION) {
@@ -214,24 +312,7 @@ int main(int argc, char* argv[])
     }
     std::cout << std::endl;
 
-    vct::TexturingAlgorithm::Pointer textureGen;
-    if (method == Method::Intersection) {
-        auto intersect = vct::IntersectionTexture::New();
-        intersect->setVolume(volume);
-        intersect->setPerPixelMap(ppm);
-        textureGen = intersect;
-    }
-
-    else if (method == Method::Composite) {
-        auto composite = vct::CompositeTexture::New();
-        composite->setPerPixelMap(ppm);
-        composite->setVolume(volume);
-        composite->setFilter(filter);
-        composite->setGenerator(generator);
-        textureGen = composite;
-    }
-
-    else if (method == Method::Integral) {
+    auto newIntegral = [&]() {
         auto integral = vct::IntegralTexture::New();
         integral->setPerPixelMap(ppm);
         integral->setVolume(volume);
@@ -245,11 +326,12 @@ int main(int argc, char* argv[])
         if (clampToMax) {
             integral->setClampMax(parsed_["clamp-to-max"].as<uint16_t>());
         }
-        textureGen = integral;
-    }
+        return integral;
+    };
 
-    else if (method == Method::Thickness) {
-        // Load mask
+    // Load the volume mask
+    vc::VolumetricMask::Pointer volumeMask;
+    if (method == Method::Thickness) {
         if (maskPath.empty()) {
             std::cerr << "ERROR: Selected Thickness texturing, but did not "
                          "provide volume mask path."
@@ -258,14 +340,106 @@ int main(int argc, char* argv[])
         }
         std::cout << "Loading volume mask..." << std::endl;
         auto pts = vc::PointSetIO<cv::Vec3i>::ReadPointSet(maskPath);
-        auto mask = vc::VolumetricMask::New(pts);
+        volumeMask = vc::VolumetricMask::New(pts);
+    }
+
+    // Create the selected texturing algorithm for a PPM
+    auto newTextureGen = [&](const vc::PerPixelMap::Pointer& p)
+        -> vct::TexturingAlgorithm::Pointer {
+        if (method == Method::Intersection) {
+            auto intersect = vct::IntersectionTexture::New();
+            intersect->setVolume(volume);
+            intersect->setPerPixelMap(p);
+            return intersect;
+        }
+
+        if (method == Method::Composite) {
+            auto composite = vct::CompositeTexture::New();
+            composite->setPerPixelMap(p);
+            composite->setVolume(volume);
+            composite->setFilter(filter);
+            composite->setGenerator(generator);
+            return composite;
+        }
+
+        if (method == Method::Integral) {
+            auto integral = newIntegral();
+            integral->setPerPixelMap(p);
+            return integral;
+        }
 
         auto thickness = vct::ThicknessTexture::New();
-        thickness->setPerPixelMap(ppm);
-        thickness->setVolumetricMask(mask);
+        thickness->setPerPixelMap(p);
+        thickness->setVolumetricMask(volumeMask);
         thickness->setNormalizeOutput(normalize);
-        textureGen = thickness;
+        return thickness;
+    };
+
+    // Incremental render: Only re-texture the tiles which changed
+    if (parsed_.count("previous-ppm") > 0) {
+        std::cout << "Loading previous render..." << std::endl;
+        auto prevPPM = vc::PerPixelMap::New(vc::PerPixelMap::ReadPPM(
+            parsed_["previous-ppm"].as<std::string>()));
+        auto prevTexture = cv::imread(
+            parsed_["previous-texture"].as<std::string>(),
+            cv::IMREAD_UNCHANGED);
+        if (prevTexture.empty()) {
+            std::cerr << "ERROR: Cannot read previous texture." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        vct::IncrementalRenderer renderer;
+        renderer.setPreviousPerPixelMap(prevPPM);
+        renderer.setPreviousTexture({prevTexture});
+        renderer.setPerPixelMap(ppm);
+        renderer.setTileSize(parsed_["tile-size"].as<std::uint32_t>());
+        renderer.setTileFunction([&](const vc::PerPixelMap::Pointer& tile) {
+            auto texture = newTextureGen(tile)->compute();
+            for (auto& img : texture) {
+                img = vc::QuantizeImage(img, prevTexture.depth(), false);
+            }
+            return texture;
+        });
+        if (parsed_["progress"].as<bool>()) {
+            vc::ReportProgress(renderer, "Texturing:");
+        } else {
+            std::cout << "Texturing..." << std::endl;
+        }
+        auto texture = renderer.compute();
+        std::cout << "Re-textured " << renderer.progressIterations()
+                  << " tiles" << std::endl;
+
+        SaveOutput(outputPath, nullptr, nullptr, texture);
+        return EXIT_SUCCESS;
     }
+
+    auto textureGen = newTextureGen(ppm);
+
+    // Fused outputs: Sample each neighborhood once for all outputs
+    vct::FusedTexture::Pointer fused;
+    if (not fusedOutputs.empty()) {
+        fused = vct::FusedTexture::New();
+        fused->setPerPixelMap(ppm);
+        fused->setVolume(volume);
+        fused->setGenerator(generator);
+        fused->addReducer(
+            std::dynamic_pointer_cast<vct::NeighborhoodReducer>(textureGen));
+        for (const auto& [name, path] : fusedOutputs) {
+            if (name == "intersection") {
+                fused->addReducer(vct::IntersectionTexture::New());
+            } else if (name == "integral") {
+                fused->addReducer(newIntegral());
+            } else if (name == "layers") {
+                fused->addReducer(vct::LayerTexture::New());
+            } else {
+                auto composite = vct::CompositeTexture::New();
+                composite->setFilter(FUSED_FILTERS.at(name));
+                fused->addReducer(composite);
+            }
+        }
+        textureGen = fused;
+    }
+
     if (parsed_["progress"].as<bool>()) {
         vc::ReportProgress(*textureGen, "Texturing:");
     } else {
@@ -275,7 +449,29 @@ int main(int argc, char* argv[])
     auto texture = textureGen->compute();
 
     // Write the output
-    SaveOutput(outputPath, nullptr, nullptr, texture);
+    if (not fused) {
+        SaveOutput(outputPath, nullptr, nullptr, texture);
+        return EXIT_SUCCESS;
+    }
+
+    auto textures = fused->reducerTextures();
+    SaveOutput(outputPath, nullptr, nullptr, textures[0]);
+    for (std::size_t i = 0; i < fusedOutputs.size(); i++) {
+        const auto& [name, path] = fusedOutputs[i];
+        const auto& output = textures[i + 1];
+        if (name != "layers") {
+            SaveOutput(path, nullptr, nullptr, output);
+            continue;
+        }
+        auto numChars = static_cast<int>(std::to_string(output.size()).size());
+        for (std::size_t l = 0; l < output.size(); l++) {
+            auto layerPath = path.parent_path() /
+                             (path.stem().string() + "_" +
+                              vc::to_padded_string(l, numChars) +
+                              path.extension().string());
+            SaveOutput(layerPath, nullptr, nullptr, {output[l]});
+        }
+    }
 
     return EXIT_SUCCESS;
 }  // end main
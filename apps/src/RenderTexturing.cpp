@@ -19,6 +19,7 @@
 #include "vc/core/util/Logging.hpp"
 #include "vc/meshing/UVMapToITKMesh.hpp"
 #include "vc/texturing/AngleBasedFlattening.hpp"
+#include "vc/texturing/ChartedFlattening.hpp"
 #include "vc/texturing/CompositeTexture.hpp"
 #include "vc/texturing/FlatteningError.hpp"
 #include "vc/texturing/IntegralTexture.hpp"
@@ -52,7 +53,7 @@ using ScaleGenerator = vct::ScaleMarkerGenerator;
 enum class ScaleColorOpt { White = 0, Black, Red, Green, Cyan };
 vc::Color GetScaleColorOpt();
 
-enum class FlatteningAlgorithm { ABF = 0, LSCM, Orthographic };
+enum class FlatteningAlgorithm { ABF = 0, LSCM, Orthographic, Charted };
 
 po::options_description GetUVOpts()
 {
@@ -63,7 +64,11 @@ po::options_description GetUVOpts()
             "Select the flattening algorithm:\n"
                 "  0 = ABF\n"
                 "  1 = LSCM\n"
-                "  2 = Orthographic Projection")
+                "  2 = Orthographic Projection\n"
+                "  3 = Charted ABF (for very large meshes)")
+        ("uv-chart-size", po::value<std::size_t>()->default_value(
+            vct::ChartedFlattening::DEFAULT_CHART_SIZE), "Target number of "
+            "faces per chart for Charted ABF")
         ("reuse-uv", "If input-mesh is specified, attempt to use its existing "
             "UV map instead of generating a new one.")
         ("uv-rotate", po::value<double>(), "Rotate the generated UV map by an "
@@ -250,6 +255,19 @@ vc::UVMap::Pointer FlattenMesh(const vc::ITKMesh::Pointer& mesh, bool resampled)
             uvMap = abf.getUVMap();
             uvMesh = abf.getMesh();
         }
+        // Charted ABF
+        else if (method == FlatteningAlgorithm::Charted) {
+            vct::ChartedFlattening charted(mesh);
+            charted.setChartSize(parsed_["uv-chart-size"].as<std::size_t>());
+            try {
+                uvMesh = charted.compute();
+            } catch (const std::exception& e) {
+                vc::Logger()->critical(e.what());
+                std::exit(EXIT_FAILURE);
+            }
+            uvMap = charted.getUVMap();
+            uvMesh = charted.getMesh();
+        }
         // Orthographic
         else if (method == FlatteningAlgorithm::Orthographic) {
             vct::OrthographicProjectionFlattening ortho;
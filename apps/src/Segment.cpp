@@ -11,6 +11,7 @@
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
+#include "vc/core/util/Trace.hpp"
 #include "vc/meshing/OrderedPointSetMesher.hpp"
 #include "vc/segmentation/LocalResliceParticleSim.hpp"
 #include "vc/segmentation/ThinnedFloodFillSegmentation.hpp"
@@ -154,6 +155,13 @@ int main(int argc, char* argv[])
         return EXIT_FAILURE;
     }
 
+    // Start tracing
+    std::unique_ptr<vc::trace::Session> traceSession;
+    if (parsed.count("trace") > 0) {
+        traceSession = std::make_unique<vc::trace::Session>(
+            parsed["trace"].as<std::string>());
+    }
+
     Algorithm alg;
     auto method = parsed["method"].as<std::string>();
     std::transform(method.begin(), method.end(), method.begin(), ::tolower);
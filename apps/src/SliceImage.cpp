@@ -33,6 +33,12 @@ bool SliceImage::operator<(const SliceImage& b) const
     return aName.size() < bName.size();
 }
 
+cv::Mat SliceImage::read() const
+{
+    return cv::imread(
+        path.string(), cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
+}
+
 bool SliceImage::analyze()
 {
     // return if the path is wrong or if this isn't a regular file
@@ -41,12 +47,15 @@ bool SliceImage::analyze()
         return false;
     }
 
+    analyze(read());
+    return true;
+}
+
+void SliceImage::analyze(const cv::Mat& image)
+{
     // Set needsConvert_ if it's not a tif
     needsConvert_ = !io::FileExtensionFilter(path, {"tif", "tiff"});
 
-    auto image =
-        cv::imread(path.string(), cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
-
     w_ = image.cols;
     h_ = image.rows;
 
@@ -60,16 +69,12 @@ bool SliceImage::analyze()
     }
 
     cv::minMaxLoc(image, &min_, &max_);
-
-    return true;
 }
 
-cv::Mat SliceImage::conformedImage()
-{
-    // Load the image
-    auto image =
-        cv::imread(path.string(), cv::IMREAD_ANYCOLOR | cv::IMREAD_ANYDEPTH);
+cv::Mat SliceImage::conformedImage() { return conform(read()); }
 
+cv::Mat SliceImage::conform(cv::Mat image) const
+{
     // Remap values to 16 bit
     if (needsScale_) {
         image.convertTo(
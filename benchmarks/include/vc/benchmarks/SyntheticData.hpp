@@ -0,0 +1,66 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/UVMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/types/VolumetricMask.hpp"
+
+/** Synthetic inputs for the benchmarks */
+namespace volcart::benchmarks
+{
+/** @brief Edge length of the synthetic volume's slices */
+static constexpr int VOLUME_SIZE{256};
+
+/** @brief Number of slices in the synthetic volume */
+static constexpr int VOLUME_SLICES{128};
+
+/**
+ * @brief Get the y position of the synthetic sheet at an x, z position
+ *
+ * The sheet is a wavy surface which spans the volume in x and z.
+ */
+auto SheetY(double x, double z) -> double;
+
+/**
+ * @brief Get a shared synthetic volume
+ *
+ * The volume contains a bright, wavy sheet on a noisy background. It is
+ * written to a temporary directory on first use.
+ */
+auto SyntheticVolume() -> Volume::Pointer;
+
+/**
+ * @brief Get a synthetic mesh which lies on the sheet of the synthetic volume
+ *
+ * The mesh is an ordered grid of `rows` x `cols` vertices.
+ */
+auto SyntheticMesh(std::size_t rows, std::size_t cols) -> ITKMesh::Pointer;
+
+/** @brief Get a UV map for a mesh created by SyntheticMesh() */
+auto SyntheticUVMap(std::size_t rows, std::size_t cols) -> UVMap::Pointer;
+
+/**
+ * @brief Get a shared synthetic PPM with the given edge length
+ *
+ * The PPM is generated from a 64x64 SyntheticMesh().
+ */
+auto SyntheticPPM(std::size_t size) -> PerPixelMap::Pointer;
+
+/** @brief Get a volumetric mask of the synthetic volume's sheet */
+auto SyntheticMask() -> VolumetricMask::Pointer;
+
+/** @brief Get the directory for the benchmark's temporary files */
+auto TempDir() -> filesystem::path;
+
+/** @brief Get `n` random positions inside of the synthetic volume */
+auto RandomPositions(std::size_t n) -> std::vector<cv::Vec3d>;
+}  // namespace volcart::benchmarks
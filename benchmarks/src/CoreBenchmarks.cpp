@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "vc/benchmarks/SyntheticData.hpp"
+#include "vc/core/neighborhood/CuboidGenerator.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/core/types/LRUCache.hpp"
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+/** Number of positions sampled by the volume benchmarks */
+static constexpr std::size_t NUM_POSITIONS{4096};
+
+static void BM_VolumeInterpolateAt(benchmark::State& state)
+{
+    auto volume = SyntheticVolume();
+    auto positions = RandomPositions(NUM_POSITIONS);
+    std::size_t i{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            volume->interpolateAt(positions[i++ % positions.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VolumeInterpolateAt);
+
+static void BM_VolumeReslice(benchmark::State& state)
+{
+    auto volume = SyntheticVolume();
+    auto positions = RandomPositions(NUM_POSITIONS);
+    auto size = static_cast<int>(state.range(0));
+    std::size_t i{0};
+    for (auto _ : state) {
+        auto r = volume->reslice(
+            positions[i++ % positions.size()], {1, 0, 0}, {0, 0, 1}, size,
+            size);
+        benchmark::DoNotOptimize(r.sliceData().data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_VolumeReslice)->Arg(64)->Arg(256);
+
+static void BM_CuboidGenerator(benchmark::State& state)
+{
+    auto volume = SyntheticVolume();
+    auto positions = RandomPositions(NUM_POSITIONS);
+    CuboidGenerator gen;
+    gen.setSamplingRadius(static_cast<double>(state.range(0)));
+    std::size_t i{0};
+    for (auto _ : state) {
+        auto n = gen.compute(
+            volume, positions[i++ % positions.size()],
+            {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}});
+        benchmark::DoNotOptimize(n.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CuboidGenerator)->Arg(2)->Arg(8);
+
+static void BM_LineGenerator(benchmark::State& state)
+{
+    auto volume = SyntheticVolume();
+    auto positions = RandomPositions(NUM_POSITIONS);
+    LineGenerator gen;
+    gen.setSamplingRadius(static_cast<double>(state.range(0)));
+    std::size_t i{0};
+    for (auto _ : state) {
+        auto n = gen.compute(
+            volume, positions[i++ % positions.size()], {{0, 1, 0}});
+        benchmark::DoNotOptimize(n.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LineGenerator)->Arg(8)->Arg(32);
+
+// One cache shared by all benchmark threads, mixing reads and writes
+static void BM_LRUCacheContention(benchmark::State& state)
+{
+    static constexpr int NUM_KEYS{1024};
+    static LRUCache<int, std::uint64_t> cache(NUM_KEYS / 2);
+    std::uint64_t key = state.thread_index() * 7919;
+    for (auto _ : state) {
+        auto k = static_cast<int>(key++ % NUM_KEYS);
+        if (cache.contains(k)) {
+            try {
+                benchmark::DoNotOptimize(cache.get(k));
+            } catch (const std::invalid_argument&) {
+                // Evicted by another thread after contains()
+            }
+        } else {
+            cache.put(k, key);
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LRUCacheContention)->ThreadRange(1, 16)->UseRealTime();
@@ -0,0 +1,95 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "vc/benchmarks/SyntheticData.hpp"
+#include "vc/core/io/OBJReader.hpp"
+#include "vc/core/io/OBJWriter.hpp"
+#include "vc/core/io/PLYReader.hpp"
+#include "vc/core/io/PLYWriter.hpp"
+
+namespace fs = volcart::filesystem;
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+// Write a synthetic mesh with the given grid size to disk once
+static auto MeshFile(std::size_t size, const std::string& ext, bool binary)
+    -> fs::path
+{
+    auto path = TempDir() / ("Mesh_" + std::to_string(size) +
+                             (binary ? "_binary" : "") + ext);
+    if (fs::exists(path)) {
+        return path;
+    }
+
+    auto mesh = SyntheticMesh(size, size);
+    if (ext == ".obj") {
+        io::OBJWriter writer;
+        writer.setPath(path);
+        writer.setMesh(mesh);
+        writer.setUVMap(SyntheticUVMap(size, size));
+        writer.write();
+    } else {
+        io::PLYWriter writer(path, mesh);
+        writer.setBinary(binary);
+        writer.write();
+    }
+    return path;
+}
+
+static void BM_ReadPPM(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = TempDir() / ("Synthetic_" + std::to_string(size) + ".ppm");
+    PerPixelMap::WritePPM(path, *SyntheticPPM(size));
+    for (auto _ : state) {
+        auto ppm = PerPixelMap::ReadPPM(path);
+        benchmark::DoNotOptimize(ppm.mask().data);
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<std::int64_t>(fs::file_size(path)));
+}
+BENCHMARK(BM_ReadPPM)->Arg(512)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+static void BM_OBJReader(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = MeshFile(size, ".obj", false);
+    io::OBJReader reader;
+    reader.setPath(path);
+    reader.setNumThreads(static_cast<std::size_t>(state.range(1)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.read());
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<std::int64_t>(fs::file_size(path)));
+}
+BENCHMARK(BM_OBJReader)
+    ->ArgNames({"grid", "threads"})
+    ->Args({256, 1})
+    ->Args({256, 0})
+    ->Args({1024, 1})
+    ->Args({1024, 0})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_PLYReader(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto path = MeshFile(size, ".ply", state.range(1) != 0);
+    io::PLYReader reader(path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.read());
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<std::int64_t>(fs::file_size(path)));
+}
+BENCHMARK(BM_PLYReader)
+    ->ArgNames({"grid", "binary"})
+    ->Args({256, 0})
+    ->Args({256, 1})
+    ->Args({1024, 0})
+    ->Args({1024, 1})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+#include <opencv2/core.hpp>
+
+#include "vc/core/util/ApplyLUT.hpp"
+#include "vc/core/util/ColorMaps.hpp"
+#include "vc/core/util/ImageConversion.hpp"
+
+using namespace volcart;
+
+// Random square 16-bit image
+static auto RandomImage(int size) -> cv::Mat
+{
+    cv::Mat img(size, size, CV_16UC1);
+    cv::RNG rng(12345);
+    rng.fill(img, cv::RNG::UNIFORM, 0, 65536);
+    return img;
+}
+
+// Baseline: serial conversion of the whole image
+static void BM_QuantizeImageSerial(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto img = RandomImage(size);
+    for (auto _ : state) {
+        cv::Mat out;
+        img.convertTo(out, CV_8U, 255.0 / 65535.0);
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_QuantizeImageSerial)->Arg(1024)->Arg(4096);
+
+static void BM_QuantizeImage(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto img = RandomImage(size);
+    for (auto _ : state) {
+        auto out = QuantizeImage(img, CV_8U, false);
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_QuantizeImage)->Arg(1024)->Arg(4096);
+
+// Baseline: serial windowing with per-pixel arithmetic
+static void BM_WindowSerial(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto img = RandomImage(size);
+    auto scale = 256.0 / (40000.0 - 1000.0 + 1.0);
+    for (auto _ : state) {
+        cv::Mat out(img.size(), CV_8UC1);
+        for (int y = 0; y < img.rows; y++) {
+            for (int x = 0; x < img.cols; x++) {
+                out.at<std::uint8_t>(y, x) = cv::saturate_cast<std::uint8_t>(
+                    (img.at<std::uint16_t>(y, x) - 1000.0) * scale);
+            }
+        }
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_WindowSerial)->Arg(1024)->Arg(4096);
+
+static void BM_WindowLUT16U(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto img = RandomImage(size);
+    auto lut = WindowLUT16U(1000, 40000);
+    cv::Mat out;
+    for (auto _ : state) {
+        ApplyLUT16U(img, lut, out);
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_WindowLUT16U)->Arg(1024)->Arg(4096);
+
+// Baseline: serial color mapping which computes the bin of every pixel
+static void BM_ApplyColorMapSerial(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto img = RandomImage(size);
+    auto lut = GetColorMapLUT(ColorMap::Viridis);
+    auto bins = lut.cols;
+    for (auto _ : state) {
+        cv::Mat gray;
+        img.convertTo(gray, CV_32F);
+        cv::Mat out(img.size(), lut.type());
+        for (int y = 0; y < gray.rows; y++) {
+            for (int x = 0; x < gray.cols; x++) {
+                auto pos = std::clamp(gray.at<float>(y, x) / 65535.F, 0.F, 1.F);
+                auto bin = static_cast<int>(std::round((bins - 1) * pos));
+                out.at<cv::Vec3b>(y, x) = lut.at<cv::Vec3b>(0, bin);
+            }
+        }
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_ApplyColorMapSerial)->Arg(1024)->Arg(4096);
+
+static void BM_ApplyColorMap(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    auto img = RandomImage(size);
+    auto lut = GetColorMapLUT(ColorMap::Viridis);
+    for (auto _ : state) {
+        auto out = ApplyLUT(img, lut, 0, 65535);
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_ApplyColorMap)->Arg(1024)->Arg(4096);
+
+static void BM_ApplyColorMapFloat(benchmark::State& state)
+{
+    auto size = static_cast<int>(state.range(0));
+    cv::Mat img;
+    RandomImage(size).convertTo(img, CV_32F, 1.0 / 65535.0);
+    auto lut = GetColorMapLUT(ColorMap::Viridis);
+    for (auto _ : state) {
+        auto out = ApplyLUT(img, lut, 0, 1);
+        benchmark::DoNotOptimize(out.data);
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_ApplyColorMapFloat)->Arg(1024)->Arg(4096);
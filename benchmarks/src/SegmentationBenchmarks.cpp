@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "vc/benchmarks/SyntheticData.hpp"
+#include "vc/segmentation/OpticalFlowSegmentation.hpp"
+
+namespace vcs = volcart::segmentation;
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+/** Starting slice of the segmentation benchmarks */
+static constexpr int START_SLICE{16};
+
+/** Spacing between the starting chain's points */
+static constexpr int CHAIN_SPACING{4};
+
+// Starting chain which follows the synthetic sheet on a slice
+static auto SheetChain(int z) -> vcs::ChainSegmentationAlgorithm::Chain
+{
+    vcs::ChainSegmentationAlgorithm::Chain chain;
+    for (int x = 16; x < VOLUME_SIZE - 16; x += CHAIN_SPACING) {
+        chain.emplace_back(x, SheetY(x, z), z);
+    }
+    return chain;
+}
+
+// Each item is a single step of the segmentation
+static void BM_OpticalFlowSegmentation(benchmark::State& state)
+{
+    auto steps = static_cast<int>(state.range(0));
+    auto chain = SheetChain(START_SLICE);
+
+    // The master cloud lies after the target slice so that it is not used
+    // for interpolation
+    OrderedPointSet<cv::Vec3d> masterCloud(chain.size());
+    masterCloud.pushRow(SheetChain(VOLUME_SLICES - 1));
+
+    for (auto _ : state) {
+        auto seg = vcs::OpticalFlowSegmentationClass::New();
+        seg->setVolume(SyntheticVolume());
+        seg->setChain(chain);
+        seg->setTargetZIndex(START_SLICE + steps);
+        seg->setOrderedPointSet(masterCloud);
+        seg->setBackwardsLength(0);
+        seg->setBackwardsInterpolationWindow(0);
+        benchmark::DoNotOptimize(seg->compute());
+    }
+    state.SetItemsProcessed(state.iterations() * steps);
+}
+BENCHMARK(BM_OpticalFlowSegmentation)
+    ->ArgName("steps")
+    ->Arg(8)
+    ->Arg(32)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,178 @@
+#include "vc/benchmarks/SyntheticData.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+#include "vc/texturing/PPMGenerator.hpp"
+
+namespace fs = volcart::filesystem;
+namespace vct = volcart::texturing;
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+/** Half-thickness of the synthetic sheet in voxels */
+static constexpr int SHEET_RADIUS{3};
+
+/** Margin between the synthetic mesh and the volume bounds */
+static constexpr double MESH_MARGIN{8};
+
+auto benchmarks::SheetY(double x, double z) -> double
+{
+    return VOLUME_SIZE / 2.0 + 16 * std::sin(2 * M_PI * x / 128.0) +
+           8 * std::sin(2 * M_PI * z / 64.0);
+}
+
+auto benchmarks::TempDir() -> fs::path
+{
+    auto dir = fs::temp_directory_path() / "vc_benchmarks";
+    fs::create_directories(dir);
+    return dir;
+}
+
+auto benchmarks::SyntheticVolume() -> Volume::Pointer
+{
+    static std::mutex mutex;
+    static Volume::Pointer volume;
+    std::unique_lock<std::mutex> lock(mutex);
+    if (volume) {
+        return volume;
+    }
+
+    // Write the slices
+    auto dir = TempDir() / "Synthetic.volume";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    {
+        auto v = Volume::New(dir, "synthetic", "Synthetic");
+        v->setSliceWidth(VOLUME_SIZE);
+        v->setSliceHeight(VOLUME_SIZE);
+        v->setNumberOfSlices(VOLUME_SLICES);
+        v->setVoxelSize(1);
+        v->setMin(0);
+        v->setMax(65535);
+
+        cv::RNG rng(0x5eed);
+        cv::Mat slice(VOLUME_SIZE, VOLUME_SIZE, CV_16UC1);
+        for (int z = 0; z < VOLUME_SLICES; z++) {
+            rng.fill(slice, cv::RNG::UNIFORM, 2000, 6000);
+            for (int x = 0; x < VOLUME_SIZE; x++) {
+                auto center = static_cast<int>(std::round(SheetY(x, z)));
+                for (int dy = -SHEET_RADIUS; dy <= SHEET_RADIUS; dy++) {
+                    auto falloff = 1.0 - std::abs(dy) / (SHEET_RADIUS + 1.0);
+                    slice.at<std::uint16_t>(center + dy, x) +=
+                        static_cast<std::uint16_t>(40000 * falloff);
+                }
+            }
+            v->setSliceData(z, slice, false);
+        }
+        v->saveMetadata();
+    }
+
+    volume = Volume::New(dir);
+    return volume;
+}
+
+auto benchmarks::SyntheticMesh(std::size_t rows, std::size_t cols)
+    -> ITKMesh::Pointer
+{
+    auto mesh = ITKMesh::New();
+
+    // Vertices on the sheet
+    auto spanX = VOLUME_SIZE - 2 * MESH_MARGIN;
+    auto spanZ = VOLUME_SLICES - 2 * MESH_MARGIN;
+    ITKPoint pt;
+    for (std::size_t r = 0; r < rows; r++) {
+        auto z = MESH_MARGIN + spanZ * r / static_cast<double>(rows - 1);
+        for (std::size_t c = 0; c < cols; c++) {
+            auto x = MESH_MARGIN + spanX * c / static_cast<double>(cols - 1);
+            pt[0] = x;
+            pt[1] = SheetY(x, z);
+            pt[2] = z;
+            mesh->SetPoint(r * cols + c, pt);
+        }
+    }
+
+    // Two triangles for each grid cell
+    ITKCell::CellAutoPointer cell;
+    std::size_t cid{0};
+    for (std::size_t r = 1; r < rows; r++) {
+        for (std::size_t c = 1; c < cols; c++) {
+            auto v1 = r * cols + c;
+            auto v2 = v1 - 1;
+            auto v3 = v2 - cols;
+            auto v4 = v1 - cols;
+
+            cell.TakeOwnership(new ITKTriangle);
+            cell->SetPointId(0, v1);
+            cell->SetPointId(1, v2);
+            cell->SetPointId(2, v3);
+            mesh->SetCell(cid++, cell);
+
+            cell.TakeOwnership(new ITKTriangle);
+            cell->SetPointId(0, v1);
+            cell->SetPointId(1, v3);
+            cell->SetPointId(2, v4);
+            mesh->SetCell(cid++, cell);
+        }
+    }
+
+    return mesh;
+}
+
+auto benchmarks::SyntheticUVMap(std::size_t rows, std::size_t cols)
+    -> UVMap::Pointer
+{
+    auto uvMap = UVMap::New();
+    for (std::size_t r = 0; r < rows; r++) {
+        for (std::size_t c = 0; c < cols; c++) {
+            uvMap->set(
+                r * cols + c, {c / static_cast<double>(cols - 1),
+                               r / static_cast<double>(rows - 1)});
+        }
+    }
+    return uvMap;
+}
+
+auto benchmarks::SyntheticPPM(std::size_t size) -> PerPixelMap::Pointer
+{
+    static std::mutex mutex;
+    static std::map<std::size_t, PerPixelMap::Pointer> ppms;
+    std::unique_lock<std::mutex> lock(mutex);
+    auto& ppm = ppms[size];
+    if (not ppm) {
+        vct::PPMGenerator gen(size, size);
+        gen.setMesh(SyntheticMesh(64, 64));
+        gen.setUVMap(SyntheticUVMap(64, 64));
+        ppm = gen.compute();
+    }
+    return ppm;
+}
+
+auto benchmarks::SyntheticMask() -> VolumetricMask::Pointer
+{
+    auto mask = VolumetricMask::New();
+    for (int z = 0; z < VOLUME_SLICES; z++) {
+        for (int x = 0; x < VOLUME_SIZE; x++) {
+            auto center = static_cast<int>(std::round(SheetY(x, z)));
+            for (int dy = -SHEET_RADIUS; dy <= SHEET_RADIUS; dy++) {
+                mask->setIn({x, center + dy, z});
+            }
+        }
+    }
+    return mask;
+}
+
+auto benchmarks::RandomPositions(std::size_t n) -> std::vector<cv::Vec3d>
+{
+    cv::RNG rng(0x5eed);
+    std::vector<cv::Vec3d> positions(n);
+    for (auto& p : positions) {
+        p[0] = rng.uniform(0.0, VOLUME_SIZE - 1.0);
+        p[1] = rng.uniform(0.0, VOLUME_SIZE - 1.0);
+        p[2] = rng.uniform(0.0, VOLUME_SLICES - 1.0);
+    }
+    return positions;
+}
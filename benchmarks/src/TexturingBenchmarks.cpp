@@ -0,0 +1,133 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "vc/benchmarks/SyntheticData.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/texturing/CompositeTexture.hpp"
+#include "vc/texturing/IntegralTexture.hpp"
+#include "vc/texturing/IntersectionTexture.hpp"
+#include "vc/texturing/LayerTexture.hpp"
+#include "vc/texturing/PPMGenerator.hpp"
+#include "vc/texturing/ThicknessTexture.hpp"
+
+namespace vct = volcart::texturing;
+
+using namespace volcart;
+using namespace volcart::benchmarks;
+
+/** Edge length of the PPM used by the texturing benchmarks */
+static constexpr std::size_t TEXTURE_SIZE{256};
+
+/** Sampling radius of the texturing benchmarks' neighborhoods */
+static constexpr double SAMPLING_RADIUS{7};
+
+// Count the texturing benchmarks' items as mapped pixels
+static void SetPixelsProcessed(
+    benchmark::State& state, const PerPixelMap::Pointer& ppm)
+{
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<std::int64_t>(ppm->getMappings().size()));
+}
+
+static auto SamplingGenerator() -> LineGenerator::Pointer
+{
+    auto gen = LineGenerator::New();
+    gen->setSamplingRadius(SAMPLING_RADIUS);
+    gen->setSamplingDirection(Direction::Bidirectional);
+    return gen;
+}
+
+static void BM_PPMGenerator(benchmark::State& state)
+{
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto mesh = SyntheticMesh(64, 64);
+    auto uvMap = SyntheticUVMap(64, 64);
+    vct::PPMGenerator gen(size, size);
+    gen.setMesh(mesh);
+    gen.setUVMap(uvMap);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(gen.compute());
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<std::int64_t>(size * size));
+}
+BENCHMARK(BM_PPMGenerator)
+    ->Arg(512)
+    ->Arg(2048)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_CompositeTexture(benchmark::State& state)
+{
+    auto ppm = SyntheticPPM(TEXTURE_SIZE);
+    vct::CompositeTexture texture;
+    texture.setVolume(SyntheticVolume());
+    texture.setPerPixelMap(ppm);
+    texture.setGenerator(SamplingGenerator());
+    texture.setFilter(
+        static_cast<vct::CompositeTexture::Filter>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(texture.compute());
+    }
+    SetPixelsProcessed(state, ppm);
+}
+BENCHMARK(BM_CompositeTexture)
+    ->ArgName("filter")
+    ->DenseRange(0, 4)
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_IntersectionTexture(benchmark::State& state)
+{
+    auto ppm = SyntheticPPM(TEXTURE_SIZE);
+    vct::IntersectionTexture texture;
+    texture.setVolume(SyntheticVolume());
+    texture.setPerPixelMap(ppm);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(texture.compute());
+    }
+    SetPixelsProcessed(state, ppm);
+}
+BENCHMARK(BM_IntersectionTexture)->Unit(benchmark::kMillisecond);
+
+static void BM_IntegralTexture(benchmark::State& state)
+{
+    auto ppm = SyntheticPPM(TEXTURE_SIZE);
+    auto texture = vct::IntegralTexture::New();
+    texture->setVolume(SyntheticVolume());
+    texture->setPerPixelMap(ppm);
+    texture->setGenerator(SamplingGenerator());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(texture->compute());
+    }
+    SetPixelsProcessed(state, ppm);
+}
+BENCHMARK(BM_IntegralTexture)->Unit(benchmark::kMillisecond);
+
+static void BM_LayerTexture(benchmark::State& state)
+{
+    auto ppm = SyntheticPPM(TEXTURE_SIZE);
+    vct::LayerTexture texture;
+    texture.setVolume(SyntheticVolume());
+    texture.setPerPixelMap(ppm);
+    texture.setGenerator(SamplingGenerator());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(texture.compute());
+    }
+    SetPixelsProcessed(state, ppm);
+}
+BENCHMARK(BM_LayerTexture)->Unit(benchmark::kMillisecond);
+
+static void BM_ThicknessTexture(benchmark::State& state)
+{
+    auto ppm = SyntheticPPM(TEXTURE_SIZE);
+    auto texture = vct::ThicknessTexture::New();
+    texture->setVolume(SyntheticVolume());
+    texture->setPerPixelMap(ppm);
+    texture->setVolumetricMask(SyntheticMask());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(texture->compute());
+    }
+    SetPixelsProcessed(state, ppm);
+}
+BENCHMARK(BM_ThicknessTexture)->Unit(benchmark::kMillisecond);
@@ -26,6 +26,9 @@ endif()
 message(STATUS "Using filesystem library: ${VC_FS_LIB}")
 list(APPEND VC_CUSTOM_MODULES "${CMAKE_MODULE_PATH}/FindFilesystem.cmake")
 
+### Threads ###
+find_package(Threads REQUIRED)
+
 ### Qt6 ###
 if((VC_BUILD_APPS OR VC_BUILD_UTILS) AND VC_BUILD_GUI)
     find_package(Qt6 6.3 QUIET REQUIRED COMPONENTS Widgets Gui Core Network)
@@ -66,6 +69,9 @@ endif()
 ### libtiff ###
 find_package(TIFF 4.0 REQUIRED)
 
+### zlib ###
+find_package(ZLIB REQUIRED)
+
 ### spdlog ###
 find_package(spdlog 1.4.2 CONFIG REQUIRED)
 
@@ -110,6 +116,23 @@ if(VC_BUILD_TESTS)
     endif()
 endif()
 
+### Google Benchmark ###
+if(VC_BUILD_BENCHMARKS)
+    FetchContent_Declare(
+        googlebenchmark
+        GIT_REPOSITORY https://github.com/google/benchmark.git
+        GIT_TAG        v1.8.3
+    )
+
+    FetchContent_GetProperties(googlebenchmark)
+    if(NOT googlebenchmark_POPULATED)
+        set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+        set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+        FetchContent_Populate(googlebenchmark)
+        add_subdirectory(${googlebenchmark_SOURCE_DIR} ${googlebenchmark_BINARY_DIR} EXCLUDE_FROM_ALL)
+    endif()
+endif()
+
 # Python bindings
 if(VC_BUILD_PYTHON_BINDINGS)
     find_package(pybind11 REQUIRED)
@@ -0,0 +1,62 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <string>
+
+#include "vc/core/filesystem.hpp"
+
+namespace volcart::io
+{
+
+/**
+ * @brief Read-only view of a file's contents
+ *
+ * On POSIX systems, the file is memory mapped so that parsing can proceed
+ * directly from the page cache without copying through stream buffers. On
+ * other systems, the file is read into memory in a single bulk read.
+ *
+ * Throws volcart::IOException if the file cannot be opened.
+ *
+ * @ingroup IO
+ */
+class MemoryMappedFile
+{
+public:
+    /** @brief Map a file into memory */
+    explicit MemoryMappedFile(const filesystem::path& path);
+
+    /** @brief Unmap the file */
+    ~MemoryMappedFile();
+
+    /**@{*/
+    /** Not copyable */
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    auto operator=(const MemoryMappedFile&) -> MemoryMappedFile& = delete;
+    /**@}*/
+
+    /** @brief Pointer to the first byte of the file */
+    [[nodiscard]] auto begin() const -> const char* { return data_; }
+
+    /** @brief Pointer to one past the last byte of the file */
+    [[nodiscard]] auto end() const -> const char* { return data_ + size_; }
+
+    /** @brief Size of the file in bytes */
+    [[nodiscard]] auto size() const -> std::size_t { return size_; }
+
+    /** @brief Returns true if the file is empty */
+    [[nodiscard]] auto empty() const -> bool { return size_ == 0; }
+
+private:
+    /** Mapped data */
+    const char* data_{nullptr};
+    /** Size of mapped data */
+    std::size_t size_{0};
+    /** Whether data_ is a memory mapping */
+    bool mapped_{false};
+    /** Fallback buffer used when memory mapping is unavailable */
+    std::string buffer_;
+};
+
+}  // namespace volcart::io
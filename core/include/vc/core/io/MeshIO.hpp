@@ -7,6 +7,7 @@
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/types/UVMap.hpp"
 
 namespace volcart
@@ -32,9 +33,23 @@ struct MeshReaderResult {
  */
 auto ReadMesh(const filesystem::path& path) -> MeshReaderResult;
 
+/**
+ * @brief Read a mesh from a file into a TriangleMesh
+ *
+ * Like ReadMesh(), but skips the construction of an ITKMesh. UV coordinates
+ * from textured meshes are stored in the returned mesh. Texture images are
+ * not returned.
+ *
+ * @param path Input file path
+ */
+auto ReadTriangleMesh(const filesystem::path& path) -> TriangleMesh::Pointer;
+
 /** @brief General options for WriteMesh */
 struct MeshWriterOpts {
+    /** Texture image file format */
     std::string imgFmt{"tif"};
+    /** Write PLY files in the binary little endian format */
+    bool binaryPLY{false};
 };
 
 /**
@@ -55,4 +70,16 @@ void WriteMesh(
     const UVMap::Pointer& uv = nullptr,
     const cv::Mat& texture = cv::Mat(),
     const MeshWriterOpts& opts = {});
+
+/**
+ * @brief Write a TriangleMesh to a file
+ *
+ * Like WriteMesh(), but writes directly from the mesh's flat arrays. If the
+ * mesh has UV coordinates, they are written with the provided texture image.
+ */
+void WriteMesh(
+    const filesystem::path& path,
+    const TriangleMesh::Pointer& mesh,
+    const cv::Mat& texture = cv::Mat(),
+    const MeshWriterOpts& opts = {});
 }  // namespace volcart
\ No newline at end of file
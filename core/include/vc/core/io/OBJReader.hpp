@@ -2,12 +2,15 @@
 
 /** @file */
 
-#include <fstream>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/types/UVMap.hpp"
 
 namespace volcart::io
@@ -18,7 +21,7 @@ namespace volcart::io
  * @author Zack Anderson, Seth Parker
  * @date 02/09/2017
  *
- * @brief Read an OBJ file into a volcart::ITKMesh
+ * @brief Read an OBJ file into a volcart::ITKMesh or volcart::TriangleMesh
  *
  * Supports image mapped meshes. Image path is parsed from the OBJ's mtl
  * include. Other material properties are currently ignored. Throws
@@ -32,9 +35,28 @@ public:
     /** @brief Set the OBJ file path */
     void setPath(const filesystem::path& p);
 
+    /**
+     * @brief Set the number of threads used to parse the file
+     *
+     * Large files are split into line-aligned chunks which are parsed in
+     * parallel. The parsed mesh is identical regardless of the number of
+     * threads. If 0 (default), uses the number of hardware threads. Small
+     * files are always parsed with a single thread.
+     */
+    void setNumThreads(std::size_t n);
+
     /** @brief Read the mesh from file */
     auto read() -> ITKMesh::Pointer;
 
+    /**
+     * @brief Read the mesh from file into a TriangleMesh
+     *
+     * UV coordinates and normals referenced by the OBJ's faces are stored
+     * per-vertex in the returned mesh. The texture image is loaded as with
+     * read(), but getMesh() and getUVMap() are not updated.
+     */
+    auto readTriangleMesh() -> TriangleMesh::Pointer;
+
     /** @brief Return the parsed mesh */
     auto getMesh() -> ITKMesh::Pointer;
 
@@ -65,17 +87,23 @@ private:
      * VertexRefs { v, vt, vn }
      */
     using VertexRefs = cv::Vec3i;
-    /** @brief A list of at least three OBJReader::VertexRefs comprise a face */
-    using Face = std::vector<VertexRefs>;
-
-    /** @brief Validation enumeration to ensure proper parsing of
-     * OBJReader::VertexRefs */
-    enum class RefType {
-        Invalid,
-        Vertex,
-        VertexWithTexture,
-        VertexWithNormal,
-        VertexWithTextureAndNormal
+
+    /** @brief Parsed contents of a contiguous range of lines */
+    struct Chunk {
+        /** Vertex positions */
+        std::vector<cv::Vec3d> vertices;
+        /** Vertex normals */
+        std::vector<cv::Vec3d> normals;
+        /** Vertex UV coordinates */
+        std::vector<cv::Vec2d> uvs;
+        /** Face vertex references, three per face */
+        std::vector<VertexRefs> faces;
+        /** Whether a non-triangular face was parsed */
+        bool hasNonTriFace{false};
+        /** Last mtllib file name */
+        std::string mtllib;
+        /** First parse error */
+        std::string error;
     };
 
     /** Clear all temporary data structures */
@@ -83,21 +111,19 @@ private:
 
     /** Parse the mesh */
     void parse_();
-    /** Handle parsed vertex lines */
-    void parse_vertex_(const std::vector<std::string>& strs);
-    /** Handle parsed vertex normal lines */
-    void parse_normal_(const std::vector<std::string>& strs);
-    /** Handle parsed vertex UV coordinate lines */
-    void parse_tcoord_(const std::vector<std::string>& strs);
-    /** Handle parsed face lines */
-    void parse_face_(const std::vector<std::string>& strs);
-    /** Handle parsed mtllib lines */
-    void parse_mtllib_(const std::vector<std::string>& strs);
-    /** Classify a OBJReader::VertexRefs as an OBJReader::RefType */
-    auto classify_vertref_(const std::string& ref) -> RefType;
+    /** Parse a range of lines */
+    static void parse_chunk_(const char* first, const char* last, Chunk& c);
+    /** Parse a face line */
+    static void parse_face_(const char* first, const char* last, Chunk& c);
+    /** Parse the mtl file */
+    void parse_mtllib_(const std::string& mtllib);
 
     /** Construct a mesh from the parsed information */
     void build_mesh_();
+    /** Construct a TriangleMesh from the parsed information */
+    auto build_triangle_mesh_() -> TriangleMesh::Pointer;
+    /** Load the texture image referenced by the mtl file */
+    void load_texture_();
 
     /** Path to the OBJ file */
     filesystem::path path_;
@@ -116,8 +142,12 @@ private:
     std::vector<cv::Vec3d> normals_;
     /** List of parsed vertex UV coordinates */
     std::vector<cv::Vec2d> uvs_;
-    /** List of parsed faces */
-    std::vector<OBJReader::Face> faces_;
+    /** List of parsed face vertex references, three per face */
+    std::vector<VertexRefs> faces_;
+    /** Whether a non-triangular face was parsed */
+    bool hasNonTriFace_{false};
+    /** Number of parsing threads */
+    std::size_t numThreads_{0};
 };
 
 }  // namespace volcart::io
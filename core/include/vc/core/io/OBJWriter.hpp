@@ -4,11 +4,13 @@
 
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #include <opencv2/core.hpp>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/types/UVMap.hpp"
 
 namespace volcart::io
@@ -18,10 +20,14 @@ namespace volcart::io
  * @author Seth Parker
  * @date 6/24/15
  *
- * @brief Write an ITKMesh to an OBJ file
+ * @brief Write an ITKMesh or TriangleMesh to an OBJ file
  *
  * Writes both textured and untextured meshes in ASCII OBJ format. Texture
- * information is automatically written if a UV map is set and is not empty.
+ * information is automatically written if a UV map is set and is not empty,
+ * or if the input is a TriangleMesh with UV coordinates.
+ *
+ * Output is formatted into large in-memory buffers before being written to
+ * disk, but is identical to that produced by standard iostream formatting.
  *
  * @ingroup IO
  */
@@ -55,6 +61,9 @@ public:
     /** @brief Set the input mesh */
     void setMesh(ITKMesh::Pointer mesh);
 
+    /** @copydoc setMesh(ITKMesh::Pointer) */
+    void setMesh(TriangleMesh::Pointer mesh);
+
     /** @brief Set the input UV Map */
     void setUVMap(UVMap::Pointer uvMap);
 
@@ -90,23 +99,32 @@ private:
 
     /**
      * Keeps track of what info we have about each point in the mesh. Used for
-     * building OBJ faces.
+     * building OBJ faces. Indexed by point ID.
      *
-     * [ Point Index, {v, vt, vn} ]
+     * {v, vt, vn}
      *
      * v = vertex index number \n
      * vt = UV coordinate index number \n
      * vn = vertex normal index number \n
      */
-    std::map<uint32_t, cv::Vec3i> pointLinks_;
+    std::vector<cv::Vec3i> pointLinks_;
 
     /** Input mesh */
     ITKMesh::Pointer mesh_;
+    /** Input mesh */
+    TriangleMesh::Pointer triMesh_;
     /** Input UV map */
     UVMap::Pointer uvMap_;
     /** Input texture image */
     cv::Mat texture_;
 
+    /** Get the number of vertices in the input mesh */
+    [[nodiscard]] auto num_vertices_() const -> std::size_t;
+    /** Get the number of faces in the input mesh */
+    [[nodiscard]] auto num_faces_() const -> std::size_t;
+    /** Returns true if texture information will be written */
+    [[nodiscard]] auto has_uvs_() const -> bool;
+
     /** Write the OBJ file */
     auto write_obj_() -> int;
     /** Write the MTL file */
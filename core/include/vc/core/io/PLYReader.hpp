@@ -2,12 +2,14 @@
 
 /** @file */
 
-#include <fstream>
-#include <map>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/ITKMesh.hpp"
 #include "vc/core/types/SimpleMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 
 namespace volcart::io
 {
@@ -17,9 +19,11 @@ namespace volcart::io
  * @author Hannah Hatch
  * @date 10/18/16
  *
- * @brief Read a PLY file to an ITKMesh
+ * @brief Read a PLY file to an ITKMesh or TriangleMesh
  *
- * Only supports vertices, vertex normals, and faces.
+ * Only supports vertices, vertex normals, and faces. Supports the ASCII,
+ * binary little endian, and binary big endian PLY formats. Vertex and face
+ * properties may be stored using any of the standard PLY scalar types.
  *
  * @ingroup IO
  */
@@ -45,41 +49,72 @@ public:
     /**@{*/
     /** @brief Parse the input file */
     auto read() -> ITKMesh::Pointer;
+
+    /**
+     * @brief Parse the input file into a TriangleMesh
+     *
+     * Skips the construction of an ITKMesh. getMesh() is not updated.
+     */
+    auto readTriangleMesh() -> TriangleMesh::Pointer;
     /**@}*/
 
 private:
+    /** PLY body encoding */
+    enum class Format { Ascii, BinaryLittleEndian, BinaryBigEndian };
+
+    /** PLY scalar property types */
+    enum class Type {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    /** A property of a PLY element */
+    struct Property {
+        /** Property name */
+        std::string name;
+        /** Value type. For lists, the type of the list items. */
+        Type type{Type::Float32};
+        /** Whether this property is a list */
+        bool isList{false};
+        /** For lists, the type of the item count */
+        Type countType{Type::UInt8};
+    };
+
+    /** An element declared in the PLY header */
+    struct Element {
+        /** Element name */
+        std::string name;
+        /** Number of element instances */
+        std::size_t count{0};
+        /** Element properties in file order */
+        std::vector<Property> properties;
+    };
+
     /** Input file path */
     filesystem::path inputPath_;
-    /** Input file stream */
-    std::ifstream plyFile_;
     /** Output mesh */
     ITKMesh::Pointer outMesh_;
-    /** Line currently being parsed */
-    std::string line_;
     /** Temporary face list */
     std::vector<SimpleMesh::Cell> faceList_;
     /** Temporary vertex list */
     std::vector<SimpleMesh::Vertex> pointList_;
-    /** List of elements parsed from the header */
-    std::vector<std::string> elementsList_;
-    /** Number of vertices expected in the parsed mesh */
-    int numVertices_;
-    /** Number of faces expected in the parsed mesh */
-    int numFaces_;
-    /** Number of lines used by the elements we can't handle */
-    std::vector<int> skippedLine_;
-    /** Maps positions in a string to a particular attribute */
-    std::map<std::string, int> properties_;
-
-    /**
-     * Tracks if there is a leading character in front of each face line. This
-     * character tells how many vertices are in that face.
-     */
-    bool hasLeadingChar_ = true;
+    /** Body encoding */
+    Format format_{Format::Ascii};
+    /** Elements parsed from the header */
+    std::vector<Element> elements_;
 
     /** Track if there are vertex normals */
     bool hasPointNorm_ = false;
 
+    /** @brief Parse the input file into the temporary vertices and faces */
+    void parse_();
+
     /** @brief Construct outMesh_ from the temporary vertices and faces */
     void create_mesh_();
 
@@ -87,16 +122,28 @@ private:
      * @brief Parse the PLY header
      *
      * The header defines the expected layout for the body of the PLY file,
-     * including the count for each element (e.g. vertices, faces, etc). This
-     * information is stored in elementsList_ and used when reading in faces
-     * and vertices.
+     * including the format, the count for each element (e.g. vertices, faces,
+     * etc), and the type of each element property. This information is stored
+     * in elements_ and used when reading in faces and vertices.
+     *
+     * @return Pointer to the first byte of the body
      */
-    void parse_header_();
+    auto parse_header_(const char* first, const char* last) -> const char*;
 
-    /** @brief Fill the temporary face list with parsed face information */
-    void read_faces_();
+    /** @brief Read a single scalar value from the body */
+    auto read_value_(const char*& p, const char* last, Type t) const
+        -> double;
 
     /** @brief Fill the temporary vertex list with parsed vertex information */
-    void read_points_();
+    auto read_points_(const Element& e, const char* p, const char* last)
+        -> const char*;
+
+    /** @brief Fill the temporary face list with parsed face information */
+    auto read_faces_(const Element& e, const char* p, const char* last)
+        -> const char*;
+
+    /** @brief Skip over all instances of an unsupported element */
+    auto skip_element_(const Element& e, const char* p, const char* last)
+        -> const char*;
 };
 }  // namespace volcart::io
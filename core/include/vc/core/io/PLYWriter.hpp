@@ -8,6 +8,7 @@
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/types/UVMap.hpp"
 
 namespace volcart::io
@@ -17,11 +18,12 @@ namespace volcart::io
  * @author Seth Parker
  * @date 10/30/15
  *
- * @brief Write an ITKMesh to a PLY file
+ * @brief Write an ITKMesh or TriangleMesh to a PLY file
  *
- * Writes both textured and untextured meshes in ASCII PLY format. Texture
- * information is automatically written if the volcart::Texture has images
- * and if the UV map is set and is not empty.
+ * Writes both textured and untextured meshes in ASCII or binary little endian
+ * PLY format. Texture information is automatically written if the
+ * volcart::Texture has images and if the UV map is set and is not empty. For
+ * a TriangleMesh with UV coordinates, the UV map is optional.
  *
  * Assumes that vertices have vertex normal information.
  *
@@ -53,6 +55,9 @@ public:
     /** @brief Set the input mesh */
     void setMesh(ITKMesh::Pointer mesh);
 
+    /** @copydoc setMesh(ITKMesh::Pointer) */
+    void setMesh(TriangleMesh::Pointer mesh);
+
     /** @brief Set the input UV Map */
     void setUVMap(UVMap::Pointer uvMap);
 
@@ -61,6 +66,14 @@ public:
 
     /** @brief Set per-vertex color information */
     void setVertexColors(const std::vector<uint16_t>& c);
+
+    /**
+     * @brief Write the binary little endian PLY format
+     *
+     * Binary PLY files are significantly smaller and faster to read and write
+     * than ASCII PLY files. Default: `false`
+     */
+    void setBinary(bool b);
     /**@}*/
 
     /**@{*/
@@ -80,12 +93,23 @@ private:
     std::ofstream outputMesh_;
     /** Input mesh */
     ITKMesh::Pointer mesh_;
+    /** Input mesh */
+    TriangleMesh::Pointer triMesh_;
     /** Input UV map */
     UVMap::Pointer uvMap_;
     /** Input texture image */
     cv::Mat texture_;
     /** Vertex colors */
     std::vector<uint16_t> vcolors_;
+    /** Write binary PLY */
+    bool binary_{false};
+
+    /** @brief Get the number of vertices in the input mesh */
+    [[nodiscard]] auto num_vertices_() const -> std::size_t;
+    /** @brief Get the number of faces in the input mesh */
+    [[nodiscard]] auto num_faces_() const -> std::size_t;
+    /** @brief Returns true if vertex colors will be written */
+    [[nodiscard]] auto has_color_() const -> bool;
 
     /** @brief Write the PLY header */
     auto write_header_() -> int;
@@ -96,6 +120,8 @@ private:
      * Lines are formatted:
      *
      * `x y z nx ny nz`
+     *
+     * In binary mode, positions and normals are written as 32-bit floats.
      */
     auto write_vertices_() -> int;
     /**@brief Write the PLY faces
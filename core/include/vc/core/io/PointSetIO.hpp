@@ -4,16 +4,19 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <fstream>
 #include <regex>
 #include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/Exceptions.hpp"
 #include "vc/core/types/OrderedPointSet.hpp"
 #include "vc/core/types/PointSet.hpp"
+#include "vc/core/util/Logging.hpp"
 #include "vc/core/util/String.hpp"
 
 namespace volcart
@@ -34,6 +37,11 @@ enum class IOMode { ASCII = 0, BINARY };
  * information is then encoded in either ASCII or binary, as determined at
  * time of write.
  *
+ * Binary point data is read and written in bulk, directly to and from the
+ * point set's contiguous storage. Binary files of type `float` can be read as
+ * `double` point sets and vice versa. Values are converted in large blocks
+ * as they are read.
+ *
  * @ingroup IO
  *
  * @see volcart::PointSet
@@ -120,7 +128,7 @@ public:
 
     /**@{*/
     /** @brief Generate a PointSet header string */
-    static std::string MakeHeader(PointSet<T> ps)
+    static std::string MakeHeader(const PointSet<T>& ps)
     {
         std::stringstream ss;
         ss << "size: " << ps.size() << std::endl;
@@ -146,7 +154,7 @@ public:
         return ss.str();
     }
     /** @brief Generate an OrderedPointSet header string */
-    static std::string MakeOrderedHeader(OrderedPointSet<T> ps)
+    static std::string MakeOrderedHeader(const OrderedPointSet<T>& ps)
     {
         std::stringstream ss;
         ss << "width: " << ps.width() << std::endl;
@@ -270,7 +278,12 @@ public:
                 } else {
                     throw IOException("unsupported reader type");
                 }
-                if (strs[1] != readerType) {
+                // float and double files are converted when read
+                auto isFloating = [](const std::string& t) {
+                    return t == "float" or t == "double";
+                };
+                if (strs[1] != readerType and
+                    not(isFloating(strs[1]) and isFloating(readerType))) {
                     auto msg = "Type mismatch: vcps filetype '" + strs[1] +
                                "' not compatible with reader type '" +
                                readerType + "'";
@@ -396,25 +409,14 @@ private:
             throw IOException(msg);
         }
         auto header = PointSetIO<T>::ParseHeader(infile, false);
-        PointSet<T> ps{header.size};
-
-        // Size of binary elements to read
-        size_t typeBytes{};
-        if (header.type == "float") {
-            typeBytes = sizeof(float);
-        } else if (header.type == "double") {
-            typeBytes = sizeof(double);
-        } else if (header.type == "int") {
-            typeBytes = sizeof(int);
-        }
 
         // Read data
-        T t;
-        for (size_t i = 0; i < header.size; ++i) {
-            auto nbytes = header.dim * typeBytes;
-            infile.read(reinterpret_cast<char*>(t.val), nbytes);
-            ps.push_back(t);
-        }
+        auto start = std::chrono::steady_clock::now();
+        typename PointSet<T>::Container points(header.size);
+        ReadBinaryPoints(infile, header, points.data(), points.size());
+        PointSet<T> ps;
+        ps.adopt(std::move(points));
+        LogThroughput("Read", path, ps.size(), start);
 
         return ps;
     }
@@ -429,42 +431,101 @@ private:
             throw IOException(msg);
         }
         auto header = PointSetIO<T>::ParseHeader(infile, true);
-        OrderedPointSet<T> ps{header.width};
 
-        // Size of binary elements to read
-        size_t typeBytes = sizeof(int);
+        // Read data
+        auto start = std::chrono::steady_clock::now();
+        typename PointSet<T>::Container points(header.width * header.height);
+        ReadBinaryPoints(infile, header, points.data(), points.size());
+        OrderedPointSet<T> ps;
+        ps.adopt(header.width, std::move(points));
+        LogThroughput("Read", path, ps.size(), start);
+
+        return ps;
+    }
+
+    /**
+     * @brief Read binary point data into contiguous point storage
+     *
+     * Converts from the file's value type to the point's value type if
+     * necessary.
+     */
+    static void ReadBinaryPoints(
+        std::ifstream& infile, const Header& header, T* out, size_t n)
+    {
+        static_assert(
+            sizeof(T) == T::channels * sizeof(typename T::value_type),
+            "Point type must be tightly packed");
+        auto* values = reinterpret_cast<typename T::value_type*>(out);
+        auto numValues = n * T::channels;
         if (header.type == "float") {
-            typeBytes = sizeof(float);
+            ReadBinaryValues<float>(infile, values, numValues);
         } else if (header.type == "double") {
-            typeBytes = sizeof(double);
+            ReadBinaryValues<double>(infile, values, numValues);
         } else if (header.type == "int") {
-            typeBytes = sizeof(int);
+            ReadBinaryValues<int>(infile, values, numValues);
         } else {
             auto msg = "Unrecognized type: " + header.type;
             throw IOException(msg);
         }
+    }
 
-        // Read data
-        T t;
-        auto nbytes = header.dim * typeBytes;
-        for (size_t h = 0; h < header.height; ++h) {
-            std::vector<T> points;
-            points.reserve(header.width);
-            for (size_t w = 0; w < header.width; ++w) {
-                infile.read(reinterpret_cast<char*>(t.val), nbytes);
-                points.push_back(t);
+    /** @brief Read `n` values of type `FileType` from a binary stream */
+    template <typename FileType>
+    static void ReadBinaryValues(
+        std::ifstream& infile, typename T::value_type* out, size_t n)
+    {
+        using ValueType = typename T::value_type;
+
+        // Same type: read directly into the output
+        if constexpr (std::is_same_v<FileType, ValueType>) {
+            ReadBytes(infile, out, n * sizeof(ValueType));
+        }
+
+        // Different types: read blocks and convert
+        else {
+            std::vector<FileType> block(std::min(n, CONVERSION_BLOCK_SIZE));
+            for (size_t i = 0; i < n; i += block.size()) {
+                auto count = std::min(block.size(), n - i);
+                ReadBytes(infile, block.data(), count * sizeof(FileType));
+                std::transform(
+                    block.begin(), block.begin() + count, out + i,
+                    [](auto v) { return static_cast<ValueType>(v); });
             }
-            ps.pushRow(points);
         }
+    }
 
-        return ps;
+    /** @brief Read exactly `nbytes` from a binary stream */
+    static void ReadBytes(std::ifstream& infile, void* out, size_t nbytes)
+    {
+        infile.read(
+            reinterpret_cast<char*>(out), static_cast<std::streamsize>(nbytes));
+        if (static_cast<size_t>(infile.gcount()) != nbytes) {
+            auto msg = "unexpected end of file while reading points";
+            throw IOException(msg);
+        }
+    }
+
+    /** @brief Log the throughput of a binary read or write */
+    static void LogThroughput(
+        const std::string& op,
+        const volcart::filesystem::path& path,
+        size_t n,
+        std::chrono::steady_clock::time_point start)
+    {
+        using Seconds = std::chrono::duration<double>;
+        auto elapsed = Seconds(std::chrono::steady_clock::now() - start);
+        auto mb = static_cast<double>(n * sizeof(T)) / 1e6;
+        auto rate = elapsed.count() > 0 ? mb / elapsed.count() : 0.0;
+        Logger()->debug(
+            "{} {} points ({:.1f} MB) in {:.3f} s ({:.1f} MB/s): {}", op, n,
+            mb, elapsed.count(), rate, path.string());
     }
     /**@}*/
 
     /**@{*/
     /** @brief Write an ASCII PointSet */
     static void WritePointSetAscii(
-        const volcart::filesystem::path& path, PointSet<T> ps)
+        const volcart::filesystem::path& path, const PointSet<T>& ps)
     {
         std::ofstream outfile{path.string()};
         if (!outfile.is_open()) {
@@ -491,7 +552,7 @@ private:
 
     /** @brief Write a binary PointSet */
     static void WritePointSetBinary(
-        const volcart::filesystem::path& path, PointSet<T> ps)
+        const volcart::filesystem::path& path, const PointSet<T>& ps)
     {
         std::ofstream outfile{path.string(), std::ios::binary};
         if (!outfile.is_open()) {
@@ -502,10 +563,11 @@ private:
         auto header = PointSetIO<T>::MakeHeader(ps);
         outfile.write(header.c_str(), header.size());
 
-        for (const auto& p : ps) {
-            auto nbytes = T::channels * sizeof(typename T::value_type);
-            outfile.write(reinterpret_cast<const char*>(p.val), nbytes);
-        }
+        // Write all points at once from contiguous storage
+        auto start = std::chrono::steady_clock::now();
+        outfile.write(
+            reinterpret_cast<const char*>(ps.data()),
+            static_cast<std::streamsize>(ps.size() * sizeof(T)));
 
         outfile.flush();
         outfile.close();
@@ -513,11 +575,12 @@ private:
             auto msg = "failure writing file '" + path.string() + "'";
             throw IOException(msg);
         }
+        LogThroughput("Wrote", path, ps.size(), start);
     }
 
     /** @brief Write an ASCII OrderedPointSet */
     static void WriteOrderedPointSetAscii(
-        const volcart::filesystem::path& path, OrderedPointSet<T> ps)
+        const volcart::filesystem::path& path, const OrderedPointSet<T>& ps)
     {
         std::ofstream outfile{path.string()};
         if (!outfile.is_open()) {
@@ -544,7 +607,7 @@ private:
 
     /** @brief Write a binary OrderedPointSet */
     static void WriteOrderedPointSetBinary(
-        const volcart::filesystem::path& path, OrderedPointSet<T> ps)
+        const volcart::filesystem::path& path, const OrderedPointSet<T>& ps)
     {
         std::ofstream outfile{path.string(), std::ios::binary};
         if (!outfile.is_open()) {
@@ -555,10 +618,11 @@ private:
         auto header = PointSetIO<T>::MakeOrderedHeader(ps);
         outfile.write(header.c_str(), header.size());
 
-        for (const auto& p : ps) {
-            auto nbytes = T::channels * sizeof(typename T::value_type);
-            outfile.write(reinterpret_cast<const char*>(p.val), nbytes);
-        }
+        // Write all points at once from contiguous storage
+        auto start = std::chrono::steady_clock::now();
+        outfile.write(
+            reinterpret_cast<const char*>(ps.data()),
+            static_cast<std::streamsize>(ps.size() * sizeof(T)));
 
         outfile.flush();
         outfile.close();
@@ -566,7 +630,11 @@ private:
             auto msg = "failure writing file '" + path.string() + "'";
             throw IOException(msg);
         }
+        LogThroughput("Wrote", path, ps.size(), start);
     }
     /**@}*/
+
+    /** Number of values converted per block when reading binary files */
+    static constexpr size_t CONVERSION_BLOCK_SIZE{1 << 20};
 };
 }  // namespace volcart
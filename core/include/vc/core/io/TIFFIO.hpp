@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <opencv2/core.hpp>
 
 #include "vc/core/filesystem.hpp"
@@ -47,14 +49,57 @@ enum class Compression {
     JP2000 = 34712
 };
 
+/**
+ * @brief Arrangement of image data within a TIFF file
+ *
+ * By default, images are written as a single strip. Splitting the image into
+ * multiple strips or into tiles lets readers decode a region of the image
+ * without decoding the whole thing.
+ */
+struct Layout {
+    /** Rows per strip. If 0, the image is written as a single strip. */
+    std::uint32_t rowsPerStrip{0};
+    /**
+     * Tile width. If nonzero, the image is written as tiles instead of strips.
+     * Must be a multiple of 16.
+     */
+    std::uint32_t tileWidth{0};
+    /** Tile height. Must be a multiple of 16. */
+    std::uint32_t tileHeight{0};
+};
+
 /**
  * @brief Write a TIFF image to file
  *
  * Supports writing floating point and signed integer TIFFs, in addition to
  * unsigned 8 & 16 bit integer types. Also supports 1-4 channel images.
+ *
+ * Image data is encoded a whole strip or tile at a time.
  */
 void WriteTIFF(
     const volcart::filesystem::path& path,
     const cv::Mat& img,
-    Compression compression = Compression::LZW);
+    Compression compression = Compression::LZW,
+    const Layout& layout = {});
+
+/**
+ * @brief Rewrite part of an existing TIFF image in place
+ *
+ * Re-encodes only the strips or tiles of the file which overlap `roi`, using
+ * the file's existing compression and layout. The rest of the file's image
+ * data is not modified. Only the first page of a multi-page file is updated.
+ *
+ * Rewritten strips or tiles which no longer fit in their original space are
+ * appended to the file, so updating a compressed file may grow it.
+ *
+ * @return false if the file does not exist, cannot be opened, or does not
+ * have the same dimensions, channels, and depth as `img`. The file is not
+ * modified in that case.
+ * @throws std::runtime_error if the image type is not supported or writing
+ * fails
+ */
+auto UpdateTIFF(
+    const volcart::filesystem::path& path,
+    const cv::Mat& img,
+    const cv::Rect& roi) -> bool;
 }  // namespace volcart::tiffio
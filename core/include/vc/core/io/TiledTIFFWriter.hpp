@@ -0,0 +1,171 @@
+#pragma once
+
+/** @file */
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/io/TIFFIO.hpp"
+
+namespace volcart::tiffio
+{
+/**
+ * @class TiledTIFFWriter
+ * @brief Incrementally write a tiled, multi-page BigTIFF file
+ *
+ * Unlike WriteTIFF(), which requires the entire image to be in memory, this
+ * class writes one tile at a time, so images much larger than the available
+ * memory can be written as they are generated. Tiles may be written in any
+ * order and to any page. The page directories are written when the file is
+ * closed. Tiles which were never written are filled with zeros.
+ *
+ * writeTile() may be called from multiple threads at once. Each tile is
+ * compressed on the calling thread, so compression runs in parallel and only
+ * the file write is serialized.
+ *
+ * Files are written in the BigTIFF format, so they are not limited to 4GB.
+ * Only uncompressed and Deflate-compressed output is supported.
+ *
+ * @code
+ * TiledTIFFWriter tif("out.tif", width, height, CV_16UC1);
+ * for (std::uint32_t y = 0; y < height; y += tif.tileHeight()) {
+ *     for (std::uint32_t x = 0; x < width; x += tif.tileWidth()) {
+ *         tif.writeTile(0, x, y, RenderTile(x, y));
+ *     }
+ * }
+ * tif.close();
+ * @endcode
+ *
+ * @ingroup IO
+ */
+class TiledTIFFWriter
+{
+public:
+    /** Default tile edge length */
+    static constexpr std::uint32_t DEFAULT_TILE_SIZE{1024};
+
+    /**
+     * @brief Open a file for writing
+     *
+     * @param path Output file path. Must have a .tif or .tiff extension.
+     * @param width Image width in pixels
+     * @param height Image height in pixels
+     * @param type OpenCV image type (e.g. `CV_16UC1`) of every page
+     * @param numPages Number of pages (images) in the file
+     * @param tileWidth Tile width. Must be a multiple of 16.
+     * @param tileHeight Tile height. Must be a multiple of 16.
+     * @param compression Compression::NONE, Compression::ADOBE_DEFLATE, or
+     * Compression::DEFLATE
+     *
+     * @throws std::runtime_error if the parameters are invalid or the file
+     * cannot be opened
+     */
+    TiledTIFFWriter(
+        const filesystem::path& path,
+        std::uint32_t width,
+        std::uint32_t height,
+        int type,
+        std::size_t numPages = 1,
+        std::uint32_t tileWidth = DEFAULT_TILE_SIZE,
+        std::uint32_t tileHeight = DEFAULT_TILE_SIZE,
+        Compression compression = Compression::ADOBE_DEFLATE);
+
+    /** @brief Closes the file if it has not already been closed */
+    ~TiledTIFFWriter();
+
+    /**@{*/
+    TiledTIFFWriter(const TiledTIFFWriter&) = delete;
+    auto operator=(const TiledTIFFWriter&) -> TiledTIFFWriter& = delete;
+    /**@}*/
+
+    /**@{*/
+    /** @brief Image width */
+    [[nodiscard]] auto width() const -> std::uint32_t;
+    /** @brief Image height */
+    [[nodiscard]] auto height() const -> std::uint32_t;
+    /** @brief OpenCV image type */
+    [[nodiscard]] auto type() const -> int;
+    /** @brief Number of pages */
+    [[nodiscard]] auto numPages() const -> std::size_t;
+    /** @brief Tile width */
+    [[nodiscard]] auto tileWidth() const -> std::uint32_t;
+    /** @brief Tile height */
+    [[nodiscard]] auto tileHeight() const -> std::uint32_t;
+    /**@}*/
+
+    /**
+     * @brief Write the tile whose top-left pixel is (`x`, `y`)
+     *
+     * `x` and `y` must be multiples of the tile width and height. `tile` must
+     * have the writer's image type and be no larger than a tile. Tiles at the
+     * right and bottom edges of the image may be smaller than a full tile and
+     * are padded with zeros. Pixels of `tile` which fall outside of the image
+     * are ignored. Writing the same tile twice replaces the first tile.
+     *
+     * Thread-safe.
+     *
+     * @throws std::runtime_error if the tile is invalid or cannot be written
+     */
+    void writeTile(
+        std::size_t page,
+        std::uint32_t x,
+        std::uint32_t y,
+        const cv::Mat& tile);
+
+    /**
+     * @brief Write the page directories and close the file
+     *
+     * @throws std::runtime_error if the directories cannot be written
+     */
+    void close();
+
+private:
+    /** Encode a tile into the file's pixel layout and compression */
+    [[nodiscard]] auto encode_(const cv::Mat& tile) const
+        -> std::vector<char>;
+    /** Append encoded data to the file and return its offset */
+    auto append_(const std::vector<char>& data) -> std::uint64_t;
+    /**
+     * Write a page directory which links to the directory at `next` and
+     * return its offset
+     */
+    auto write_directory_(std::size_t page, std::uint64_t next)
+        -> std::uint64_t;
+
+    /** Output file */
+    std::ofstream file_;
+    /** Current end of the file */
+    std::uint64_t end_{0};
+    /** Serializes file writes */
+    std::mutex mutex_;
+
+    /** Image width */
+    std::uint32_t width_;
+    /** Image height */
+    std::uint32_t height_;
+    /** OpenCV image type */
+    int type_;
+    /** Number of pages */
+    std::size_t numPages_;
+    /** Tile width */
+    std::uint32_t tileWidth_;
+    /** Tile height */
+    std::uint32_t tileHeight_;
+    /** Compression */
+    Compression compression_;
+    /** Number of tiles across */
+    std::uint32_t tilesAcross_;
+    /** Number of tiles down */
+    std::uint32_t tilesDown_;
+
+    /** Byte offset of each tile, indexed by page then tile */
+    std::vector<std::vector<std::uint64_t>> offsets_;
+    /** Byte count of each tile, indexed by page then tile */
+    std::vector<std::vector<std::uint64_t>> byteCounts_;
+};
+}  // namespace volcart::tiffio
@@ -65,6 +65,9 @@ public:
     /** @overload setSamplingRadius(double, double, double) */
     void setSamplingRadius(const cv::Vec3d& radii) { radius_ = radii; }
 
+    /** @brief Get the sampling search radius for all axes */
+    cv::Vec3d samplingRadius() const { return radius_; }
+
     /**
      * @brief Set the sampling interval: how frequently along the radius (in
      * Volume units) the samples are taken
@@ -73,6 +76,9 @@ public:
      */
     void setSamplingInterval(double i) { interval_ = i; }
 
+    /** @brief Get the sampling interval */
+    double samplingInterval() const { return interval_; }
+
     /**
      * @brief Set the filtering search direction
      *
@@ -80,12 +86,18 @@ public:
      */
     void setSamplingDirection(Direction d) { direction_ = d; }
 
+    /** @brief Get the filtering search direction */
+    Direction samplingDirection() const { return direction_; }
+
     /**
      * @brief Enable/Disable auto-generation of missing axes
      *
      * Derived classes are not guaranteed to make use of this functionality
      */
     void setAutoGenAxes(bool b) { autoGenAxes_ = b; }
+
+    /** @brief Get whether missing axes are auto-generated */
+    bool autoGenAxes() const { return autoGenAxes_; }
     /**@}*/
 
     /**@{*/
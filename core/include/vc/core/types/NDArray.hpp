@@ -179,7 +179,10 @@ public:
     typename Container::value_type* data() { return data_.data(); }
 
     /** @overload data() */
-    typename Container::value_type* data() const { return data_.data(); }
+    const typename Container::value_type* data() const
+    {
+        return data_.data();
+    }
 
     /**
      * @brief Return an iterator that points to the first element in the array
@@ -138,6 +138,26 @@ public:
             std::begin(points), std::end(points), std::back_inserter(data_));
     }
 
+    /**
+     * @brief Replace the contents of the OrderedPointSet with rows of points
+     *
+     * The container is moved into the OrderedPointSet without copying. This
+     * allows the point storage to be sized and filled in place (e.g. by bulk
+     * file reads) rather than row-by-row with pushRow().
+     *
+     * @throws std::logic_error If the size of `points` is not a multiple of
+     * `width`.
+     */
+    void adopt(size_t width, typename BaseClass::Container&& points)
+    {
+        if (width == 0 ? not points.empty() : points.size() % width != 0) {
+            auto msg = "Number of points is not a multiple of the width";
+            throw std::logic_error(msg);
+        }
+        width_ = width;
+        data_ = std::move(points);
+    }
+
     // Cannot add individual points to this class because it would break
     // width constraint calculation
     void push_back(const T& val) = delete;
@@ -176,6 +176,16 @@ public:
      * Uses hasMapping() to determine which pixels in the PPM are valid.
      */
     [[nodiscard]] auto getMappings() const -> std::vector<PixelMap>;
+
+    /**
+     * @brief Get a copy of a rectangular region of the map
+     *
+     * The mask and cell map, if set, are cropped to the same region.
+     *
+     * @throws std::invalid_argument if the region is empty or not contained
+     * in the map
+     */
+    [[nodiscard]] auto crop(const cv::Rect& region) const -> PerPixelMap;
     /**@}*/
 
     /**@{*/
@@ -92,6 +92,12 @@ public:
     /** @brief Get the PointSet storage container */
     Container as_vector() { return data_; }
 
+    /** @brief Get a pointer to the contiguous Point storage */
+    T* data() { return data_.data(); }
+
+    /** @copydoc data() */
+    const T* data() const { return data_.data(); }
+
     /** @brief Remove all elements from the PointSet */
     void clear() { data_.clear(); }
     /**@}*/
@@ -110,6 +116,13 @@ public:
         data_.emplace_back(std::forward<Args>(args)...);
     }
 
+    /**
+     * @brief Replace the contents of the PointSet with a container of Points
+     *
+     * The container is moved into the PointSet without copying.
+     */
+    void adopt(Container&& points) { data_ = std::move(points); }
+
     /** @brief Append a PointSet to the end of the current one */
     template <class ContainerType>
     void append(const ContainerType& c)
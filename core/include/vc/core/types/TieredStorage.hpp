@@ -0,0 +1,172 @@
+#pragma once
+
+/** @file */
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "vc/core/filesystem.hpp"
+
+namespace volcart
+{
+/**
+ * @class TieredStorage
+ * @brief Resolves files to the fastest storage root which holds a copy
+ *
+ * A TieredStorage maps files below a canonical root directory onto an ordered
+ * list of storage roots, fastest first, which mirror all or part of the
+ * canonical root's file tree. The canonical root is always the last (slowest)
+ * tier. The first time a file is resolved, the tiers are probed in order and
+ * the location of the first copy is cached, so later resolves do not touch
+ * the filesystem.
+ *
+ * If a promotion budget is set, files which have been resolved at least
+ * `threshold` times are copied to the fastest tier by a background thread,
+ * until the total size of the promoted files reaches the budget. Promoted
+ * files are recorded in a manifest in the fastest tier, so the budget holds
+ * across sessions.
+ *
+ * Storage roots other than the fastest tier are treated as read-only
+ * mirrors. The fastest tier holds the promoted copies and the manifest, so it
+ * must be writable if promotion is enabled. When a file in the canonical root
+ * is rewritten, invalidate() must be called to remove its promoted copy.
+ * Because the mirrors may still hold the old file, an invalidated file is
+ * resolved to the canonical root until it is promoted again.
+ *
+ * @ingroup Types
+ */
+class TieredStorage
+{
+public:
+    /** Shared pointer type */
+    using Pointer = std::shared_ptr<TieredStorage>;
+
+    /** Name of the promotion manifest in the fastest tier */
+    static constexpr const char* MANIFEST_NAME{".vc_promoted.json"};
+
+    /** Default number of loads before a file is promoted */
+    static constexpr std::size_t DEFAULT_THRESHOLD{2};
+
+    /**@{*/
+    /**
+     * @brief Constructor
+     *
+     * @param root Canonical root directory
+     * @param tiers Storage roots which mirror `root`, fastest first
+     */
+    TieredStorage(
+        filesystem::path root, std::vector<filesystem::path> tiers);
+
+    /** @copydoc TieredStorage(filesystem::path, std::vector<filesystem::path>)
+     */
+    static auto New(filesystem::path root, std::vector<filesystem::path> tiers)
+        -> Pointer;
+
+    /** @brief Destructor. Waits for the running promotion. */
+    ~TieredStorage();
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Get the path of the fastest copy of a file
+     *
+     * `path` must be below the canonical root, otherwise it is returned
+     * unchanged. Counts as a load of the file for promotion.
+     */
+    auto resolve(const filesystem::path& path) -> filesystem::path;
+
+    /**
+     * @brief Resolve a file to the canonical root and remove its promoted copy
+     *
+     * Call after rewriting the file in the canonical root. Copies of the file
+     * in the other tiers are ignored from then on, since they may be stale.
+     */
+    void invalidate(const filesystem::path& path);
+
+    /** @brief Get the storage roots, fastest first */
+    [[nodiscard]] auto tiers() const -> std::vector<filesystem::path>;
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Set the maximum total size of the promoted files in bytes
+     *
+     * Promotion is disabled if `bytes` is 0. Default: 0
+     */
+    void setPromotionBudget(std::size_t bytes);
+
+    /** @brief Set the number of loads before a file is promoted */
+    void setPromotionThreshold(std::size_t loads);
+
+    /** @brief Get the total size of the promoted files in bytes */
+    [[nodiscard]] auto promotedBytes() const -> std::size_t;
+
+    /** @brief Block until the queued promotions are finished */
+    void waitForPromotions();
+    /**@}*/
+
+private:
+    /** Location index entry */
+    struct Location {
+        /** Tier which holds the fastest copy */
+        std::size_t tier{0};
+        /** Number of loads */
+        std::size_t loads{0};
+    };
+
+    /** Path relative to the canonical root, or empty if not below it */
+    auto relative_(const filesystem::path& path) const -> filesystem::path;
+    /** Find the fastest tier which holds a file */
+    auto probe_(const filesystem::path& rel) const -> std::size_t;
+    /** Promotion thread loop */
+    void run_();
+    /** Copy a file to the fastest tier. Returns the size of the copy. */
+    auto promote_(
+        const filesystem::path& src, const filesystem::path& rel)
+        -> std::size_t;
+    /** Read the promotion manifest */
+    void load_manifest_();
+    /** Write the promotion manifest. Requires the lock. */
+    void save_manifest_() const;
+
+    /** Canonical root */
+    filesystem::path root_;
+    /** Storage roots, fastest first, ending with the canonical root */
+    std::vector<filesystem::path> tiers_;
+
+    /** Protects all of the following members */
+    mutable std::mutex mutex_;
+    /** Signals queued promotions and shutdown to the promotion thread */
+    std::condition_variable cv_;
+    /** Signals finished promotions */
+    std::condition_variable idle_;
+    /** Location index, keyed by path relative to the canonical root */
+    std::unordered_map<std::string, Location> index_;
+    /** Promoted files and their sizes */
+    std::unordered_map<std::string, std::size_t> promoted_;
+    /** Total size of the promoted files */
+    std::size_t promotedBytes_{0};
+    /** Promotion budget */
+    std::size_t budget_{0};
+    /** Promotion threshold */
+    std::size_t threshold_{DEFAULT_THRESHOLD};
+    /** Queued promotions */
+    std::deque<std::string> queue_;
+    /** Queued or running promotions */
+    std::unordered_set<std::string> pending_;
+    /** Pending promotions which were invalidated */
+    std::unordered_set<std::string> discard_;
+    /** Promotion thread, started with the first promotion */
+    std::thread worker_;
+    /** Shut down the promotion thread */
+    bool stop_{false};
+};
+}  // namespace volcart
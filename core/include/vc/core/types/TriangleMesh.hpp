@@ -0,0 +1,222 @@
+#pragma once
+
+/** @file */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/UVMap.hpp"
+
+namespace volcart
+{
+
+/**
+ * @class TriangleMesh
+ * @brief Triangle mesh stored in flat, contiguous arrays
+ *
+ * Vertex positions, vertex normals, and vertex UV coordinates are each stored
+ * in their own contiguous array indexed by vertex ID. Faces are stored in a
+ * single index buffer of three vertex IDs per face. Unlike ITKMesh, no
+ * per-vertex or per-face objects are allocated, so algorithms which visit
+ * every vertex or face of a large mesh do not pay for pointer chasing.
+ *
+ * Normals and UV coordinates are optional. If present, there is exactly one
+ * normal and/or UV coordinate per vertex. UV coordinates are relative to the
+ * top-left corner of the texture image, like the default volcart::UVMap.
+ *
+ * Use ToITKMesh() and FromITKMesh() to convert to and from ITKMesh, and
+ * VertexFaceAdjacency to look up the faces which share a vertex.
+ *
+ * @ingroup Types
+ */
+class TriangleMesh
+{
+public:
+    /** Pointer type */
+    using Pointer = std::shared_ptr<TriangleMesh>;
+    /** Vertex and face index type */
+    using Index = std::uint32_t;
+    /** Vertex position type */
+    using Vertex = cv::Vec3d;
+    /** Vertex normal type */
+    using Normal = cv::Vec3d;
+    /** Vertex UV coordinate type */
+    using UV = cv::Vec2d;
+    /** Face type: The IDs of the face's three vertices */
+    using Face = std::array<Index, 3>;
+
+    /**@{*/
+    /** @brief Default constructor */
+    TriangleMesh() = default;
+
+    /** Static New function for all constructors of T */
+    template <typename... Args>
+    static auto New(Args... args) -> Pointer
+    {
+        return std::make_shared<TriangleMesh>(std::forward<Args>(args)...);
+    }
+    /**@}*/
+
+    /**@{*/
+    /** @brief Get the number of vertices */
+    [[nodiscard]] auto numVertices() const -> std::size_t;
+
+    /** @brief Get the number of faces */
+    [[nodiscard]] auto numFaces() const -> std::size_t;
+
+    /** @brief Returns true if the mesh has no vertices */
+    [[nodiscard]] auto empty() const -> bool;
+
+    /** @brief Returns true if the mesh has one normal per vertex */
+    [[nodiscard]] auto hasNormals() const -> bool;
+
+    /** @brief Returns true if the mesh has one UV coordinate per vertex */
+    [[nodiscard]] auto hasUVs() const -> bool;
+    /**@}*/
+
+    /**@{*/
+    /** @brief Reserve storage for vertices and faces */
+    void reserve(std::size_t numVertices, std::size_t numFaces);
+
+    /** @brief Remove all vertices, normals, UVs, and faces */
+    void clear();
+
+    /** @brief Add a vertex and return its ID */
+    auto addVertex(const Vertex& v) -> Index;
+
+    /** @brief Add a face and return its ID */
+    auto addFace(Index a, Index b, Index c) -> Index;
+    /**@}*/
+
+    /**@{*/
+    /** @brief Vertex positions, indexed by vertex ID */
+    auto vertices() -> std::vector<Vertex>&;
+
+    /** @copydoc vertices() */
+    [[nodiscard]] auto vertices() const -> const std::vector<Vertex>&;
+
+    /**
+     * @brief Vertex normals, indexed by vertex ID
+     *
+     * Empty if the mesh does not have normals.
+     */
+    auto normals() -> std::vector<Normal>&;
+
+    /** @copydoc normals() */
+    [[nodiscard]] auto normals() const -> const std::vector<Normal>&;
+
+    /**
+     * @brief Vertex UV coordinates, indexed by vertex ID
+     *
+     * Empty if the mesh does not have UV coordinates.
+     */
+    auto uvs() -> std::vector<UV>&;
+
+    /** @copydoc uvs() */
+    [[nodiscard]] auto uvs() const -> const std::vector<UV>&;
+
+    /** @brief Faces, indexed by face ID */
+    auto faces() -> std::vector<Face>&;
+
+    /** @copydoc faces() */
+    [[nodiscard]] auto faces() const -> const std::vector<Face>&;
+    /**@}*/
+
+private:
+    /** Vertex positions */
+    std::vector<Vertex> vertices_;
+    /** Vertex normals */
+    std::vector<Normal> normals_;
+    /** Vertex UV coordinates */
+    std::vector<UV> uvs_;
+    /** Face index buffer */
+    std::vector<Face> faces_;
+};
+
+/**
+ * @brief Vertex-to-face adjacency for a TriangleMesh
+ *
+ * Stores the faces incident to each vertex in compressed sparse row (CSR)
+ * form: the IDs of the faces incident to vertex `v` are stored contiguously in
+ * the range [`begin(v)`, `end(v)`). The adjacency is a snapshot of the mesh's
+ * faces at construction and is not updated if the mesh's faces are modified.
+ *
+ * @code
+ * VertexFaceAdjacency adj(mesh);
+ * for (auto f = adj.begin(v); f != adj.end(v); f++) {
+ *     const auto& face = mesh.faces()[*f];
+ * }
+ * @endcode
+ *
+ * @ingroup Types
+ */
+class VertexFaceAdjacency
+{
+public:
+    /** @brief Default constructor */
+    VertexFaceAdjacency() = default;
+
+    /** @brief Build the adjacency for a mesh */
+    explicit VertexFaceAdjacency(const TriangleMesh& mesh);
+
+    /** @brief Get the number of vertices */
+    [[nodiscard]] auto numVertices() const -> std::size_t;
+
+    /** @brief Get the number of faces incident to a vertex */
+    [[nodiscard]] auto size(TriangleMesh::Index v) const -> std::size_t;
+
+    /** @brief Pointer to the first face incident to a vertex */
+    [[nodiscard]] auto begin(TriangleMesh::Index v) const
+        -> const TriangleMesh::Index*;
+
+    /** @brief Pointer past the last face incident to a vertex */
+    [[nodiscard]] auto end(TriangleMesh::Index v) const
+        -> const TriangleMesh::Index*;
+
+private:
+    /** Start of each vertex's face list. Has numVertices() + 1 entries. */
+    std::vector<std::size_t> offsets_;
+    /** Concatenated face lists */
+    std::vector<TriangleMesh::Index> faces_;
+};
+
+/**
+ * @brief Convert a TriangleMesh to an ITKMesh
+ *
+ * Copies vertices, vertex normals (if present), and faces. ITK point and cell
+ * containers cannot adopt external buffers, so this is always a copy.
+ */
+auto ToITKMesh(const TriangleMesh& mesh) -> ITKMesh::Pointer;
+
+/**
+ * @brief Convert an ITKMesh to a TriangleMesh
+ *
+ * Copies vertices, vertex normals (if every vertex has one), and faces.
+ * Vertices are stored in the order of the ITKMesh's points container. Point
+ * IDs which are not contiguous are remapped to vertex indices, and face
+ * indices are translated accordingly. If `uvMap` is provided, the mesh's UV
+ * coordinates are filled from the UV map's entries for each point ID.
+ * Vertices without a mapping are assigned NULL_MAPPING.
+ *
+ * @throws std::invalid_argument if the ITKMesh contains a non-triangular
+ * face or a face which references a missing point
+ */
+auto FromITKMesh(
+    const ITKMesh::Pointer& mesh, const UVMap::Pointer& uvMap = nullptr)
+    -> TriangleMesh::Pointer;
+
+/**
+ * @brief Create a UVMap from a TriangleMesh's UV coordinates
+ *
+ * Returns an empty UVMap if the mesh does not have UV coordinates.
+ */
+auto ToUVMap(const TriangleMesh& mesh) -> UVMap::Pointer;
+
+}  // namespace volcart
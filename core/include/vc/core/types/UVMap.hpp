@@ -2,8 +2,10 @@
 
 /** @file */
 
+#include <cstddef>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
@@ -40,6 +42,12 @@ const static cv::Vec2d NULL_MAPPING{-1, -1};
  * set(size_t, const cv::Vec2d&) and get(size_t) functions, the source and
  * target origins are set using the constructor or setOrigin().
  *
+ * Mappings are stored in a contiguous array indexed by point ID, with a
+ * validity bitmap to track which IDs have been set. Lookups are constant time,
+ * and the bulk functions (setAll(), getAll(), Rotate(), Flip()) make a single
+ * pass over contiguous memory. Storage grows to the largest ID which has been
+ * set, so sparse maps with very large IDs should be avoided.
+ *
  * Since UV maps store \em relative position information, they are agnostic to
  * size of the texture space to which they apply. The ratio functions provide
  * a way to store the dimensions and aspect ratio of the texture space for
@@ -82,6 +90,17 @@ public:
 
     /** @brief Return whether the UVMap is empty */
     [[nodiscard]] auto empty() const -> bool;
+
+    /**
+     * @brief Return one greater than the largest point ID which may have a
+     * mapping
+     *
+     * Equal to size() if every ID in the range `[0, size())` has a mapping.
+     */
+    [[nodiscard]] auto idBound() const -> std::size_t;
+
+    /** @brief Reserve storage for point IDs in the range `[0, n)` */
+    void reserve(std::size_t n);
     /**@}*/
 
     /**@{*/
@@ -128,7 +147,42 @@ public:
     /** @brief Check if the vertex index has a UV mapping */
     [[nodiscard]] auto contains(std::size_t id) const -> bool;
 
-    /** Access to underlying data. For serialization only. */
+    /**
+     * @brief Replace all mappings with a dense list of UV values
+     *
+     * The UV value for point ID `i` is `uvs[i]`. Points are inserted relative
+     * to the provided origin.
+     */
+    void setAll(const std::vector<cv::Vec2d>& uvs, const Origin& o);
+
+    /**
+     * @copybrief setAll()
+     *
+     * Points are inserted relative to the origin returned by origin().
+     */
+    void setAll(const std::vector<cv::Vec2d>& uvs);
+
+    /**
+     * @brief Get a dense list of all UV values
+     *
+     * Returns a list of idBound() UV values indexed by point ID. IDs without a
+     * mapping are set to NULL_MAPPING. Points are retrieved relative to the
+     * provided origin.
+     */
+    [[nodiscard]] auto getAll(const Origin& o) const -> std::vector<cv::Vec2d>;
+
+    /**
+     * @copybrief getAll()
+     *
+     * Points are retrieved relative to the origin returned by origin().
+     */
+    [[nodiscard]] auto getAll() const -> std::vector<cv::Vec2d>;
+
+    /**
+     * @brief Copy of the underlying data, relative to the top-left origin
+     *
+     * @deprecated Constructs a std::map of every mapping. Prefer getAll().
+     */
     [[nodiscard]] auto as_map() const -> std::map<size_t, cv::Vec2d>;
     /**@}*/
 
@@ -205,8 +259,12 @@ public:
     /**@}*/
 
 private:
-    /** UV storage */
-    std::map<size_t, cv::Vec2d> map_;
+    /** UV storage, relative to the top-left origin. Indexed by point ID. */
+    std::vector<cv::Vec2d> uvs_;
+    /** Validity bitmap. Indexed by point ID. */
+    std::vector<bool> valid_;
+    /** Number of valid mappings */
+    std::size_t size_{0};
     /** Origin for set and get functions */
     Origin origin_{Origin::TopLeft};
     /** Aspect ratio */
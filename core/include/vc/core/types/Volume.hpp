@@ -10,6 +10,7 @@
 #include "vc/core/types/DiskBasedObjectBaseClass.hpp"
 #include "vc/core/types/LRUCache.hpp"
 #include "vc/core/types/Reslice.hpp"
+#include "vc/core/types/TieredStorage.hpp"
 
 namespace volcart
 {
@@ -211,6 +212,19 @@ public:
     void cachePurge() const;
     /**@}*/
 
+    /**@{*/
+    /**
+     * @brief Set the tiered storage which slices are loaded from
+     *
+     * If set, each slice is loaded from the fastest storage root which holds
+     * a copy of it. Otherwise, slices are loaded from the Volume directory.
+     */
+    void setStorage(TieredStorage::Pointer s) { storage_ = std::move(s); }
+
+    /** @brief Get the tiered storage */
+    TieredStorage::Pointer storage() const { return storage_; }
+    /**@}*/
+
 protected:
     /** Slice width */
     int width_{0};
@@ -235,6 +249,7 @@ protected:
     cv::Mat cache_slice_(int index) const;
     /** Shared mutex for thread-safe access */
     mutable std::shared_mutex cache_mutex_;
-    mutable std::shared_mutex print_mutex_;
+    /** Tiered slice storage */
+    TieredStorage::Pointer storage_;
 };
 }  // namespace volcart
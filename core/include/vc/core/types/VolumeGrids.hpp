@@ -11,6 +11,7 @@
 #include "vc/core/types/Volume.hpp"
 #include "vc/core/types/LRUCache.hpp"
 #include "vc/core/types/Reslice.hpp"
+#include "vc/core/types/TieredStorage.hpp"
 
 namespace volcart
 {
@@ -212,6 +213,19 @@ public:
     void cachePurge() const;
     /**@}*/
 
+    /**@{*/
+    /**
+     * @brief Set the tiered storage which slices are loaded from
+     *
+     * If set, each slice is loaded from the fastest storage root which holds
+     * a copy of it. Otherwise, slices are loaded from the VolumeGrids directory.
+     */
+    void setStorage(TieredStorage::Pointer s) { storage_ = std::move(s); }
+
+    /** @brief Get the tiered storage */
+    TieredStorage::Pointer storage() const { return storage_; }
+    /**@}*/
+
 protected:
     /** Slice width */
     int width_{0};
@@ -236,6 +250,7 @@ protected:
     cv::Mat cache_slice_(int index) const;
     /** Shared mutex for thread-safe access */
     mutable std::shared_mutex cache_mutex_;
-    mutable std::shared_mutex print_mutex_;
+    /** Tiered slice storage */
+    TieredStorage::Pointer storage_;
 };
 }  // namespace volcart
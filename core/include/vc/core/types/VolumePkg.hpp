@@ -2,13 +2,16 @@
 
 /** @file */
 
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <mutex>
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/types/Metadata.hpp"
 #include "vc/core/types/Render.hpp"
 #include "vc/core/types/Segmentation.hpp"
+#include "vc/core/types/TieredStorage.hpp"
 #include "vc/core/types/Volume.hpp"
 #include "vc/core/types/VolumePkgVersion.hpp"
 
@@ -21,7 +24,23 @@ namespace volcart
  *
  * Provides access to volume, segmentation, and rendering data stored on disk.
  *
- * @warning VolumePkg is not thread safe.
+ * Opening a VolumePkg only lists the IDs and names of its Volumes,
+ * Segmentations, and Renders. Each object is loaded from disk the first time
+ * it is accessed. The IDs and names are cached in an index file in the root of
+ * the VolumePkg, which is refreshed from the modification times of the objects'
+ * metadata files whenever the VolumePkg is opened.
+ *
+ * Slice data can be spread over several storage roots which mirror the
+ * VolumePkg's file tree. If the VolumePkg config lists these roots, fastest
+ * first, in the `storage_tiers` key, Volumes load each slice from the fastest
+ * root which holds a copy of it. If `storage_promotion_budget` is set to a
+ * memory size string (e.g. `"100GB"`), frequently loaded slices are copied to
+ * the fastest root in the background, up to the given total size. The number
+ * of loads before a slice is copied is set by `storage_promotion_threshold`.
+ * See volcart::TieredStorage.
+ *
+ * @warning VolumePkg is not thread safe. Only the lazy loading of objects is
+ * synchronized.
  *
  * @ingroup Types
  * @ingroup VolumePackage
@@ -242,6 +261,17 @@ public:
     /**@}*/
 
 private:
+    /** Object listed in the VolumePkg, loaded on first access */
+    template <class T>
+    struct Entry {
+        /** Path to the object */
+        filesystem::path path;
+        /** Cached name of the object */
+        std::string name;
+        /** The object, if it has been loaded */
+        mutable typename T::Pointer ptr;
+    };
+
     /** VolumePkg metadata */
     Metadata config_;
     /** The root directory of the VolumePkg */
@@ -253,11 +283,29 @@ private:
     /** The subdirectory containing Render data */
     filesystem::path rendDir_;
     /** The list of all Volumes in the VolumePkg. */
-    std::map<Volume::Identifier, Volume::Pointer> volumes_;
+    std::map<Volume::Identifier, Entry<Volume>> volumes_;
     /** The list of all Segmentations in the VolumePkg. */
-    std::map<Segmentation::Identifier, Segmentation::Pointer> segmentations_;
+    std::map<Segmentation::Identifier, Entry<Segmentation>> segmentations_;
     /** The list of all Renders in the VolumePkg. */
-    std::map<Render::Identifier, Render::Pointer> renders_;
+    std::map<Render::Identifier, Entry<Render>> renders_;
+    /** Tiered slice storage shared by the Volumes, if configured */
+    TieredStorage::Pointer storage_;
+    /** Synchronizes loading objects on first access */
+    mutable std::mutex loadMutex_;
+
+    /**
+     * @brief Lists the objects in the VolumePkg
+     *
+     * Objects whose metadata files have not changed since the index was last
+     * written are listed from the index. All other objects have their metadata
+     * read from disk. The index is rewritten if it has changed. Failing to
+     * write the index is not an error.
+     */
+    void scan_();
+
+    /** @brief Gets an object, loading it if needed */
+    template <class T>
+    auto load_(const Entry<T>& entry) const -> typename T::Pointer;
 
     /**
      * @brief Populates an empty VolumePkg::config from a volcart::Dictionary
@@ -17,6 +17,10 @@ namespace volcart
  * and values \f$\geq\f$ max will be mapped to the last bin. If invert is true,
  * the bin mapping will be reversed.
  *
+ * Large images are mapped in parallel bands of rows. For 8-bit and large
+ * 16-bit images, the LUT entry for every possible input value is computed
+ * once and pixels are mapped with a table lookup.
+ *
  * @ingroup Util
  */
 cv::Mat ApplyLUT(
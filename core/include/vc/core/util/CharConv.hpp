@@ -0,0 +1,138 @@
+#pragma once
+
+/** @file */
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+namespace volcart
+{
+
+/** @brief Returns true if `c` is a space or tab */
+constexpr auto IsBlank(char c) -> bool { return c == ' ' or c == '\t'; }
+
+/** @brief Returns true if `c` is a line ending character */
+constexpr auto IsLineEnd(char c) -> bool { return c == '\n' or c == '\r'; }
+
+/** @brief Advance `first` past any spaces and tabs */
+inline auto SkipBlanks(const char* first, const char* last) -> const char*
+{
+    while (first != last and IsBlank(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+/** @brief Advance `first` to the next space, tab, or line ending */
+inline auto SkipToken(const char* first, const char* last) -> const char*
+{
+    while (first != last and not IsBlank(*first) and not IsLineEnd(*first)) {
+        ++first;
+    }
+    return first;
+}
+
+/** @brief Advance `first` to the start of the next line */
+inline auto SkipLine(const char* first, const char* last) -> const char*
+{
+    while (first != last and *first != '\n') {
+        ++first;
+    }
+    return (first == last) ? last : first + 1;
+}
+
+/**
+ * @brief Parse a number from a character range without allocating
+ *
+ * Leading spaces and tabs are skipped. On success, `val` is set, `first` is
+ * advanced past the parsed characters, and this function returns `true`.
+ * On failure, `first` and `val` are unchanged.
+ *
+ * Floating-point values are parsed with the same correctly-rounded results as
+ * `std::stod`, so meshes parsed with this function are bit-identical to those
+ * parsed by the string-based readers.
+ */
+template <typename T>
+auto ParseNumber(const char*& first, const char* last, T& val) -> bool
+{
+    static_assert(std::is_arithmetic_v<T>, "T must be arithmetic");
+    auto p = SkipBlanks(first, last);
+    // from_chars does not accept a leading plus sign
+    if (p != last and *p == '+') {
+        ++p;
+    }
+
+    if constexpr (std::is_integral_v<T>) {
+        auto [end, ec] = std::from_chars(p, last, val);
+        if (ec != std::errc()) {
+            return false;
+        }
+        first = end;
+        return true;
+    } else {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto [end, ec] = std::from_chars(p, last, val);
+        if (ec != std::errc()) {
+            return false;
+        }
+        first = end;
+        return true;
+#else
+        // Fallback for standard libraries without floating-point from_chars
+        constexpr std::size_t MAX_LEN{64};
+        char buf[MAX_LEN + 1];
+        auto end = SkipToken(p, last);
+        auto len = static_cast<std::size_t>(end - p);
+        if (len == 0 or len > MAX_LEN) {
+            return false;
+        }
+        std::copy(p, end, buf);
+        buf[len] = '\0';
+        char* parsedEnd{nullptr};
+        auto v = std::strtod(buf, &parsedEnd);
+        if (parsedEnd == buf) {
+            return false;
+        }
+        val = static_cast<T>(v);
+        first = p + (parsedEnd - buf);
+        return true;
+#endif
+    }
+}
+
+/**
+ * @brief Append a number to a string buffer without allocating temporaries
+ *
+ * Integers are written in full. Floating-point values are written like
+ * `std::ostream::operator<<` with the default stream precision (`%g` with 6
+ * significant digits), so files written with this function are identical to
+ * those written with iostreams.
+ */
+template <typename T>
+void AppendNumber(std::string& buffer, T val)
+{
+    static_assert(std::is_arithmetic_v<T>, "T must be arithmetic");
+    constexpr std::size_t MAX_LEN{32};
+    char buf[MAX_LEN];
+    if constexpr (std::is_integral_v<T>) {
+        auto res = std::to_chars(buf, buf + MAX_LEN, val);
+        buffer.append(buf, res.ptr);
+    } else {
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto res = std::to_chars(
+            buf, buf + MAX_LEN, static_cast<double>(val),
+            std::chars_format::general, 6);
+        buffer.append(buf, res.ptr);
+#else
+        auto len = std::snprintf(buf, MAX_LEN, "%g", static_cast<double>(val));
+        buffer.append(buf, static_cast<std::size_t>(len));
+#endif
+    }
+}
+
+}  // namespace volcart
@@ -2,6 +2,10 @@
 
 /** @file */
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
 
@@ -19,11 +23,51 @@ auto DepthToString(int depth) -> std::string;
  * will be scaled to the range of the output depth. For floating-point images,
  * the default input range is assumed to be [0,1].
  *
+ * Large images are converted in parallel bands of rows. The result is
+ * identical to a single call to cv::Mat::convertTo.
+ *
  * @ingroup Util
  */
 auto QuantizeImage(
     const cv::Mat& m, int depth = CV_16U, bool scaleMinMax = true) -> cv::Mat;
 
+/** @brief Lookup table from 16-bit to 8-bit intensities */
+using LUT16U = std::array<std::uint8_t, 65536>;
+
+/**
+ * @brief Build a LUT which maps the 16-bit window [`low`, `high`] onto the
+ * full 8-bit range
+ *
+ * Values outside of the window are clamped. Each bin of the output range
+ * covers an equal number of input values, and values are rounded as by
+ * cv::saturate_cast.
+ *
+ * @throws std::invalid_argument if `low >= high`
+ *
+ * @ingroup Util
+ */
+auto WindowLUT16U(std::uint16_t low, std::uint16_t high) -> LUT16U;
+
+/**
+ * @brief Map a 16-bit, single-channel image to 8-bit with a lookup table
+ *
+ * `out` is reallocated as CV_8UC1 if it does not already have the size and
+ * type of the result. A Mat which wraps an external buffer of the correct
+ * size (e.g. a QImage) is written in place.
+ *
+ * Large images are processed in parallel bands of rows. If `numThreads` is 0,
+ * DefaultThreadCount() threads are used.
+ *
+ * @throws std::invalid_argument if `in` is not CV_16UC1
+ *
+ * @ingroup Util
+ */
+void ApplyLUT16U(
+    const cv::Mat& in,
+    const LUT16U& lut,
+    cv::Mat& out,
+    std::size_t numThreads = 0);
+
 /**
  * @brief Convert image to specified number of channels
  *
@@ -0,0 +1,147 @@
+#pragma once
+
+/** @file */
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace volcart
+{
+
+/**
+ * @brief Get the default number of threads used by parallel algorithms
+ *
+ * Returns the number of hardware threads, or 1 if that cannot be determined.
+ *
+ * @ingroup Util
+ */
+inline auto DefaultThreadCount() -> std::size_t
+{
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+/**
+ * @brief Call `fn(i)` for every `i` in [0, `n`) using a pool of threads
+ *
+ * Indices are handed out to the worker threads `grain` at a time in increasing
+ * order, so work is balanced even when the cost per index varies. Each index
+ * is processed exactly once, but the order of completion is unspecified.
+ *
+ * If `numThreads` is 0, DefaultThreadCount() threads are used. If only one
+ * thread is needed, `fn` is called on the calling thread.
+ *
+ * If any call to `fn` throws, unstarted indices are skipped and the first
+ * exception is rethrown on the calling thread once all workers have stopped.
+ *
+ * @code
+ * std::vector<double> out(in.size());
+ * ParallelFor(in.size(), [&](auto i) { out[i] = std::sqrt(in[i]); });
+ * @endcode
+ *
+ * @ingroup Util
+ */
+template <typename Fn>
+void ParallelFor(
+    std::size_t n, Fn&& fn, std::size_t numThreads = 0, std::size_t grain = 1)
+{
+    if (n == 0) {
+        return;
+    }
+    grain = std::max<std::size_t>(grain, 1);
+    if (numThreads == 0) {
+        numThreads = DefaultThreadCount();
+    }
+    numThreads = std::min(numThreads, (n + grain - 1) / grain);
+
+    // Serial
+    if (numThreads <= 1) {
+        for (std::size_t i = 0; i < n; i++) {
+            fn(i);
+        }
+        return;
+    }
+
+    // Parallel
+    std::atomic<std::size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        while (not failed) {
+            auto begin = next.fetch_add(grain);
+            if (begin >= n) {
+                return;
+            }
+            auto end = std::min(begin + grain, n);
+            try {
+                for (auto i = begin; i < end; i++) {
+                    fn(i);
+                }
+            } catch (...) {
+                std::unique_lock<std::mutex> lock(errorMutex);
+                if (not error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (std::size_t t = 1; t < numThreads; t++) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * @brief Call `fn(begin, end)` for consecutive blocks of [0, `n`) using a pool
+ * of threads
+ *
+ * [0, `n`) is split into blocks of `blockSize` indices. The last block also
+ * takes any remaining indices, so every block has at least `blockSize`
+ * indices unless `n` itself is smaller. Blocks are scheduled as in
+ * ParallelFor().
+ *
+ * @code
+ * // Process the rows of an image in bands of at least 64 rows
+ * ParallelForBlocks(img.rows, 64, [&](auto begin, auto end) {
+ *     ProcessRows(img.rowRange(begin, end));
+ * });
+ * @endcode
+ *
+ * @ingroup Util
+ */
+template <typename Fn>
+void ParallelForBlocks(
+    std::size_t n, std::size_t blockSize, Fn&& fn, std::size_t numThreads = 0)
+{
+    if (n == 0) {
+        return;
+    }
+    blockSize = std::max<std::size_t>(blockSize, 1);
+    auto numBlocks = std::max<std::size_t>(n / blockSize, 1);
+    ParallelFor(
+        numBlocks,
+        [&](std::size_t b) {
+            auto begin = b * blockSize;
+            auto end = (b + 1 == numBlocks) ? n : begin + blockSize;
+            fn(begin, end);
+        },
+        numThreads);
+}
+
+}  // namespace volcart
@@ -0,0 +1,186 @@
+#pragma once
+
+/**
+ * @file Trace.hpp
+ *
+ * @ingroup Util
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include "vc/core/filesystem.hpp"
+
+/**
+ * @namespace volcart::trace
+ * @brief Low-overhead tracing of spans and counters
+ *
+ * Spans record the wall time and thread of a scope. Counters accumulate
+ * totals such as cache hits or bytes read. Both are only recorded while
+ * tracing is enabled. Otherwise, they cost a single relaxed atomic load.
+ * Recorded spans and counters can be exported as a Chrome trace, which can
+ * be opened with `chrome://tracing` or https://ui.perfetto.dev.
+ *
+ * @code{.cpp}
+ * static trace::Counter BYTES_READ{"MyReader.bytesRead"};
+ *
+ * void Read()
+ * {
+ *     trace::Span span("MyReader::Read", "io");
+ *     ...
+ *     BYTES_READ.add(n);
+ * }
+ * @endcode
+ */
+namespace volcart
+{
+namespace trace
+{
+namespace detail
+{
+/** Global tracing flag */
+extern std::atomic<bool> ENABLED;
+}  // namespace detail
+
+/** @brief Enable or disable tracing. Default: disabled */
+void SetEnabled(bool b);
+
+/** @brief Return whether tracing is enabled */
+inline auto Enabled() -> bool
+{
+    return detail::ENABLED.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Records the wall time of a scope
+ *
+ * The span is recorded when it is destroyed, with the ID of the thread which
+ * created it. Spans created while tracing is disabled are not recorded.
+ */
+class Span
+{
+public:
+    /** @brief Start a span. `category` must be a string literal. */
+    explicit Span(const char* name, const char* category = "vc");
+
+    /** @copydoc Span(const char*, const char*) */
+    explicit Span(std::string name, const char* category = "vc");
+
+    /** @brief End the span and record it */
+    ~Span();
+
+    /**@{*/
+    /** Not copyable */
+    Span(const Span&) = delete;
+    auto operator=(const Span&) -> Span& = delete;
+    /**@}*/
+
+private:
+    /** Clock type */
+    using Clock = std::chrono::steady_clock;
+    /** Whether the span is recorded */
+    bool active_{false};
+    /** Span name */
+    std::string name_;
+    /** Span category */
+    const char* category_{nullptr};
+    /** Start time */
+    Clock::time_point start_;
+};
+
+/**
+ * @brief Named, process-wide counter
+ *
+ * Counters must outlive any call to WriteChromeTrace() or Summary(), so they
+ * should have static storage duration.
+ */
+class Counter
+{
+public:
+    /** @brief Construct and register a counter */
+    explicit Counter(std::string name);
+
+    /** @brief Unregister the counter */
+    ~Counter();
+
+    /**@{*/
+    /** Not copyable */
+    Counter(const Counter&) = delete;
+    auto operator=(const Counter&) -> Counter& = delete;
+    /**@}*/
+
+    /** @brief Add to the counter if tracing is enabled */
+    void add(std::int64_t n = 1)
+    {
+        if (Enabled()) {
+            value_.fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Get the counter's name */
+    [[nodiscard]] auto name() const -> const std::string& { return name_; }
+
+    /** @brief Get the counter's value */
+    [[nodiscard]] auto value() const -> std::int64_t
+    {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+    /** @brief Reset the counter to zero */
+    void reset() { value_.store(0, std::memory_order_relaxed); }
+
+private:
+    /** Counter name */
+    std::string name_;
+    /** Counter value */
+    std::atomic<std::int64_t> value_{0};
+};
+
+/**
+ * @brief Write the recorded spans and counters as a Chrome trace
+ *
+ * @throws std::runtime_error If the file cannot be written
+ */
+void WriteChromeTrace(const filesystem::path& path);
+
+/**
+ * @brief Get a human-readable summary of the recorded spans and counters
+ *
+ * Spans are grouped by name and listed with their count, and their total and
+ * mean wall times.
+ */
+auto Summary() -> std::string;
+
+/** @brief Clear the recorded spans and reset all counters */
+void Clear();
+
+/**
+ * @brief Enables tracing for the lifetime of the object
+ *
+ * When destroyed, writes the Chrome trace to the given path and logs the
+ * summary. Write failures are logged, not thrown.
+ */
+class Session
+{
+public:
+    /** @brief Clear previous traces and enable tracing */
+    explicit Session(filesystem::path path);
+
+    /** @brief Disable tracing and write the trace */
+    ~Session();
+
+    /**@{*/
+    /** Not copyable */
+    Session(const Session&) = delete;
+    auto operator=(const Session&) -> Session& = delete;
+    /**@}*/
+
+private:
+    /** Output path */
+    filesystem::path path_;
+};
+
+}  // namespace trace
+}  // namespace volcart
@@ -25,5 +25,12 @@ void init_Reslice(py::module& m)
         "Convert a 2D Reslice coordinate into its 3D Volume coordinate");
 
     /** Image */
-    c.def("data", &vc::Reslice::sliceData, "Get the Reslice image data");
+    c.def(
+        "data",
+        [](const vc::Reslice& r) {
+            // Shares the Reslice's image, which must not be modified
+            return vc::python::ReadOnlyArray(r.sliceData());
+        },
+        "Get a read-only view of the Reslice image data. Use numpy.array() "
+        "to get a writable copy.");
 }
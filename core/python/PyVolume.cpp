@@ -1,13 +1,40 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 
 #include "vc/core/neighborhood/CuboidGenerator.hpp"
 #include "vc/core/types/Volume.hpp"
+#include "vc/core/util/Parallel.hpp"
 #include "vc/python/PyCVMatCaster.hpp"
 #include "vc/python/PyCVVecCaster.hpp"
 
 namespace py = pybind11;
 namespace vc = volcart;
 
+// Input arrays are converted to contiguous doubles, copying only if needed
+using DoubleArray =
+    py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// Number of points sampled by a thread at a time
+static constexpr std::size_t POINTS_GRAIN{1024};
+
+// Move a neighborhood into a NumPy array which owns it
+static auto ToArray(vc::Neighborhood&& n) -> py::array_t<std::uint16_t>
+{
+    auto* owner = new vc::Neighborhood(std::move(n));
+    py::capsule base(
+        owner, [](void* p) { delete static_cast<vc::Neighborhood*>(p); });
+    auto extents = owner->extents();
+    return py::array_t<std::uint16_t>(
+        std::vector<ssize_t>{extents.begin(), extents.end()}, owner->data(),
+        base);
+}
+
 void init_Volume(py::module& m);
 
 void init_Volume(py::module& m)
@@ -52,8 +79,50 @@ void init_Volume(py::module& m)
 
     /** Slice Data */
     c.def(
-        "slice", &vc::Volume::getSliceData, py::arg("z"),
-        "Get a slice image by index");
+        "slice",
+        [](const vc::Volume& v, int z) {
+            cv::Mat slice;
+            {
+                py::gil_scoped_release release;
+                slice = v.getSliceData(z);
+            }
+            // Shares the cached slice, which must not be modified
+            return vc::python::ReadOnlyArray(slice);
+        },
+        py::arg("z"),
+        "Get a slice image by index. The returned array is a read-only view "
+        "of the cached slice. Use numpy.array() to get a writable copy.");
+    c.def(
+        "sliceRange",
+        [](const vc::Volume& v, int start, int stop, std::size_t threads) {
+            if (start < 0 or stop > v.numSlices() or start >= stop) {
+                throw std::invalid_argument("Invalid slice range");
+            }
+            auto num = static_cast<std::size_t>(stop - start);
+            auto h = static_cast<std::size_t>(v.sliceHeight());
+            auto w = static_cast<std::size_t>(v.sliceWidth());
+            py::array_t<std::uint16_t> output({num, h, w});
+            auto* out = output.mutable_data();
+            {
+                py::gil_scoped_release release;
+                vc::ParallelFor(
+                    num,
+                    [&](auto i) {
+                        auto z = start + static_cast<int>(i);
+                        auto slice = v.getSliceData(z);
+                        cv::Mat dst(
+                            static_cast<int>(h), static_cast<int>(w), CV_16UC1,
+                            out + i * h * w);
+                        slice.copyTo(dst);
+                    },
+                    threads);
+            }
+            return output;
+        },
+        py::arg("start"), py::arg("stop"), py::arg("threads") = 0,
+        "Load the slices in [start, stop) into a (slices, height, width) "
+        "array. Slices are loaded in parallel without holding the GIL. If "
+        "threads is 0, the number of hardware threads is used.");
 
     /** Voxel Data */
     c.def(
@@ -67,6 +136,33 @@ void init_Volume(py::module& m)
             &vc::Volume::interpolateAt, py::const_),
         "Get the interpolated intensity at a subvoxel position",
         py::arg_v("pos", "(x, y, z)"));
+    c.def(
+        "interpolate",
+        [](const vc::Volume& v, const DoubleArray& points,
+           std::size_t threads) {
+            if (points.ndim() != 2 or points.shape(1) != 3) {
+                throw std::invalid_argument("points must have shape (N, 3)");
+            }
+            auto num = static_cast<std::size_t>(points.shape(0));
+            py::array_t<std::uint16_t> output(static_cast<ssize_t>(num));
+            const auto* pts = points.data();
+            auto* out = output.mutable_data();
+            {
+                py::gil_scoped_release release;
+                vc::ParallelFor(
+                    num,
+                    [&](auto i) {
+                        const auto* p = pts + 3 * i;
+                        out[i] = v.interpolateAt(p[0], p[1], p[2]);
+                    },
+                    threads, POINTS_GRAIN);
+            }
+            return output;
+        },
+        py::arg("points"), py::arg("threads") = 0,
+        "Get the interpolated intensities at an (N, 3) array of subvoxel "
+        "positions. Points are sampled in parallel without holding the GIL. "
+        "If threads is 0, the number of hardware threads is used.");
 
     /** Reslices and Subvolumes */
     c.def(
@@ -88,16 +184,7 @@ void init_Volume(py::module& m)
             subvolume.setSamplingRadius(rx, ry, rz);
             auto s = subvolume.compute(
                 v.shared_from_this(), center, {xvec, yvec, zvec});
-            auto buf = s.as_vector();
-            size_t size = sizeof(uint16_t);
-            std::string format = py::format_descriptor<uint16_t>::format();
-            auto extents = s.extents();
-            std::vector<size_t> strides{
-                size * extents[1] * extents[0], size * extents[0], size};
-            return py::array(py::buffer_info{
-                                 buf.data(), static_cast<ssize_t>(size), format,
-                                 3, extents, strides})
-                .release();
+            return ToArray(std::move(s));
         },
         // clang-format off
         py::arg_v("center", "(x, y, z)"),
@@ -109,4 +196,57 @@ void init_Volume(py::module& m)
         py::arg_v("z_vec", cv::Vec3d{0, 0, 1}, "(0, 0, 1)"),
         "Generate an arbitrarily-oriented subvolume");
     // clang-format on
+
+    c.def(
+        "subvolumes",
+        [](vc::Volume& v, const DoubleArray& centers, const DoubleArray& bases,
+           cv::Vec3d radii, std::size_t threads) {
+            if (centers.ndim() != 2 or centers.shape(1) != 3) {
+                throw std::invalid_argument("centers must have shape (N, 3)");
+            }
+            if (bases.ndim() != 3 or bases.shape(0) != centers.shape(0) or
+                bases.shape(1) != 3 or bases.shape(2) != 3) {
+                throw std::invalid_argument("bases must have shape (N, 3, 3)");
+            }
+
+            vc::CuboidGenerator gen;
+            gen.setSamplingRadius(radii);
+            auto extents = gen.extents();
+            auto num = static_cast<std::size_t>(centers.shape(0));
+            std::vector<ssize_t> shape{static_cast<ssize_t>(num)};
+            shape.insert(shape.end(), extents.begin(), extents.end());
+            py::array_t<std::uint16_t> output(shape);
+            if (num == 0) {
+                return output;
+            }
+            auto size = static_cast<std::size_t>(output.size()) / num;
+            const auto* c = centers.data();
+            const auto* b = bases.data();
+            auto* out = output.mutable_data();
+            auto vol = v.shared_from_this();
+            {
+                py::gil_scoped_release release;
+                vc::ParallelFor(
+                    num,
+                    [&](auto i) {
+                        const auto* p = c + 3 * i;
+                        const auto* a = b + 9 * i;
+                        auto s = gen.compute(
+                            vol, {p[0], p[1], p[2]},
+                            {{a[0], a[1], a[2]},
+                             {a[3], a[4], a[5]},
+                             {a[6], a[7], a[8]}});
+                        std::copy(s.data(), s.data() + size, out + i * size);
+                    },
+                    threads);
+            }
+            return output;
+        },
+        py::arg("centers"), py::arg("bases"), py::arg_v("radii", "(x, y, z)"),
+        py::arg("threads") = 0,
+        "Generate an arbitrarily-oriented subvolume at each of an (N, 3) "
+        "array of centers. bases is an (N, 3, 3) array which holds the x, y, "
+        "and z vectors of each subvolume. The subvolumes are returned as a "
+        "single (N, ...) array and are sampled in parallel without holding "
+        "the GIL. If threads is 0, the number of hardware threads is used.");
 }
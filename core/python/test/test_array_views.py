@@ -0,0 +1,115 @@
+import json
+import struct
+import tempfile
+import unittest
+from pathlib import Path
+
+import numpy as np
+
+from volcart import Core
+
+WIDTH = 8
+HEIGHT = 6
+SLICES = 4
+
+
+def write_tiff(path, image):
+    """Write a single-channel, uncompressed, 16-bit TIFF"""
+    height, width = image.shape
+    data = image.astype('<u2').tobytes()
+
+    # (tag, type, count, value). Type 3 is SHORT and type 4 is LONG.
+    entries = [
+        (256, 4, 1, width),
+        (257, 4, 1, height),
+        (258, 3, 1, 16),
+        (259, 3, 1, 1),
+        (262, 3, 1, 1),
+        (273, 4, 1, 0),
+        (277, 3, 1, 1),
+        (278, 4, 1, height),
+        (279, 4, 1, len(data)),
+    ]
+    ifd_size = 2 + 12 * len(entries) + 4
+    data_offset = 8 + ifd_size
+    entries[5] = (273, 4, 1, data_offset)
+
+    ifd = struct.pack('<H', len(entries))
+    for tag, typ, count, value in entries:
+        if typ == 3:
+            ifd += struct.pack('<HHIHH', tag, typ, count, value, 0)
+        else:
+            ifd += struct.pack('<HHII', tag, typ, count, value)
+    ifd += struct.pack('<I', 0)
+    with open(path, 'wb') as f:
+        f.write(b'II*\x00' + struct.pack('<I', 8) + ifd + data)
+
+
+class ArrayViewsTest(unittest.TestCase):
+    """Arrays which view shared C++ state are read-only"""
+
+    def setUp(self):
+        self.tmp = tempfile.TemporaryDirectory()
+        path = Path(self.tmp.name)
+        meta = {
+            'uuid': 'test',
+            'name': 'test',
+            'type': 'vol',
+            'width': WIDTH,
+            'height': HEIGHT,
+            'slices': SLICES,
+            'voxelsize': 1.0,
+            'min': 0.0,
+            'max': 65535.0,
+        }
+        with open(path / 'meta.json', 'w') as f:
+            json.dump(meta, f)
+        self.slices = []
+        for z in range(SLICES):
+            image = np.arange(WIDTH * HEIGHT, dtype=np.uint16)
+            image = image.reshape(HEIGHT, WIDTH) + 100 * z
+            write_tiff(path / f'{z}.tif', image)
+            self.slices.append(image)
+        self.volume = Core.Volume(str(path))
+
+    def tearDown(self):
+        self.tmp.cleanup()
+
+    def test_slice_is_read_only(self):
+        view = self.volume.slice(1)
+        np.testing.assert_array_equal(view, self.slices[1])
+        self.assertFalse(view.flags.writeable)
+        with self.assertRaises(ValueError):
+            view[0, 0] = 1
+
+        # Copies are writable and do not modify the cached slice
+        copy = np.array(view)
+        copy[0, 0] = 1
+        np.testing.assert_array_equal(self.volume.slice(1), self.slices[1])
+
+    def test_reslice_data_aliases_reslice(self):
+        reslice = self.volume.reslice((3, 2, 1), width=4, height=4)
+        first = reslice.data()
+        second = reslice.data()
+
+        # Both arrays view the memory owned by the Reslice
+        self.assertTrue(np.shares_memory(first, second))
+        self.assertFalse(first.flags.writeable)
+        with self.assertRaises(ValueError):
+            first[0, 0] = 1
+
+        # Writing to a copy does not change the Reslice
+        expected = np.array(first)
+        copy = np.array(first)
+        copy += 1
+        np.testing.assert_array_equal(reslice.data(), expected)
+
+    def test_view_outlives_owner(self):
+        view = self.volume.reslice((3, 2, 1), width=4, height=4).data()
+        expected = np.array(view)
+        del self.volume
+        np.testing.assert_array_equal(view, expected)
+
+
+if __name__ == '__main__':
+    unittest.main()
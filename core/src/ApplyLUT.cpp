@@ -1,9 +1,17 @@
 #include "vc/core/util/ApplyLUT.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
 #include <opencv2/imgproc.hpp>
 
 #include "vc/core/util/ImageConversion.hpp"
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Parallel.hpp"
 
 using namespace volcart;
 namespace vc = volcart;
@@ -31,10 +39,15 @@ static int ValueToBin(float value, float min, float max, int bins)
     return static_cast<int>(bin);
 }
 
-cv::Mat vc::ApplyLUT(
-    const cv::Mat& img, const cv::Mat& lut, float min, float max, bool invert)
+// Minimum number of pixels in a band of rows processed by one task
+static constexpr std::size_t MIN_BAND_PIXELS{1 << 16};
+
+// Minimum number of 16-bit pixels for which a full value table is built
+static constexpr std::size_t MIN_TABLE_PIXELS{1 << 16};
+
+// Throw if the LUT is not a (1, bins) gray or RGB 8bpc image
+static void ValidateLUT(const cv::Mat& lut)
 {
-    // Validate the LUT
     if (lut.depth() != CV_8U) {
         throw std::invalid_argument("LUT must be 8bpc");
     }
@@ -44,40 +57,102 @@ cv::Mat vc::ApplyLUT(
     if (lut.channels() != 1 and lut.channels() != 3) {
         throw std::invalid_argument("LUT must be gray/RGB");
     }
+}
 
-    // Convert input img to 32FC1
-    cv::Mat gray;
-    if (img.channels() != 1) {
-        gray = ColorConvertImage(img);
-    } else {
-        gray = img.clone();
+// Map every pixel of a single-channel image through binOf into the LUT.
+// Integer inputs with a small range are mapped with a table of the LUT color
+// for every possible input value, which is computed with the same binOf and
+// so gives identical results.
+template <typename In, typename Out, typename BinFn>
+static void MapPixels(
+    const cv::Mat& img, const cv::Mat& lut, BinFn binOf, cv::Mat& output)
+{
+    const auto* colors = lut.ptr<Out>(0);
+    std::vector<Out> table;
+    if constexpr (std::is_integral_v<In>) {
+        if (sizeof(In) == 1 or img.total() >= MIN_TABLE_PIXELS) {
+            table.resize(std::size_t{std::numeric_limits<In>::max()} + 1);
+            for (std::size_t v = 0; v < table.size(); v++) {
+                table[v] = colors[binOf(static_cast<float>(v))];
+            }
+        }
     }
-    gray.convertTo(gray, CV_32F);
-
-    // Construct output image
-    cv::Mat output = cv::Mat::zeros(gray.rows, gray.cols, lut.type());
 
-    // Iterate over pixels
-    for (const auto& [y, x] : range2D(gray.rows, gray.cols)) {
-        auto val = gray.at<float>(y, x);
-        auto bin = ValueToBin(val, min, max, lut.cols);
-
-        // Invert bin assignment values
-        if (invert) {
-            bin = lut.cols - 1 - bin;
+    auto rows = static_cast<std::size_t>(img.rows);
+    auto cols = static_cast<std::size_t>(std::max(img.cols, 1));
+    auto bandRows = std::max<std::size_t>(MIN_BAND_PIXELS / cols, 1);
+    ParallelForBlocks(rows, bandRows, [&](auto begin, auto end) {
+        for (auto y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+            const auto* in = img.ptr<In>(y);
+            auto* out = output.ptr<Out>(y);
+            if (not table.empty()) {
+                for (int x = 0; x < img.cols; x++) {
+                    out[x] = table[in[x]];
+                }
+            } else {
+                for (int x = 0; x < img.cols; x++) {
+                    out[x] = colors[binOf(static_cast<float>(in[x]))];
+                }
+            }
         }
+    });
+}
+
+// Apply a LUT using binOf to assign each (float) pixel value to a bin
+template <typename BinFn>
+static auto ApplyLUTImpl(const cv::Mat& img, const cv::Mat& lut, BinFn binOf)
+    -> cv::Mat
+{
+    ValidateLUT(lut);
+
+    // Convert input img to single channel. 8U and 16U images are converted to
+    // float per pixel. Everything else is converted to 32F up front.
+    cv::Mat gray = img.channels() != 1 ? ColorConvertImage(img) : img;
+    if (gray.depth() != CV_8U and gray.depth() != CV_16U and
+        gray.depth() != CV_32F) {
+        gray.convertTo(gray, CV_32F);
+    }
 
-        // Assign to image
+    // Construct output image. Every pixel is assigned below.
+    cv::Mat output(gray.rows, gray.cols, lut.type());
+    auto apply = [&](auto in) {
+        using In = decltype(in);
         if (lut.channels() == 1) {
-            output.at<uint8_t>(y, x) = lut.at<uint8_t>(0, bin);
-        } else if (lut.channels() == 3) {
-            output.at<cv::Vec3b>(y, x) = lut.at<cv::Vec3b>(0, bin);
+            MapPixels<In, std::uint8_t>(gray, lut, binOf, output);
+        } else {
+            MapPixels<In, cv::Vec3b>(gray, lut, binOf, output);
         }
+    };
+    switch (gray.depth()) {
+        case CV_8U:
+            apply(std::uint8_t{});
+            break;
+        case CV_16U:
+            apply(std::uint16_t{});
+            break;
+        default:
+            apply(float{});
+            break;
     }
 
     return output;
 }
 
+cv::Mat vc::ApplyLUT(
+    const cv::Mat& img, const cv::Mat& lut, float min, float max, bool invert)
+{
+    auto bins = lut.cols;
+    return ApplyLUTImpl(img, lut, [=](float val) {
+        auto bin = ValueToBin(val, min, max, bins);
+
+        // Invert bin assignment values
+        if (invert) {
+            bin = bins - 1 - bin;
+        }
+        return bin;
+    });
+}
+
 cv::Mat vc::ApplyLUT(
     const cv::Mat& img,
     const cv::Mat& lut,
@@ -86,58 +161,26 @@ cv::Mat vc::ApplyLUT(
     float max,
     bool invert)
 {
-    // Validate the LUT
-    if (lut.depth() != CV_8U) {
-        throw std::invalid_argument("LUT must be 8bpc");
-    }
-    if (lut.rows != 1) {
-        throw std::invalid_argument("LUT must have shape (1, bins)");
-    }
-    if (lut.channels() != 1 and lut.channels() != 3) {
-        throw std::invalid_argument("LUT must be gray/RGB");
-    }
-
-    // Convert input img to 32FC1
-    cv::Mat gray;
-    if (img.channels() != 1) {
-        gray = ColorConvertImage(img);
-    } else {
-        gray = img.clone();
-    }
-    gray.convertTo(gray, CV_32F);
-
-    // Construct output image
-    cv::Mat output = cv::Mat::zeros(gray.rows, gray.cols, lut.type());
-
     // Mid point bin
-    auto midBin = static_cast<int>(std::round(lut.cols / 2));
+    auto bins = lut.cols;
+    auto midBin = static_cast<int>(std::round(bins / 2));
 
-    // Iterate over pixels
-    for (const auto& [y, x] : range2D(gray.rows, gray.cols)) {
-        auto val = gray.at<float>(y, x);
+    return ApplyLUTImpl(img, lut, [=](float val) {
         int bin{0};
         if (val == mid) {
             bin = midBin;
         } else if (val < mid) {
             bin = ValueToBin(val, min, mid, midBin);
         } else {
-            bin = ValueToBin(val, mid, max, lut.cols - midBin) + midBin;
+            bin = ValueToBin(val, mid, max, bins - midBin) + midBin;
         }
 
         // Invert bin assignment values
         if (invert) {
-            bin = lut.cols - 1 - bin;
+            bin = bins - 1 - bin;
         }
-
-        // Assign to image
-        if (lut.channels() == 1) {
-            output.at<uint8_t>(y, x) = lut.at<uint8_t>(0, bin);
-        } else if (lut.channels() == 3) {
-            output.at<cv::Vec3b>(y, x) = lut.at<cv::Vec3b>(0, bin);
-        }
-    }
-
-    return output;
+        return bin;
+    });
 }
 
 cv::Mat vc::ApplyLUT(
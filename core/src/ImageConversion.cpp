@@ -1,7 +1,22 @@
 #include "vc/core/util/ImageConversion.hpp"
 
+#include <algorithm>
+#include <stdexcept>
+
+#include "vc/core/util/Parallel.hpp"
+
 namespace vc = volcart;
 
+// Minimum number of pixels in a band of rows processed by one task
+static constexpr std::size_t MIN_BAND_PIXELS{1 << 16};
+
+// Number of rows in a band which has at least MIN_BAND_PIXELS pixels
+static inline auto BandRows(const cv::Mat& m) -> std::size_t
+{
+    auto cols = static_cast<std::size_t>(std::max(m.cols, 1));
+    return std::max<std::size_t>(MIN_BAND_PIXELS / cols, 1);
+}
+
 static inline auto CreateAlphaChannel(const cv::Size& size, int depth)
     -> cv::Mat
 {
@@ -56,9 +71,6 @@ auto vc::QuantizeImage(const cv::Mat& m, int depth, bool scaleMinMax) -> cv::Mat
         return m;
     }
 
-    // Copy to output
-    auto output = m.clone();
-
     // Setup the max value for integer images
     double outputMax{1.0};
     switch (depth) {
@@ -83,7 +95,7 @@ auto vc::QuantizeImage(const cv::Mat& m, int depth, bool scaleMinMax) -> cv::Mat
     double min{0};
     double max{1};
     if (scaleMinMax) {
-        cv::minMaxLoc(output, &min, &max);
+        cv::minMaxLoc(m, &min, &max);
     } else {
         switch (m.depth()) {
             case CV_8U:
@@ -103,12 +115,59 @@ auto vc::QuantizeImage(const cv::Mat& m, int depth, bool scaleMinMax) -> cv::Mat
                 break;
         }
     }
-    output.convertTo(
-        output, depth, outputMax / (max - min), -min * outputMax / (max - min));
+    auto alpha = outputMax / (max - min);
+    auto beta = -min * outputMax / (max - min);
+
+    // Convert bands of rows in parallel. Every band is converted with the
+    // same vectorized kernel as the whole image, so the output is identical.
+    cv::Mat output(m.size(), CV_MAKETYPE(depth, m.channels()));
+    auto rows = static_cast<std::size_t>(m.rows);
+    vc::ParallelForBlocks(rows, BandRows(m), [&](auto begin, auto end) {
+        auto b = static_cast<int>(begin);
+        auto e = static_cast<int>(end);
+        cv::Mat band = output.rowRange(b, e);
+        m.rowRange(b, e).convertTo(band, depth, alpha, beta);
+    });
 
     return output;
 }
 
+auto vc::WindowLUT16U(std::uint16_t low, std::uint16_t high) -> LUT16U
+{
+    if (low >= high) {
+        throw std::invalid_argument("Window low must be less than high");
+    }
+
+    LUT16U lut;
+    auto scale = 256.0 / (static_cast<double>(high) - low + 1.0);
+    for (std::size_t v = 0; v < lut.size(); v++) {
+        lut[v] = cv::saturate_cast<std::uint8_t>(
+            (static_cast<double>(v) - low) * scale);
+    }
+    return lut;
+}
+
+void vc::ApplyLUT16U(
+    const cv::Mat& in, const LUT16U& lut, cv::Mat& out, std::size_t numThreads)
+{
+    if (in.type() != CV_16UC1) {
+        throw std::invalid_argument("Input image must be CV_16UC1");
+    }
+
+    out.create(in.size(), CV_8UC1);
+    auto rows = static_cast<std::size_t>(in.rows);
+    auto fn = [&](std::size_t begin, std::size_t end) {
+        for (auto y = static_cast<int>(begin); y < static_cast<int>(end); y++) {
+            const auto* i = in.ptr<std::uint16_t>(y);
+            auto* o = out.ptr<std::uint8_t>(y);
+            for (int x = 0; x < in.cols; x++) {
+                o[x] = lut[i[x]];
+            }
+        }
+    };
+    vc::ParallelForBlocks(rows, BandRows(in), fn, numThreads);
+}
+
 auto vc::ColorConvertImage(const cv::Mat& m, int channels) -> cv::Mat
 {
     // Make sure we have work to do
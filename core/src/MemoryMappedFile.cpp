@@ -0,0 +1,78 @@
+#include "vc/core/io/MemoryMappedFile.hpp"
+
+#include <fstream>
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || \
+    (defined(__APPLE__) && defined(__MACH__))
+#define VC_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "vc/core/types/Exceptions.hpp"
+
+using namespace volcart;
+using namespace volcart::io;
+
+namespace fs = volcart::filesystem;
+
+MemoryMappedFile::MemoryMappedFile(const fs::path& path)
+{
+#if defined(VC_HAS_MMAP)
+    auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        auto msg = "Failed to open file for reading: " + path.string();
+        throw IOException(msg);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        auto msg = "Failed to stat file: " + path.string();
+        throw IOException(msg);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    // mmap of a zero-length file fails, so only map non-empty files
+    if (size_ > 0) {
+        auto* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED) {
+            // We read front-to-back, so let the kernel read ahead aggressively
+            ::madvise(addr, size_, MADV_SEQUENTIAL);
+            data_ = static_cast<const char*>(addr);
+            mapped_ = true;
+        }
+    }
+    ::close(fd);
+    if (mapped_ or size_ == 0) {
+        return;
+    }
+#endif
+
+    // Fallback: bulk read into memory
+    std::ifstream ifs(path.string(), std::ios::binary | std::ios::ate);
+    if (not ifs.is_open()) {
+        auto msg = "Failed to open file for reading: " + path.string();
+        throw IOException(msg);
+    }
+    size_ = static_cast<std::size_t>(ifs.tellg());
+    buffer_.resize(size_);
+    ifs.seekg(0);
+    ifs.read(buffer_.data(), static_cast<std::streamsize>(size_));
+    if (not ifs) {
+        auto msg = "Failed to read file: " + path.string();
+        throw IOException(msg);
+    }
+    data_ = buffer_.data();
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+#if defined(VC_HAS_MMAP)
+    if (mapped_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+#endif
+}
@@ -41,6 +41,28 @@ auto volcart::ReadMesh(const filesystem::path& path) -> MeshReaderResult
     return result;
 }
 
+auto volcart::ReadTriangleMesh(const filesystem::path& path)
+    -> TriangleMesh::Pointer
+{
+    // OBJs
+    if (IsFileType(path, {"obj"})) {
+        OBJReader r;
+        r.setPath(path);
+        return r.readTriangleMesh();
+    }
+
+    // PLYs
+    if (IsFileType(path, {"ply"})) {
+        PLYReader r;
+        r.setPath(path);
+        return r.readTriangleMesh();
+    }
+
+    // Can't load file
+    auto msg = "Mesh file not of supported type: " + path.string();
+    throw std::invalid_argument(msg);
+}
+
 void volcart::WriteMesh(
     const filesystem::path& path,
     const ITKMesh::Pointer& mesh,
@@ -64,7 +86,32 @@ void volcart::WriteMesh(
         PLYWriter writer;
         writer.setPath(path);
         writer.setMesh(mesh);
+        writer.setBinary(opts.binaryPLY);
         // TODO: Add texture writing support back
         writer.write();
     }
 }
+
+void volcart::WriteMesh(
+    const filesystem::path& path,
+    const TriangleMesh::Pointer& mesh,
+    const cv::Mat& texture,
+    const MeshWriterOpts& opts)
+{
+    if (IsFileType(path, {"obj"})) {
+        OBJWriter writer;
+        writer.setPath(path);
+        writer.setMesh(mesh);
+        writer.setTextureFormat(opts.imgFmt);
+        writer.setTexture(texture);
+        writer.write();
+    }
+
+    else if (IsFileType(path, {"ply"})) {
+        PLYWriter writer;
+        writer.setPath(path);
+        writer.setMesh(mesh);
+        writer.setBinary(opts.binaryPLY);
+        writer.write();
+    }
+}
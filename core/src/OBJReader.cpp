@@ -1,10 +1,17 @@
 #include "vc/core/io/OBJReader.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
 #include <regex>
 #include <string>
+#include <string_view>
+#include <thread>
 
 #include "vc/core/io/ImageIO.hpp"
+#include "vc/core/io/MemoryMappedFile.hpp"
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/String.hpp"
 
@@ -16,9 +23,23 @@ namespace fs = volcart::filesystem;
 // Constant for validating face values
 constexpr static int NOT_PRESENT = -1;
 constexpr static size_t VALID_FACE_SIZE = 3;
+// Minimum number of bytes parsed by each thread
+constexpr static std::size_t MIN_CHUNK_BYTES = 4 << 20;
+
+// Convert a 1-indexed OBJ reference to a 0-indexed ID, checking its range
+static auto CheckedIndex(int ref, std::size_t size, const char* msg)
+    -> std::size_t
+{
+    if (ref - 1 < 0 or ref - 1 >= static_cast<int>(size)) {
+        throw IOException(msg);
+    }
+    return static_cast<std::size_t>(ref - 1);
+}
 
 void OBJReader::setPath(const filesystem::path& p) { path_ = p; }
 
+void OBJReader::setNumThreads(std::size_t n) { numThreads_ = n; }
+
 auto OBJReader::getMesh() -> ITKMesh::Pointer { return mesh_; }
 
 auto OBJReader::getUVMap() -> UVMap::Pointer { return uvMap_; }
@@ -32,9 +53,24 @@ auto OBJReader::read() -> ITKMesh::Pointer
     reset_();
     parse_();
     build_mesh_();
+    load_texture_();
+
+    // If we have a UV map and a texture image, set the dimensions on the UVMap
+    if (not uvMap_->empty() and not textureMat_.empty()) {
+        uvMap_->ratio(textureMat_.cols, textureMat_.rows);
+    }
     return mesh_;
 }
 
+auto OBJReader::readTriangleMesh() -> TriangleMesh::Pointer
+{
+    reset_();
+    parse_();
+    auto mesh = build_triangle_mesh_();
+    load_texture_();
+    return mesh;
+}
+
 // Prepare all data structures to read a new file
 void OBJReader::reset_()
 {
@@ -42,6 +78,7 @@ void OBJReader::reset_()
     normals_.clear();
     uvs_.clear();
     faces_.clear();
+    hasNonTriFace_ = false;
     texturePath_.clear();
     textureMat_ = cv::Mat();
 }
@@ -49,124 +86,206 @@ void OBJReader::reset_()
 // Parse the file
 void OBJReader::parse_()
 {
-    std::regex vertex{"^v"};
-    std::regex normal{"^vn"};
-    std::regex tcoord{"^vt"};
-    std::regex face{"^f"};
-    std::regex mtllib("^mtllib");
+    MemoryMappedFile file(path_);
 
-    std::ifstream ifs(path_.string());
-    if (!ifs.good()) {
-        // error msg with path
-        auto msg = "Failed to open file for reading: " + path_.string();
-        throw IOException(msg);
+    // Split the file into line-aligned chunks
+    auto numThreads = numThreads_;
+    if (numThreads == 0) {
+        numThreads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    numThreads = std::max<std::size_t>(
+        1, std::min(numThreads, file.size() / MIN_CHUNK_BYTES));
+
+    std::vector<const char*> bounds{file.begin()};
+    for (std::size_t i = 1; i < numThreads; i++) {
+        auto p = file.begin() + i * file.size() / numThreads;
+        p = std::max(p, bounds.back());
+        bounds.push_back(SkipLine(p, file.end()));
+    }
+    bounds.push_back(file.end());
+
+    // Parse the chunks
+    std::vector<Chunk> chunks(numThreads);
+    if (numThreads == 1) {
+        parse_chunk_(file.begin(), file.end(), chunks[0]);
+    } else {
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < numThreads; i++) {
+            threads.emplace_back(
+                &OBJReader::parse_chunk_, bounds[i], bounds[i + 1],
+                std::ref(chunks[i]));
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
     }
 
-    std::string line;
-    std::vector<std::string> strs;
-    while (std::getline(ifs, line)) {
-        // Parse the line
-        trim(line);
-        strs = split(line, ' ');
-        std::for_each(
-            std::begin(strs), std::end(strs), [](auto& s) { trim(s); });
-        if (strs.empty()) {
-            continue;
+    // Merge the chunks in file order
+    std::string mtllib;
+    std::size_t nV{0};
+    std::size_t nN{0};
+    std::size_t nUV{0};
+    std::size_t nF{0};
+    for (const auto& c : chunks) {
+        if (not c.error.empty()) {
+            throw IOException(c.error);
+        }
+        nV += c.vertices.size();
+        nN += c.normals.size();
+        nUV += c.uvs.size();
+        nF += c.faces.size();
+    }
+    vertices_.reserve(nV);
+    normals_.reserve(nN);
+    uvs_.reserve(nUV);
+    faces_.reserve(nF);
+    for (auto& c : chunks) {
+        vertices_.insert(
+            vertices_.end(), c.vertices.begin(), c.vertices.end());
+        normals_.insert(normals_.end(), c.normals.begin(), c.normals.end());
+        uvs_.insert(uvs_.end(), c.uvs.begin(), c.uvs.end());
+        faces_.insert(faces_.end(), c.faces.begin(), c.faces.end());
+        hasNonTriFace_ |= c.hasNonTriFace;
+        if (not c.mtllib.empty()) {
+            mtllib = c.mtllib;
+        }
+        c = Chunk();
+    }
+
+    // Handle mtllib
+    if (not mtllib.empty()) {
+        parse_mtllib_(mtllib);
+    }
+}
+
+void OBJReader::parse_chunk_(const char* first, const char* last, Chunk& c)
+{
+    // Parse a fixed number of numbers from the line
+    auto parseNums = [](const char*& p, const char* end, double* v, int n) {
+        for (int i = 0; i < n; i++) {
+            if (not ParseNumber(p, end, v[i])) {
+                return false;
+            }
         }
+        return true;
+    };
+
+    auto p = first;
+    while (p != last) {
+        // Find the line
+        auto lineEnd = p;
+        while (lineEnd != last and *lineEnd != '\n') {
+            ++lineEnd;
+        }
+        auto next = (lineEnd == last) ? last : lineEnd + 1;
+
+        // Get the keyword
+        auto kw = SkipBlanks(p, lineEnd);
+        auto kwEnd = SkipToken(kw, lineEnd);
+        std::string_view key(kw, kwEnd - kw);
 
         // Handle vertices
-        if (std::regex_match(strs[0], vertex)) {
-            parse_vertex_(strs);
+        if (key == "v") {
+            cv::Vec3d v;
+            if (not parseNums(kwEnd, lineEnd, v.val, 3)) {
+                c.error = "Invalid vertex in obj file";
+                return;
+            }
+            c.vertices.push_back(v);
         }
 
         // Handle normals
-        else if (std::regex_match(strs[0], normal)) {
-            parse_normal_(strs);
+        else if (key == "vn") {
+            cv::Vec3d n;
+            if (not parseNums(kwEnd, lineEnd, n.val, 3)) {
+                c.error = "Invalid vertex normal in obj file";
+                return;
+            }
+            c.normals.push_back(n);
         }
 
         // Handle texture coordinates
-        else if (std::regex_match(strs[0], tcoord)) {
-            parse_tcoord_(strs);
+        else if (key == "vt") {
+            cv::Vec2d uv;
+            if (not parseNums(kwEnd, lineEnd, uv.val, 2)) {
+                c.error = "Invalid texture coordinate in obj file";
+                return;
+            }
+            c.uvs.push_back(uv);
         }
 
         // Handle faces
-        else if (std::regex_match(strs[0], face)) {
-            parse_face_(strs);
+        else if (key == "f") {
+            parse_face_(kwEnd, lineEnd, c);
+            if (not c.error.empty()) {
+                return;
+            }
         }
 
         // Handle mtllib
-        else if (std::regex_match(strs[0], mtllib)) {
-            parse_mtllib_(strs);
+        else if (key == "mtllib") {
+            std::string name(kwEnd, lineEnd);
+            trim(name);
+            c.mtllib = split(name, ' ').at(0);
         }
 
-        // Otherwise clear and continue
-        strs.clear();
+        p = next;
     }
-
-    ifs.close();
-}
-
-void OBJReader::parse_vertex_(const std::vector<std::string>& strs)
-{
-    auto a = std::stod(strs[1]);
-    auto b = std::stod(strs[2]);
-    auto c = std::stod(strs[3]);
-    vertices_.emplace_back(a, b, c);
-}
-
-void OBJReader::parse_normal_(const std::vector<std::string>& strs)
-{
-    auto a = std::stod(strs[1]);
-    auto b = std::stod(strs[2]);
-    auto c = std::stod(strs[3]);
-    normals_.emplace_back(a, b, c);
 }
 
-void OBJReader::parse_tcoord_(const std::vector<std::string>& strs)
+void OBJReader::parse_face_(const char* first, const char* last, Chunk& c)
 {
-    auto u = std::stod(strs[1]);
-    auto v = std::stod(strs[2]);
-    uvs_.emplace_back(u, v);
-}
+    VertexRefs refs[VALID_FACE_SIZE];
+    std::size_t n{0};
+
+    auto p = SkipBlanks(first, last);
+    while (p != last and not IsLineEnd(*p)) {
+        // Parse v[/vt][/vn] or v//vn
+        VertexRefs ref{NOT_PRESENT, NOT_PRESENT, NOT_PRESENT};
+        auto refEnd = SkipToken(p, last);
+        if (*p == '/' or *(refEnd - 1) == '/' or
+            not ParseNumber(p, refEnd, ref[0])) {
+            c.error = "Invalid face in obj file";
+            return;
+        }
+        if (p != refEnd and *p == '/') {
+            ++p;
+            if (p != refEnd and *p != '/' and
+                not ParseNumber(p, refEnd, ref[1])) {
+                c.error = "Invalid face in obj file";
+                return;
+            }
+            if (p != refEnd and *p == '/') {
+                ++p;
+                if (not ParseNumber(p, refEnd, ref[2])) {
+                    c.error = "Invalid face in obj file";
+                    return;
+                }
+            }
+        }
+        if (p != refEnd) {
+            c.error = "Invalid face in obj file";
+            return;
+        }
 
-void OBJReader::parse_face_(const std::vector<std::string>& strs)
-{
-    OBJReader::Face f;
-    std::vector<std::string> vinfo;
-    std::vector<std::string> sub(std::begin(strs) + 1, std::end(strs));
-
-    for (const auto& s : sub) {
-        auto faceType = classify_vertref_(s);
-        vinfo = split(s, '/');
-        switch (faceType) {
-            case RefType::Vertex:
-                f.emplace_back(std::stoi(vinfo[0]), NOT_PRESENT, NOT_PRESENT);
-                break;
-            case RefType::VertexWithTexture:
-                f.emplace_back(
-                    std::stoi(vinfo[0]), std::stoi(vinfo[1]), NOT_PRESENT);
-                break;
-            case RefType::VertexWithNormal:
-                f.emplace_back(
-                    std::stoi(vinfo[0]), NOT_PRESENT, std::stoi(vinfo[1]));
-                break;
-            case RefType::VertexWithTextureAndNormal:
-                f.emplace_back(
-                    std::stoi(vinfo[0]), std::stoi(vinfo[1]),
-                    std::stoi(vinfo[2]));
-                break;
-            case RefType::Invalid:
-                throw IOException("Invalid face in obj file");
+        if (n < VALID_FACE_SIZE) {
+            refs[n] = ref;
         }
-        vinfo.clear();
+        ++n;
+        p = SkipBlanks(p, last);
     }
-    faces_.push_back(f);
+
+    if (n != VALID_FACE_SIZE) {
+        c.hasNonTriFace = true;
+        return;
+    }
+    c.faces.insert(c.faces.end(), std::begin(refs), std::end(refs));
 }
 
-void OBJReader::parse_mtllib_(const std::vector<std::string>& strs)
+void OBJReader::parse_mtllib_(const std::string& mtllib)
 {
     // Get mtl path, relative to OBJ directory
-    fs::path mtlPath = path_.parent_path() / strs[1];
+    fs::path mtlPath = path_.parent_path() / mtllib;
 
     // Open the mtl file
     std::ifstream ifs(mtlPath.string());
@@ -198,43 +317,6 @@ void OBJReader::parse_mtllib_(const std::vector<std::string>& strs)
     ifs.close();
 }
 
-OBJReader::RefType OBJReader::classify_vertref_(const std::string& ref)
-{
-    const char delimiter = '/';
-    auto slashCount = std::count(ref.begin(), ref.end(), delimiter);
-
-    // Invalid slash positions
-    if (ref.front() == delimiter || ref.back() == delimiter) {
-        throw IOException("Invalid face in obj file");
-    }
-
-    // No slashes
-    if (slashCount == 0) {
-        return RefType::Vertex;
-    }
-
-    // One slash
-    else if (slashCount == 1) {
-        return RefType::VertexWithTexture;
-    }
-
-    // Two slashes
-    else if (slashCount == 2) {
-        // Get the two slash positions
-        auto pos0 = ref.find(delimiter, 0);
-        auto pos1 = ref.find(delimiter, pos0 + 1);
-
-        // If positions differ by 1, then v//vn
-        // else v/vt/vn
-        if ((pos1 - pos0) == 1) {
-            return RefType::VertexWithNormal;
-        } else {
-            return RefType::VertexWithTextureAndNormal;
-        }
-    }
-    return RefType::Invalid;
-}
-
 void OBJReader::build_mesh_()
 {
     // Reset output structures
@@ -247,6 +329,11 @@ void OBJReader::build_mesh_()
         throw IOException("No vertices in OBJ file");
     }
 
+    if (hasNonTriFace_) {
+        throw IOException("Parsed unsupported, non-triangular face");
+    }
+
+    mesh_->GetPoints()->Reserve(vertices_.size());
     ITKMesh::PointIdentifier pid = 0;
     for (const auto& v : vertices_) {
         mesh_->SetPoint(pid++, v.val);
@@ -256,42 +343,88 @@ void OBJReader::build_mesh_()
     // Note: OBJs index vert info from 1
     ITKCell::CellAutoPointer cell;
     ITKMesh::CellIdentifier cid = 0;
-    for (const auto& face : faces_) {
-        if (face.size() != VALID_FACE_SIZE) {
-            throw IOException("Parsed unsupported, non-triangular face");
-        }
-
+    for (std::size_t f = 0; f < faces_.size(); f += VALID_FACE_SIZE) {
         cell.TakeOwnership(new ITKTriangle);
         auto idInCell = 0;
-        for (auto vinfo : face) {
-            if (vinfo[0] - 1 < 0 ||
-                vinfo[0] - 1 >= static_cast<int>(vertices_.size())) {
-                throw IOException("Out-of-range vertex reference");
-            }
-            auto vertexID = vinfo[0] - 1;
+        for (std::size_t i = 0; i < VALID_FACE_SIZE; i++) {
+            const auto& vinfo = faces_[f + i];
+            auto vertexID = CheckedIndex(
+                vinfo[0], vertices_.size(), "Out-of-range vertex reference");
 
             cell->SetPointId(idInCell++, vertexID);
 
             if (vinfo[1] != NOT_PRESENT) {
-                if (vinfo[1] - 1 < 0 ||
-                    vinfo[1] - 1 >= static_cast<int>(uvs_.size())) {
-                    throw IOException("Out-of-range UV reference");
-                }
-                uvMap_->set(vertexID, uvs_[vinfo[1] - 1]);
+                auto uvID = CheckedIndex(
+                    vinfo[1], uvs_.size(), "Out-of-range UV reference");
+                uvMap_->set(vertexID, uvs_[uvID]);
             }
 
             if (vinfo[2] != NOT_PRESENT) {
-                if (vinfo[2] - 1 < 0 ||
-                    vinfo[2] - 1 >= static_cast<int>(normals_.size())) {
-                    throw IOException("Out-of-range normal reference");
-                }
-                mesh_->SetPointData(vertexID, normals_[vinfo[2] - 1].val);
+                auto normalID = CheckedIndex(
+                    vinfo[2], normals_.size(), "Out-of-range normal reference");
+                mesh_->SetPointData(vertexID, normals_[normalID].val);
             }
         }
         mesh_->SetCell(cid++, cell);
     }
     uvMap_->setOrigin(UVMap::Origin::TopLeft);
+}
 
+auto OBJReader::build_triangle_mesh_() -> TriangleMesh::Pointer
+{
+    if (vertices_.empty()) {
+        throw IOException("No vertices in OBJ file");
+    }
+
+    if (hasNonTriFace_) {
+        throw IOException("Parsed unsupported, non-triangular face");
+    }
+
+    auto mesh = TriangleMesh::New();
+    mesh->vertices() = vertices_;
+
+    // Build the faces and assign per-vertex UVs and normals
+    // Note: OBJs index vert info from 1
+    auto& faces = mesh->faces();
+    auto& uvs = mesh->uvs();
+    auto& normals = mesh->normals();
+    faces.reserve(faces_.size() / VALID_FACE_SIZE);
+    for (std::size_t f = 0; f < faces_.size(); f += VALID_FACE_SIZE) {
+        TriangleMesh::Face face;
+        for (std::size_t i = 0; i < VALID_FACE_SIZE; i++) {
+            const auto& vinfo = faces_[f + i];
+            auto vertexID = CheckedIndex(
+                vinfo[0], vertices_.size(), "Out-of-range vertex reference");
+            face[i] = static_cast<TriangleMesh::Index>(vertexID);
+
+            if (vinfo[1] != NOT_PRESENT) {
+                auto uvID = CheckedIndex(
+                    vinfo[1], uvs_.size(), "Out-of-range UV reference");
+                if (uvs.empty()) {
+                    uvs.assign(vertices_.size(), NULL_MAPPING);
+                }
+                // Convert from bottom-left to top-left origin
+                const auto& uv = uvs_[uvID];
+                uvs[vertexID] = {std::abs(uv[0]), std::abs(uv[1] - 1.0)};
+            }
+
+            if (vinfo[2] != NOT_PRESENT) {
+                auto normalID = CheckedIndex(
+                    vinfo[2], normals_.size(), "Out-of-range normal reference");
+                if (normals.empty()) {
+                    normals.assign(vertices_.size(), cv::Vec3d(0, 0, 0));
+                }
+                normals[vertexID] = normals_[normalID];
+            }
+        }
+        faces.push_back(face);
+    }
+
+    return mesh;
+}
+
+void OBJReader::load_texture_()
+{
     // Read the image
     if (!texturePath_.empty()) {
         if (fs::exists(texturePath_)) {
@@ -301,9 +434,4 @@ void OBJReader::build_mesh_()
                 "Texture image file not found: {}", texturePath_.string());
         }
     }
-
-    // If we have a UV map and a texture image, set the dimensions on the UVMap
-    if (not uvMap_->empty() and not textureMat_.empty()) {
-        uvMap_->ratio(textureMat_.cols, textureMat_.rows);
-    }
 }
@@ -1,13 +1,28 @@
 #include "vc/core/io/OBJWriter.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <string>
 
 #include "vc/core/io/ImageIO.hpp"
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
 
 static constexpr int UNSET_VALUE = -1;
 
+// Size at which formatted output is flushed to disk
+static constexpr std::size_t BUFFER_SIZE{4 << 20};
+
+// Write the buffer to the stream if it is full or if forced
+static void FlushBuffer(std::ostream& os, std::string& buf, bool force = false)
+{
+    if (force or buf.size() >= BUFFER_SIZE) {
+        os.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        buf.clear();
+    }
+}
+
 using namespace volcart;
 using namespace volcart::io;
 
@@ -31,7 +46,16 @@ OBJWriter::OBJWriter(
 }
 
 void OBJWriter::setPath(const filesystem::path& path) { outputPath_ = path; }
-void OBJWriter::setMesh(ITKMesh::Pointer mesh) { mesh_ = std::move(mesh); }
+void OBJWriter::setMesh(ITKMesh::Pointer mesh)
+{
+    mesh_ = std::move(mesh);
+    triMesh_ = nullptr;
+}
+void OBJWriter::setMesh(TriangleMesh::Pointer mesh)
+{
+    triMesh_ = std::move(mesh);
+    mesh_ = nullptr;
+}
 void OBJWriter::setUVMap(UVMap::Pointer uvMap) { uvMap_ = std::move(uvMap); }
 void OBJWriter::setTexture(cv::Mat uvImg) { texture_ = std::move(uvImg); }
 void OBJWriter::setTextureFormat(std::string fmt)
@@ -43,7 +67,7 @@ void OBJWriter::setTextureFormat(std::string fmt)
 // Write everything (OBJ, MTL, and PNG) to disk
 auto OBJWriter::write() -> int
 {
-    if (not mesh_ or mesh_->GetNumberOfPoints() == 0) {
+    if ((not mesh_ and not triMesh_) or num_vertices_() == 0) {
         throw volcart::IOException("Mesh is empty or null");
     }
 
@@ -51,7 +75,7 @@ auto OBJWriter::write() -> int
     write_obj_();
 
     // Write texture stuff if we have a UV coordinate map
-    if (uvMap_ and not uvMap_->empty()) {
+    if (has_uvs_()) {
         write_mtl_();
         write_texture_();
     }
@@ -59,6 +83,22 @@ auto OBJWriter::write() -> int
     return EXIT_SUCCESS;
 }
 
+auto OBJWriter::num_vertices_() const -> std::size_t
+{
+    return triMesh_ ? triMesh_->numVertices() : mesh_->GetNumberOfPoints();
+}
+
+auto OBJWriter::num_faces_() const -> std::size_t
+{
+    return triMesh_ ? triMesh_->numFaces() : mesh_->GetNumberOfCells();
+}
+
+auto OBJWriter::has_uvs_() const -> bool
+{
+    return (uvMap_ and not uvMap_->empty()) or
+           (triMesh_ and triMesh_->hasUVs());
+}
+
 // Write the OBJ file to disk
 auto OBJWriter::write_obj_() -> int
 {
@@ -73,7 +113,7 @@ auto OBJWriter::write_obj_() -> int
     write_vertices_();
 
     // Only write texture information if we have a UV map
-    if (uvMap_ and not uvMap_->empty()) {
+    if (has_uvs_()) {
         write_texture_coordinates_();
     }
 
@@ -150,38 +190,85 @@ auto OBJWriter::write_header_() -> int
 // Vertex normal: 'vn nx ny nz'
 auto OBJWriter::write_vertices_() -> int
 {
-    if (!outputMesh_.is_open() || mesh_->GetNumberOfPoints() == 0) {
+    auto numVerts = num_vertices_();
+    if (!outputMesh_.is_open() || numVerts == 0) {
         return EXIT_FAILURE;
     }
     Logger()->debug("Writing vertices...");
 
-    outputMesh_ << "# Vertices: " << mesh_->GetNumberOfPoints() << "\n";
+    outputMesh_ << "# Vertices: " << numVerts << "\n";
 
-    // Iterate over all of the points
+    // Reset the point links. Links are indexed by point ID, and the IDs of an
+    // ITKMesh are not necessarily contiguous.
+    auto numLinks = numVerts;
+    if (not triMesh_) {
+        for (auto pt = mesh_->GetPoints()->Begin();
+             pt != mesh_->GetPoints()->End(); ++pt) {
+            numLinks = std::max<std::size_t>(numLinks, pt.Index() + 1);
+        }
+    }
+    pointLinks_.assign(
+        numLinks, cv::Vec3i(UNSET_VALUE, UNSET_VALUE, UNSET_VALUE));
+
+    // Write a point and its normal
+    std::string buf;
+    buf.reserve(BUFFER_SIZE + 256);
     uint32_t vIndex = 1;
     uint32_t vnIndex = 1;
-    for (auto pt = mesh_->GetPoints()->Begin(); pt != mesh_->GetPoints()->End();
-         pt++) {
+    auto writeVertex = [&](std::size_t idx, const cv::Vec3d& pt,
+                           const cv::Vec3d& normal, bool hasNormal) {
         // Make a new point link for this point
         cv::Vec3i pointLink(vIndex, UNSET_VALUE, UNSET_VALUE);
 
         // Write the point position components
-        outputMesh_ << "v " << pt.Value()[0] << " " << pt.Value()[1] << " "
-                    << pt.Value()[2] << "\n";
+        buf += "v ";
+        AppendNumber(buf, pt[0]);
+        buf += ' ';
+        AppendNumber(buf, pt[1]);
+        buf += ' ';
+        AppendNumber(buf, pt[2]);
+        buf += '\n';
 
         // Write the point normal information
-        ITKPixel normal;
-        if (mesh_->GetPointData(pt.Index(), &normal)) {
-            outputMesh_ << "vn " << normal[0] << " " << normal[1] << " "
-                        << normal[2] << "\n";
+        if (hasNormal) {
+            buf += "vn ";
+            AppendNumber(buf, normal[0]);
+            buf += ' ';
+            AppendNumber(buf, normal[1]);
+            buf += ' ';
+            AppendNumber(buf, normal[2]);
+            buf += '\n';
             pointLink[2] = vnIndex++;
         }
 
         // Add this vertex to the point links
-        pointLinks_.insert({pt.Index(), pointLink});
+        pointLinks_[idx] = pointLink;
 
         ++vIndex;
+        FlushBuffer(outputMesh_, buf);
+    };
+
+    // Iterate over all of the points
+    if (triMesh_) {
+        auto hasTriNormals = triMesh_->hasNormals();
+        for (std::size_t idx = 0; idx < numVerts; idx++) {
+            cv::Vec3d normal;
+            if (hasTriNormals) {
+                normal = triMesh_->normals()[idx];
+            }
+            writeVertex(idx, triMesh_->vertices()[idx], normal, hasTriNormals);
+        }
+    } else {
+        for (auto pt = mesh_->GetPoints()->Begin();
+             pt != mesh_->GetPoints()->End(); ++pt) {
+            ITKPixel n;
+            auto hasNormal = mesh_->GetPointData(pt.Index(), &n);
+            const auto& p = pt.Value();
+            writeVertex(
+                pt.Index(), {p[0], p[1], p[2]}, {n[0], n[1], n[2]}, hasNormal);
+        }
     }
+    FlushBuffer(outputMesh_, buf, true);
 
     return EXIT_SUCCESS;
 }
@@ -189,14 +276,23 @@ auto OBJWriter::write_vertices_() -> int
 // Write the UV coordinates that will be attached to points: 'vt u v'
 auto OBJWriter::write_texture_coordinates_() -> int
 {
-    if (not outputMesh_.is_open() or uvMap_->empty()) {
+    if (not outputMesh_.is_open() or not has_uvs_()) {
         return EXIT_FAILURE;
     }
     Logger()->debug("Writing texture coordinates...");
 
-    // Ensure coordinates are relative to bottom left
-    auto startingOrigin = uvMap_->origin();
-    uvMap_->setOrigin(UVMap::Origin::BottomLeft);
+    // Get coordinates relative to bottom left
+    auto useUVMap = uvMap_ and not uvMap_->empty();
+    std::vector<cv::Vec2d> uvs;
+    if (useUVMap) {
+        uvs = uvMap_->getAll(UVMap::Origin::BottomLeft);
+    } else {
+        // Mesh UVs are relative to the top left
+        uvs.reserve(triMesh_->uvs().size());
+        for (const auto& tl : triMesh_->uvs()) {
+            uvs.emplace_back(std::abs(tl[0]), std::abs(tl[1] - 1.0));
+        }
+    }
 
     // Write mtl path, relative to OBJ
     auto mtlpath = outputPath_.stem();
@@ -206,67 +302,92 @@ auto OBJWriter::write_texture_coordinates_() -> int
     outputMesh_ << "usemtl default\n";
 
     // Iterate over all of the saved coordinates in our coordinate map
+    std::string buf;
+    buf.reserve(BUFFER_SIZE + 256);
     uint32_t vtIndex = 1;
-    for (uint32_t pId = 0; pId < uvMap_->size(); ++pId) {
-        cv::Vec2d uv = uvMap_->get(pId);
-        outputMesh_ << "vt " << uv[0] << " " << uv[1] << "\n";
+    auto numUVs = useUVMap ? uvMap_->size() : uvs.size();
+    for (std::size_t pId = 0; pId < numUVs; ++pId) {
+        const auto& uv = uvs[pId];
+        buf += "vt ";
+        AppendNumber(buf, uv[0]);
+        buf += ' ';
+        AppendNumber(buf, uv[1]);
+        buf += '\n';
 
         // Find this UV map's point in _point_links and set its vt value to our
         // current position in the vt list
-        pointLinks_.find(pId)->second[1] = vtIndex;
+        if (pId < pointLinks_.size()) {
+            pointLinks_[pId][1] = vtIndex;
+        }
 
         ++vtIndex;
+        FlushBuffer(outputMesh_, buf);
     }
+    FlushBuffer(outputMesh_, buf, true);
 
-    // Restore the starting origin
-    uvMap_->setOrigin(startingOrigin);
     return EXIT_SUCCESS;
 }
 
 // Write the face information: 'f v/vt/vn'
 auto OBJWriter::write_faces_() -> int
 {
-    if (!outputMesh_.is_open() || mesh_->GetNumberOfCells() == 0) {
+    if (!outputMesh_.is_open() || num_faces_() == 0) {
         return EXIT_FAILURE;
     }
     Logger()->debug("Writing faces...");
 
-    outputMesh_ << "# Faces: " << mesh_->GetNumberOfCells() << "\n";
+    outputMesh_ << "# Faces: " << num_faces_() << "\n";
 
-    // Iterate over the faces of the mesh
-    ITKPointInCellIterator point;
-    for (auto cell = mesh_->GetCells()->Begin();
-         cell != mesh_->GetCells()->End(); ++cell) {
+    // Write a face from a range of point IDs
+    std::string buf;
+    buf.reserve(BUFFER_SIZE + 256);
+    auto appendFace = [this, &buf](auto first, auto last) {
         // Starts a new face line
-        outputMesh_ << "f ";
+        buf += "f ";
 
         // Iterate over the points of this face
-        for (point = cell.Value()->PointIdsBegin();
-             point != cell.Value()->PointIdsEnd(); ++point) {
+        for (auto point = first; point != last; ++point) {
 
-            cv::Vec3i pointLink = pointLinks_.find(*point)->second;
+            const auto& pointLink = pointLinks_.at(*point);
 
-            outputMesh_ << pointLink[0];
+            AppendNumber(buf, pointLink[0]);
 
             // Write the vtIndex
             if (pointLink[1] != UNSET_VALUE) {
-                outputMesh_ << "/" << pointLink[1];
+                buf += '/';
+                AppendNumber(buf, pointLink[1]);
             }
 
             // Write the vnIndex
             if (pointLink[2] != UNSET_VALUE) {
                 // Write a buffer slash if there wasn't a vtIndex
                 if (pointLink[1] == UNSET_VALUE) {
-                    outputMesh_ << "/";
+                    buf += '/';
                 }
 
-                outputMesh_ << "/" << pointLink[2];
+                buf += '/';
+                AppendNumber(buf, pointLink[2]);
             }
 
-            outputMesh_ << " ";
+            buf += ' ';
+        }
+        buf += '\n';
+        FlushBuffer(outputMesh_, buf);
+    };
+
+    // Iterate over the faces of the mesh
+    if (triMesh_) {
+        for (const auto& f : triMesh_->faces()) {
+            appendFace(f.begin(), f.end());
+        }
+    } else {
+        for (auto cell = mesh_->GetCells()->Begin();
+             cell != mesh_->GetCells()->End(); ++cell) {
+            appendFace(
+                cell.Value()->PointIdsBegin(), cell.Value()->PointIdsEnd());
         }
-        outputMesh_ << "\n";
     }
+    FlushBuffer(outputMesh_, buf, true);
 
     return EXIT_SUCCESS;
 }
@@ -1,6 +1,12 @@
 #include "vc/core/io/PLYReader.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "vc/core/io/MemoryMappedFile.hpp"
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/String.hpp"
 
@@ -8,7 +14,91 @@ using namespace volcart;
 using namespace volcart::io;
 namespace fs = volcart::filesystem;
 
+// Vertex fields which are stored in the temporary vertex list
+enum class VertexField { None = -1, X, Y, Z, NX, NY, NZ, R, G, B };
+
+static auto ToVertexField(const std::string& name) -> VertexField
+{
+    if (name == "x") {
+        return VertexField::X;
+    } else if (name == "y") {
+        return VertexField::Y;
+    } else if (name == "z") {
+        return VertexField::Z;
+    } else if (name == "nx") {
+        return VertexField::NX;
+    } else if (name == "ny") {
+        return VertexField::NY;
+    } else if (name == "nz") {
+        return VertexField::NZ;
+    } else if (name == "r" or name == "red") {
+        return VertexField::R;
+    } else if (name == "g" or name == "green") {
+        return VertexField::G;
+    } else if (name == "b" or name == "blue") {
+        return VertexField::B;
+    }
+    return VertexField::None;
+}
+
+static auto HostIsLittleEndian() -> bool
+{
+    const std::uint16_t v{1};
+    std::uint8_t b{0};
+    std::memcpy(&b, &v, 1);
+    return b == 1;
+}
+
+// Advance past any whitespace, including line endings
+static auto SkipSpace(const char* p, const char* last) -> const char*
+{
+    while (p != last and (IsBlank(*p) or IsLineEnd(*p))) {
+        ++p;
+    }
+    return p;
+}
+
 ITKMesh::Pointer PLYReader::read()
+{
+    parse_();
+    outMesh_ = ITKMesh::New();
+    create_mesh_();
+    return outMesh_;
+}
+
+auto PLYReader::readTriangleMesh() -> TriangleMesh::Pointer
+{
+    parse_();
+
+    auto mesh = TriangleMesh::New();
+    auto& verts = mesh->vertices();
+    verts.reserve(pointList_.size());
+    for (const auto& v : pointList_) {
+        verts.emplace_back(v.x, v.y, v.z);
+    }
+    if (hasPointNorm_) {
+        auto& normals = mesh->normals();
+        normals.reserve(pointList_.size());
+        for (const auto& v : pointList_) {
+            normals.emplace_back(v.nx, v.ny, v.nz);
+        }
+    }
+    auto& faces = mesh->faces();
+    faces.reserve(faceList_.size());
+    for (const auto& f : faceList_) {
+        faces.push_back(
+            {static_cast<TriangleMesh::Index>(f.v1),
+             static_cast<TriangleMesh::Index>(f.v2),
+             static_cast<TriangleMesh::Index>(f.v3)});
+    }
+
+    // Release the temporary lists
+    pointList_ = {};
+    faceList_ = {};
+    return mesh;
+}
+
+void PLYReader::parse_()
 {
     if (inputPath_.empty() || !fs::exists(inputPath_)) {
         auto msg = "File not provided or does not exist.";
@@ -18,142 +108,338 @@ ITKMesh::Pointer PLYReader::read()
     // Resets values of member variables in case of 2nd reading
     pointList_.clear();
     faceList_.clear();
-    properties_.clear();
-    elementsList_.clear();
-    outMesh_ = ITKMesh::New();
-    numVertices_ = 0;
-    numFaces_ = 0;
-    hasLeadingChar_ = true;
+    elements_.clear();
+    format_ = Format::Ascii;
     hasPointNorm_ = false;
 
-    int skippedElementCnt = 0;
-
-    plyFile_.open(inputPath_.string());
-    if (!plyFile_.is_open()) {
-        auto msg = "Open file " + inputPath_.string() + " failed.";
-        throw volcart::IOException(msg);
-    }
-    parse_header_();
-    for (auto& cur : elementsList_) {
-        if (cur == "vertex") {
-            read_points_();
-        } else if (cur == "face") {
-            read_faces_();
+    MemoryMappedFile file(inputPath_);
+    auto p = parse_header_(file.begin(), file.end());
+    for (const auto& e : elements_) {
+        if (e.name == "vertex") {
+            p = read_points_(e, p, file.end());
+        } else if (e.name == "face") {
+            p = read_faces_(e, p, file.end());
         } else {
-            int curSkip = skippedLine_[skippedElementCnt];
-            for (int i = 0; i < curSkip; i++) {
-                std::getline(plyFile_, line_);
-            }
-            skippedElementCnt++;
+            p = skip_element_(e, p, file.end());
         }
     }
-    plyFile_.close();
-    create_mesh_();
-
-    return outMesh_;
 }
 
-void PLYReader::parse_header_()
+auto PLYReader::parse_header_(const char* first, const char* last)
+    -> const char*
 {
-    std::getline(plyFile_, line_);
-    while (line_ != "end_header") {
-        if (line_.find("element") != std::string::npos) {
-            auto splitLine = split(line_, ' ');
-            elementsList_.push_back(splitLine[1]);
-            if (splitLine[1] == "vertex") {
-                numVertices_ = std::stoi(splitLine[2]);
-            } else if (splitLine[1] == "face") {
-                numFaces_ = std::stoi(splitLine[2]);
+    // Get the next header line
+    auto p = first;
+    auto nextLine = [&p, last]() {
+        if (p == last) {
+            throw IOException("Unexpected end of PLY header");
+        }
+        auto next = SkipLine(p, last);
+        std::string line(p, next);
+        p = next;
+        trim(line);
+        return line;
+    };
+
+    // Convert a PLY type name to a Type
+    auto toType = [](const std::string& t) {
+        if (t == "char" or t == "int8") {
+            return Type::Int8;
+        } else if (t == "uchar" or t == "uint8") {
+            return Type::UInt8;
+        } else if (t == "short" or t == "int16") {
+            return Type::Int16;
+        } else if (t == "ushort" or t == "uint16") {
+            return Type::UInt16;
+        } else if (t == "int" or t == "int32") {
+            return Type::Int32;
+        } else if (t == "uint" or t == "uint32") {
+            return Type::UInt32;
+        } else if (t == "float" or t == "float32") {
+            return Type::Float32;
+        } else if (t == "double" or t == "float64") {
+            return Type::Float64;
+        }
+        throw IOException("Unsupported PLY property type: " + t);
+    };
+
+    if (nextLine() != "ply") {
+        throw IOException("Not a PLY file: " + inputPath_.string());
+    }
+
+    std::size_t numFaces{0};
+    for (auto line = nextLine(); line != "end_header"; line = nextLine()) {
+        auto strs = split(line, ' ');
+        if (strs.empty()) {
+            continue;
+        }
+
+        if (strs[0] == "format" and strs.size() > 1) {
+            if (strs[1] == "ascii") {
+                format_ = Format::Ascii;
+            } else if (strs[1] == "binary_little_endian") {
+                format_ = Format::BinaryLittleEndian;
+            } else if (strs[1] == "binary_big_endian") {
+                format_ = Format::BinaryBigEndian;
             } else {
-                skippedLine_.push_back(std::stoi(splitLine[2]));
+                throw IOException("Unsupported PLY format: " + strs[1]);
             }
-            std::getline(plyFile_, line_);
-            splitLine = split(line_, ' ');
-            int currentLine{0};
-            while (splitLine[0] == "property") {
-                if (splitLine[1] == "list") {
-                    hasLeadingChar_ = line_.find("uchar") != std::string::npos;
-                }
-                // Not sure how to handle if it's not the vertices or faces
-                else {
-                    if (splitLine[2] == "nx") {
-                        hasPointNorm_ = true;
-                    }
-                    properties_[splitLine[2]] = currentLine;
-                }
-                std::getline(plyFile_, line_);
-                currentLine++;
-                splitLine = split(line_, ' ');
+        } else if (strs[0] == "element" and strs.size() > 2) {
+            Element e;
+            e.name = strs[1];
+            e.count = std::stoul(strs[2]);
+            if (e.name == "face") {
+                numFaces = e.count;
             }
-        } else {
-            std::getline(plyFile_, line_);
+            elements_.push_back(e);
+        } else if (strs[0] == "property" and not elements_.empty()) {
+            Property prop;
+            if (strs.size() > 4 and strs[1] == "list") {
+                prop.isList = true;
+                prop.countType = toType(strs[2]);
+                prop.type = toType(strs[3]);
+                prop.name = strs[4];
+            } else if (strs.size() > 2) {
+                prop.type = toType(strs[1]);
+                prop.name = strs[2];
+            } else {
+                throw IOException("Invalid PLY property: " + line);
+            }
+            if (elements_.back().name == "vertex" and prop.name == "nx") {
+                hasPointNorm_ = true;
+            }
+            elements_.back().properties.push_back(prop);
         }
     }
-    if (numFaces_ == 0) {
+
+    if (numFaces == 0) {
         Logger()->warn("Warning: No face information found");
     }
-    std::getline(plyFile_, line_);
 
-}  // ParseHeader
+    return p;
+}
 
-void PLYReader::read_points_()
+auto PLYReader::read_value_(const char*& p, const char* last, Type t) const
+    -> double
 {
-    for (int i = 0; i < numVertices_; i++) {
-        SimpleMesh::Vertex curPoint;
-        auto curLine = split(line_, ' ');
-        curPoint.x = std::stod(curLine[properties_["x"]]);
-        curPoint.y = std::stod(curLine[properties_["y"]]);
-        curPoint.z = std::stod(curLine[properties_["z"]]);
-        if (properties_.find("nx") != properties_.end()) {
-            curPoint.nx = std::stod(curLine[properties_["nx"]]);
-            curPoint.ny = std::stod(curLine[properties_["ny"]]);
-            curPoint.nz = std::stod(curLine[properties_["nz"]]);
-        }
-        if (properties_.find("r") != properties_.end()) {
-            curPoint.r = stoi(curLine[properties_["r"]]);
-            curPoint.g = stoi(curLine[properties_["g"]]);
-            curPoint.b = stoi(curLine[properties_["b"]]);
-        }
-        pointList_.push_back(curPoint);
-        std::getline(plyFile_, line_);
+    if (format_ == Format::Ascii) {
+        double v{0};
+        if (not ParseNumber(p, last, v)) {
+            throw IOException("Failed to parse PLY value");
+        }
+        return v;
+    }
+
+    std::size_t size{0};
+    switch (t) {
+        case Type::Int8:
+        case Type::UInt8:
+            size = 1;
+            break;
+        case Type::Int16:
+        case Type::UInt16:
+            size = 2;
+            break;
+        case Type::Int32:
+        case Type::UInt32:
+        case Type::Float32:
+            size = 4;
+            break;
+        case Type::Float64:
+            size = 8;
+            break;
+    }
+    if (static_cast<std::size_t>(last - p) < size) {
+        throw IOException("Unexpected end of PLY file");
+    }
+
+    unsigned char bytes[8];
+    std::memcpy(bytes, p, size);
+    p += size;
+    static const bool hostLE = HostIsLittleEndian();
+    if ((format_ == Format::BinaryLittleEndian) != hostLE) {
+        std::reverse(bytes, bytes + size);
     }
+
+    // Reinterpret the bytes as the stored type
+    auto as = [&bytes](auto v) {
+        std::memcpy(&v, bytes, sizeof(v));
+        return static_cast<double>(v);
+    };
+    switch (t) {
+        case Type::Int8:
+            return as(std::int8_t{});
+        case Type::UInt8:
+            return as(std::uint8_t{});
+        case Type::Int16:
+            return as(std::int16_t{});
+        case Type::UInt16:
+            return as(std::uint16_t{});
+        case Type::Int32:
+            return as(std::int32_t{});
+        case Type::UInt32:
+            return as(std::uint32_t{});
+        case Type::Float32:
+            return as(float{});
+        case Type::Float64:
+            return as(double{});
+    }
+    return 0;
 }
 
-void PLYReader::read_faces_()
+auto PLYReader::read_points_(const Element& e, const char* p, const char* last)
+    -> const char*
 {
-    for (int i = 0; i < numFaces_; i++) {
-        SimpleMesh::Cell face;
-        auto curFace = split(line_, ' ');
-        if (hasLeadingChar_) {
-            int pointsPerFace = std::stoi(curFace[0]);
-            if (pointsPerFace != 3) {
-                auto msg = "Not a Triangular Mesh";
-                throw volcart::IOException(msg);
+    // Map each property to its vertex field
+    std::vector<VertexField> fields;
+    for (const auto& prop : e.properties) {
+        fields.push_back(
+            prop.isList ? VertexField::None : ToVertexField(prop.name));
+    }
+
+    auto isAscii = format_ == Format::Ascii;
+    pointList_.reserve(e.count);
+    for (std::size_t i = 0; i < e.count; i++) {
+        if (isAscii) {
+            p = SkipSpace(p, last);
+        }
+
+        SimpleMesh::Vertex v{};
+        for (std::size_t pi = 0; pi < e.properties.size(); pi++) {
+            const auto& prop = e.properties[pi];
+            if (prop.isList) {
+                auto n = static_cast<std::size_t>(
+                    read_value_(p, last, prop.countType));
+                for (std::size_t li = 0; li < n; li++) {
+                    read_value_(p, last, prop.type);
+                }
+                continue;
+            }
+
+            auto val = read_value_(p, last, prop.type);
+            switch (fields[pi]) {
+                case VertexField::X:
+                    v.x = val;
+                    break;
+                case VertexField::Y:
+                    v.y = val;
+                    break;
+                case VertexField::Z:
+                    v.z = val;
+                    break;
+                case VertexField::NX:
+                    v.nx = val;
+                    break;
+                case VertexField::NY:
+                    v.ny = val;
+                    break;
+                case VertexField::NZ:
+                    v.nz = val;
+                    break;
+                case VertexField::R:
+                    v.r = static_cast<int>(val);
+                    break;
+                case VertexField::G:
+                    v.g = static_cast<int>(val);
+                    break;
+                case VertexField::B:
+                    v.b = static_cast<int>(val);
+                    break;
+                case VertexField::None:
+                    break;
+            }
+        }
+        pointList_.push_back(v);
+
+        if (isAscii) {
+            p = SkipLine(p, last);
+        }
+    }
+    return p;
+}
+
+auto PLYReader::read_faces_(const Element& e, const char* p, const char* last)
+    -> const char*
+{
+    // Find the vertex index list
+    auto idxProp = std::find_if(
+        e.properties.begin(), e.properties.end(), [](const auto& prop) {
+            return prop.isList and
+                   (prop.name == "vertex_indices" or
+                    prop.name == "vertex_index");
+        });
+    if (idxProp == e.properties.end()) {
+        throw volcart::IOException("PLY faces do not have vertex indices");
+    }
+
+    auto isAscii = format_ == Format::Ascii;
+    faceList_.reserve(e.count);
+    for (std::size_t i = 0; i < e.count; i++) {
+        if (isAscii) {
+            p = SkipSpace(p, last);
+        }
+
+        for (auto prop = e.properties.begin(); prop != e.properties.end();
+             ++prop) {
+            if (prop == idxProp) {
+                auto n = read_value_(p, last, prop->countType);
+                if (n != 3) {
+                    auto msg = "Not a Triangular Mesh";
+                    throw volcart::IOException(msg);
+                }
+                auto v1 = read_value_(p, last, prop->type);
+                auto v2 = read_value_(p, last, prop->type);
+                auto v3 = read_value_(p, last, prop->type);
+                faceList_.emplace_back(
+                    static_cast<std::uint64_t>(v1),
+                    static_cast<std::uint64_t>(v2),
+                    static_cast<std::uint64_t>(v3));
+            } else if (prop->isList) {
+                auto n = static_cast<std::size_t>(
+                    read_value_(p, last, prop->countType));
+                for (std::size_t li = 0; li < n; li++) {
+                    read_value_(p, last, prop->type);
+                }
             } else {
-                face = SimpleMesh::Cell(
-                    std::stoul(curFace[1]), std::stoul(curFace[2]),
-                    std::stoul(curFace[3]));
-                faceList_.push_back(face);
+                read_value_(p, last, prop->type);
             }
-        } else {
-            if (curFace.size() != 3) {
-                auto msg = "Not a Triangular Mesh";
-                throw volcart::IOException(msg);
+        }
+
+        if (isAscii) {
+            p = SkipLine(p, last);
+        }
+    }
+    return p;
+}
+
+auto PLYReader::skip_element_(
+    const Element& e, const char* p, const char* last) -> const char*
+{
+    for (std::size_t i = 0; i < e.count; i++) {
+        if (format_ == Format::Ascii) {
+            p = SkipLine(SkipSpace(p, last), last);
+            continue;
+        }
+        for (const auto& prop : e.properties) {
+            if (prop.isList) {
+                auto n = static_cast<std::size_t>(
+                    read_value_(p, last, prop.countType));
+                for (std::size_t li = 0; li < n; li++) {
+                    read_value_(p, last, prop.type);
+                }
             } else {
-                face = SimpleMesh::Cell(
-                    std::stoul(curFace[1]), std::stoul(curFace[2]),
-                    std::stoul(curFace[3]));
-                faceList_.push_back(face);
+                read_value_(p, last, prop.type);
             }
         }
-        std::getline(plyFile_, line_);
     }
+    return p;
 }
 
 void PLYReader::create_mesh_()
 {
     ITKPoint p;
     uint32_t pointCount = 0;
+    outMesh_->GetPoints()->Reserve(pointList_.size());
     for (auto& cur : pointList_) {
         p[0] = cur.x;
         p[1] = cur.y;
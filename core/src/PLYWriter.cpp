@@ -1,17 +1,52 @@
 #include "vc/core/io/PLYWriter.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
 #include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/CharConv.hpp"
 #include "vc/core/util/Logging.hpp"
 
 using namespace volcart;
 using namespace volcart::io;
 namespace fs = volcart::filesystem;
 
-static inline auto PtIntensity(
-    std::size_t idx, const UVMap::Pointer& uvMap, const cv::Mat& image)
+// Size at which formatted output is flushed to disk
+static constexpr std::size_t BUFFER_SIZE{4 << 20};
+
+// Write the buffer to the stream if it is full or if forced
+static void FlushBuffer(std::ostream& os, std::string& buf, bool force = false)
+{
+    if (force or buf.size() >= BUFFER_SIZE) {
+        os.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+        buf.clear();
+    }
+}
+
+// Append a value to the buffer in little endian byte order
+template <typename T>
+static void AppendLE(std::string& buf, T val)
+{
+    static const bool hostLE = []() {
+        const std::uint16_t v{1};
+        std::uint8_t b{0};
+        std::memcpy(&b, &v, 1);
+        return b == 1;
+    }();
+
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &val, sizeof(T));
+    if (not hostLE) {
+        std::reverse(bytes, bytes + sizeof(T));
+    }
+    buf.append(bytes, sizeof(T));
+}
+
+static inline auto PtIntensity(const cv::Vec2d& uv, const cv::Mat& image)
     -> double
 {
-    auto uv = uvMap->get(idx);
     int u = cvRound(uv[0] * (image.cols - 1));
     int v = cvRound(uv[1] * (image.rows - 1));
     return image.at<uint16_t>(v, u);
@@ -20,12 +55,16 @@ static inline auto PtIntensity(
 ///// Output Methods /////
 auto PLYWriter::write() -> int
 {
-    if (not mesh_ or mesh_->GetNumberOfPoints() == 0) {
+    if ((not mesh_ and not triMesh_) or num_vertices_() == 0) {
         throw volcart::IOException("Mesh is empty or null");
     }
 
     // Open the file stream
-    outputMesh_.open(outputPath_.string());
+    auto mode = std::ios::out;
+    if (binary_) {
+        mode |= std::ios::binary;
+    }
+    outputMesh_.open(outputPath_.string(), mode);
     if (!outputMesh_.is_open()) {
         return EXIT_FAILURE;
     }
@@ -51,6 +90,23 @@ auto PLYWriter::write() -> int
     return EXIT_SUCCESS;
 }
 
+auto PLYWriter::num_vertices_() const -> std::size_t
+{
+    return triMesh_ ? triMesh_->numVertices() : mesh_->GetNumberOfPoints();
+}
+
+auto PLYWriter::num_faces_() const -> std::size_t
+{
+    return triMesh_ ? triMesh_->numFaces() : mesh_->GetNumberOfCells();
+}
+
+auto PLYWriter::has_color_() const -> bool
+{
+    auto hasUV = (uvMap_ and not uvMap_->empty()) or
+                 (triMesh_ and triMesh_->hasUVs());
+    return (not texture_.empty() and hasUV) or not vcolors_.empty();
+}
+
 // Write our custom header
 auto PLYWriter::write_header_() -> int
 {
@@ -58,36 +114,38 @@ auto PLYWriter::write_header_() -> int
         return EXIT_FAILURE;
     }
 
-    outputMesh_ << "ply" << std::endl;
-    outputMesh_ << "format ascii 1.0" << std::endl;
-    outputMesh_ << "comment VC PLY Exporter v1.0" << std::endl;
+    outputMesh_ << "ply\n";
+    if (binary_) {
+        outputMesh_ << "format binary_little_endian 1.0\n";
+    } else {
+        outputMesh_ << "format ascii 1.0\n";
+    }
+    outputMesh_ << "comment VC PLY Exporter v1.0\n";
 
     // Vertex Info for Header
-    outputMesh_ << "element vertex " << mesh_->GetNumberOfPoints() << std::endl;
-    outputMesh_ << "property float x" << std::endl;
-    outputMesh_ << "property float y" << std::endl;
-    outputMesh_ << "property float z" << std::endl;
-    outputMesh_ << "property float nx" << std::endl;
-    outputMesh_ << "property float ny" << std::endl;
-    outputMesh_ << "property float nz" << std::endl;
+    outputMesh_ << "element vertex " << num_vertices_() << "\n";
+    outputMesh_ << "property float x\n";
+    outputMesh_ << "property float y\n";
+    outputMesh_ << "property float z\n";
+    outputMesh_ << "property float nx\n";
+    outputMesh_ << "property float ny\n";
+    outputMesh_ << "property float nz\n";
 
     // Color info for vertices
-    if ((not texture_.empty() and uvMap_ and not uvMap_->empty()) or
-        not vcolors_.empty()) {
-        outputMesh_ << "property uchar red" << std::endl;
-        outputMesh_ << "property uchar green" << std::endl;
-        outputMesh_ << "property uchar blue" << std::endl;
+    if (has_color_()) {
+        outputMesh_ << "property uchar red\n";
+        outputMesh_ << "property uchar green\n";
+        outputMesh_ << "property uchar blue\n";
     }
 
     // Face Info for Header
-    if (mesh_->GetNumberOfCells() != 0) {
-        outputMesh_ << "element face " << mesh_->GetNumberOfCells()
-                    << std::endl;
-        outputMesh_ << "property list uchar int vertex_indices" << std::endl;
+    if (num_faces_() != 0) {
+        outputMesh_ << "element face " << num_faces_() << "\n";
+        outputMesh_ << "property list uchar int vertex_indices\n";
     }
 
     // End header
-    outputMesh_ << "end_header" << std::endl;
+    outputMesh_ << "end_header\n";
 
     return EXIT_SUCCESS;
 }
@@ -95,44 +153,97 @@ auto PLYWriter::write_header_() -> int
 // Write the vertex information: 'x y z nx ny nz'
 auto PLYWriter::write_vertices_() -> int
 {
-    if (!outputMesh_.is_open() || mesh_->GetNumberOfPoints() == 0) {
+    if (!outputMesh_.is_open() || num_vertices_() == 0) {
         return EXIT_FAILURE;
     }
     Logger()->info("Writing vertices...");
 
-    // Iterate over all of the points
-    for (auto point = mesh_->GetPoints()->Begin();
-         point != mesh_->GetPoints()->End(); ++point) {
-
-        // Get the point's normal
-        ITKPixel normal;
-        mesh_->GetPointData(point.Index(), &normal);
-
-        // Write the point position components and its normal components.
-        outputMesh_ << point.Value()[0] << " " << point.Value()[1] << " "
-                    << point.Value()[2] << " ";
-        outputMesh_ << normal[0] << " " << normal[1] << " " << normal[2];
-
+    // Write a point with its normal and color
+    std::string buf;
+    buf.reserve(BUFFER_SIZE + 256);
+    auto hasUVMap = uvMap_ and not uvMap_->empty();
+    auto hasTexture = not texture_.empty() and
+                      (hasUVMap or (triMesh_ and triMesh_->hasUVs()));
+    auto hasColor = has_color_();
+    auto writeVertex = [&](std::size_t idx, const cv::Vec3d& point,
+                           const cv::Vec3d& normal) {
+        // Get the point's color
+        int i{0};
         // If the texture has images and a uv map, write texture info
-        if (not texture_.empty() and uvMap_ and not uvMap_->empty()) {
+        if (hasTexture) {
             // Get the intensity for this point from the texture. If it doesn't
             // exist, set to 0.
             double intensity{0};
-            if (uvMap_->contains(point.Index())) {
-                intensity = PtIntensity(point.Index(), uvMap_, texture_);
-                intensity = cvRound(intensity * 255.0 / 65535.0);
+            if (hasUVMap and uvMap_->contains(idx)) {
+                intensity = PtIntensity(uvMap_->get(idx), texture_);
+            } else if (not hasUVMap) {
+                intensity = PtIntensity(triMesh_->uvs()[idx], texture_);
             }
-
-            auto i = static_cast<int>(intensity);
-            outputMesh_ << " " << i << " " << i << " " << i;
+            intensity = cvRound(intensity * 255.0 / 65535.0);
+            i = static_cast<int>(intensity);
         } else if (not vcolors_.empty()) {
-            float val = vcolors_.at(point.Index());
-            auto i = static_cast<int>(val * 255.F / 65535.F);
-            outputMesh_ << " " << i << " " << i << " " << i;
+            float val = vcolors_.at(idx);
+            i = static_cast<int>(val * 255.F / 65535.F);
         }
 
-        outputMesh_ << std::endl;
+        // Write the point position components and its normal components.
+        if (binary_) {
+            for (int d = 0; d < 3; d++) {
+                AppendLE(buf, static_cast<float>(point[d]));
+            }
+            for (int d = 0; d < 3; d++) {
+                AppendLE(buf, static_cast<float>(normal[d]));
+            }
+            if (hasColor) {
+                auto c = static_cast<std::uint8_t>(i);
+                AppendLE(buf, c);
+                AppendLE(buf, c);
+                AppendLE(buf, c);
+            }
+        } else {
+            AppendNumber(buf, point[0]);
+            buf += ' ';
+            AppendNumber(buf, point[1]);
+            buf += ' ';
+            AppendNumber(buf, point[2]);
+            buf += ' ';
+            AppendNumber(buf, normal[0]);
+            buf += ' ';
+            AppendNumber(buf, normal[1]);
+            buf += ' ';
+            AppendNumber(buf, normal[2]);
+            if (hasColor) {
+                for (int c = 0; c < 3; c++) {
+                    buf += ' ';
+                    AppendNumber(buf, i);
+                }
+            }
+            buf += '\n';
+        }
+        FlushBuffer(outputMesh_, buf);
+    };
+
+    // Iterate over the points of the mesh
+    if (triMesh_) {
+        auto hasTriNormals = triMesh_->hasNormals();
+        for (std::size_t idx = 0; idx < triMesh_->numVertices(); idx++) {
+            cv::Vec3d normal;
+            if (hasTriNormals) {
+                normal = triMesh_->normals()[idx];
+            }
+            writeVertex(idx, triMesh_->vertices()[idx], normal);
+        }
+    } else {
+        for (auto point = mesh_->GetPoints()->Begin();
+             point != mesh_->GetPoints()->End(); ++point) {
+            ITKPixel n;
+            mesh_->GetPointData(point.Index(), &n);
+            const auto& pt = point.Value();
+            writeVertex(
+                point.Index(), {pt[0], pt[1], pt[2]}, {n[0], n[1], n[2]});
+        }
     }
+    FlushBuffer(outputMesh_, buf, true);
 
     return EXIT_SUCCESS;
 }
@@ -140,24 +251,48 @@ auto PLYWriter::write_vertices_() -> int
 // Write the face information: 'n#-of-verts v1 v1 ... vn'
 auto PLYWriter::write_faces_() -> int
 {
-    if (!outputMesh_.is_open() || mesh_->GetNumberOfCells() == 0) {
+    if (!outputMesh_.is_open() || num_faces_() == 0) {
         return EXIT_FAILURE;
     }
     Logger()->info("Writing faces...");
 
+    // Write a face with n vertices
+    std::string buf;
+    buf.reserve(BUFFER_SIZE + 256);
+    auto appendFace = [this, &buf](auto first, auto last) {
+        auto numPoints = std::distance(first, last);
+        if (binary_) {
+            AppendLE(buf, static_cast<std::uint8_t>(numPoints));
+        } else {
+            AppendNumber(buf, numPoints);
+        }
+        for (auto point = first; point != last; ++point) {
+            if (binary_) {
+                AppendLE(buf, static_cast<std::int32_t>(*point));
+            } else {
+                buf += ' ';
+                AppendNumber(buf, *point);
+            }
+        }
+        if (not binary_) {
+            buf += '\n';
+        }
+        FlushBuffer(outputMesh_, buf);
+    };
+
     // Iterate over the faces of the mesh
-    ITKPointInCellIterator point;
-    for (auto cell = mesh_->GetCells()->Begin();
-         cell != mesh_->GetCells()->End(); ++cell) {
-        outputMesh_ << cell->Value()->GetNumberOfPoints();
-
-        // Iterate over the points of this face and write the point IDs
-        for (point = cell.Value()->PointIdsBegin();
-             point != cell.Value()->PointIdsEnd(); ++point) {
-            outputMesh_ << " " << *point;
+    if (triMesh_) {
+        for (const auto& f : triMesh_->faces()) {
+            appendFace(f.begin(), f.end());
+        }
+    } else {
+        for (auto cell = mesh_->GetCells()->Begin();
+             cell != mesh_->GetCells()->End(); ++cell) {
+            appendFace(
+                cell.Value()->PointIdsBegin(), cell.Value()->PointIdsEnd());
         }
-        outputMesh_ << std::endl;
     }
+    FlushBuffer(outputMesh_, buf, true);
 
     return EXIT_SUCCESS;
 }
@@ -167,6 +302,8 @@ void PLYWriter::setVertexColors(const std::vector<uint16_t>& c)
     vcolors_ = c;
 }
 
+void PLYWriter::setBinary(bool b) { binary_ = b; }
+
 PLYWriter::PLYWriter(fs::path outputPath, ITKMesh::Pointer mesh)
     : outputPath_{std::move(outputPath)}, mesh_{std::move(mesh)}
 {
@@ -180,6 +317,15 @@ PLYWriter::PLYWriter(
 {
 }
 void PLYWriter::setPath(const filesystem::path& path) { outputPath_ = path; }
-void PLYWriter::setMesh(ITKMesh::Pointer mesh) { mesh_ = std::move(mesh); }
+void PLYWriter::setMesh(ITKMesh::Pointer mesh)
+{
+    mesh_ = std::move(mesh);
+    triMesh_ = nullptr;
+}
+void PLYWriter::setMesh(TriangleMesh::Pointer mesh)
+{
+    triMesh_ = std::move(mesh);
+    mesh_ = nullptr;
+}
 void PLYWriter::setUVMap(UVMap::Pointer uvMap) { uvMap_ = std::move(uvMap); }
 void PLYWriter::setTexture(cv::Mat texture) { texture_ = std::move(texture); }
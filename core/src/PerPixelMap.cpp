@@ -1,5 +1,7 @@
 #include "vc/core/types/PerPixelMap.hpp"
 
+#include <stdexcept>
+
 #include <opencv2/imgcodecs.hpp>
 
 #include "vc/core/io/PointSetIO.hpp"
@@ -70,6 +72,32 @@ auto PerPixelMap::getMappings() const -> std::vector<PPM::PixelMap>
     return mappings;
 }
 
+auto PerPixelMap::crop(const cv::Rect& region) const -> PerPixelMap
+{
+    cv::Rect bounds{0, 0, static_cast<int>(width_), static_cast<int>(height_)};
+    if (region.empty() or (region & bounds) != region) {
+        throw std::invalid_argument("Region is not contained in the map");
+    }
+
+    auto rows = static_cast<size_t>(region.height);
+    auto cols = static_cast<size_t>(region.width);
+    PerPixelMap result(rows, cols);
+    for (size_t y = 0; y < rows; ++y) {
+        for (size_t x = 0; x < cols; ++x) {
+            result(y, x) = map_(
+                y + static_cast<size_t>(region.y),
+                x + static_cast<size_t>(region.x));
+        }
+    }
+    if (not mask_.empty()) {
+        result.mask_ = mask_(region).clone();
+    }
+    if (not cellMap_.empty()) {
+        result.cellMap_ = cellMap_(region).clone();
+    }
+    return result;
+}
+
 // Initialize map
 void PerPixelMap::initialize_map_()
 {
@@ -1,6 +1,10 @@
 #include "vc/core/io/TIFFIO.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <opencv2/imgproc.hpp>
 
@@ -16,10 +20,112 @@ namespace lt
 namespace tio = volcart::tiffio;
 namespace fs = volcart::filesystem;
 
+namespace
+{
+// Get the TIFF sample format and bits per sample of an image depth
+auto GetSampleFormat(int depth) -> std::pair<int, int>
+{
+    switch (depth) {
+        case CV_8U:
+            return {SAMPLEFORMAT_UINT, 8};
+        case CV_8S:
+            return {SAMPLEFORMAT_INT, 8};
+        case CV_16U:
+            return {SAMPLEFORMAT_UINT, 16};
+        case CV_16S:
+            return {SAMPLEFORMAT_INT, 16};
+        case CV_32S:
+            return {SAMPLEFORMAT_INT, 32};
+        case CV_32F:
+            return {SAMPLEFORMAT_IEEEFP, 32};
+        case CV_64F:
+            return {SAMPLEFORMAT_IEEEFP, 64};
+        default:
+            throw std::runtime_error("Unsupported image depth");
+    }
+}
+
+// Get a copy of an image with its channels in TIFF (RGB) order
+auto ToTIFFChannels(const cv::Mat& img) -> cv::Mat
+{
+    cv::Mat imgCopy;
+    if (img.channels() == 3) {
+        cv::cvtColor(img, imgCopy, cv::COLOR_BGR2RGB);
+    } else if (img.channels() == 4) {
+        cv::cvtColor(img, imgCopy, cv::COLOR_BGRA2RGBA);
+    } else {
+        imgCopy = img;
+    }
+    return imgCopy;
+}
+
+// Encode and write the tile at (x, y), padding the edges with zeros. libtiff
+// may modify the buffer passed to the encoder, so we can't use the cv::Mat
+// directly.
+void WriteTile(
+    lt::TIFF* out,
+    const cv::Mat& img,
+    unsigned x,
+    unsigned y,
+    unsigned tileWidth,
+    unsigned tileHeight,
+    std::vector<char>& buffer)
+{
+    auto width = static_cast<unsigned>(img.cols);
+    auto height = static_cast<unsigned>(img.rows);
+    auto pixelSize = img.elemSize();
+    auto tileSize = static_cast<size_t>(lt::TIFFTileSize(out));
+    auto tileRowSize = tileWidth * pixelSize;
+    buffer.assign(tileSize, 0);
+    auto rows = std::min(tileHeight, height - y);
+    auto cols = std::min(tileWidth, width - x);
+    for (unsigned r = 0; r < rows; r++) {
+        std::memcpy(
+            &buffer[r * tileRowSize], img.ptr(y + r) + x * pixelSize,
+            cols * pixelSize);
+    }
+    auto tile = lt::TIFFComputeTile(out, x, y, 0, 0);
+    auto result = lt::TIFFWriteEncodedTile(out, tile, &buffer[0], tileSize);
+    if (result == -1) {
+        lt::TIFFClose(out);
+        throw std::runtime_error(
+            "Failed to write tile " + std::to_string(tile));
+    }
+}
+
+// Encode and write the strip which starts at row y
+void WriteStrip(
+    lt::TIFF* out,
+    const cv::Mat& img,
+    unsigned y,
+    unsigned rowsPerStrip,
+    std::vector<char>& buffer)
+{
+    auto height = static_cast<unsigned>(img.rows);
+    auto rowSize = img.cols * img.elemSize();
+    auto rows = std::min(rowsPerStrip, height - y);
+    buffer.resize(rows * rowSize);
+    for (unsigned r = 0; r < rows; r++) {
+        std::memcpy(&buffer[r * rowSize], img.ptr(y + r), rowSize);
+    }
+    auto strip = lt::TIFFComputeStrip(out, y, 0);
+    auto result =
+        lt::TIFFWriteEncodedStrip(out, strip, &buffer[0], rows * rowSize);
+    if (result == -1) {
+        lt::TIFFClose(out);
+        throw std::runtime_error(
+            "Failed to write strip " + std::to_string(strip));
+    }
+}
+}  // namespace
+
 // Write a TIFF to a file. This implementation heavily borrows from how OpenCV's
 // TIFFEncoder writes to the TIFF
 void tio::WriteTIFF(
-    const fs::path& path, const cv::Mat& img, Compression compression)
+    const fs::path& path,
+    const cv::Mat& img,
+    Compression compression,
+    const Layout& layout)
 {
     // Safety checks
     if (img.channels() < 1 or img.channels() > 4) {
@@ -31,47 +137,23 @@ void tio::WriteTIFF(
             "Invalid file extension " + path.extension().string());
     }
 
+    auto tiled = layout.tileWidth > 0 or layout.tileHeight > 0;
+    if (tiled and (layout.tileWidth == 0 or layout.tileWidth % 16 != 0 or
+                   layout.tileHeight == 0 or layout.tileHeight % 16 != 0)) {
+        throw std::runtime_error("Tile dimensions must be multiples of 16");
+    }
+
     // Image metadata
     auto channels = img.channels();
     auto width = static_cast<unsigned>(img.cols);
     auto height = static_cast<unsigned>(img.rows);
     auto rowsPerStrip = height;
+    if (layout.rowsPerStrip > 0) {
+        rowsPerStrip = std::min(layout.rowsPerStrip, height);
+    }
 
     // Sample format
-    int bitsPerSample;
-    int sampleFormat;
-    switch (img.depth()) {
-        case CV_8U:
-            sampleFormat = SAMPLEFORMAT_UINT;
-            bitsPerSample = 8;
-            break;
-        case CV_8S:
-            sampleFormat = SAMPLEFORMAT_INT;
-            bitsPerSample = 8;
-            break;
-        case CV_16U:
-            sampleFormat = SAMPLEFORMAT_UINT;
-            bitsPerSample = 16;
-            break;
-        case CV_16S:
-            sampleFormat = SAMPLEFORMAT_INT;
-            bitsPerSample = 16;
-            break;
-        case CV_32S:
-            sampleFormat = SAMPLEFORMAT_INT;
-            bitsPerSample = 32;
-            break;
-        case CV_32F:
-            sampleFormat = SAMPLEFORMAT_IEEEFP;
-            bitsPerSample = 32;
-            break;
-        case CV_64F:
-            sampleFormat = SAMPLEFORMAT_IEEEFP;
-            bitsPerSample = 64;
-            break;
-        default:
-            throw std::runtime_error("Unsupported image depth");
-    }
+    auto [sampleFormat, bitsPerSample] = GetSampleFormat(img.depth());
 
     // Photometric Interpretation
     int photometric;
@@ -103,7 +185,12 @@ void tio::WriteTIFF(
     lt::TIFFSetField(out, TIFFTAG_SAMPLEFORMAT, sampleFormat);
     lt::TIFFSetField(out, TIFFTAG_BITSPERSAMPLE, bitsPerSample);
     lt::TIFFSetField(out, TIFFTAG_SAMPLESPERPIXEL, channels);
-    lt::TIFFSetField(out, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+    if (tiled) {
+        lt::TIFFSetField(out, TIFFTAG_TILEWIDTH, layout.tileWidth);
+        lt::TIFFSetField(out, TIFFTAG_TILELENGTH, layout.tileHeight);
+    } else {
+        lt::TIFFSetField(out, TIFFTAG_ROWSPERSTRIP, rowsPerStrip);
+    }
 
     // Add alpha tag data
     // TODO: Let user decide associated/unassociated tag
@@ -117,32 +204,99 @@ void tio::WriteTIFF(
     lt::TIFFSetField(
         out, TIFFTAG_SOFTWARE, ProjectInfo::NameAndVersion().c_str());
 
-    // Row buffer. OpenCV documentation mentions that TIFFWriteScanline
-    // modifies its read buffer, so we can't use the cv::Mat directly
-    auto bufferSize = static_cast<size_t>(lt::TIFFScanlineSize(out));
-    std::vector<char> buffer(bufferSize + 32);
-
     // Get working copy with converted channels if an RGB-type image
-    cv::Mat imgCopy;
-    if (img.channels() == 3) {
-        cv::cvtColor(img, imgCopy, cv::COLOR_BGR2RGB);
-    } else if (img.channels() == 4) {
-        cv::cvtColor(img, imgCopy, cv::COLOR_BGRA2RGBA);
+    auto imgCopy = ToTIFFChannels(img);
+
+    // Write tiles or strips
+    std::vector<char> buffer;
+    if (tiled) {
+        for (unsigned y = 0; y < height; y += layout.tileHeight) {
+            for (unsigned x = 0; x < width; x += layout.tileWidth) {
+                WriteTile(
+                    out, imgCopy, x, y, layout.tileWidth, layout.tileHeight,
+                    buffer);
+            }
+        }
     } else {
-        imgCopy = img;
+        for (unsigned y = 0; y < height; y += rowsPerStrip) {
+            WriteStrip(out, imgCopy, y, rowsPerStrip, buffer);
+        }
+    }
+
+    // Close the tiff
+    lt::TIFFClose(out);
+}
+
+auto tio::UpdateTIFF(
+    const fs::path& path, const cv::Mat& img, const cv::Rect& roi) -> bool
+{
+    if (img.channels() < 1 or img.channels() > 4) {
+        throw std::runtime_error("Unsupported number of channels");
+    }
+    auto [sampleFormat, bitsPerSample] = GetSampleFormat(img.depth());
+    if (not fs::exists(path)) {
+        return false;
+    }
+
+    // Open the file for in-place modification
+    auto out = lt::TIFFOpen(path.c_str(), "r+");
+    if (out == nullptr) {
+        return false;
     }
 
-    // For each row
-    for (unsigned row = 0; row < height; row++) {
-        std::memcpy(&buffer[0], imgCopy.ptr(row), bufferSize);
-        auto result = lt::TIFFWriteScanline(out, &buffer[0], row, 0);
-        if (result == -1) {
-            lt::TIFFClose(out);
-            auto msg = "Failed to write row " + std::to_string(row);
-            throw std::runtime_error(msg);
+    // Check that the file's image data matches the image
+    std::uint32_t width{0};
+    std::uint32_t height{0};
+    std::uint16_t fileBits{0};
+    std::uint16_t fileChannels{0};
+    std::uint16_t fileFormat{0};
+    std::uint16_t planar{0};
+    lt::TIFFGetField(out, TIFFTAG_IMAGEWIDTH, &width);
+    lt::TIFFGetField(out, TIFFTAG_IMAGELENGTH, &height);
+    lt::TIFFGetFieldDefaulted(out, TIFFTAG_BITSPERSAMPLE, &fileBits);
+    lt::TIFFGetFieldDefaulted(out, TIFFTAG_SAMPLESPERPIXEL, &fileChannels);
+    lt::TIFFGetFieldDefaulted(out, TIFFTAG_SAMPLEFORMAT, &fileFormat);
+    lt::TIFFGetFieldDefaulted(out, TIFFTAG_PLANARCONFIG, &planar);
+    if (width != static_cast<std::uint32_t>(img.cols) or
+        height != static_cast<std::uint32_t>(img.rows) or
+        fileBits != bitsPerSample or fileChannels != img.channels() or
+        fileFormat != sampleFormat or planar != PLANARCONFIG_CONTIG) {
+        lt::TIFFClose(out);
+        return false;
+    }
+
+    // Rewrite the tiles or strips which overlap the region
+    auto region = roi & cv::Rect(0, 0, img.cols, img.rows);
+    if (region.empty()) {
+        lt::TIFFClose(out);
+        return true;
+    }
+    auto imgCopy = ToTIFFChannels(img);
+    std::vector<char> buffer;
+    auto top = static_cast<unsigned>(region.y);
+    auto bottom = static_cast<unsigned>(region.y + region.height);
+    if (lt::TIFFIsTiled(out) != 0) {
+        std::uint32_t tileWidth{0};
+        std::uint32_t tileHeight{0};
+        lt::TIFFGetField(out, TIFFTAG_TILEWIDTH, &tileWidth);
+        lt::TIFFGetField(out, TIFFTAG_TILELENGTH, &tileHeight);
+        auto left = static_cast<unsigned>(region.x);
+        auto right = static_cast<unsigned>(region.x + region.width);
+        for (auto y = top - top % tileHeight; y < bottom; y += tileHeight) {
+            for (auto x = left - left % tileWidth; x < right; x += tileWidth) {
+                WriteTile(out, imgCopy, x, y, tileWidth, tileHeight, buffer);
+            }
+        }
+    } else {
+        std::uint32_t rowsPerStrip{0};
+        lt::TIFFGetFieldDefaulted(out, TIFFTAG_ROWSPERSTRIP, &rowsPerStrip);
+        rowsPerStrip = std::clamp<std::uint32_t>(rowsPerStrip, 1, height);
+        for (auto y = top - top % rowsPerStrip; y < bottom; y += rowsPerStrip) {
+            WriteStrip(out, imgCopy, y, rowsPerStrip, buffer);
         }
     }
 
-    // Close the tiff
+    // Close the tiff, which updates the strip/tile offsets
     lt::TIFFClose(out);
+    return true;
 }
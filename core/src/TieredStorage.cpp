@@ -0,0 +1,280 @@
+#include "vc/core/types/TieredStorage.hpp"
+
+#include <algorithm>
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
+using namespace volcart;
+
+namespace fs = volcart::filesystem;
+
+#ifdef VC_USE_BOOSTFS
+using ErrorCode = boost::system::error_code;
+#else
+using ErrorCode = std::error_code;
+#endif
+
+static constexpr const char* PARTIAL_EXT{".part"};
+
+TieredStorage::TieredStorage(fs::path root, std::vector<fs::path> tiers)
+    : root_{std::move(root)}, tiers_{std::move(tiers)}
+{
+    // The canonical root is always the slowest tier
+    if (tiers_.empty() or tiers_.back() != root_) {
+        tiers_.push_back(root_);
+    }
+    load_manifest_();
+}
+
+auto TieredStorage::New(fs::path root, std::vector<fs::path> tiers)
+    -> Pointer
+{
+    return std::make_shared<TieredStorage>(std::move(root), std::move(tiers));
+}
+
+TieredStorage::~TieredStorage()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+        queue_.clear();
+    }
+    cv_.notify_all();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+auto TieredStorage::resolve(const fs::path& path) -> fs::path
+{
+    auto rel = relative_(path);
+    if (rel.empty()) {
+        return path;
+    }
+    auto key = rel.generic_string();
+
+    // Probe the tiers once, without holding the lock
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+        lock.unlock();
+        auto tier = probe_(rel);
+        lock.lock();
+        it = index_.emplace(key, Location{tier, 0}).first;
+    }
+    auto& loc = it->second;
+    loc.loads++;
+
+    // Queue hot files on slower tiers for promotion
+    if (budget_ > 0 and loc.tier > 0 and loc.loads >= threshold_ and
+        promotedBytes_ < budget_ and pending_.count(key) == 0) {
+        pending_.insert(key);
+        queue_.push_back(key);
+        if (not worker_.joinable()) {
+            worker_ = std::thread(&TieredStorage::run_, this);
+        }
+        cv_.notify_one();
+    }
+    return tiers_[loc.tier] / rel;
+}
+
+void TieredStorage::invalidate(const fs::path& path)
+{
+    auto rel = relative_(path);
+    if (rel.empty()) {
+        return;
+    }
+    auto key = rel.generic_string();
+
+    // Mirrors may still hold the old file, so only the canonical copy is
+    // current until the file is promoted again
+    std::unique_lock<std::mutex> lock(mutex_);
+    index_[key] = {tiers_.size() - 1, 0};
+    if (pending_.count(key) > 0) {
+        discard_.insert(key);
+    }
+    auto it = promoted_.find(key);
+    if (it != promoted_.end()) {
+        ErrorCode ec;
+        fs::remove(tiers_.front() / rel, ec);
+        promotedBytes_ -= it->second;
+        promoted_.erase(it);
+        save_manifest_();
+    }
+}
+
+auto TieredStorage::tiers() const -> std::vector<fs::path> { return tiers_; }
+
+void TieredStorage::setPromotionBudget(std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    budget_ = bytes;
+}
+
+void TieredStorage::setPromotionThreshold(std::size_t loads)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    threshold_ = std::max<std::size_t>(loads, 1);
+}
+
+auto TieredStorage::promotedBytes() const -> std::size_t
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return promotedBytes_;
+}
+
+void TieredStorage::waitForPromotions()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this]() { return pending_.empty(); });
+}
+
+auto TieredStorage::relative_(const fs::path& path) const -> fs::path
+{
+    auto rel = path.lexically_relative(root_);
+    if (rel.empty() or *rel.begin() == "..") {
+        return {};
+    }
+    return rel;
+}
+
+auto TieredStorage::probe_(const fs::path& rel) const -> std::size_t
+{
+    for (std::size_t tier = 0; tier + 1 < tiers_.size(); tier++) {
+        ErrorCode ec;
+        if (fs::exists(tiers_[tier] / rel, ec)) {
+            return tier;
+        }
+    }
+    return tiers_.size() - 1;
+}
+
+void TieredStorage::run_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stop_ or not queue_.empty(); });
+        if (stop_) {
+            return;
+        }
+        auto key = queue_.front();
+        queue_.pop_front();
+        auto tier = index_.count(key) > 0 ? index_[key].tier : 0;
+        auto budget = budget_ - std::min(budget_, promotedBytes_);
+        lock.unlock();
+
+        // Copy without holding the lock
+        std::size_t size{0};
+        if (tier > 0) {
+            ErrorCode ec;
+            auto src = tiers_[tier] / key;
+            auto bytes = fs::file_size(src, ec);
+            if (not ec and bytes <= budget) {
+                size = promote_(src, fs::path(key));
+            }
+        }
+
+        lock.lock();
+        // Drop copies of files which were rewritten during the copy
+        if (size > 0 and discard_.count(key) > 0) {
+            ErrorCode ec;
+            fs::remove(tiers_.front() / key, ec);
+            size = 0;
+        }
+        discard_.erase(key);
+        auto it = index_.find(key);
+        if (size > 0) {
+            promoted_[key] = size;
+            promotedBytes_ += size;
+            if (it != index_.end()) {
+                it->second.tier = 0;
+            }
+            save_manifest_();
+        } else if (it != index_.end()) {
+            // Retry failed promotions after another `threshold` loads
+            it->second.loads = 0;
+        }
+        pending_.erase(key);
+        if (pending_.empty()) {
+            idle_.notify_all();
+        }
+    }
+}
+
+auto TieredStorage::promote_(const fs::path& src, const fs::path& rel)
+    -> std::size_t
+{
+    // Copy to a temporary file so that readers never see a partial copy
+    ErrorCode ec;
+    auto dst = tiers_.front() / rel;
+    auto tmp = dst;
+    tmp += PARTIAL_EXT;
+    fs::create_directories(dst.parent_path(), ec);
+    if (ec) {
+        return 0;
+    }
+    fs::copy_file(src, tmp, fs::copy_options::overwrite_existing, ec);
+    if (not ec) {
+        fs::rename(tmp, dst, ec);
+    }
+    if (ec) {
+        fs::remove(tmp, ec);
+        return 0;
+    }
+    auto size = fs::file_size(dst, ec);
+    return ec ? 0 : static_cast<std::size_t>(size);
+}
+
+void TieredStorage::load_manifest_()
+{
+    if (tiers_.size() < 2) {
+        return;
+    }
+    auto path = tiers_.front() / MANIFEST_NAME;
+    ErrorCode ec;
+    if (not fs::exists(path, ec)) {
+        return;
+    }
+
+    // A corrupt manifest is ignored and rewritten by the next promotion
+    nlohmann::json manifest;
+    try {
+        std::ifstream file(path.string());
+        file >> manifest;
+        for (const auto& f : manifest.at("files").items()) {
+            auto size = f.value().get<std::size_t>();
+            promoted_[f.key()] = size;
+            promotedBytes_ += size;
+        }
+    } catch (const nlohmann::json::exception&) {
+        promoted_.clear();
+        promotedBytes_ = 0;
+    }
+}
+
+void TieredStorage::save_manifest_() const
+{
+    nlohmann::json manifest;
+    manifest["files"] = nlohmann::json::object();
+    for (const auto& [key, size] : promoted_) {
+        manifest["files"][key] = size;
+    }
+
+    // Write then rename so the manifest is never partially written
+    auto path = tiers_.front() / MANIFEST_NAME;
+    auto tmp = path;
+    tmp += PARTIAL_EXT;
+    {
+        std::ofstream file(tmp.string());
+        if (not file) {
+            return;
+        }
+        file << manifest.dump(4) << std::endl;
+    }
+    ErrorCode ec;
+    fs::rename(tmp, path, ec);
+    if (ec) {
+        fs::remove(tmp, ec);
+    }
+}
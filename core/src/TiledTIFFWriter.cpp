@@ -0,0 +1,416 @@
+#include "vc/core/io/TiledTIFFWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <opencv2/imgproc.hpp>
+#include <zlib.h>
+
+#include "vc/core/Version.hpp"
+#include "vc/core/io/FileExtensionFilter.hpp"
+
+namespace tio = volcart::tiffio;
+namespace fs = volcart::filesystem;
+
+using TiledTIFFWriter = tio::TiledTIFFWriter;
+
+namespace
+{
+// TIFF tags
+constexpr std::uint16_t TAG_IMAGE_WIDTH{256};
+constexpr std::uint16_t TAG_IMAGE_LENGTH{257};
+constexpr std::uint16_t TAG_BITS_PER_SAMPLE{258};
+constexpr std::uint16_t TAG_COMPRESSION{259};
+constexpr std::uint16_t TAG_PHOTOMETRIC{262};
+constexpr std::uint16_t TAG_SAMPLES_PER_PIXEL{277};
+constexpr std::uint16_t TAG_PLANAR_CONFIG{284};
+constexpr std::uint16_t TAG_SOFTWARE{305};
+constexpr std::uint16_t TAG_TILE_WIDTH{322};
+constexpr std::uint16_t TAG_TILE_LENGTH{323};
+constexpr std::uint16_t TAG_TILE_OFFSETS{324};
+constexpr std::uint16_t TAG_TILE_BYTE_COUNTS{325};
+constexpr std::uint16_t TAG_EXTRA_SAMPLES{338};
+constexpr std::uint16_t TAG_SAMPLE_FORMAT{339};
+
+// TIFF field types
+constexpr std::uint16_t TYPE_ASCII{2};
+constexpr std::uint16_t TYPE_SHORT{3};
+constexpr std::uint16_t TYPE_LONG{4};
+constexpr std::uint16_t TYPE_LONG8{16};
+
+// Tag values
+constexpr std::uint16_t PHOTOMETRIC_MINISBLACK{1};
+constexpr std::uint16_t PHOTOMETRIC_RGB{2};
+constexpr std::uint16_t PLANARCONFIG_CONTIG{1};
+constexpr std::uint16_t EXTRASAMPLE_UNASSALPHA{2};
+constexpr std::uint16_t SAMPLEFORMAT_UINT{1};
+constexpr std::uint16_t SAMPLEFORMAT_INT{2};
+constexpr std::uint16_t SAMPLEFORMAT_IEEEFP{3};
+
+// BigTIFF header
+constexpr std::uint16_t BIGTIFF_VERSION{43};
+constexpr std::uint16_t BIGTIFF_OFFSET_SIZE{8};
+constexpr std::size_t BIGTIFF_HEADER_SIZE{16};
+constexpr std::size_t BIGTIFF_INLINE_SIZE{8};
+
+// A single IFD entry
+struct Entry {
+    std::uint16_t tag;
+    std::uint16_t type;
+    std::uint64_t count;
+    std::vector<char> data;
+};
+
+// Append a value to a byte buffer in host byte order. The file's byte order
+// marker is set to match the host.
+template <typename T>
+void Append(std::vector<char>& buf, T val)
+{
+    auto pos = buf.size();
+    buf.resize(pos + sizeof(T));
+    std::memcpy(&buf[pos], &val, sizeof(T));
+}
+
+template <typename T>
+auto MakeEntry(std::uint16_t tag, std::uint16_t type, const std::vector<T>& v)
+    -> Entry
+{
+    Entry e{tag, type, v.size(), {}};
+    for (const auto& val : v) {
+        Append(e.data, val);
+    }
+    return e;
+}
+
+auto HostIsLittleEndian() -> bool
+{
+    std::uint16_t val{1};
+    char first{0};
+    std::memcpy(&first, &val, 1);
+    return first == 1;
+}
+
+auto SampleFormat(int depth) -> std::pair<std::uint16_t, std::uint16_t>
+{
+    switch (depth) {
+        case CV_8U:
+            return {SAMPLEFORMAT_UINT, 8};
+        case CV_8S:
+            return {SAMPLEFORMAT_INT, 8};
+        case CV_16U:
+            return {SAMPLEFORMAT_UINT, 16};
+        case CV_16S:
+            return {SAMPLEFORMAT_INT, 16};
+        case CV_32S:
+            return {SAMPLEFORMAT_INT, 32};
+        case CV_32F:
+            return {SAMPLEFORMAT_IEEEFP, 32};
+        case CV_64F:
+            return {SAMPLEFORMAT_IEEEFP, 64};
+        default:
+            throw std::runtime_error("Unsupported image depth");
+    }
+}
+}  // namespace
+
+TiledTIFFWriter::TiledTIFFWriter(
+    const fs::path& path,
+    std::uint32_t width,
+    std::uint32_t height,
+    int type,
+    std::size_t numPages,
+    std::uint32_t tileWidth,
+    std::uint32_t tileHeight,
+    Compression compression)
+    : width_{width}
+    , height_{height}
+    , type_{type}
+    , numPages_{numPages}
+    , tileWidth_{tileWidth}
+    , tileHeight_{tileHeight}
+    , compression_{compression}
+{
+    // Safety checks
+    auto channels = CV_MAT_CN(type);
+    if (channels < 1 or channels > 4) {
+        throw std::runtime_error("Unsupported number of channels");
+    }
+    SampleFormat(CV_MAT_DEPTH(type));
+
+    if (not io::FileExtensionFilter(path, {"tif", "tiff"})) {
+        throw std::runtime_error(
+            "Invalid file extension " + path.extension().string());
+    }
+
+    if (width == 0 or height == 0 or numPages == 0) {
+        throw std::runtime_error("Image dimensions must be nonzero");
+    }
+
+    if (tileWidth == 0 or tileWidth % 16 != 0 or tileHeight == 0 or
+        tileHeight % 16 != 0) {
+        throw std::runtime_error("Tile dimensions must be multiples of 16");
+    }
+
+    if (compression != Compression::NONE and
+        compression != Compression::ADOBE_DEFLATE and
+        compression != Compression::DEFLATE) {
+        throw std::runtime_error("Unsupported compression for tiled TIFF");
+    }
+
+    // Tile bookkeeping
+    tilesAcross_ = (width + tileWidth - 1) / tileWidth;
+    tilesDown_ = (height + tileHeight - 1) / tileHeight;
+    auto numTiles = std::size_t{tilesAcross_} * tilesDown_;
+    offsets_.assign(numPages, std::vector<std::uint64_t>(numTiles, 0));
+    byteCounts_.assign(numPages, std::vector<std::uint64_t>(numTiles, 0));
+
+    // Open the file
+    file_.open(path.string(), std::ios::binary | std::ios::trunc);
+    if (not file_.is_open()) {
+        throw std::runtime_error("Failed to open file for writing");
+    }
+
+    // Header. The first directory offset is filled in by close().
+    std::vector<char> header;
+    header.push_back(HostIsLittleEndian() ? 'I' : 'M');
+    header.push_back(header.back());
+    Append(header, BIGTIFF_VERSION);
+    Append(header, BIGTIFF_OFFSET_SIZE);
+    Append(header, std::uint16_t{0});
+    Append(header, std::uint64_t{0});
+    append_(header);
+}
+
+TiledTIFFWriter::~TiledTIFFWriter()
+{
+    if (file_.is_open()) {
+        try {
+            close();
+        } catch (...) {
+        }
+    }
+}
+
+auto TiledTIFFWriter::width() const -> std::uint32_t { return width_; }
+
+auto TiledTIFFWriter::height() const -> std::uint32_t { return height_; }
+
+auto TiledTIFFWriter::type() const -> int { return type_; }
+
+auto TiledTIFFWriter::numPages() const -> std::size_t { return numPages_; }
+
+auto TiledTIFFWriter::tileWidth() const -> std::uint32_t { return tileWidth_; }
+
+auto TiledTIFFWriter::tileHeight() const -> std::uint32_t
+{
+    return tileHeight_;
+}
+
+void TiledTIFFWriter::writeTile(
+    std::size_t page, std::uint32_t x, std::uint32_t y, const cv::Mat& tile)
+{
+    if (page >= numPages_) {
+        throw std::runtime_error("Invalid page " + std::to_string(page));
+    }
+    if (x >= width_ or y >= height_ or x % tileWidth_ != 0 or
+        y % tileHeight_ != 0) {
+        throw std::runtime_error("Tile position is not aligned to the grid");
+    }
+    if (tile.type() != type_ or tile.cols > static_cast<int>(tileWidth_) or
+        tile.rows > static_cast<int>(tileHeight_)) {
+        throw std::runtime_error("Tile type or size does not match the image");
+    }
+
+    // Compress outside of the lock
+    auto cols = std::min<std::uint32_t>(tile.cols, width_ - x);
+    auto rows = std::min<std::uint32_t>(tile.rows, height_ - y);
+    cv::Rect roi{0, 0, static_cast<int>(cols), static_cast<int>(rows)};
+    auto data = encode_(tile(roi));
+
+    auto idx = std::size_t{y / tileHeight_} * tilesAcross_ + x / tileWidth_;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (not file_.is_open()) {
+        throw std::runtime_error("File is closed");
+    }
+    offsets_[page][idx] = append_(data);
+    byteCounts_[page][idx] = data.size();
+}
+
+auto TiledTIFFWriter::encode_(const cv::Mat& tile) const -> std::vector<char>
+{
+    // Convert channel order if an RGB-type image
+    cv::Mat pixels;
+    if (tile.channels() == 3) {
+        cv::cvtColor(tile, pixels, cv::COLOR_BGR2RGB);
+    } else if (tile.channels() == 4) {
+        cv::cvtColor(tile, pixels, cv::COLOR_BGRA2RGBA);
+    } else {
+        pixels = tile;
+    }
+
+    // Copy into a zero-padded, full-size tile
+    auto pixelSize = CV_ELEM_SIZE(type_);
+    auto tileRowSize = tileWidth_ * pixelSize;
+    std::vector<char> raw(std::size_t{tileHeight_} * tileRowSize, 0);
+    for (int r = 0; r < pixels.rows; r++) {
+        std::memcpy(
+            &raw[r * tileRowSize], pixels.ptr(r), pixels.cols * pixelSize);
+    }
+
+    if (compression_ == Compression::NONE) {
+        return raw;
+    }
+
+    // Deflate
+    auto len = compressBound(static_cast<uLong>(raw.size()));
+    std::vector<char> compressed(len);
+    auto res = compress2(
+        reinterpret_cast<Bytef*>(compressed.data()), &len,
+        reinterpret_cast<const Bytef*>(raw.data()),
+        static_cast<uLong>(raw.size()), Z_DEFAULT_COMPRESSION);
+    if (res != Z_OK) {
+        throw std::runtime_error("Failed to compress tile");
+    }
+    compressed.resize(len);
+    return compressed;
+}
+
+auto TiledTIFFWriter::append_(const std::vector<char>& data) -> std::uint64_t
+{
+    auto offset = end_;
+    file_.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (file_.fail()) {
+        throw std::runtime_error("Failed to write to file");
+    }
+    end_ += data.size();
+
+    // Keep the next write word-aligned
+    if (end_ % 2 != 0) {
+        file_.put(0);
+        end_++;
+    }
+    return offset;
+}
+
+auto TiledTIFFWriter::write_directory_(
+    std::size_t page, std::uint64_t next) -> std::uint64_t
+{
+    auto channels = static_cast<std::uint16_t>(CV_MAT_CN(type_));
+    auto [format, bits] = SampleFormat(CV_MAT_DEPTH(type_));
+    auto photometric =
+        (channels >= 3) ? PHOTOMETRIC_RGB : PHOTOMETRIC_MINISBLACK;
+    auto software = ProjectInfo::NameAndVersion();
+
+    // Entries, in increasing tag order
+    std::vector<Entry> entries;
+    entries.push_back(MakeEntry(
+        TAG_IMAGE_WIDTH, TYPE_LONG, std::vector<std::uint32_t>{width_}));
+    entries.push_back(MakeEntry(
+        TAG_IMAGE_LENGTH, TYPE_LONG, std::vector<std::uint32_t>{height_}));
+    entries.push_back(MakeEntry(
+        TAG_BITS_PER_SAMPLE, TYPE_SHORT,
+        std::vector<std::uint16_t>(channels, bits)));
+    entries.push_back(MakeEntry(
+        TAG_COMPRESSION, TYPE_SHORT,
+        std::vector<std::uint16_t>{static_cast<std::uint16_t>(compression_)}));
+    entries.push_back(MakeEntry(
+        TAG_PHOTOMETRIC, TYPE_SHORT, std::vector<std::uint16_t>{photometric}));
+    entries.push_back(MakeEntry(
+        TAG_SAMPLES_PER_PIXEL, TYPE_SHORT,
+        std::vector<std::uint16_t>{channels}));
+    entries.push_back(MakeEntry(
+        TAG_PLANAR_CONFIG, TYPE_SHORT,
+        std::vector<std::uint16_t>{PLANARCONFIG_CONTIG}));
+    entries.push_back(MakeEntry(
+        TAG_SOFTWARE, TYPE_ASCII,
+        std::vector<char>(
+            software.c_str(), software.c_str() + software.size() + 1)));
+    entries.push_back(MakeEntry(
+        TAG_TILE_WIDTH, TYPE_LONG, std::vector<std::uint32_t>{tileWidth_}));
+    entries.push_back(MakeEntry(
+        TAG_TILE_LENGTH, TYPE_LONG, std::vector<std::uint32_t>{tileHeight_}));
+    entries.push_back(
+        MakeEntry(TAG_TILE_OFFSETS, TYPE_LONG8, offsets_[page]));
+    entries.push_back(
+        MakeEntry(TAG_TILE_BYTE_COUNTS, TYPE_LONG8, byteCounts_[page]));
+    if (channels == 2 or channels == 4) {
+        entries.push_back(MakeEntry(
+            TAG_EXTRA_SAMPLES, TYPE_SHORT,
+            std::vector<std::uint16_t>{EXTRASAMPLE_UNASSALPHA}));
+    }
+    entries.push_back(MakeEntry(
+        TAG_SAMPLE_FORMAT, TYPE_SHORT,
+        std::vector<std::uint16_t>(channels, format)));
+
+    // Write values which don't fit in an entry before the directory
+    std::vector<std::uint64_t> valueOffsets(entries.size(), 0);
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].data.size() > BIGTIFF_INLINE_SIZE) {
+            valueOffsets[i] = append_(entries[i].data);
+        }
+    }
+
+    // Directory
+    std::vector<char> ifd;
+    Append(ifd, std::uint64_t{entries.size()});
+    for (std::size_t i = 0; i < entries.size(); i++) {
+        const auto& e = entries[i];
+        Append(ifd, e.tag);
+        Append(ifd, e.type);
+        Append(ifd, e.count);
+        if (e.data.size() > BIGTIFF_INLINE_SIZE) {
+            Append(ifd, valueOffsets[i]);
+        } else {
+            std::array<char, BIGTIFF_INLINE_SIZE> inlined{};
+            std::copy(e.data.begin(), e.data.end(), inlined.begin());
+            ifd.insert(ifd.end(), inlined.begin(), inlined.end());
+        }
+    }
+    Append(ifd, next);
+    return append_(ifd);
+}
+
+void TiledTIFFWriter::close()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (not file_.is_open()) {
+        return;
+    }
+
+    // Point tiles which were never written at a single empty tile
+    std::uint64_t emptyOffset{0};
+    std::uint64_t emptySize{0};
+    for (std::size_t p = 0; p < numPages_; p++) {
+        for (std::size_t t = 0; t < offsets_[p].size(); t++) {
+            if (byteCounts_[p][t] != 0) {
+                continue;
+            }
+            if (emptySize == 0) {
+                auto empty = encode_(cv::Mat(0, 0, type_));
+                emptyOffset = append_(empty);
+                emptySize = empty.size();
+            }
+            offsets_[p][t] = emptyOffset;
+            byteCounts_[p][t] = emptySize;
+        }
+    }
+
+    // Write the directories in reverse so each can point to the next
+    std::uint64_t next{0};
+    for (auto p = numPages_; p > 0; p--) {
+        next = write_directory_(p - 1, next);
+    }
+
+    // Point the header at the first directory
+    file_.seekp(static_cast<std::streamoff>(
+        BIGTIFF_HEADER_SIZE - sizeof(std::uint64_t)));
+    file_.write(reinterpret_cast<const char*>(&next), sizeof(next));
+
+    file_.close();
+    if (file_.fail()) {
+        throw std::runtime_error("Failed to write TIFF directories");
+    }
+}
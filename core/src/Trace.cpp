@@ -0,0 +1,263 @@
+#include "vc/core/util/Trace.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "vc/core/util/Logging.hpp"
+
+namespace fs = volcart::filesystem;
+namespace trace = volcart::trace;
+
+std::atomic<bool> trace::detail::ENABLED{false};
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+// Recorded span
+struct Event {
+    std::string name;
+    const char* category;
+    Clock::time_point start;
+    Clock::duration duration;
+};
+
+// Spans recorded by a single thread. The mutex is only contended while the
+// trace is being exported.
+struct ThreadBuffer {
+    std::uint32_t tid{0};
+    std::mutex mutex;
+    std::vector<Event> events;
+};
+
+// Process-wide registry of thread buffers and counters
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    std::vector<trace::Counter*> counters;
+    Clock::time_point epoch{Clock::now()};
+};
+
+auto GetRegistry() -> Registry&
+{
+    static Registry registry;
+    return registry;
+}
+
+// Get the calling thread's buffer, registering it on first use. Buffers
+// outlive their threads so that their spans can still be exported.
+auto LocalBuffer() -> ThreadBuffer&
+{
+    thread_local auto buffer = []() {
+        auto b = std::make_shared<ThreadBuffer>();
+        auto& r = GetRegistry();
+        std::unique_lock<std::mutex> lock(r.mutex);
+        b->tid = static_cast<std::uint32_t>(r.buffers.size()) + 1;
+        r.buffers.push_back(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+// Write a string as a JSON string literal
+void WriteJSONString(std::ostream& os, const std::string& s)
+{
+    os << '"';
+    for (auto c : s) {
+        switch (c) {
+            case '"':
+                os << "\\\"";
+                break;
+            case '\\':
+                os << "\\\\";
+                break;
+            case '\n':
+                os << "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    os << "\\u" << std::hex << std::setw(4)
+                       << std::setfill('0') << static_cast<int>(c)
+                       << std::dec;
+                } else {
+                    os << c;
+                }
+        }
+    }
+    os << '"';
+}
+
+// Microseconds since the trace epoch
+auto Micros(Clock::duration d) -> double
+{
+    return std::chrono::duration<double, std::micro>(d).count();
+}
+}  // namespace
+
+void trace::SetEnabled(bool b)
+{
+    detail::ENABLED.store(b, std::memory_order_relaxed);
+}
+
+trace::Span::Span(const char* name, const char* category)
+    : Span(std::string(Enabled() ? name : ""), category)
+{
+}
+
+trace::Span::Span(std::string name, const char* category)
+    : active_{Enabled()}, category_{category}
+{
+    if (active_) {
+        name_ = std::move(name);
+        start_ = Clock::now();
+    }
+}
+
+trace::Span::~Span()
+{
+    if (not active_) {
+        return;
+    }
+    auto duration = Clock::now() - start_;
+    auto& buffer = LocalBuffer();
+    std::unique_lock<std::mutex> lock(buffer.mutex);
+    buffer.events.push_back({std::move(name_), category_, start_, duration});
+}
+
+trace::Counter::Counter(std::string name) : name_{std::move(name)}
+{
+    auto& r = GetRegistry();
+    std::unique_lock<std::mutex> lock(r.mutex);
+    r.counters.push_back(this);
+}
+
+trace::Counter::~Counter()
+{
+    auto& r = GetRegistry();
+    std::unique_lock<std::mutex> lock(r.mutex);
+    r.counters.erase(
+        std::remove(r.counters.begin(), r.counters.end(), this),
+        r.counters.end());
+}
+
+void trace::WriteChromeTrace(const fs::path& path)
+{
+    std::ofstream os(path.string());
+    if (not os) {
+        throw std::runtime_error("Cannot open trace file: " + path.string());
+    }
+
+    auto& r = GetRegistry();
+    std::unique_lock<std::mutex> lock(r.mutex);
+    os << std::fixed << std::setprecision(3);
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    auto first = true;
+    auto sep = [&]() {
+        os << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    // Complete events
+    auto end = r.epoch;
+    for (const auto& b : r.buffers) {
+        std::unique_lock<std::mutex> bufferLock(b->mutex);
+        for (const auto& e : b->events) {
+            sep();
+            os << "{\"ph\":\"X\",\"pid\":1,\"tid\":" << b->tid
+               << ",\"name\":";
+            WriteJSONString(os, e.name);
+            os << ",\"cat\":";
+            WriteJSONString(os, e.category);
+            os << ",\"ts\":" << Micros(e.start - r.epoch)
+               << ",\"dur\":" << Micros(e.duration) << "}";
+            end = std::max(end, e.start + e.duration);
+        }
+    }
+
+    // Counter totals at the end of the trace
+    for (const auto* c : r.counters) {
+        sep();
+        os << "{\"ph\":\"C\",\"pid\":1,\"tid\":0,\"name\":";
+        WriteJSONString(os, c->name());
+        os << ",\"ts\":" << Micros(end - r.epoch) << ",\"args\":{\"value\":"
+           << c->value() << "}}";
+    }
+    os << "\n]}\n";
+
+    if (not os) {
+        throw std::runtime_error("Cannot write trace file: " + path.string());
+    }
+}
+
+auto trace::Summary() -> std::string
+{
+    struct Stats {
+        std::size_t count{0};
+        Clock::duration total{0};
+    };
+    std::map<std::string, Stats> spans;
+
+    auto& r = GetRegistry();
+    std::unique_lock<std::mutex> lock(r.mutex);
+    for (const auto& b : r.buffers) {
+        std::unique_lock<std::mutex> bufferLock(b->mutex);
+        for (const auto& e : b->events) {
+            auto& s = spans[e.name];
+            s.count++;
+            s.total += e.duration;
+        }
+    }
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(3);
+    for (const auto& [name, s] : spans) {
+        auto total = Micros(s.total) / 1000.0;
+        ss << name << ": " << s.count << " spans, " << total << " ms total, "
+           << total / static_cast<double>(s.count) << " ms mean\n";
+    }
+    for (const auto* c : r.counters) {
+        if (c->value() != 0) {
+            ss << c->name() << ": " << c->value() << "\n";
+        }
+    }
+    return ss.str();
+}
+
+void trace::Clear()
+{
+    auto& r = GetRegistry();
+    std::unique_lock<std::mutex> lock(r.mutex);
+    for (const auto& b : r.buffers) {
+        std::unique_lock<std::mutex> bufferLock(b->mutex);
+        b->events.clear();
+    }
+    for (auto* c : r.counters) {
+        c->reset();
+    }
+    r.epoch = Clock::now();
+}
+
+trace::Session::Session(fs::path path) : path_{std::move(path)}
+{
+    Clear();
+    SetEnabled(true);
+}
+
+trace::Session::~Session()
+{
+    SetEnabled(false);
+    try {
+        WriteChromeTrace(path_);
+        Logger()->info("Wrote trace: {}", path_.string());
+        Logger()->info("Trace summary:\n{}", Summary());
+    } catch (const std::exception& e) {
+        Logger()->error("Failed to write trace: {}", e.what());
+    }
+}
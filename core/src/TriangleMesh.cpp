@@ -0,0 +1,294 @@
+#include "vc/core/types/TriangleMesh.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+using namespace volcart;
+
+using Index = TriangleMesh::Index;
+using Face = TriangleMesh::Face;
+
+// Throw if a count cannot be addressed by TriangleMesh::Index
+static void CheckIndexable(std::size_t n)
+{
+    if (n > std::numeric_limits<Index>::max()) {
+        throw std::overflow_error("Mesh too large for TriangleMesh::Index");
+    }
+}
+
+///// TriangleMesh /////
+auto TriangleMesh::numVertices() const -> std::size_t
+{
+    return vertices_.size();
+}
+
+auto TriangleMesh::numFaces() const -> std::size_t { return faces_.size(); }
+
+auto TriangleMesh::empty() const -> bool { return vertices_.empty(); }
+
+auto TriangleMesh::hasNormals() const -> bool
+{
+    return not vertices_.empty() and normals_.size() == vertices_.size();
+}
+
+auto TriangleMesh::hasUVs() const -> bool
+{
+    return not vertices_.empty() and uvs_.size() == vertices_.size();
+}
+
+void TriangleMesh::reserve(std::size_t numVertices, std::size_t numFaces)
+{
+    vertices_.reserve(numVertices);
+    faces_.reserve(numFaces);
+}
+
+void TriangleMesh::clear()
+{
+    vertices_.clear();
+    normals_.clear();
+    uvs_.clear();
+    faces_.clear();
+}
+
+auto TriangleMesh::addVertex(const Vertex& v) -> Index
+{
+    CheckIndexable(vertices_.size() + 1);
+    vertices_.push_back(v);
+    return static_cast<Index>(vertices_.size() - 1);
+}
+
+auto TriangleMesh::addFace(Index a, Index b, Index c) -> Index
+{
+    CheckIndexable(faces_.size() + 1);
+    faces_.push_back({a, b, c});
+    return static_cast<Index>(faces_.size() - 1);
+}
+
+auto TriangleMesh::vertices() -> std::vector<Vertex>& { return vertices_; }
+
+auto TriangleMesh::vertices() const -> const std::vector<Vertex>&
+{
+    return vertices_;
+}
+
+auto TriangleMesh::normals() -> std::vector<Normal>& { return normals_; }
+
+auto TriangleMesh::normals() const -> const std::vector<Normal>&
+{
+    return normals_;
+}
+
+auto TriangleMesh::uvs() -> std::vector<UV>& { return uvs_; }
+
+auto TriangleMesh::uvs() const -> const std::vector<UV>& { return uvs_; }
+
+auto TriangleMesh::faces() -> std::vector<Face>& { return faces_; }
+
+auto TriangleMesh::faces() const -> const std::vector<Face>& { return faces_; }
+
+///// VertexFaceAdjacency /////
+VertexFaceAdjacency::VertexFaceAdjacency(const TriangleMesh& mesh)
+{
+    const auto& faces = mesh.faces();
+    auto numVerts = mesh.numVertices();
+
+    // Count the faces incident to each vertex
+    offsets_.assign(numVerts + 1, 0);
+    for (const auto& f : faces) {
+        for (const auto& v : f) {
+            if (v >= numVerts) {
+                throw std::out_of_range("Face references invalid vertex");
+            }
+            offsets_[v + 1]++;
+        }
+    }
+
+    // Prefix sum into offsets
+    for (std::size_t v = 0; v < numVerts; v++) {
+        offsets_[v + 1] += offsets_[v];
+    }
+
+    // Fill the face lists in order of face ID
+    faces_.resize(offsets_.back());
+    std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (std::size_t f = 0; f < faces.size(); f++) {
+        for (const auto& v : faces[f]) {
+            faces_[next[v]++] = static_cast<Index>(f);
+        }
+    }
+}
+
+auto VertexFaceAdjacency::numVertices() const -> std::size_t
+{
+    return offsets_.empty() ? 0 : offsets_.size() - 1;
+}
+
+auto VertexFaceAdjacency::size(Index v) const -> std::size_t
+{
+    return offsets_[v + 1] - offsets_[v];
+}
+
+auto VertexFaceAdjacency::begin(Index v) const -> const Index*
+{
+    return faces_.data() + offsets_[v];
+}
+
+auto VertexFaceAdjacency::end(Index v) const -> const Index*
+{
+    return faces_.data() + offsets_[v + 1];
+}
+
+///// Conversion /////
+auto volcart::ToITKMesh(const TriangleMesh& mesh) -> ITKMesh::Pointer
+{
+    auto output = ITKMesh::New();
+
+    // Vertices and normals
+    const auto& verts = mesh.vertices();
+    const auto& normals = mesh.normals();
+    auto hasNormals = mesh.hasNormals();
+    output->GetPoints()->Reserve(verts.size());
+    if (hasNormals) {
+        output->GetPointData()->Reserve(verts.size());
+    }
+    ITKPoint pt;
+    ITKPixel n;
+    for (std::size_t i = 0; i < verts.size(); i++) {
+        pt[0] = verts[i][0];
+        pt[1] = verts[i][1];
+        pt[2] = verts[i][2];
+        output->SetPoint(i, pt);
+        if (hasNormals) {
+            n[0] = normals[i][0];
+            n[1] = normals[i][1];
+            n[2] = normals[i][2];
+            output->SetPointData(i, n);
+        }
+    }
+
+    // Faces
+    const auto& faces = mesh.faces();
+    output->GetCells()->Reserve(faces.size());
+    ITKCell::CellAutoPointer cell;
+    for (std::size_t f = 0; f < faces.size(); f++) {
+        cell.TakeOwnership(new ITKTriangle);
+        cell->SetPointId(0, faces[f][0]);
+        cell->SetPointId(1, faces[f][1]);
+        cell->SetPointId(2, faces[f][2]);
+        output->SetCell(f, cell);
+    }
+
+    return output;
+}
+
+auto volcart::FromITKMesh(
+    const ITKMesh::Pointer& mesh, const UVMap::Pointer& uvMap)
+    -> TriangleMesh::Pointer
+{
+    auto output = TriangleMesh::New();
+    auto numPts = mesh->GetNumberOfPoints();
+    auto numCells = mesh->GetNumberOfCells();
+    CheckIndexable(numPts);
+    CheckIndexable(numCells);
+
+    // Vertices. Points are stored in container order. If the point IDs are
+    // not 0 to N-1 in that order, they are remapped to their position.
+    auto& verts = output->vertices();
+    verts.reserve(numPts);
+    std::vector<ITKMesh::PointIdentifier> ids;
+    ids.reserve(numPts);
+    auto contiguous = true;
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        contiguous = contiguous and pt.Index() == verts.size();
+        const auto& p = pt.Value();
+        verts.emplace_back(p[0], p[1], p[2]);
+        ids.push_back(pt.Index());
+    }
+    std::unordered_map<ITKMesh::PointIdentifier, Index> remap;
+    if (not contiguous) {
+        remap.reserve(numPts);
+        for (std::size_t i = 0; i < ids.size(); i++) {
+            remap[ids[i]] = static_cast<Index>(i);
+        }
+    }
+
+    // Get the vertex index of a point ID. Returns false if there is no point
+    // with that ID.
+    auto toIndex = [&](ITKMesh::PointIdentifier id, Index& idx) {
+        if (contiguous) {
+            idx = static_cast<Index>(id);
+            return id < numPts;
+        }
+        auto it = remap.find(id);
+        if (it == remap.end()) {
+            return false;
+        }
+        idx = it->second;
+        return true;
+    };
+
+    // Normals
+    if (numPts > 0 and mesh->GetPointData()->Size() == numPts) {
+        auto& normals = output->normals();
+        normals.resize(numPts);
+        Index idx{0};
+        for (auto n = mesh->GetPointData()->Begin();
+             n != mesh->GetPointData()->End(); ++n) {
+            // Point data for a missing point: not every vertex has a normal
+            if (not toIndex(n.Index(), idx)) {
+                normals.clear();
+                break;
+            }
+            const auto& v = n.Value();
+            normals[idx] = {v[0], v[1], v[2]};
+        }
+    }
+
+    // UVs
+    if (uvMap) {
+        auto& uvs = output->uvs();
+        if (contiguous) {
+            uvs = uvMap->getAll();
+            uvs.resize(numPts, NULL_MAPPING);
+        } else {
+            uvs.reserve(numPts);
+            for (auto id : ids) {
+                uvs.push_back(
+                    uvMap->contains(id) ? uvMap->get(id) : NULL_MAPPING);
+            }
+        }
+    }
+
+    // Faces
+    auto& faces = output->faces();
+    faces.reserve(numCells);
+    for (auto cell = mesh->GetCells()->Begin(); cell != mesh->GetCells()->End();
+         ++cell) {
+        if (cell.Value()->GetNumberOfPoints() != 3) {
+            throw std::invalid_argument("ITKMesh has a non-triangular face");
+        }
+        const auto* cellIds = cell.Value()->GetPointIds();
+        Face f;
+        for (std::size_t i = 0; i < 3; i++) {
+            if (not toIndex(cellIds[i], f[i])) {
+                throw std::invalid_argument(
+                    "ITKMesh face references a missing point");
+            }
+        }
+        faces.push_back(f);
+    }
+
+    return output;
+}
+
+auto volcart::ToUVMap(const TriangleMesh& mesh) -> UVMap::Pointer
+{
+    auto uvMap = UVMap::New();
+    if (mesh.hasUVs()) {
+        uvMap->setAll(mesh.uvs());
+    }
+    return uvMap;
+}
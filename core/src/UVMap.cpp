@@ -1,5 +1,7 @@
 #include "vc/core/types/UVMap.hpp"
 
+#include <cmath>
+
 #include <opencv2/imgproc.hpp>
 
 #include "vc/core/util/Iteration.hpp"
@@ -20,24 +22,36 @@ using namespace volcart;
 
 inline auto OriginVector(const UVMap::Origin& o) -> cv::Vec2d;
 
+// Transform a UV between the top-left origin and the origin `o`. The
+// transform is its own inverse.
+static inline auto Transform(const cv::Vec2d& uv, const cv::Vec2d& o)
+    -> cv::Vec2d
+{
+    return {std::abs(uv[0] - o[0]), std::abs(uv[1] - o[1])};
+}
+
 void UVMap::set(size_t id, const cv::Vec2d& uv, const Origin& o)
 {
+    if (id >= uvs_.size()) {
+        uvs_.resize(id + 1);
+        valid_.resize(id + 1, false);
+    }
+    if (not valid_[id]) {
+        valid_[id] = true;
+        size_++;
+    }
+
     // transform to be relative to top-left
-    cv::Vec2d transformed;
-    cv::absdiff(uv, OriginVector(o), transformed);
-    map_[id] = transformed;
+    uvs_[id] = Transform(uv, OriginVector(o));
 }
 
 void UVMap::set(size_t id, const cv::Vec2d& uv) { set(id, uv, origin_); }
 
 auto UVMap::get(size_t id, const Origin& o) const -> cv::Vec2d
 {
-    auto it = map_.find(id);
-    if (it != map_.end()) {
+    if (contains(id)) {
         // transform to be relative to the provided origin
-        cv::Vec2d transformed;
-        cv::absdiff(it->second, OriginVector(o), transformed);
-        return transformed;
+        return Transform(uvs_[id], OriginVector(o));
     } else {
         return NULL_MAPPING;
     }
@@ -47,14 +61,56 @@ auto UVMap::get(size_t id) const -> cv::Vec2d { return get(id, origin_); }
 
 auto UVMap::contains(std::size_t id) const -> bool
 {
-    return map_.count(id) > 0;
+    return id < valid_.size() and valid_[id];
+}
+
+void UVMap::setAll(const std::vector<cv::Vec2d>& uvs, const Origin& o)
+{
+    auto origin = OriginVector(o);
+    uvs_.resize(uvs.size());
+    for (std::size_t i = 0; i < uvs.size(); i++) {
+        uvs_[i] = Transform(uvs[i], origin);
+    }
+    valid_.assign(uvs.size(), true);
+    size_ = uvs.size();
+}
+
+void UVMap::setAll(const std::vector<cv::Vec2d>& uvs) { setAll(uvs, origin_); }
+
+auto UVMap::getAll(const Origin& o) const -> std::vector<cv::Vec2d>
+{
+    auto origin = OriginVector(o);
+    std::vector<cv::Vec2d> result(uvs_.size());
+    for (std::size_t i = 0; i < uvs_.size(); i++) {
+        result[i] = Transform(uvs_[i], origin);
+    }
+
+    // Mark missing mappings
+    if (size_ != uvs_.size()) {
+        for (std::size_t i = 0; i < uvs_.size(); i++) {
+            if (not valid_[i]) {
+                result[i] = NULL_MAPPING;
+            }
+        }
+    }
+    return result;
 }
 
+auto UVMap::getAll() const -> std::vector<cv::Vec2d> { return getAll(origin_); }
+
 UVMap::UVMap(UVMap::Origin o) : origin_{o} {}
 
-auto UVMap::size() const -> size_t { return map_.size(); }
+auto UVMap::size() const -> size_t { return size_; }
+
+auto UVMap::empty() const -> bool { return size_ == 0; }
 
-auto UVMap::empty() const -> bool { return map_.empty(); }
+auto UVMap::idBound() const -> std::size_t { return uvs_.size(); }
+
+void UVMap::reserve(std::size_t n)
+{
+    uvs_.reserve(n);
+    valid_.reserve(n);
+}
 
 void UVMap::setOrigin(const UVMap::Origin& o) { origin_ = o; }
 
@@ -70,7 +126,16 @@ void UVMap::ratio(double w, double h)
     ratio_.height = h;
     ratio_.aspect = w / h;
 }
-auto UVMap::as_map() const -> std::map<size_t, cv::Vec2d> { return map_; }
+auto UVMap::as_map() const -> std::map<size_t, cv::Vec2d>
+{
+    std::map<size_t, cv::Vec2d> map;
+    for (std::size_t i = 0; i < uvs_.size(); i++) {
+        if (valid_[i]) {
+            map.emplace_hint(map.end(), i, uvs_[i]);
+        }
+    }
+    return map;
+}
 
 auto OriginVector(const UVMap::Origin& o) -> cv::Vec2d
 {
@@ -95,8 +160,11 @@ auto UVMap::Plot(const UVMap& uv, const Color& color) -> cv::Mat
     auto h = static_cast<int>(std::ceil(w / uv.ratio_.aspect));
     cv::Mat r = cv::Mat::zeros(h, w, CV_8UC3);
 
-    for (auto it : uv.map_) {
-        cv::Point2d p(it.second[0] * w, it.second[1] * h);
+    for (std::size_t i = 0; i < uv.uvs_.size(); i++) {
+        if (not uv.valid_[i]) {
+            continue;
+        }
+        cv::Point2d p(uv.uvs_[i][0] * w, uv.uvs_[i][1] * h);
         cv::circle(r, p, 1, color, -1);
     }
 
@@ -151,20 +219,26 @@ void UVMap::Rotate(UVMap& uv, Rotation rotation, cv::Mat& texture)
         uv.ratio_ = {uv.ratio_.height, uv.ratio_.width, 1. / uv.ratio_.aspect};
     }
 
-    // Update each UV coordinate
-    for (auto& m : uv.map_) {
-        if (rotation == Rotation::CW90) {
-            auto u = 1. - m.second[1];
-            auto v = m.second[0];
-            m.second[0] = u;
-            m.second[1] = v;
-        } else if (rotation == Rotation::CW180) {
-            m.second = cv::Vec2d{1, 1} - m.second;
-        } else if (rotation == Rotation::CCW90) {
-            auto u = m.second[1];
-            auto v = 1. - m.second[0];
-            m.second[0] = u;
-            m.second[1] = v;
+    // Update each UV coordinate. Unset entries are also transformed, which is
+    // harmless and keeps the loops branch-free.
+    if (rotation == Rotation::CW90) {
+        for (auto& m : uv.uvs_) {
+            auto u = 1. - m[1];
+            auto v = m[0];
+            m[0] = u;
+            m[1] = v;
+        }
+    } else if (rotation == Rotation::CW180) {
+        for (auto& m : uv.uvs_) {
+            m[0] = 1. - m[0];
+            m[1] = 1. - m[1];
+        }
+    } else if (rotation == Rotation::CCW90) {
+        for (auto& m : uv.uvs_) {
+            auto u = m[1];
+            auto v = 1. - m[0];
+            m[0] = u;
+            m[1] = v;
         }
     }
 
@@ -177,17 +251,21 @@ void UVMap::Rotate(UVMap& uv, Rotation rotation, cv::Mat& texture)
 void UVMap::Rotate(
     UVMap& uv, double theta, cv::Mat& texture, const cv::Vec2d& center)
 {
-    // Setup pts matrix
-    cv::Mat pts = cv::Mat::ones(uv.map_.size(), 3, CV_64F);
+    // Setup pts matrix from the valid mappings
+    auto origin = OriginVector(uv.origin_);
+    cv::Mat pts = cv::Mat::ones(static_cast<int>(uv.size_), 3, CV_64F);
     int row = 0;
-    for (const auto& p : uv.map_) {
+    for (std::size_t i = 0; i < uv.uvs_.size(); i++) {
+        if (not uv.valid_[i]) {
+            continue;
+        }
         // transform so that operation happens relative to stored origin
-        cv::Vec2d transformed;
-        cv::absdiff(p.second, OriginVector(uv.origin_), transformed);
+        auto transformed = Transform(uv.uvs_[i], origin);
 
         // Store in matrix of points
-        pts.at<double>(row, 0) = transformed[0];
-        pts.at<double>(row, 1) = transformed[1];
+        auto* pt = pts.ptr<double>(row);
+        pt[0] = transformed[0];
+        pt[1] = transformed[1];
         row++;
     }
 
@@ -235,18 +313,17 @@ void UVMap::Rotate(
     // Update UVs within new bounds
     cv::Vec2d newPos;
     row = 0;
-    for (auto& p : uv.map_) {
+    for (std::size_t i = 0; i < uv.uvs_.size(); i++) {
+        if (not uv.valid_[i]) {
+            continue;
+        }
         // rescale within bounds
-        newPos[0] = (pts.at<double>(row, 0) - uMin) / (uMax - uMin);
-        newPos[1] = (pts.at<double>(row, 1) - vMin) / (vMax - vMin);
+        const auto* pt = pts.ptr<double>(row);
+        newPos[0] = (pt[0] - uMin) / (uMax - uMin);
+        newPos[1] = (pt[1] - vMin) / (vMax - vMin);
 
         // transform back to storage origin
-        cv::Vec2d transformed;
-        cv::absdiff(newPos, OriginVector(uv.origin_), transformed);
-
-        // store
-        p.second[0] = transformed[0];
-        p.second[1] = transformed[1];
+        uv.uvs_[i] = Transform(newPos, origin);
 
         // Advance the row counter
         row++;
@@ -283,17 +360,16 @@ void UVMap::Rotate(UVMap& uv, double theta, const cv::Vec2d& center)
 
 void UVMap::Flip(UVMap& uv, FlipAxis axis)
 {
-    for (auto& p : uv.map_) {
-        switch (axis) {
-            case FlipAxis::Horizontal:
-                p.second[0] = 1 - p.second[0];
-                continue;
-            case FlipAxis::Vertical:
-                p.second[1] = 1 - p.second[1];
-                continue;
-            case FlipAxis::Both:
-                p.second = cv::Vec2d{1, 1} - p.second;
-                continue;
+    auto flipU = axis == FlipAxis::Horizontal or axis == FlipAxis::Both;
+    auto flipV = axis == FlipAxis::Vertical or axis == FlipAxis::Both;
+    if (flipU) {
+        for (auto& p : uv.uvs_) {
+            p[0] = 1 - p[0];
+        }
+    }
+    if (flipV) {
+        for (auto& p : uv.uvs_) {
+            p[1] = 1 - p[1];
         }
     }
 }
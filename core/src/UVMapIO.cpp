@@ -1,11 +1,14 @@
 #include "vc/core/io/UVMapIO.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
+#include <limits>
 #include <regex>
 #include <sstream>
 
 #include "vc/core/types/Exceptions.hpp"
-#include "vc/core/util/Iteration.hpp"
 #include "vc/core/util/String.hpp"
 
 using namespace volcart;
@@ -14,6 +17,13 @@ using namespace volcart::io;
 namespace fs = volcart::filesystem;
 namespace vio = volcart::io;
 
+// Size of a UV value in the file
+static constexpr std::size_t UV_SIZE{2 * sizeof(double)};
+// Size of an {id, u, v} record in the file
+static constexpr std::size_t RECORD_SIZE{sizeof(std::size_t) + UV_SIZE};
+// Number of records read or written at once
+static constexpr std::size_t BLOCK_SIZE{1 << 16};
+
 void vio::WriteUVMap(const fs::path& path, const UVMap& uvMap)
 {
     std::ofstream outfile{path.string(), std::ios::binary};
@@ -28,19 +38,35 @@ void vio::WriteUVMap(const fs::path& path, const UVMap& uvMap)
     ss << "version: 1" << std::endl;
     ss << "type: per-vertex" << std::endl;
     ss << "size: " << uvMap.size() << std::endl;
+    ss << std::setprecision(std::numeric_limits<double>::max_digits10);
     ss << "width: " << uvMap.ratio().width << std::endl;
     ss << "height: " << uvMap.ratio().height << std::endl;
     ss << "origin: " << static_cast<int>(uvMap.origin()) << std::endl;
     ss << "<>" << std::endl;
     outfile << ss.rdbuf();
 
-    // Write the mappings
-    for (const auto& mapping : uvMap.as_map()) {
-        const auto& id = mapping.first;
-        const auto& uv = mapping.second;
-        outfile.write(reinterpret_cast<const char*>(&id), sizeof(id));
-        auto nbytes = 2 * sizeof(double);
-        outfile.write(reinterpret_cast<const char*>(uv.val), nbytes);
+    // Write the mappings in blocks of packed {id, u, v} records
+    auto uvs = uvMap.getAll(UVMap::Origin::TopLeft);
+    std::vector<char> buffer;
+    buffer.reserve(BLOCK_SIZE * RECORD_SIZE);
+    for (std::size_t id = 0; id < uvs.size(); id++) {
+        if (not uvMap.contains(id)) {
+            continue;
+        }
+        auto offset = buffer.size();
+        buffer.resize(offset + RECORD_SIZE);
+        std::memcpy(&buffer[offset], &id, sizeof(id));
+        std::memcpy(&buffer[offset + sizeof(id)], uvs[id].val, UV_SIZE);
+        if (buffer.size() == BLOCK_SIZE * RECORD_SIZE) {
+            outfile.write(
+                buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            buffer.clear();
+        }
+    }
+    outfile.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    if (outfile.fail()) {
+        auto msg = "failed to write file '" + path.string() + "'";
+        throw IOException(msg);
     }
 
     outfile.close();
@@ -166,14 +192,35 @@ auto vio::ReadUVMap(const fs::path& path) -> UVMap
     map.setOrigin(static_cast<UVMap::Origin>(h.origin));
     map.ratio(h.width, h.height);
 
-    // Read all of the points
-    for (const auto& i : range(h.size)) {
-        std::ignore = i;
-        size_t id{0};
-        cv::Vec2d uv;
-        infile.read(reinterpret_cast<char*>(&id), sizeof(id));
-        infile.read(reinterpret_cast<char*>(uv.val), 2 * sizeof(double));
-        map.set(id, uv);
+    // Read all of the points in blocks of packed {id, u, v} records
+    std::vector<char> buffer;
+    for (std::size_t first = 0; first < h.size; first += BLOCK_SIZE) {
+        auto count = std::min(BLOCK_SIZE, h.size - first);
+        buffer.resize(count * RECORD_SIZE);
+        infile.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        if (static_cast<std::size_t>(infile.gcount()) != buffer.size()) {
+            throw IOException("UVMap file is truncated");
+        }
+
+        // Reserve storage using the largest ID in the first block
+        if (first == 0) {
+            std::size_t maxID{0};
+            for (std::size_t i = 0; i < count; i++) {
+                std::size_t id{0};
+                std::memcpy(&id, &buffer[i * RECORD_SIZE], sizeof(id));
+                maxID = std::max(maxID, id);
+            }
+            map.reserve(std::max(maxID + 1, h.size));
+        }
+
+        for (std::size_t i = 0; i < count; i++) {
+            const auto* record = &buffer[i * RECORD_SIZE];
+            std::size_t id{0};
+            cv::Vec2d uv;
+            std::memcpy(&id, record, sizeof(id));
+            std::memcpy(uv.val, record + sizeof(id), UV_SIZE);
+            map.set(id, uv);
+        }
     }
 
     return map;
@@ -6,12 +6,17 @@
 #include <opencv2/imgcodecs.hpp>
 
 #include "vc/core/io/TIFFIO.hpp"
+#include "vc/core/util/Trace.hpp"
 
 namespace fs = volcart::filesystem;
 namespace tio = volcart::tiffio;
 
 using namespace volcart;
 
+static trace::Counter SLICE_CACHE_HITS{"Volume.sliceCacheHits"};
+static trace::Counter SLICE_CACHE_MISSES{"Volume.sliceCacheMisses"};
+static trace::Counter SLICE_BYTES_READ{"Volume.sliceBytesRead"};
+
 // Load a Volume from disk
 Volume::Volume(fs::path path) : DiskBasedObjectBaseClass(std::move(path))
 {
@@ -147,6 +152,9 @@ void Volume::setSliceData(int index, const cv::Mat& slice, bool compress)
     tio::WriteTIFF(
         slicePath.string(), slice,
         (compress) ? tiffio::Compression::LZW : tiffio::Compression::NONE);
+    if (storage_) {
+        storage_->invalidate(slicePath);
+    }
 }
 
 uint16_t Volume::intensityAt(int x, int y, int z) const
@@ -219,71 +227,19 @@ Reslice Volume::reslice(
     return Reslice(m, origin, xnorm, ynorm);
 }
 
-// cv::Mat Volume::load_slice_(int index) const
-// {
-//     {
-//         std::unique_lock<std::shared_mutex> lock(print_mutex_);
-//         std::cout << "Requested to load slice " << index << std::endl;
-//     }
-//     auto slicePath = getSlicePath(index);
-//     return cv::imread(slicePath.string(), -1);
-// }
-
 cv::Mat Volume::load_slice_(int index) const
 {
+    trace::Span span("Volume::LoadSlice", "io");
     auto slicePath = getSlicePath(index);
-    // auto slicePathSSD = slicePath;
-    // std::string pathStr = slicePath.string();
-    // std::string pathStr2 = slicePath.string();
-    // std::string pathStr3 = slicePath.string();
-    // // Replace SSD4TB with HDD8TB if the path does not exist
-    // // string of the disk name to be replaced
-    // char* diskName = "SSD4TB2";
-    // char* diskName2 = "HDD8TB";
-    // // check if diskname in path, if not: set diskname to diskname2
-    // auto pos2 = pathStr2.find(diskName);
-    // if (pos2 == std::string::npos) {
-    //     diskName = diskName2;
-    // }
-
-    // size_t pos = pathStr.find(diskName);
-    // if (pos != std::string::npos) {
-    //     pathStr.replace(pos, std::strlen(diskName), "SSD4TB");
-    //     slicePathSSD = std::filesystem::path(pathStr);
-    // }
-    // // Check if the slice exists
-    // if (std::filesystem::exists(slicePathSSD)) {
-    //     slicePath = slicePathSSD;
-    // }
-    // else {
-    //     pos = pathStr2.find(diskName);
-    //     if (pos != std::string::npos) {
-    //         pathStr2.replace(pos, std::strlen(diskName), "SSD120GB");
-    //         slicePathSSD = std::filesystem::path(pathStr2);
-    //     }
-    //     if (std::filesystem::exists(slicePathSSD)) {
-    //         slicePath = slicePathSSD;
-    //     }
-    //     else {
-    //         pos = pathStr3.find(diskName);
-    //         if (pos != std::string::npos) {
-    //             pathStr3.replace(pos, std::strlen(diskName), "FastSSD");
-    //             slicePathSSD = std::filesystem::path(pathStr3);
-    //         }
-    //         if (std::filesystem::exists(slicePathSSD)) {
-    //             slicePath = slicePathSSD;
-    //         }
-    //     }
-
-    // }
-    
-
-    {
-        std::unique_lock<std::shared_mutex> lock(print_mutex_);
-        std::cout << "Requested to load slice " << index << " from " << slicePath << std::endl;
+    if (storage_) {
+        slicePath = storage_->resolve(slicePath);
     }
+
     // Attempt to load the slice
-    return cv::imread(slicePath.string(), -1);
+    auto slice = cv::imread(slicePath.string(), -1);
+    SLICE_BYTES_READ.add(
+        static_cast<std::int64_t>(slice.total() * slice.elemSize()));
+    return slice;
 }
 
 cv::Mat Volume::cache_slice_(int index) const
@@ -292,6 +248,7 @@ cv::Mat Volume::cache_slice_(int index) const
     {
         std::shared_lock<std::shared_mutex> lock(cache_mutex_);
         if (cache_->contains(index)) {
+            SLICE_CACHE_HITS.add();
             return cache_->get(index);
         }
     }
@@ -311,6 +268,7 @@ cv::Mat Volume::cache_slice_(int index) const
         }
         // Load the slice and add it to the cache.
         {
+            SLICE_CACHE_MISSES.add();
             auto slice = load_slice_(index);
             std::unique_lock<std::shared_mutex> lock(cache_mutex_);
             cache_->put(index, slice);
@@ -1,6 +1,11 @@
 #include "vc/core/types/VolumePkg.hpp"
 
+#include <fstream>
+
+#include <nlohmann/json.hpp>
+
 #include "vc/core/util/DateTime.hpp"
+#include "vc/core/util/MemorySizeStringParser.hpp"
 
 using namespace volcart;
 
@@ -10,6 +15,91 @@ static const fs::path SUBPATH_META{"config.json"};
 static const fs::path SUBPATH_REND{"renders"};
 static const fs::path SUBPATH_SEGS{"paths"};
 static const fs::path SUBPATH_VOLS{"volumes"};
+static const fs::path SUBPATH_INDEX{".vc_index.json"};
+static const fs::path OBJECT_META{"meta.json"};
+static constexpr int INDEX_VERSION{1};
+
+// Modification time of a file in the filesystem library's native units
+static auto ModifiedTime(const fs::path& path) -> std::int64_t
+{
+#ifdef VC_USE_BOOSTFS
+    return static_cast<std::int64_t>(fs::last_write_time(path));
+#else
+    return static_cast<std::int64_t>(
+        fs::last_write_time(path).time_since_epoch().count());
+#endif
+}
+
+// Attach the tiered slice storage to Volumes. Other objects are not affected.
+static void AttachStorage(
+    const Volume::Pointer& volume, const TieredStorage::Pointer& storage)
+{
+    if (storage) {
+        volume->setStorage(storage);
+    }
+}
+
+template <class T>
+static void AttachStorage(const T&, const TieredStorage::Pointer&)
+{
+}
+
+// List the objects in a VolumePkg subdirectory. Objects are listed from the
+// previous index if their metadata file's modification time and size have not
+// changed. Otherwise their metadata is read and checked against `type`.
+// Returns whether the index section has changed.
+template <class EntryMap>
+static auto ScanObjects(
+    const fs::path& dir,
+    const std::string& type,
+    const nlohmann::json& prev,
+    nlohmann::json& next,
+    EntryMap& entries) -> bool
+{
+    auto changed = false;
+    for (const auto& dirEntry : fs::directory_iterator(dir)) {
+        if (not fs::is_directory(dirEntry)) {
+            continue;
+        }
+        const auto& path = dirEntry.path();
+        auto key = path.filename().string();
+        auto metaPath = path / OBJECT_META;
+        if (not fs::exists(metaPath)) {
+            auto msg = "could not find json file '" + metaPath.string() + "'";
+            throw std::runtime_error(msg);
+        }
+        auto mtime = ModifiedTime(metaPath);
+        auto size = static_cast<std::uint64_t>(fs::file_size(metaPath));
+
+        // Reuse the indexed entry if the metadata has not changed
+        nlohmann::json record;
+        auto found = prev.find(key);
+        if (found != prev.end() and found->is_object() and
+            found->value("mtime", std::int64_t{-1}) == mtime and
+            found->value("size", std::uint64_t{0}) == size) {
+            record = *found;
+        } else {
+            Metadata meta(metaPath);
+            if (meta.get<std::string>("type") != type) {
+                throw std::runtime_error("File not of type: " + type);
+            }
+            record["uuid"] = meta.get<std::string>("uuid");
+            record["name"] = meta.get<std::string>("name");
+            record["mtime"] = mtime;
+            record["size"] = size;
+            changed = true;
+        }
+
+        entries.emplace(
+            record["uuid"].get<std::string>(),
+            typename EntryMap::mapped_type{
+                path, record["name"].get<std::string>(), nullptr});
+        next[key] = std::move(record);
+    }
+
+    // Removed objects also change the index
+    return changed or next.size() != prev.size();
+}
 
 // CONSTRUCTORS //
 // Make a volpkg of a particular version number
@@ -56,29 +146,26 @@ VolumePkg::VolumePkg(const fs::path& fileLocation)
     // Loads the metadata
     config_ = Metadata(fileLocation / SUBPATH_META);
 
-    // Load volumes into volumes_ vector
-    for (const auto& entry : fs::directory_iterator(volsDir_)) {
-        if (fs::is_directory(entry)) {
-            auto v = Volume::New(entry);
-            volumes_.emplace(v->id(), v);
+    // Set up the tiered slice storage
+    if (config_.hasKey("storage_tiers")) {
+        std::vector<fs::path> tiers;
+        for (const auto& t :
+             config_.get<std::vector<std::string>>("storage_tiers")) {
+            tiers.emplace_back(t);
         }
-    }
-
-    // Load segmentations into the segmentations_ vector
-    for (const auto& entry : fs::directory_iterator(segsDir_)) {
-        if (fs::is_directory(entry)) {
-            auto s = Segmentation::New(entry);
-            segmentations_.emplace(s->id(), s);
+        storage_ = TieredStorage::New(rootDir_, tiers);
+        if (config_.hasKey("storage_promotion_budget")) {
+            storage_->setPromotionBudget(MemorySizeStringParser(
+                config_.get<std::string>("storage_promotion_budget")));
         }
-    }
-
-    // Load Renders into the renders_ vector
-    for (const auto& entry : fs::directory_iterator(rendDir_)) {
-        if (fs::is_directory(entry)) {
-            auto r = Render::New(entry);
-            renders_.emplace(r->id(), r);
+        if (config_.hasKey("storage_promotion_threshold")) {
+            storage_->setPromotionThreshold(
+                config_.get<std::size_t>("storage_promotion_threshold"));
         }
     }
+
+    // List the volumes, segmentations, and renders
+    scan_();
 }
 
 auto VolumePkg::New(fs::path fileLocation, int version) -> VolumePkg::Pointer
@@ -92,6 +179,69 @@ auto VolumePkg::New(fs::path fileLocation) -> VolumePkg::Pointer
     return std::make_shared<VolumePkg>(fileLocation);
 }
 
+// LAZY LOADING //
+void VolumePkg::scan_()
+{
+    // Read the previous index. Unreadable indices are rebuilt.
+    nlohmann::json prev;
+    auto indexPath = rootDir_ / SUBPATH_INDEX;
+    if (fs::exists(indexPath)) {
+        try {
+            std::ifstream file(indexPath.string());
+            file >> prev;
+        } catch (const nlohmann::json::exception&) {
+            prev = nlohmann::json();
+        }
+    }
+    if (not prev.is_object() or prev.value("version", 0) != INDEX_VERSION) {
+        prev = nlohmann::json::object();
+    }
+
+    auto section = [&prev](const fs::path& subpath) {
+        auto it = prev.find(subpath.string());
+        if (it == prev.end() or not it->is_object()) {
+            return nlohmann::json::object();
+        }
+        return *it;
+    };
+
+    nlohmann::json vols = nlohmann::json::object();
+    nlohmann::json segs = nlohmann::json::object();
+    nlohmann::json rends = nlohmann::json::object();
+    auto changed = prev.empty();
+    changed |= ScanObjects(
+        volsDir_, "vol", section(SUBPATH_VOLS), vols, volumes_);
+    changed |= ScanObjects(
+        segsDir_, "seg", section(SUBPATH_SEGS), segs, segmentations_);
+    changed |= ScanObjects(
+        rendDir_, "render", section(SUBPATH_REND), rends, renders_);
+    if (not changed) {
+        return;
+    }
+
+    nlohmann::json index;
+    index["version"] = INDEX_VERSION;
+    index[SUBPATH_VOLS.string()] = std::move(vols);
+    index[SUBPATH_SEGS.string()] = std::move(segs);
+    index[SUBPATH_REND.string()] = std::move(rends);
+    // The index is only a cache, so read-only packages are scanned each time
+    std::ofstream file(indexPath.string());
+    if (file) {
+        file << index.dump(4) << std::endl;
+    }
+}
+
+template <class T>
+auto VolumePkg::load_(const Entry<T>& entry) const -> typename T::Pointer
+{
+    std::unique_lock<std::mutex> lock(loadMutex_);
+    if (not entry.ptr) {
+        entry.ptr = T::New(entry.path);
+        AttachStorage(entry.ptr, storage_);
+    }
+    return entry.ptr;
+}
+
 // METADATA RETRIEVAL //
 // Returns Volume Name from JSON config
 auto VolumePkg::name() const -> std::string
@@ -144,7 +294,8 @@ auto VolumePkg::volumeNames() const -> std::vector<std::string>
 {
     std::vector<Volume::Identifier> names;
     for (const auto& v : volumes_) {
-        names.emplace_back(v.second->name());
+        const auto& e = v.second;
+        names.emplace_back(e.ptr ? e.ptr->name() : e.name);
     }
     return names;
 }
@@ -168,14 +319,16 @@ auto VolumePkg::newVolume(std::string name) -> Volume::Pointer
     }
 
     // Make the volume
-    auto r = volumes_.emplace(uuid, Volume::New(volDir, uuid, name));
+    auto v = Volume::New(volDir, uuid, name);
+    AttachStorage(v, storage_);
+    auto r = volumes_.emplace(uuid, Entry<Volume>{volDir, name, v});
     if (!r.second) {
         auto msg = "Volume already exists with id " + uuid;
         throw std::runtime_error(msg);
     }
 
     // Return the Volume Pointer
-    return r.first->second;
+    return v;
 }
 
 auto VolumePkg::volume() const -> const Volume::Pointer
@@ -183,7 +336,7 @@ auto VolumePkg::volume() const -> const Volume::Pointer
     if (volumes_.empty()) {
         throw std::out_of_range("No volumes in VolPkg");
     }
-    return volumes_.begin()->second;
+    return load_(volumes_.begin()->second);
 }
 
 auto VolumePkg::volume() -> Volume::Pointer
@@ -191,18 +344,18 @@ auto VolumePkg::volume() -> Volume::Pointer
     if (volumes_.empty()) {
         throw std::out_of_range("No volumes in VolPkg");
     }
-    return volumes_.begin()->second;
+    return load_(volumes_.begin()->second);
 }
 
 auto VolumePkg::volume(const Volume::Identifier& id) const
     -> const Volume::Pointer
 {
-    return volumes_.at(id);
+    return load_(volumes_.at(id));
 }
 
 auto VolumePkg::volume(const Volume::Identifier& id) -> Volume::Pointer
 {
-    return volumes_.at(id);
+    return load_(volumes_.at(id));
 }
 
 // SEGMENTATION FUNCTIONS //
@@ -216,13 +369,13 @@ auto VolumePkg::numberOfSegmentations() -> size_t
 auto VolumePkg::segmentation(const DiskBasedObjectBaseClass::Identifier& id)
     const -> const Segmentation::Pointer
 {
-    return segmentations_.at(id);
+    return load_(segmentations_.at(id));
 }
 
 auto VolumePkg::segmentation(const DiskBasedObjectBaseClass::Identifier& id)
     -> Segmentation::Pointer
 {
-    return segmentations_.at(id);
+    return load_(segmentations_.at(id));
 }
 
 auto VolumePkg::segmentationIDs() const -> std::vector<Segmentation::Identifier>
@@ -238,7 +391,8 @@ auto VolumePkg::segmentationNames() const -> std::vector<std::string>
 {
     std::vector<std::string> names;
     for (const auto& s : segmentations_) {
-        names.emplace_back(s.second->name());
+        const auto& e = s.second;
+        names.emplace_back(e.ptr ? e.ptr->name() : e.name);
     }
     return names;
 }
@@ -265,15 +419,16 @@ auto VolumePkg::newSegmentation(std::string name) -> Segmentation::Pointer
     }
 
     // Make the Segmentation
+    auto s = Segmentation::New(segDir, uuid, name);
     auto r =
-        segmentations_.emplace(uuid, Segmentation::New(segDir, uuid, name));
+        segmentations_.emplace(uuid, Entry<Segmentation>{segDir, name, s});
     if (!r.second) {
         auto msg = "Segmentation already exists with id " + uuid;
         throw std::runtime_error(msg);
     }
 
     // Return the Segmentation Pointer
-    return r.first->second;
+    return s;
 }
 
 // RENDER FUNCTIONS //
@@ -282,12 +437,12 @@ auto VolumePkg::numberOfRenders() -> size_t { return renders_.size(); }
 auto VolumePkg::render(const DiskBasedObjectBaseClass::Identifier& id) const
     -> const Render::Pointer
 {
-    return renders_.at(id);
+    return load_(renders_.at(id));
 }
 auto VolumePkg::render(const DiskBasedObjectBaseClass::Identifier& id)
     -> Render::Pointer
 {
-    return renders_.at(id);
+    return load_(renders_.at(id));
 }
 
 auto VolumePkg::renderIDs() const -> std::vector<Render::Identifier>
@@ -303,7 +458,8 @@ auto VolumePkg::renderNames() const -> std::vector<std::string>
 {
     std::vector<std::string> names;
     for (const auto& r : renders_) {
-        names.emplace_back(r.second->name());
+        const auto& e = r.second;
+        names.emplace_back(e.ptr ? e.ptr->name() : e.name);
     }
     return names;
 }
@@ -329,14 +485,15 @@ auto VolumePkg::newRender(std::string name) -> Render::Pointer
     }
 
     // Make the Render
-    auto r = renders_.emplace(uuid, Render::New(renDir, uuid, name));
+    auto ren = Render::New(renDir, uuid, name);
+    auto r = renders_.emplace(uuid, Entry<Render>{renDir, name, ren});
     if (!r.second) {
         auto msg = "Render already exists with id " + uuid;
         throw std::runtime_error(msg);
     }
 
     // Return the Render Pointer
-    return r.first->second;
+    return ren;
 }
 
 auto VolumePkg::InitConfig(const Dictionary& dict, int version) -> Metadata
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/util/ApplyLUT.hpp"
+#include "vc/core/util/ImageConversion.hpp"
+
+using namespace volcart;
+
+// Large enough to be processed in several parallel bands
+static constexpr int ROWS{700};
+static constexpr int COLS{400};
+
+// Random single-channel image
+static auto RandomImage(int depth, double lo, double hi) -> cv::Mat
+{
+    cv::Mat img(ROWS, COLS, CV_MAKETYPE(depth, 1));
+    cv::RNG rng(12345);
+    rng.fill(img, cv::RNG::UNIFORM, lo, hi);
+    return img;
+}
+
+// Reference implementation of ApplyLUT(img, lut, min, max, invert)
+static auto ReferenceLUT(
+    const cv::Mat& img, const cv::Mat& lut, float min, float max, bool invert)
+    -> cv::Mat
+{
+    cv::Mat gray;
+    img.convertTo(gray, CV_32F);
+    cv::Mat output = cv::Mat::zeros(gray.rows, gray.cols, lut.type());
+    auto bins = lut.cols;
+    for (int y = 0; y < gray.rows; y++) {
+        for (int x = 0; x < gray.cols; x++) {
+            auto val = gray.at<float>(y, x);
+            int bin{0};
+            if (val == max) {
+                bin = bins - 1;
+            } else if (val != min) {
+                auto pos = (val - min) / (max - min);
+                pos = std::max(std::min(pos, 1.F), 0.F);
+                bin = static_cast<int>(std::round(float(bins - 1) * pos));
+            }
+            if (invert) {
+                bin = bins - 1 - bin;
+            }
+            if (lut.channels() == 1) {
+                output.at<std::uint8_t>(y, x) = lut.at<std::uint8_t>(0, bin);
+            } else {
+                output.at<cv::Vec3b>(y, x) = lut.at<cv::Vec3b>(0, bin);
+            }
+        }
+    }
+    return output;
+}
+
+// Whether two images are identical
+static auto Identical(const cv::Mat& a, const cv::Mat& b) -> bool
+{
+    return a.size() == b.size() and a.type() == b.type() and
+           cv::norm(a, b, cv::NORM_INF) == 0;
+}
+
+TEST(ImageConversion, QuantizeMatchesConvertTo)
+{
+    // 16-bit to 8-bit over the full range
+    auto img = RandomImage(CV_16U, 0, 65536);
+    cv::Mat expected;
+    img.convertTo(expected, CV_8U, 255.0 / 65535.0);
+    EXPECT_TRUE(Identical(QuantizeImage(img, CV_8U, false), expected));
+
+    // Float to 16-bit with min/max scaling
+    img = RandomImage(CV_32F, -0.5, 2.0);
+    double min{0};
+    double max{0};
+    cv::minMaxLoc(img, &min, &max);
+    auto scale = 65535.0 / (max - min);
+    img.convertTo(expected, CV_16U, scale, -min * scale);
+    EXPECT_TRUE(Identical(QuantizeImage(img), expected));
+}
+
+TEST(ImageConversion, WindowLUT16U)
+{
+    auto lut = WindowLUT16U(1000, 40000);
+    EXPECT_EQ(lut[0], 0);
+    EXPECT_EQ(lut[1000], 0);
+    EXPECT_EQ(lut[40000], 255);
+    EXPECT_EQ(lut[65535], 255);
+    for (std::size_t v = 1; v < lut.size(); v++) {
+        EXPECT_GE(lut[v], lut[v - 1]);
+    }
+
+    auto img = RandomImage(CV_16U, 0, 65536);
+    cv::Mat out;
+    ApplyLUT16U(img, lut, out);
+    ASSERT_EQ(out.type(), CV_8UC1);
+    ASSERT_EQ(out.size(), img.size());
+    for (int y = 0; y < img.rows; y++) {
+        for (int x = 0; x < img.cols; x++) {
+            auto v = img.at<std::uint16_t>(y, x);
+            ASSERT_EQ(out.at<std::uint8_t>(y, x), lut[v]);
+        }
+    }
+
+    EXPECT_THROW(WindowLUT16U(10, 10), std::invalid_argument);
+    EXPECT_THROW(
+        ApplyLUT16U(cv::Mat(2, 2, CV_8UC1), lut, out), std::invalid_argument);
+}
+
+TEST(ImageConversion, ApplyLUTMatchesReference)
+{
+    cv::Mat gray(1, 256, CV_8UC1);
+    cv::Mat color(1, 100, CV_8UC3);
+    cv::RNG rng(54321);
+    rng.fill(gray, cv::RNG::UNIFORM, 0, 256);
+    rng.fill(color, cv::RNG::UNIFORM, 0, 256);
+
+    struct Input {
+        cv::Mat img;
+        float min;
+        float max;
+    };
+    std::vector<Input> inputs{
+        {RandomImage(CV_8U, 0, 256), 20, 200},
+        {RandomImage(CV_16U, 0, 65536), 1000, 60000},
+        {RandomImage(CV_16U, 0, 65536)(cv::Rect(0, 0, 9, 7)), 1000, 60000},
+        {RandomImage(CV_32F, -0.2, 1.2), 0.1F, 0.9F}};
+    for (const auto& in : inputs) {
+        for (const auto& lut : {gray, color}) {
+            for (auto invert : {false, true}) {
+                auto result = ApplyLUT(in.img, lut, in.min, in.max, invert);
+                auto expected =
+                    ReferenceLUT(in.img, lut, in.min, in.max, invert);
+                EXPECT_TRUE(Identical(result, expected));
+            }
+        }
+    }
+}
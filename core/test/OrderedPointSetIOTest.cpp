@@ -54,4 +54,29 @@ TEST_F(OrderedPointSetIO, WriteReadASCII)
     EXPECT_EQ(read(0, 0), ps(0, 0));
     EXPECT_EQ(read(0, 1), ps(0, 1));
     EXPECT_EQ(read(0, 2), ps(0, 2));
-}
\ No newline at end of file
+}
+TEST_F(OrderedPointSetIO, ReadFloatAsDouble)
+{
+    // Write a float point set to disk
+    path += "ReadFloatAsDouble.vcps";
+    OrderedPointSet<cv::Vec3f> psf{2};
+    psf.pushRow({{0.1F, 0.2F, 0.3F}, {1.5F, 2.5F, 3.5F}});
+    psf.pushRow({{-1.F, -2.F, -3.F}, {4.25F, 5.25F, 6.25F}});
+    EXPECT_NO_THROW(PointSetIO<cv::Vec3f>::WriteOrderedPointSet(path, psf));
+
+    // Read from disk as double
+    OrderedPointSet<cv::Vec3d> read;
+    EXPECT_NO_THROW(read = PointSetIO<cv::Vec3d>::ReadOrderedPointSet(path));
+
+    // Check values
+    EXPECT_EQ(read.width(), psf.width());
+    EXPECT_EQ(read.height(), psf.height());
+    for (size_t y = 0; y < psf.height(); y++) {
+        for (size_t x = 0; x < psf.width(); x++) {
+            EXPECT_EQ(read(y, x), cv::Vec3d(psf(y, x)));
+        }
+    }
+
+    // Integer point sets are not converted
+    EXPECT_THROW(PointSetIO<cv::Vec3i>::ReadOrderedPointSet(path), IOException);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include "vc/core/io/PLYReader.hpp"
 #include "vc/core/io/PLYWriter.hpp"
 #include "vc/core/shapes/Plane.hpp"
 #include "vc/core/types/SimpleMesh.hpp"
@@ -70,4 +71,90 @@ TEST_F(PLYWriter, UntexturedMesh)
 
         idx++;
     }
-}
\ No newline at end of file
+}
+
+TEST_F(PLYWriter, BinaryMesh)
+{
+    // Write test file
+    path += "Binary.ply";
+    writer.setPath(path);
+    writer.setBinary(true);
+    ASSERT_NO_THROW(writer.write());
+
+    // Read it back in
+    vc::io::PLYReader reader(path);
+    vc::ITKMesh::Pointer saved;
+    ASSERT_NO_THROW(saved = reader.read());
+
+    // compare number of points and cells for equality
+    EXPECT_EQ(mesh->GetNumberOfPoints(), saved->GetNumberOfPoints());
+    EXPECT_EQ(mesh->GetNumberOfCells(), saved->GetNumberOfCells());
+
+    // Check vertex values (stored as 32-bit floats)
+    vc::ITKPixel origN;
+    vc::ITKPixel savedN;
+    for (size_t idx = 0; idx < mesh->GetNumberOfPoints(); idx++) {
+        auto orig = mesh->GetPoint(idx);
+        auto pt = saved->GetPoint(idx);
+        for (int d = 0; d < 3; d++) {
+            EXPECT_FLOAT_EQ(pt[d], orig[d]);
+        }
+
+        mesh->GetPointData(idx, &origN);
+        saved->GetPointData(idx, &savedN);
+        for (int d = 0; d < 3; d++) {
+            EXPECT_FLOAT_EQ(savedN[d], origN[d]);
+        }
+    }
+
+    // Check face vertex IDs
+    for (size_t idx = 0; idx < mesh->GetNumberOfCells(); idx++) {
+        auto orig = mesh->GetCells()->GetElement(idx);
+        auto cell = saved->GetCells()->GetElement(idx);
+        for (int v = 0; v < 3; v++) {
+            EXPECT_EQ(cell->GetPointIds()[v], orig->GetPointIds()[v]);
+        }
+    }
+}
+
+TEST_F(PLYWriter, NonContiguousPointIDs)
+{
+    // Sparse point IDs. The points container fills the unused IDs with
+    // default points.
+    auto sparse = vc::ITKMesh::New();
+    vc::ITKPoint pt;
+    vc::ITKPixel n;
+    pt[0] = 1.0;
+    pt[1] = 2.0;
+    pt[2] = 3.0;
+    n[0] = 0.0;
+    n[1] = 0.0;
+    n[2] = 1.0;
+    sparse->SetPoint(10, pt);
+    sparse->SetPointData(10, n);
+    pt[0] = 4.0;
+    pt[1] = 5.0;
+    pt[2] = 6.0;
+    n[0] = 0.0;
+    n[1] = 1.0;
+    n[2] = 0.0;
+    sparse->SetPoint(20, pt);
+    sparse->SetPointData(20, n);
+
+    // Write test file
+    path += "NonContiguous.ply";
+    writer.setMesh(sparse);
+    writer.setPath(path);
+    ASSERT_NO_THROW(writer.write());
+
+    // load in written data
+    vc::SimpleMesh saved;
+    vctest::ParsingHelpers::ParsePLYFile(path, saved.verts, saved.faces);
+    ASSERT_EQ(saved.verts.size(), sparse->GetNumberOfPoints());
+
+    // Points are written in container order
+    EXPECT_DOUBLE_EQ(saved.verts[10].x, 1);
+    EXPECT_DOUBLE_EQ(saved.verts[10].nz, 1);
+    EXPECT_DOUBLE_EQ(saved.verts[20].x, 4);
+    EXPECT_DOUBLE_EQ(saved.verts[20].ny, 1);
+}
@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "vc/core/util/Parallel.hpp"
+
+using namespace volcart;
+
+TEST(Parallel, ParallelForVisitsEachIndexOnce)
+{
+    std::vector<int> visits(10007, 0);
+    ParallelFor(visits.size(), [&](auto i) { visits[i]++; }, 4, 13);
+    for (const auto& v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+}
+
+TEST(Parallel, ParallelForSingleThreadIsOrdered)
+{
+    std::vector<std::size_t> order;
+    ParallelFor(5, [&](auto i) { order.push_back(i); }, 1);
+    EXPECT_EQ(order, std::vector<std::size_t>({0, 1, 2, 3, 4}));
+}
+
+TEST(Parallel, ParallelForRethrows)
+{
+    auto fn = [](auto i) {
+        if (i == 500) {
+            throw std::runtime_error("failed");
+        }
+    };
+    EXPECT_THROW(ParallelFor(1000, fn, 4), std::runtime_error);
+}
+
+TEST(Parallel, ParallelForBlocksCoversRange)
+{
+    std::vector<int> visits(1000, 0);
+    std::mutex mutex;
+    std::vector<std::size_t> sizes;
+    ParallelForBlocks(
+        visits.size(), 64,
+        [&](auto begin, auto end) {
+            for (auto i = begin; i < end; i++) {
+                visits[i]++;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            sizes.push_back(end - begin);
+        },
+        4);
+    for (const auto& v : visits) {
+        EXPECT_EQ(v, 1);
+    }
+
+    // 15 blocks of 64, with the remainder added to the last block
+    std::sort(sizes.begin(), sizes.end());
+    ASSERT_EQ(sizes.size(), 15U);
+    EXPECT_EQ(sizes.front(), 64U);
+    EXPECT_EQ(sizes.back(), 104U);
+}
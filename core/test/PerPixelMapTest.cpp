@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 #include "vc/core/types/PerPixelMap.hpp"
 
 using namespace volcart;
@@ -30,4 +32,47 @@ TEST(PerPixelMap, WriteRead)
             EXPECT_EQ(result(y, x), ppm(y, x));
         }
     }
-}
\ No newline at end of file
+}
+TEST(PerPixelMap, Crop)
+{
+    // Build a PPM with a mask and cell map
+    PerPixelMap ppm(10, 12);
+    cv::Mat mask = cv::Mat::zeros(10, 12, CV_8UC1);
+    cv::Mat cellMap(10, 12, CV_32SC1);
+    for (auto y = 0; y < 10; ++y) {
+        for (auto x = 0; x < 12; ++x) {
+            auto dx = static_cast<double>(x);
+            auto dy = static_cast<double>(y);
+            ppm(y, x) = {dx, dy, 0, 0, 0, 1};
+            mask.at<uint8_t>(y, x) = (x + y) % 2 == 0 ? 255 : 0;
+            cellMap.at<int32_t>(y, x) = y * 12 + x;
+        }
+    }
+    ppm.setMask(mask);
+    ppm.setCellMap(cellMap);
+
+    // Crop and compare
+    cv::Rect region{3, 2, 7, 5};
+    auto result = ppm.crop(region);
+    EXPECT_EQ(result.width(), 7U);
+    EXPECT_EQ(result.height(), 5U);
+    for (auto y = 0; y < 5; ++y) {
+        for (auto x = 0; x < 7; ++x) {
+            EXPECT_EQ(result(y, x), ppm(y + 2, x + 3));
+            EXPECT_EQ(result.hasMapping(y, x), ppm.hasMapping(y + 2, x + 3));
+            EXPECT_EQ(
+                result.cellMap().at<int32_t>(y, x),
+                cellMap.at<int32_t>(y + 2, x + 3));
+        }
+    }
+
+    // The crop does not share memory with the source
+    result.mask().setTo(0);
+    result.cellMap().setTo(-1);
+    EXPECT_EQ(ppm.mask().at<uint8_t>(2, 4), 255);
+    EXPECT_EQ(ppm.cellMap().at<int32_t>(2, 3), 2 * 12 + 3);
+
+    // Regions outside of the map are invalid
+    EXPECT_THROW(ppm.crop({8, 0, 8, 8}), std::invalid_argument);
+    EXPECT_THROW(ppm.crop({0, 0, 0, 0}), std::invalid_argument);
+}
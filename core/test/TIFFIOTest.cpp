@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <opencv2/imgcodecs.hpp>
+
+#include "vc/core/io/TIFFIO.hpp"
+
+using namespace volcart;
+using namespace volcart::tiffio;
+
+// Image with a unique value at every pixel
+static auto MakeImage(int rows, int cols) -> cv::Mat
+{
+    cv::Mat img(rows, cols, CV_16UC1);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            img.at<std::uint16_t>(y, x) =
+                static_cast<std::uint16_t>(y * cols + x);
+        }
+    }
+    return img;
+}
+
+// Write `original`, then update the file from `modified` within `roi`
+static auto Update(
+    const std::string& path,
+    const cv::Mat& original,
+    const cv::Mat& modified,
+    const cv::Rect& roi,
+    Compression compression,
+    const Layout& layout) -> cv::Mat
+{
+    WriteTIFF(path, original, compression, layout);
+    EXPECT_TRUE(UpdateTIFF(path, modified, roi));
+    return cv::imread(path, cv::IMREAD_UNCHANGED);
+}
+
+TEST(TIFFIO, UpdateStrips)
+{
+    auto original = MakeImage(64, 40);
+    cv::Mat modified = original + 1;
+    const cv::Rect roi{5, 20, 3, 2};
+
+    // Only the 16-row strip which holds the ROI is rewritten
+    for (auto compression : {Compression::NONE, Compression::LZW}) {
+        auto result = Update(
+            "vc_core_TIFFIO_UpdateStrips.tif", original, modified, roi,
+            compression, {16, 0, 0});
+        ASSERT_EQ(result.type(), CV_16UC1);
+        cv::Rect strip{0, 16, 40, 16};
+        EXPECT_EQ(cv::norm(result(strip), modified(strip), cv::NORM_INF), 0);
+        result(strip).setTo(0);
+        cv::Mat expected = original.clone();
+        expected(strip).setTo(0);
+        EXPECT_EQ(cv::norm(result, expected, cv::NORM_INF), 0);
+    }
+}
+
+TEST(TIFFIO, UpdateTiles)
+{
+    auto original = MakeImage(64, 64);
+    cv::Mat modified = original + 1;
+
+    // The ROI overlaps two tiles
+    auto result = Update(
+        "vc_core_TIFFIO_UpdateTiles.tif", original, modified, {30, 40, 4, 4},
+        Compression::LZW, {0, 32, 32});
+    cv::Rect tiles{0, 32, 64, 32};
+    EXPECT_EQ(cv::norm(result(tiles), modified(tiles), cv::NORM_INF), 0);
+    cv::Rect rest{0, 0, 64, 32};
+    EXPECT_EQ(cv::norm(result(rest), original(rest), cv::NORM_INF), 0);
+}
+
+TEST(TIFFIO, UpdateMismatched)
+{
+    const std::string path{"vc_core_TIFFIO_UpdateMismatched.tif"};
+    auto original = MakeImage(32, 32);
+    WriteTIFF(path, original);
+
+    cv::Mat bigger = MakeImage(32, 48);
+    EXPECT_FALSE(UpdateTIFF(path, bigger, {0, 0, 1, 1}));
+    cv::Mat byte(32, 32, CV_8UC1, cv::Scalar(1));
+    EXPECT_FALSE(UpdateTIFF(path, byte, {0, 0, 1, 1}));
+    EXPECT_FALSE(UpdateTIFF("vc_core_TIFFIO_Missing.tif", original, {}));
+
+    // The file is unchanged
+    auto result = cv::imread(path, cv::IMREAD_UNCHANGED);
+    EXPECT_EQ(cv::norm(result, original, cv::NORM_INF), 0);
+}
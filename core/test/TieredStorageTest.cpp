@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <string>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/types/TieredStorage.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+class TieredStorage_Dirs : public ::testing::Test
+{
+public:
+    TieredStorage_Dirs()
+    {
+        fs::remove_all(base);
+        for (const auto& d : {root / "slices", fast, slow / "slices"}) {
+            fs::create_directories(d);
+        }
+        Write(root / "slices" / "0.tif", "canonical");
+        Write(root / "slices" / "1.tif", "canonical");
+        Write(slow / "slices" / "1.tif", "slow");
+    }
+
+    ~TieredStorage_Dirs() override { fs::remove_all(base); }
+
+    static void Write(const fs::path& path, const std::string& s)
+    {
+        std::ofstream(path.string()) << s;
+    }
+
+    fs::path base{"TieredStorage"};
+    fs::path root{base / "root"};
+    fs::path fast{base / "fast"};
+    fs::path slow{base / "slow"};
+};
+
+TEST_F(TieredStorage_Dirs, ResolvesFastestCopy)
+{
+    auto storage = TieredStorage::New(root, {fast, slow});
+    EXPECT_EQ(storage->tiers().size(), 3U);
+    EXPECT_EQ(storage->resolve(root / "slices/0.tif"), root / "slices/0.tif");
+    EXPECT_EQ(storage->resolve(root / "slices/1.tif"), slow / "slices/1.tif");
+
+    // Locations are cached
+    fs::create_directories(fast / "slices");
+    Write(fast / "slices" / "0.tif", "fast");
+    EXPECT_EQ(storage->resolve(root / "slices/0.tif"), root / "slices/0.tif");
+
+    // Rewritten files always resolve to the canonical copy, even if a mirror
+    // still holds the old file
+    Write(root / "slices" / "1.tif", "rewritten");
+    storage->invalidate(root / "slices/1.tif");
+    EXPECT_EQ(storage->resolve(root / "slices/1.tif"), root / "slices/1.tif");
+
+    // Paths outside of the root are not changed
+    EXPECT_EQ(storage->resolve(base / "other.tif"), base / "other.tif");
+}
+
+TEST_F(TieredStorage_Dirs, PromotesHotFiles)
+{
+    auto storage = TieredStorage::New(root, {fast, slow});
+    storage->setPromotionBudget(1024);
+    storage->setPromotionThreshold(2);
+
+    auto path = root / "slices/1.tif";
+    EXPECT_EQ(storage->resolve(path), slow / "slices/1.tif");
+    EXPECT_EQ(storage->resolve(path), slow / "slices/1.tif");
+    storage->waitForPromotions();
+    EXPECT_TRUE(fs::exists(fast / "slices/1.tif"));
+    EXPECT_EQ(storage->resolve(path), fast / "slices/1.tif");
+    EXPECT_EQ(storage->promotedBytes(), 4U);
+
+    // The manifest carries the budget across sessions
+    storage = TieredStorage::New(root, {fast, slow});
+    EXPECT_EQ(storage->promotedBytes(), 4U);
+
+    // Invalidating a file removes its promoted copy
+    storage->invalidate(path);
+    EXPECT_FALSE(fs::exists(fast / "slices/1.tif"));
+    EXPECT_EQ(storage->promotedBytes(), 0U);
+}
+
+TEST_F(TieredStorage_Dirs, PromotionBudget)
+{
+    auto storage = TieredStorage::New(root, {fast, slow});
+    storage->setPromotionBudget(4);
+    storage->setPromotionThreshold(1);
+
+    // Only the first file fits in the budget
+    storage->resolve(root / "slices/1.tif");
+    storage->waitForPromotions();
+    storage->resolve(root / "slices/0.tif");
+    storage->waitForPromotions();
+    EXPECT_TRUE(fs::exists(fast / "slices/1.tif"));
+    EXPECT_FALSE(fs::exists(fast / "slices/0.tif"));
+    EXPECT_EQ(storage->promotedBytes(), 4U);
+}
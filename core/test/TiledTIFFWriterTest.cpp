@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+#include <opencv2/imgcodecs.hpp>
+
+#include "vc/core/io/TiledTIFFWriter.hpp"
+#include "vc/core/util/Parallel.hpp"
+
+using namespace volcart;
+using namespace volcart::tiffio;
+
+// Image with a unique value at every pixel
+static auto MakeImage(int rows, int cols, int offset) -> cv::Mat
+{
+    cv::Mat img(rows, cols, CV_16UC1);
+    for (int y = 0; y < rows; y++) {
+        for (int x = 0; x < cols; x++) {
+            img.at<std::uint16_t>(y, x) =
+                static_cast<std::uint16_t>(y * cols + x + offset);
+        }
+    }
+    return img;
+}
+
+TEST(TiledTIFFWriter, WriteMultiPageInParallel)
+{
+    const int width{100};
+    const int height{70};
+    const std::uint32_t tileSize{32};
+    std::vector<cv::Mat> pages{
+        MakeImage(height, width, 0), MakeImage(height, width, 1000)};
+
+    TiledTIFFWriter tif(
+        "vc_core_TiledTIFFWriter_MultiPage.tif", width, height, CV_16UC1,
+        pages.size(), tileSize, tileSize);
+    auto across = (width + tileSize - 1) / tileSize;
+    auto down = (height + tileSize - 1) / tileSize;
+    ParallelFor(pages.size() * across * down, [&](auto i) {
+        auto page = i % pages.size();
+        auto tile = i / pages.size();
+        auto x = static_cast<int>((tile % across) * tileSize);
+        auto y = static_cast<int>((tile / across) * tileSize);
+        cv::Rect roi{x, y, std::min<int>(tileSize, width - x),
+                     std::min<int>(tileSize, height - y)};
+        tif.writeTile(page, x, y, pages[page](roi));
+    });
+    tif.close();
+
+    std::vector<cv::Mat> result;
+    cv::imreadmulti(
+        "vc_core_TiledTIFFWriter_MultiPage.tif", result, cv::IMREAD_UNCHANGED);
+    ASSERT_EQ(result.size(), pages.size());
+    for (std::size_t i = 0; i < pages.size(); i++) {
+        ASSERT_EQ(result[i].type(), CV_16UC1);
+        EXPECT_EQ(cv::countNonZero(result[i] != pages[i]), 0);
+    }
+}
+
+TEST(TiledTIFFWriter, MissingTilesAreZero)
+{
+    cv::Mat tile(16, 16, CV_8UC3, cv::Scalar(1, 2, 3));
+    {
+        TiledTIFFWriter tif(
+            "vc_core_TiledTIFFWriter_Missing.tif", 32, 16, CV_8UC3, 1, 16, 16,
+            Compression::NONE);
+        tif.writeTile(0, 16, 0, tile);
+    }
+
+    auto result = cv::imread(
+        "vc_core_TiledTIFFWriter_Missing.tif", cv::IMREAD_UNCHANGED);
+    ASSERT_EQ(result.size(), cv::Size(32, 16));
+    EXPECT_EQ(cv::countNonZero(result.reshape(1)(cv::Rect{0, 0, 48, 16})), 0);
+    cv::Mat right = result(cv::Rect{16, 0, 16, 16});
+    EXPECT_EQ(cv::norm(right, tile, cv::NORM_INF), 0);
+}
+
+TEST(TiledTIFFWriter, InvalidParameters)
+{
+    EXPECT_THROW(
+        TiledTIFFWriter("vc_core_TiledTIFFWriter.png", 16, 16, CV_8UC1),
+        std::runtime_error);
+    EXPECT_THROW(
+        TiledTIFFWriter("vc_core_TiledTIFFWriter.tif", 16, 16, CV_8UC1, 1, 20),
+        std::runtime_error);
+
+    TiledTIFFWriter tif(
+        "vc_core_TiledTIFFWriter_Invalid.tif", 64, 64, CV_8UC1, 1, 32, 32);
+    cv::Mat tile(32, 32, CV_8UC1);
+    EXPECT_THROW(tif.writeTile(1, 0, 0, tile), std::runtime_error);
+    EXPECT_THROW(tif.writeTile(0, 16, 0, tile), std::runtime_error);
+    EXPECT_THROW(
+        tif.writeTile(0, 0, 0, cv::Mat(32, 32, CV_16UC1)), std::runtime_error);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <nlohmann/json.hpp>
+
+#include "vc/core/util/Trace.hpp"
+
+using namespace volcart;
+
+static trace::Counter TEST_COUNTER{"TraceTest.counter"};
+
+TEST(Trace, DisabledRecordsNothing)
+{
+    trace::SetEnabled(false);
+    trace::Clear();
+    {
+        trace::Span span("Disabled");
+        TEST_COUNTER.add(5);
+    }
+    EXPECT_EQ(TEST_COUNTER.value(), 0);
+    EXPECT_EQ(trace::Summary().find("Disabled"), std::string::npos);
+}
+
+TEST(Trace, WriteChromeTrace)
+{
+    trace::Clear();
+    trace::SetEnabled(true);
+    {
+        trace::Span outer("Outer", "test");
+        std::thread t([]() { trace::Span inner(std::string("Inner")); });
+        t.join();
+        TEST_COUNTER.add(3);
+    }
+    trace::SetEnabled(false);
+    EXPECT_EQ(TEST_COUNTER.value(), 3);
+
+    trace::WriteChromeTrace("trace.json");
+    nlohmann::json json;
+    std::ifstream("trace.json") >> json;
+
+    int outerTid{-1};
+    int innerTid{-1};
+    auto counters = 0;
+    for (const auto& e : json["traceEvents"]) {
+        if (e["ph"] == "X" and e["name"] == "Outer") {
+            EXPECT_EQ(e["cat"], "test");
+            EXPECT_GE(e["dur"].get<double>(), 0);
+            outerTid = e["tid"];
+        } else if (e["ph"] == "X" and e["name"] == "Inner") {
+            innerTid = e["tid"];
+        } else if (e["ph"] == "C" and e["name"] == "TraceTest.counter") {
+            EXPECT_EQ(e["args"]["value"], 3);
+            counters++;
+        }
+    }
+    EXPECT_GT(outerTid, 0);
+    EXPECT_GT(innerTid, 0);
+    EXPECT_NE(outerTid, innerTid);
+    EXPECT_EQ(counters, 1);
+
+    auto summary = trace::Summary();
+    EXPECT_NE(summary.find("Outer: 1 spans"), std::string::npos);
+    EXPECT_NE(summary.find("TraceTest.counter: 3"), std::string::npos);
+
+    trace::Clear();
+    EXPECT_EQ(TEST_COUNTER.value(), 0);
+    EXPECT_EQ(trace::Summary(), "");
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "vc/core/io/MeshIO.hpp"
+#include "vc/core/shapes/Plane.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
+
+using namespace volcart;
+
+TEST(TriangleMesh, AddVerticesAndFaces)
+{
+    TriangleMesh mesh;
+    EXPECT_TRUE(mesh.empty());
+
+    EXPECT_EQ(mesh.addVertex({0, 0, 0}), 0);
+    EXPECT_EQ(mesh.addVertex({1, 0, 0}), 1);
+    EXPECT_EQ(mesh.addVertex({0, 1, 0}), 2);
+    EXPECT_EQ(mesh.addFace(0, 1, 2), 0);
+
+    EXPECT_FALSE(mesh.empty());
+    EXPECT_EQ(mesh.numVertices(), 3);
+    EXPECT_EQ(mesh.numFaces(), 1);
+    EXPECT_FALSE(mesh.hasNormals());
+    EXPECT_FALSE(mesh.hasUVs());
+
+    mesh.normals().assign(3, {0, 0, 1});
+    EXPECT_TRUE(mesh.hasNormals());
+
+    mesh.clear();
+    EXPECT_TRUE(mesh.empty());
+    EXPECT_EQ(mesh.numFaces(), 0);
+    EXPECT_FALSE(mesh.hasNormals());
+}
+
+TEST(TriangleMesh, VertexFaceAdjacency)
+{
+    // Two triangles sharing the edge 1-2
+    TriangleMesh mesh;
+    mesh.addVertex({0, 0, 0});
+    mesh.addVertex({1, 0, 0});
+    mesh.addVertex({0, 1, 0});
+    mesh.addVertex({1, 1, 0});
+    mesh.addFace(0, 1, 2);
+    mesh.addFace(2, 1, 3);
+
+    VertexFaceAdjacency adj(mesh);
+    EXPECT_EQ(adj.numVertices(), 4);
+    EXPECT_EQ(adj.size(0), 1);
+    EXPECT_EQ(adj.size(1), 2);
+    EXPECT_EQ(adj.size(2), 2);
+    EXPECT_EQ(adj.size(3), 1);
+
+    std::vector<TriangleMesh::Index> faces(adj.begin(1), adj.end(1));
+    EXPECT_EQ(faces, std::vector<TriangleMesh::Index>({0, 1}));
+    EXPECT_EQ(*adj.begin(3), 1);
+}
+
+TEST(TriangleMesh, ITKMeshRoundTrip)
+{
+    shapes::Plane plane;
+    auto itkMesh = plane.itkMesh();
+
+    auto mesh = FromITKMesh(itkMesh);
+    ASSERT_EQ(mesh->numVertices(), itkMesh->GetNumberOfPoints());
+    ASSERT_EQ(mesh->numFaces(), itkMesh->GetNumberOfCells());
+    EXPECT_TRUE(mesh->hasNormals());
+
+    auto result = ToITKMesh(*mesh);
+    ASSERT_EQ(result->GetNumberOfPoints(), itkMesh->GetNumberOfPoints());
+    ASSERT_EQ(result->GetNumberOfCells(), itkMesh->GetNumberOfCells());
+    for (std::size_t i = 0; i < itkMesh->GetNumberOfPoints(); i++) {
+        EXPECT_EQ(result->GetPoint(i), itkMesh->GetPoint(i));
+        ITKPixel expected;
+        ITKPixel actual;
+        itkMesh->GetPointData(i, &expected);
+        result->GetPointData(i, &actual);
+        EXPECT_EQ(actual, expected);
+    }
+
+    ITKCell::CellAutoPointer expected;
+    ITKCell::CellAutoPointer actual;
+    for (std::size_t c = 0; c < itkMesh->GetNumberOfCells(); c++) {
+        itkMesh->GetCell(c, expected);
+        result->GetCell(c, actual);
+        for (std::size_t i = 0; i < 3; i++) {
+            EXPECT_EQ(actual->GetPointIds()[i], expected->GetPointIds()[i]);
+        }
+    }
+}
+
+TEST(TriangleMesh, ITKMeshNonContiguousIDs)
+{
+    // One triangle with sparse, unordered point IDs. The points container
+    // fills the unused IDs with default points.
+    auto itkMesh = ITKMesh::New();
+    ITKPoint pt;
+    ITKPixel n;
+    n[0] = 0.0;
+    n[1] = 0.0;
+    n[2] = 1.0;
+    for (const auto id : {30, 10, 20}) {
+        pt[0] = id;
+        pt[1] = 0.0;
+        pt[2] = 0.0;
+        itkMesh->SetPoint(id, pt);
+        itkMesh->SetPointData(id, n);
+    }
+    ITKCell::CellAutoPointer cell;
+    cell.TakeOwnership(new ITKTriangle);
+    cell->SetPointId(0, 10);
+    cell->SetPointId(1, 20);
+    cell->SetPointId(2, 30);
+    itkMesh->SetCell(0, cell);
+
+    auto uvMap = UVMap::New();
+    uvMap->set(20, {0.5, 0.5});
+
+    // Faces reference the same points after conversion
+    auto mesh = FromITKMesh(itkMesh, uvMap);
+    ASSERT_EQ(mesh->numVertices(), itkMesh->GetNumberOfPoints());
+    ASSERT_EQ(mesh->numFaces(), 1);
+    const auto& f = mesh->faces()[0];
+    EXPECT_EQ(mesh->vertices()[f[0]][0], 10);
+    EXPECT_EQ(mesh->vertices()[f[1]][0], 20);
+    EXPECT_EQ(mesh->vertices()[f[2]][0], 30);
+    EXPECT_EQ(mesh->uvs()[f[1]], cv::Vec2d(0.5, 0.5));
+    EXPECT_EQ(mesh->uvs()[f[0]], NULL_MAPPING);
+
+    // Faces which reference missing points are invalid
+    cell.TakeOwnership(new ITKTriangle);
+    cell->SetPointId(0, 10);
+    cell->SetPointId(1, 20);
+    cell->SetPointId(2, 40);
+    itkMesh->SetCell(1, cell);
+    EXPECT_THROW(FromITKMesh(itkMesh), std::invalid_argument);
+}
+
+TEST(TriangleMesh, OBJRoundTrip)
+{
+    shapes::Plane plane;
+    auto mesh = FromITKMesh(plane.itkMesh());
+    auto& uvs = mesh->uvs();
+    for (const auto& v : mesh->vertices()) {
+        uvs.emplace_back(v[0] / 4.0, v[2] / 4.0);
+    }
+
+    const std::string path{"vc_core_TriangleMesh_OBJRoundTrip.obj"};
+    WriteMesh(path, mesh);
+    auto result = ReadTriangleMesh(path);
+
+    ASSERT_EQ(result->numVertices(), mesh->numVertices());
+    ASSERT_EQ(result->faces(), mesh->faces());
+    ASSERT_TRUE(result->hasNormals());
+    ASSERT_TRUE(result->hasUVs());
+    for (std::size_t i = 0; i < mesh->numVertices(); i++) {
+        for (int d = 0; d < 3; d++) {
+            EXPECT_NEAR(
+                result->vertices()[i][d], mesh->vertices()[i][d], 1e-5);
+            EXPECT_NEAR(result->normals()[i][d], mesh->normals()[i][d], 1e-5);
+        }
+        for (int d = 0; d < 2; d++) {
+            EXPECT_NEAR(result->uvs()[i][d], mesh->uvs()[i][d], 1e-5);
+        }
+    }
+}
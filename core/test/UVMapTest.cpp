@@ -54,6 +54,35 @@ TEST(UVMapTest, GetSetTest)
     EXPECT_EQ(map.get(0), p);
 }
 
+// Check that bulk get/set match the per-point functions
+TEST(UVMapTest, SetAllGetAllTest)
+{
+    std::vector<cv::Vec2d> uvs{{0.0, 0.0}, {0.25, 0.5}, {1.0, 0.75}};
+    volcart::UVMap map;
+    map.setAll(uvs, UVMap::Origin::BottomLeft);
+    EXPECT_EQ(map.size(), uvs.size());
+    EXPECT_EQ(map.getAll(UVMap::Origin::BottomLeft), uvs);
+    for (std::size_t i = 0; i < uvs.size(); i++) {
+        EXPECT_EQ(map.get(i, UVMap::Origin::BottomLeft), uvs[i]);
+        EXPECT_EQ(map.getAll()[i], map.get(i));
+    }
+
+    // Unset IDs are returned as NULL_MAPPING
+    volcart::UVMap sparse;
+    sparse.set(1, {0.5, 0.5});
+    sparse.set(4, {0.25, 0.75});
+    EXPECT_EQ(sparse.size(), 2);
+    EXPECT_EQ(sparse.idBound(), 5);
+    EXPECT_FALSE(sparse.contains(0));
+    EXPECT_TRUE(sparse.contains(4));
+    auto all = sparse.getAll();
+    ASSERT_EQ(all.size(), 5);
+    EXPECT_EQ(all[0], NULL_MAPPING);
+    EXPECT_EQ(all[1], cv::Vec2d(0.5, 0.5));
+    EXPECT_EQ(all[3], NULL_MAPPING);
+    EXPECT_EQ(all[4], cv::Vec2d(0.25, 0.75));
+}
+
 // Check the fun origin transformation part of this class
 TEST_F(CreateUVMapFixture, TransformationTest)
 {
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/types/VolumePkg.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+class VolumePkg_Lazy : public ::testing::Test
+{
+public:
+    VolumePkg_Lazy()
+    {
+        fs::remove_all(path);
+        auto pkg = VolumePkg::New(path, VOLPKG_VERSION_LATEST);
+        volID = pkg->newVolume("volume")->id();
+        pkg->volume(volID)->saveMetadata();
+        segID = pkg->newSegmentation("segmentation")->id();
+        auto render = pkg->newRender("render");
+        render->saveMetadata();
+        renderID = render->id();
+    }
+
+    ~VolumePkg_Lazy() override { fs::remove_all(path); }
+
+    fs::path path{"LazyVolumePkg.volpkg"};
+    Volume::Identifier volID;
+    Segmentation::Identifier segID;
+    Render::Identifier renderID;
+};
+
+TEST_F(VolumePkg_Lazy, ListsObjectsAndWritesIndex)
+{
+    auto pkg = VolumePkg::New(path);
+    EXPECT_TRUE(fs::exists(path / ".vc_index.json"));
+
+    EXPECT_EQ(pkg->volumeIDs(), std::vector<std::string>{volID});
+    EXPECT_EQ(pkg->volumeNames(), std::vector<std::string>{"volume"});
+    EXPECT_EQ(pkg->segmentationIDs(), std::vector<std::string>{segID});
+    EXPECT_EQ(
+        pkg->segmentationNames(), std::vector<std::string>{"segmentation"});
+    EXPECT_EQ(pkg->renderIDs(), std::vector<std::string>{renderID});
+    EXPECT_EQ(pkg->renderNames(), std::vector<std::string>{"render"});
+
+    // Objects are loaded on first access and reused afterwards
+    auto seg = pkg->segmentation(segID);
+    EXPECT_EQ(seg->id(), segID);
+    EXPECT_EQ(seg, pkg->segmentation(segID));
+    EXPECT_EQ(pkg->volume()->id(), volID);
+    EXPECT_EQ(pkg->render(renderID)->name(), "render");
+    EXPECT_THROW(pkg->segmentation("missing"), std::out_of_range);
+}
+
+TEST_F(VolumePkg_Lazy, ReopenFromIndex)
+{
+    VolumePkg::New(path);
+    auto pkg = VolumePkg::New(path);
+    EXPECT_EQ(pkg->segmentationIDs(), std::vector<std::string>{segID});
+    EXPECT_EQ(pkg->volume(volID)->id(), volID);
+}
+
+TEST_F(VolumePkg_Lazy, RefreshesChangedObjects)
+{
+    // Build the index, then rename the segmentation
+    auto pkg = VolumePkg::New(path);
+    auto seg = pkg->segmentation(segID);
+    seg->setName("a longer segmentation name");
+    seg->saveMetadata();
+
+    pkg = VolumePkg::New(path);
+    EXPECT_EQ(
+        pkg->segmentationNames(),
+        std::vector<std::string>{"a longer segmentation name"});
+}
+
+TEST_F(VolumePkg_Lazy, RefreshesRemovedObjects)
+{
+    VolumePkg::New(path);
+    fs::remove_all(path / "renders" / renderID);
+    auto pkg = VolumePkg::New(path);
+    EXPECT_FALSE(pkg->hasRenders());
+}
+
+TEST_F(VolumePkg_Lazy, IgnoresCorruptIndex)
+{
+    VolumePkg::New(path);
+    std::ofstream((path / ".vc_index.json").string()) << "{ not json";
+    auto pkg = VolumePkg::New(path);
+    EXPECT_EQ(pkg->volumeIDs(), std::vector<std::string>{volID});
+}
@@ -3,6 +3,8 @@
 /** @file */
 
 #include "vc/graph/core.hpp"
+#include "vc/graph/ResultCache.hpp"
+#include "vc/graph/TaskPool.hpp"
 #include "vc/graph/meshing.hpp"
 #include "vc/graph/texturing.hpp"
 
@@ -0,0 +1,318 @@
+#pragma once
+
+/** @file */
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/OrderedPointSet.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
+#include "vc/core/types/UVMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/core/types/VolumetricMask.hpp"
+
+namespace volcart
+{
+
+/**
+ * @brief Streaming hash of graph node inputs and parameters
+ *
+ * Produces a 128-bit digest which is used as the content address of a node's
+ * results in the ResultCache. Data is consumed 8 bytes at a time with two
+ * independent multiply-xorshift lanes, so hashing is memory-bandwidth bound
+ * even for large meshes and PerPixelMaps.
+ *
+ * Objects which are too large to reasonably hash by content (e.g. Volume) are
+ * hashed by identity: their path, ID, and dimensions.
+ *
+ * @ingroup Graph
+ */
+class ResultHasher
+{
+public:
+    /** @brief Construct and seed the hash with a node type name */
+    explicit ResultHasher(const std::string& nodeType = "");
+
+    /** @brief Add raw bytes to the hash */
+    void update(const void* data, std::size_t n);
+
+    /** @brief Add an arithmetic or enum value to the hash */
+    template <
+        typename T,
+        std::enable_if_t<
+            std::is_arithmetic_v<T> or std::is_enum_v<T>,
+            bool> = true>
+    void update(const T& v)
+    {
+        update(&v, sizeof(T));
+    }
+
+    /** @brief Add a string to the hash */
+    void update(const std::string& s);
+
+    /** @brief Add a fixed-size OpenCV vector to the hash */
+    template <typename T, int N>
+    void update(const cv::Vec<T, N>& v)
+    {
+        update(v.val, sizeof(T) * N);
+    }
+
+    /** @brief Add a path to the hash */
+    void update(const filesystem::path& p);
+
+    /** @brief Add an image to the hash */
+    void update(const cv::Mat& m);
+
+    /** @brief Add a mesh's points, cells, and point data to the hash */
+    void update(const ITKMesh::Pointer& mesh);
+
+    /** @brief Add a mesh's vertices, faces, normals, and UVs to the hash */
+    void update(const TriangleMesh::Pointer& mesh);
+
+    /** @brief Add a UVMap to the hash */
+    void update(const UVMap::Pointer& uv);
+
+    /** @brief Add a PerPixelMap to the hash */
+    void update(const PerPixelMap::Pointer& ppm);
+
+    /** @brief Add a Volume to the hash (by identity) */
+    void update(const Volume::Pointer& vol);
+
+    /** @brief Add a VolumetricMask to the hash */
+    void update(const VolumetricMask::Pointer& mask);
+
+    /** @brief Add a NeighborhoodGenerator's parameters to the hash */
+    void update(const NeighborhoodGenerator::Pointer& gen);
+
+    /** @brief Add an ordered point set to the hash */
+    template <typename T>
+    void update(const OrderedPointSet<T>& ps)
+    {
+        update(ps.width());
+        update(ps.height());
+        if (not ps.empty()) {
+            update(&ps[0], ps.size() * sizeof(T));
+        }
+    }
+
+    /** @brief Get the hex-encoded digest */
+    [[nodiscard]] auto digest() const -> std::string;
+
+private:
+    /** Hash lanes */
+    std::uint64_t h0_{0};
+    /** Hash lanes */
+    std::uint64_t h1_{0};
+    /** Total number of bytes consumed */
+    std::uint64_t length_{0};
+};
+
+/**
+ * @brief Size-bounded, content-addressed on-disk cache of node results
+ *
+ * Each entry is a directory in `entries/` named by the ResultHasher digest of
+ * a node's inputs and parameters. Nodes write their outputs into the entry
+ * directory using their normal serialization formats (e.g. `.obj`, `.uvm`,
+ * `.ppm`) and read them back on a hash match, skipping computation entirely.
+ * The cache can be shared between any number of renders and VolumePkgs.
+ *
+ * Entry sizes and usage are tracked in `index.json` at the cache root. When
+ * the total size of all entries exceeds capacity(), the least recently used
+ * entries are evicted. Entry directories which are missing from the index
+ * but are named like a digest are counted against the capacity and are
+ * evicted first.
+ *
+ * A marker file identifies the root as a cache. A new cache can only be
+ * created in an empty or missing directory, so the cache never deletes files
+ * it did not create.
+ *
+ * All member functions are safe to call from multiple threads. On POSIX
+ * systems, the index is also guarded by an exclusive file lock and is
+ * re-read before every update, so concurrent processes sharing a cache do not
+ * overwrite each other's entries. Entries which are being loaded are pinned
+ * and will not be evicted by this process during the load. If another process
+ * evicts an entry during a load, the load fails and the result is recomputed.
+ *
+ * @ingroup Graph
+ */
+class ResultCache
+{
+public:
+    /** Pointer type */
+    using Pointer = std::shared_ptr<ResultCache>;
+
+    /** Entry load/store callback. Receives the entry directory. */
+    using EntryCallback = std::function<void(const filesystem::path&)>;
+
+    /** Default capacity: 50 GB */
+    static constexpr std::size_t DEFAULT_CAPACITY{50'000'000'000};
+
+    /**
+     * @brief Open or create a cache at the given root directory
+     *
+     * @throws std::invalid_argument if `root` is a non-empty directory which
+     * is not a result cache
+     */
+    explicit ResultCache(
+        filesystem::path root, std::size_t capacity = DEFAULT_CAPACITY);
+
+    /** @copydoc ResultCache(filesystem::path, std::size_t) */
+    static auto New(
+        filesystem::path root, std::size_t capacity = DEFAULT_CAPACITY)
+        -> Pointer;
+
+    /** @brief Get the cache root directory */
+    [[nodiscard]] auto root() const -> filesystem::path;
+
+    /** @brief Set the maximum size of the cache in bytes */
+    void setCapacity(std::size_t bytes);
+
+    /** @brief Get the maximum size of the cache in bytes */
+    [[nodiscard]] auto capacity() const -> std::size_t;
+
+    /**
+     * @brief Get the current size of all cache entries in bytes
+     *
+     * Reflects the cache index as of the last operation by this object.
+     */
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /**
+     * @brief Get the number of cache entries
+     *
+     * Reflects the cache index as of the last operation by this object.
+     */
+    [[nodiscard]] auto numEntries() const -> std::size_t;
+
+    /**
+     * @brief Check if an entry exists for a key
+     *
+     * Reflects the cache index as of the last operation by this object.
+     */
+    [[nodiscard]] auto contains(const std::string& key) const -> bool;
+
+    /**
+     * @brief Load an entry
+     *
+     * If an entry for the key exists, calls `loader` with the entry directory
+     * and returns true. If the entry does not exist or `loader` throws, the
+     * entry is removed and this function returns false.
+     */
+    auto load(const std::string& key, const EntryCallback& loader) -> bool;
+
+    /**
+     * @brief Store an entry
+     *
+     * Calls `writer` with an empty staging directory. After `writer` returns,
+     * the staging directory is atomically moved into place and LRU entries
+     * are evicted until the cache fits within capacity().
+     */
+    void store(const std::string& key, const EntryCallback& writer);
+
+    /** @brief Remove all entries from the cache */
+    void purge();
+
+private:
+    /** Cache entry information */
+    struct Entry {
+        /** Size on disk */
+        std::size_t bytes{0};
+        /** Logical time of last use */
+        std::uint64_t lastUse{0};
+    };
+
+    /**
+     * Load the index file and add any unindexed entry directories. Must be
+     * called with the index lock held.
+     */
+    void read_index_();
+    /** Save the index file. Must be called with the index lock held. */
+    void write_index_() const;
+    /** Remove an entry from disk and from the index */
+    void remove_(const std::string& key);
+    /** Evict LRU entries until the cache fits within capacity */
+    void evict_();
+    /** Get the directory of an entry */
+    [[nodiscard]] auto entry_dir_(const std::string& key) const
+        -> filesystem::path;
+
+    /** Root directory */
+    filesystem::path root_;
+    /** Max size in bytes */
+    std::size_t capacity_{DEFAULT_CAPACITY};
+    /** Current size in bytes */
+    std::size_t size_{0};
+    /** Logical clock for LRU tracking */
+    std::uint64_t clock_{0};
+    /** Entries by key */
+    std::map<std::string, Entry> entries_;
+    /** Entries currently being loaded */
+    std::map<std::string, std::size_t> pinned_;
+    /** Index mutex */
+    mutable std::mutex mutex_;
+};
+
+/**
+ * @brief Write a mesh to a lossless binary file
+ *
+ * Used for ResultCache entries, where round-tripping through a text format
+ * would perturb vertex positions and change downstream results.
+ */
+void WriteCachedMesh(
+    const filesystem::path& path, const ITKMesh::Pointer& mesh);
+
+/** @brief Read a mesh written by WriteCachedMesh() */
+auto ReadCachedMesh(const filesystem::path& path) -> ITKMesh::Pointer;
+
+/**
+ * @brief Write an image to a raw binary file
+ *
+ * Unlike WriteImage(), every OpenCV depth and channel count is supported
+ * without conversion (e.g. PerPixelMap cell maps).
+ */
+void WriteCachedMat(const filesystem::path& path, const cv::Mat& img);
+
+/** @brief Read an image written by WriteCachedMat() */
+auto ReadCachedMat(const filesystem::path& path) -> cv::Mat;
+
+/**
+ * @brief Set the ResultCache used by VC graph nodes
+ *
+ * Pass `nullptr` to disable result caching (the default).
+ */
+void SetResultCache(ResultCache::Pointer cache);
+
+/** @brief Get the ResultCache used by VC graph nodes */
+auto GetResultCache() -> ResultCache::Pointer;
+
+/**
+ * @brief Compute a node's results, or load them from the global ResultCache
+ *
+ * If no ResultCache is set, this simply calls `compute` and returns an empty
+ * string. Otherwise, `hashInputs` is called to build the content address of
+ * the node's inputs and parameters. If a matching entry is found, `load` is
+ * called instead of `compute`. On a miss, `compute` is called and its results
+ * are saved with `store`.
+ *
+ * @return The content address of the node's inputs, or an empty string if
+ * caching is disabled
+ */
+auto CachedCompute(
+    const std::string& nodeType,
+    const std::function<void(ResultHasher&)>& hashInputs,
+    const std::function<void()>& compute,
+    const ResultCache::EntryCallback& load,
+    const ResultCache::EntryCallback& store) -> std::string;
+
+}  // namespace volcart
@@ -0,0 +1,174 @@
+#pragma once
+
+/** @file */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "vc/core/util/Trace.hpp"
+
+namespace volcart
+{
+
+/**
+ * @brief Bounded pool of worker threads for asynchronous graph work
+ *
+ * VC graph nodes which have no downstream consumers (e.g. WriteMeshNode,
+ * WritePPMNode, WriteImageNode) submit their work to this pool rather than
+ * running it in the graph's update thread. This lets I/O-heavy writer nodes
+ * overlap with compute-heavy nodes such as texturing. Call WaitForTasks()
+ * before reading the results of asynchronous nodes.
+ *
+ * If the pool has zero threads, submitted tasks run immediately on the
+ * calling thread.
+ *
+ * @ingroup Graph
+ */
+class TaskPool
+{
+public:
+    /** Task type */
+    using Task = std::function<void()>;
+
+    /** @brief Construct with a maximum number of worker threads */
+    explicit TaskPool(std::size_t numThreads = 0);
+
+    /** @brief Waits for all queued tasks before destruction */
+    ~TaskPool();
+
+    /**@{*/
+    /** Not copyable or movable */
+    TaskPool(const TaskPool&) = delete;
+    auto operator=(const TaskPool&) -> TaskPool& = delete;
+    /**@}*/
+
+    /** @brief Get the number of worker threads */
+    [[nodiscard]] auto numThreads() const -> std::size_t;
+
+    /**
+     * @brief Submit a task
+     *
+     * The returned future becomes ready when the task completes. Exceptions
+     * thrown by the task are stored and rethrown by wait().
+     */
+    auto submit(Task task) -> std::shared_future<void>;
+
+    /**
+     * @brief Wait for all submitted tasks to complete
+     *
+     * @throws The first exception thrown by a task since the last call to
+     * wait()
+     */
+    void wait();
+
+private:
+    /** Worker thread loop */
+    void worker_();
+
+    /** Worker threads */
+    std::vector<std::thread> threads_;
+    /** Queued tasks */
+    std::deque<std::packaged_task<void()>> queue_;
+    /** Number of queued or running tasks */
+    std::size_t pending_{0};
+    /** First error thrown by a task */
+    std::exception_ptr error_;
+    /** Shutdown flag */
+    bool stop_{false};
+    /** Queue mutex */
+    mutable std::mutex mutex_;
+    /** Signals workers that tasks are available */
+    std::condition_variable taskReady_;
+    /** Signals waiters that all tasks have completed */
+    std::condition_variable allDone_;
+};
+
+/**
+ * @brief Set the number of threads used for asynchronous graph work
+ *
+ * Waits for any outstanding tasks before resizing. The default, 0, runs all
+ * node work synchronously in the graph's update thread.
+ */
+void SetGraphThreads(std::size_t numThreads);
+
+/** @brief Get the number of threads used for asynchronous graph work */
+auto GetGraphThreads() -> std::size_t;
+
+/** @brief Submit a task to the global graph TaskPool */
+auto SubmitGraphTask(TaskPool::Task task) -> std::shared_future<void>;
+
+/** @brief Wait for all tasks in the global graph TaskPool to complete */
+void WaitForGraphTasks();
+
+/**
+ * @brief Record the wall time of a graph node's work
+ *
+ * Timings are accumulated in a process-wide registry which can be retrieved
+ * with GetNodeTimings() and stored in a graph's project metadata. If tracing
+ * is enabled, the node's work is also recorded as a trace::Span.
+ *
+ * @code
+ * compute = [=]() {
+ *     ScopedNodeTimer timer("MyNode");
+ *     ...
+ * };
+ * @endcode
+ *
+ * @ingroup Graph
+ */
+class ScopedNodeTimer
+{
+public:
+    /** @brief Start timing */
+    explicit ScopedNodeTimer(std::string nodeType);
+
+    /** @brief Stop timing and record the result */
+    ~ScopedNodeTimer();
+
+    /**@{*/
+    /** Not copyable */
+    ScopedNodeTimer(const ScopedNodeTimer&) = delete;
+    auto operator=(const ScopedNodeTimer&) -> ScopedNodeTimer& = delete;
+    /**@}*/
+
+    /** @brief Add a key/value annotation to the recorded timing */
+    void annotate(const std::string& key, nlohmann::json value);
+
+private:
+    /** Clock type */
+    using Clock = std::chrono::steady_clock;
+    /** Node type name */
+    std::string nodeType_;
+    /** Annotations */
+    nlohmann::json extra_;
+    /** Start time */
+    Clock::time_point start_;
+    /** Trace span */
+    trace::Span span_;
+};
+
+/**
+ * @brief Get all recorded node timings
+ *
+ * Returns a JSON array with one object per recorded node execution, in order
+ * of completion. Each object contains the node type, start offset and
+ * duration in seconds, the executing thread, and any annotations.
+ */
+auto GetNodeTimings() -> nlohmann::json;
+
+/** @brief Clear all recorded node timings */
+void ClearNodeTimings();
+
+}  // namespace volcart
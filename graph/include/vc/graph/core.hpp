@@ -2,6 +2,8 @@
 
 /** @file */
 
+#include <future>
+
 #include <opencv2/core.hpp>
 #include <smgl/Node.hpp>
 
@@ -284,6 +286,9 @@ private:
 /**
  * @copybrief WriteMesh()
  *
+ * The write is submitted to the graph TaskPool and may complete after this
+ * node's compute returns. Call WaitForGraphTasks() before using the file.
+ *
  * @see WriteMesh()
  * @ingroup Graph
  */
@@ -300,6 +305,8 @@ private:
     cv::Mat texture_{};
     /** Include the saved file in the graph cache */
     bool cacheArgs_{false};
+    /** Pending asynchronous write */
+    std::shared_future<void> pending_;
 
 public:
     /** @brief Output file */
@@ -485,6 +492,9 @@ private:
 /**
  * @copybrief WriteImage()
  *
+ * The write is submitted to the graph TaskPool and may complete after this
+ * node's compute returns. Call WaitForGraphTasks() before using the file.
+ *
  * @see WriteImage()
  * @ingroup Graph
  */
@@ -497,6 +507,8 @@ private:
     cv::Mat image_{};
     /** Include the saved file in the graph cache */
     bool cacheArgs_{false};
+    /** Pending asynchronous write */
+    std::shared_future<void> pending_;
 
 public:
     /** @brief Output file */
@@ -561,6 +573,9 @@ private:
 /**
  * @copybrief PerPixelMap::WritePPM()
  *
+ * The write is submitted to the graph TaskPool and may complete after this
+ * node's compute returns. Call WaitForGraphTasks() before using the file.
+ *
  * @see PerPixelMap::WritePPM()
  * @ingroup Graph
  */
@@ -573,6 +588,8 @@ private:
     PerPixelMap::Pointer ppm_{};
     /** Include the saved file in the graph cache */
     bool cacheArgs_{false};
+    /** Pending asynchronous write */
+    std::shared_future<void> pending_;
 
 public:
     /** @brief Output file */
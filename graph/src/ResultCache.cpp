@@ -0,0 +1,846 @@
+#include "vc/graph/ResultCache.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__unix) || defined(unix) || \
+    (defined(__APPLE__) && defined(__MACH__))
+#define VC_HAS_FLOCK
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/file.h>
+#include <unistd.h>
+#endif
+
+#include <nlohmann/json.hpp>
+
+#include "vc/core/types/Exceptions.hpp"
+#include "vc/core/util/Logging.hpp"
+#include "vc/graph/TaskPool.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+/** Marker file which identifies a cache root */
+static const std::string MARKER_FILE{".vc-result-cache"};
+/** Entries directory name */
+static const std::string ENTRIES_DIR{"entries"};
+/** Index file name */
+static const std::string INDEX_FILE{"index.json"};
+/** Index lock file name */
+static const std::string LOCK_FILE{".lock"};
+/** Staging directory prefix */
+static const std::string STAGING_PREFIX{".staging-"};
+
+/** Lane multipliers (64-bit primes) */
+static constexpr std::uint64_t K0{0x9E3779B185EBCA87ULL};
+static constexpr std::uint64_t K1{0xC2B2AE3D27D4EB4FULL};
+
+static inline auto Mix(std::uint64_t h, std::uint64_t k, std::uint64_t m)
+    -> std::uint64_t
+{
+    h ^= k;
+    h *= m;
+    h ^= h >> 29;
+    return h;
+}
+
+static inline auto Finalize(std::uint64_t h) -> std::uint64_t
+{
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static auto DirectorySize(const fs::path& dir) -> std::size_t
+{
+    std::size_t bytes{0};
+    for (const auto& e : fs::recursive_directory_iterator(dir)) {
+        if (fs::is_regular_file(e.path())) {
+            bytes += fs::file_size(e.path());
+        }
+    }
+    return bytes;
+}
+
+// Whether a directory name has the format of a ResultHasher digest
+static auto IsDigest(const std::string& name) -> bool
+{
+    return name.size() == 32 and
+           name.find_first_not_of("0123456789abcdef") == std::string::npos;
+}
+
+// ID of this process, or 0 if it cannot be determined
+static auto ProcessID() -> std::uint64_t
+{
+#if defined(VC_HAS_FLOCK)
+    return static_cast<std::uint64_t>(::getpid());
+#else
+    return 0;
+#endif
+}
+
+// Suffix for temporary paths which is unique across threads and processes:
+// "<pid>-<random>"
+static auto UniqueSuffix() -> std::string
+{
+    static std::atomic<std::uint64_t> counter{std::random_device{}()};
+    std::ostringstream ss;
+    ss << ProcessID() << "-" << std::hex
+       << (counter.fetch_add(1) * 0x9E3779B97F4A7C15ULL);
+    return ss.str();
+}
+
+// Whether the process which created a staging directory has exited. Staging
+// directory names start with STAGING_PREFIX + "<pid>-".
+static auto StagingIsStale(const std::string& name) -> bool
+{
+#if defined(VC_HAS_FLOCK)
+    auto pidStr = name.substr(STAGING_PREFIX.size());
+    pidStr = pidStr.substr(0, pidStr.find('-'));
+    if (pidStr.empty() or
+        pidStr.find_first_not_of("0123456789") != std::string::npos) {
+        return true;
+    }
+    auto pid = static_cast<pid_t>(std::stoll(pidStr));
+    return pid != ::getpid() and ::kill(pid, 0) != 0 and errno == ESRCH;
+#else
+    // Cannot tell if another process is still writing
+    return false;
+#endif
+}
+
+namespace
+{
+// Exclusive lock on the cache index which is shared by all processes using
+// the cache. Where flock is unavailable, only the threads of one process are
+// synchronized (by ResultCache's mutex).
+class IndexLock
+{
+public:
+    explicit IndexLock(const fs::path& path)
+    {
+#if defined(VC_HAS_FLOCK)
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) {
+            throw IOException("Failed to open lock file: " + path.string());
+        }
+        while (::flock(fd_, LOCK_EX) != 0) {
+            if (errno != EINTR) {
+                ::close(fd_);
+                throw IOException("Failed to lock file: " + path.string());
+            }
+        }
+#endif
+    }
+
+    ~IndexLock()
+    {
+#if defined(VC_HAS_FLOCK)
+        ::flock(fd_, LOCK_UN);
+        ::close(fd_);
+#endif
+    }
+
+    IndexLock(const IndexLock&) = delete;
+    auto operator=(const IndexLock&) -> IndexLock& = delete;
+
+private:
+    int fd_{-1};
+};
+}  // namespace
+
+///// ResultHasher /////
+ResultHasher::ResultHasher(const std::string& nodeType)
+    : h0_{0x243F6A8885A308D3ULL}, h1_{0x13198A2E03707344ULL}
+{
+    update(nodeType);
+}
+
+void ResultHasher::update(const void* data, std::size_t n)
+{
+    auto bytes = static_cast<const std::uint8_t*>(data);
+    length_ += n;
+
+    // Bulk: alternate 8-byte words between lanes
+    while (n >= 16) {
+        std::uint64_t k0{0};
+        std::uint64_t k1{0};
+        std::memcpy(&k0, bytes, 8);
+        std::memcpy(&k1, bytes + 8, 8);
+        h0_ = Mix(h0_, k0, K0);
+        h1_ = Mix(h1_, k1, K1);
+        bytes += 16;
+        n -= 16;
+    }
+
+    // Tail
+    if (n > 0) {
+        std::uint64_t k0{0};
+        std::uint64_t k1{0};
+        auto n0 = std::min<std::size_t>(n, 8);
+        std::memcpy(&k0, bytes, n0);
+        if (n > 8) {
+            std::memcpy(&k1, bytes + 8, n - 8);
+        }
+        h0_ = Mix(h0_, k0 ^ n, K0);
+        h1_ = Mix(h1_, k1 ^ n, K1);
+    }
+}
+
+void ResultHasher::update(const std::string& s)
+{
+    update(s.size());
+    update(s.data(), s.size());
+}
+
+void ResultHasher::update(const fs::path& p) { update(p.string()); }
+
+void ResultHasher::update(const cv::Mat& m)
+{
+    update(m.type());
+    update(m.rows);
+    update(m.cols);
+    if (m.empty()) {
+        return;
+    }
+    auto rowBytes = m.cols * m.elemSize();
+    for (int y = 0; y < m.rows; y++) {
+        update(m.ptr(y), rowBytes);
+    }
+}
+
+void ResultHasher::update(const ITKMesh::Pointer& mesh)
+{
+    if (not mesh) {
+        update(std::string("null"));
+        return;
+    }
+
+    update(mesh->GetNumberOfPoints());
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        update(pt.Index());
+        update(pt.Value().GetDataPointer(), 3 * sizeof(double));
+    }
+
+    update(mesh->GetNumberOfCells());
+    for (auto c = mesh->GetCells()->Begin(); c != mesh->GetCells()->End();
+         ++c) {
+        for (auto id = c.Value()->PointIdsBegin();
+             id != c.Value()->PointIdsEnd(); ++id) {
+            update(*id);
+        }
+    }
+
+    if (mesh->GetPointData() != nullptr) {
+        update(mesh->GetPointData()->Size());
+        for (auto d = mesh->GetPointData()->Begin();
+             d != mesh->GetPointData()->End(); ++d) {
+            update(d.Index());
+            update(d.Value().GetDataPointer(), 3 * sizeof(double));
+        }
+    }
+}
+
+void ResultHasher::update(const TriangleMesh::Pointer& mesh)
+{
+    if (not mesh) {
+        update(std::string("null"));
+        return;
+    }
+
+    // Hash each attribute with its length so empty attributes are distinct
+    auto updateAll = [this](const auto& v) {
+        update(v.size());
+        if (not v.empty()) {
+            update(v.data(), v.size() * sizeof(v[0]));
+        }
+    };
+    updateAll(mesh->vertices());
+    updateAll(mesh->faces());
+    updateAll(mesh->normals());
+    updateAll(mesh->uvs());
+}
+
+void ResultHasher::update(const UVMap::Pointer& uv)
+{
+    if (not uv) {
+        update(std::string("null"));
+        return;
+    }
+    update(uv->ratio().width);
+    update(uv->ratio().height);
+    update(uv->ratio().aspect);
+    update(uv->size());
+    // Unset IDs are NULL_MAPPING, which cannot occur relative to the top-left
+    auto uvs = uv->getAll(UVMap::Origin::TopLeft);
+    update(uvs.data(), uvs.size() * sizeof(cv::Vec2d));
+}
+
+void ResultHasher::update(const PerPixelMap::Pointer& ppm)
+{
+    if (not ppm) {
+        update(std::string("null"));
+        return;
+    }
+    update(ppm->height());
+    update(ppm->width());
+    if (ppm->initialized()) {
+        for (std::size_t y = 0; y < ppm->height(); y++) {
+            update(&ppm->getMapping(y, 0), ppm->width() * sizeof(cv::Vec6d));
+        }
+    }
+    update(ppm->mask());
+    update(ppm->cellMap());
+}
+
+void ResultHasher::update(const Volume::Pointer& vol)
+{
+    if (not vol) {
+        update(std::string("null"));
+        return;
+    }
+    update(vol->path());
+    update(vol->id());
+    update(vol->sliceWidth());
+    update(vol->sliceHeight());
+    update(vol->numSlices());
+    update(vol->voxelSize());
+}
+
+void ResultHasher::update(const VolumetricMask::Pointer& mask)
+{
+    if (not mask) {
+        update(std::string("null"));
+        return;
+    }
+
+    // Storage order is unspecified, so combine voxels commutatively
+    std::uint64_t sum{0};
+    std::uint64_t count{0};
+    for (const auto& v : *mask) {
+        std::uint64_t k{0};
+        k = Mix(k, static_cast<std::uint64_t>(v[0]), K0);
+        k = Mix(k, static_cast<std::uint64_t>(v[1]), K0);
+        k = Mix(k, static_cast<std::uint64_t>(v[2]), K0);
+        sum += Finalize(k);
+        count++;
+    }
+    update(count);
+    update(sum);
+}
+
+void ResultHasher::update(const NeighborhoodGenerator::Pointer& gen)
+{
+    if (not gen) {
+        update(std::string("null"));
+        return;
+    }
+    update(gen->dim());
+    update(gen->samplingRadius());
+    update(gen->samplingInterval());
+    update(gen->samplingDirection());
+    update(gen->autoGenAxes());
+    for (const auto& e : gen->extents()) {
+        update(e);
+    }
+}
+
+auto ResultHasher::digest() const -> std::string
+{
+    auto a = Finalize(h0_ ^ length_);
+    auto b = Finalize(h1_ ^ (length_ * K0));
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << a << std::setw(16)
+       << b;
+    return ss.str();
+}
+
+///// ResultCache /////
+ResultCache::ResultCache(fs::path root, std::size_t capacity)
+    : root_{std::move(root)}, capacity_{capacity}
+{
+    // Only manage directories which were created as a cache. Eviction
+    // deletes entries, so never adopt the contents of an arbitrary directory.
+    fs::create_directories(root_);
+    if (not fs::exists(root_ / MARKER_FILE)) {
+        if (not fs::is_empty(root_)) {
+            auto msg = "Not a result cache directory: " + root_.string();
+            throw std::invalid_argument(msg);
+        }
+        std::ofstream marker((root_ / MARKER_FILE).string());
+        marker << "volume-cartographer result cache\n";
+        if (not marker) {
+            auto msg = "Failed to create result cache: " + root_.string();
+            throw IOException(msg);
+        }
+    }
+    fs::create_directories(root_ / ENTRIES_DIR);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    IndexLock indexLock(root_ / LOCK_FILE);
+
+    // Clean up staging dirs left by interrupted stores
+    std::vector<fs::path> staging;
+    for (const auto& e : fs::directory_iterator(root_)) {
+        auto name = e.path().filename().string();
+        if (name.rfind(STAGING_PREFIX, 0) == 0 and StagingIsStale(name)) {
+            staging.push_back(e.path());
+        }
+    }
+    for (const auto& p : staging) {
+        fs::remove_all(p);
+    }
+
+    read_index_();
+    evict_();
+    write_index_();
+}
+
+auto ResultCache::New(fs::path root, std::size_t capacity) -> Pointer
+{
+    return std::make_shared<ResultCache>(std::move(root), capacity);
+}
+
+auto ResultCache::root() const -> fs::path { return root_; }
+
+void ResultCache::setCapacity(std::size_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    IndexLock indexLock(root_ / LOCK_FILE);
+    read_index_();
+    capacity_ = bytes;
+    evict_();
+    write_index_();
+}
+
+auto ResultCache::capacity() const -> std::size_t
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return capacity_;
+}
+
+auto ResultCache::size() const -> std::size_t
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return size_;
+}
+
+auto ResultCache::numEntries() const -> std::size_t
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+auto ResultCache::contains(const std::string& key) const -> bool
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return entries_.count(key) > 0;
+}
+
+auto ResultCache::load(const std::string& key, const EntryCallback& loader)
+    -> bool
+{
+    // Pin the entry so it isn't evicted while loading
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        IndexLock indexLock(root_ / LOCK_FILE);
+        read_index_();
+        auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return false;
+        }
+        it->second.lastUse = ++clock_;
+        pinned_[key]++;
+        write_index_();
+    }
+
+    bool loaded{true};
+    try {
+        loader(entry_dir_(key));
+    } catch (const std::exception& e) {
+        Logger()->warn("Failed to load cached result {}: {}", key, e.what());
+        loaded = false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (--pinned_[key] == 0) {
+        pinned_.erase(key);
+    }
+    if (not loaded and pinned_.count(key) == 0) {
+        IndexLock indexLock(root_ / LOCK_FILE);
+        read_index_();
+        remove_(key);
+        write_index_();
+    }
+    return loaded;
+}
+
+void ResultCache::store(const std::string& key, const EntryCallback& writer)
+{
+    // Write into a private staging directory
+    auto staging = root_ / (STAGING_PREFIX + UniqueSuffix() + "-" + key);
+    fs::create_directories(staging);
+    try {
+        writer(staging);
+    } catch (const std::exception& e) {
+        Logger()->warn("Failed to store cached result {}: {}", key, e.what());
+        fs::remove_all(staging);
+        return;
+    }
+    auto bytes = DirectorySize(staging);
+
+    // Move into place
+    std::unique_lock<std::mutex> lock(mutex_);
+    IndexLock indexLock(root_ / LOCK_FILE);
+    read_index_();
+    if (pinned_.count(key) > 0) {
+        // Someone is reading an identical entry; keep theirs
+        fs::remove_all(staging);
+        return;
+    }
+    remove_(key);
+    fs::rename(staging, entry_dir_(key));
+    entries_[key] = {bytes, ++clock_};
+    size_ += bytes;
+    evict_();
+    write_index_();
+}
+
+void ResultCache::purge()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    IndexLock indexLock(root_ / LOCK_FILE);
+    read_index_();
+    std::vector<std::string> keys;
+    for (const auto& e : entries_) {
+        if (pinned_.count(e.first) == 0) {
+            keys.push_back(e.first);
+        }
+    }
+    for (const auto& k : keys) {
+        remove_(k);
+    }
+    write_index_();
+}
+
+void ResultCache::read_index_()
+{
+    entries_.clear();
+    size_ = 0;
+    clock_ = 0;
+
+    auto indexPath = root_ / INDEX_FILE;
+    if (fs::exists(indexPath)) {
+        try {
+            nlohmann::json index;
+            std::ifstream ifs(indexPath.string());
+            ifs >> index;
+            clock_ = index["clock"].get<std::uint64_t>();
+            for (const auto& [key, e] : index["entries"].items()) {
+                // Skip entries which have been removed from disk
+                if (not fs::is_directory(entry_dir_(key))) {
+                    continue;
+                }
+                Entry entry;
+                entry.bytes = e["bytes"].get<std::size_t>();
+                entry.lastUse = e["lastUse"].get<std::uint64_t>();
+                entries_[key] = entry;
+            }
+        } catch (const std::exception& e) {
+            Logger()->warn("Result cache index is corrupt. Rebuilding index.");
+            entries_.clear();
+        }
+    }
+
+    // Entry directories which are missing from the index (e.g. after a crash
+    // or a corrupt index) still count against the capacity. They are treated
+    // as least recently used so that they are evicted first. Only directories
+    // named like a digest are adopted.
+    for (const auto& d : fs::directory_iterator(root_ / ENTRIES_DIR)) {
+        auto key = d.path().filename().string();
+        if (not fs::is_directory(d.path()) or not IsDigest(key) or
+            entries_.count(key) > 0) {
+            continue;
+        }
+        entries_[key] = {DirectorySize(d.path()), 0};
+    }
+
+    for (const auto& e : entries_) {
+        size_ += e.second.bytes;
+    }
+}
+
+void ResultCache::write_index_() const
+{
+    nlohmann::json index;
+    index["clock"] = clock_;
+    index["entries"] = nlohmann::json::object();
+    for (const auto& [key, e] : entries_) {
+        index["entries"][key] = {{"bytes", e.bytes}, {"lastUse", e.lastUse}};
+    }
+
+    // Write then rename so the index is never partially written
+    auto tmp = root_ / (INDEX_FILE + ".tmp-" + UniqueSuffix());
+    std::ofstream ofs(tmp.string());
+    ofs << index.dump(2) << "\n";
+    ofs.close();
+    fs::rename(tmp, root_ / INDEX_FILE);
+}
+
+void ResultCache::remove_(const std::string& key)
+{
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+        size_ -= it->second.bytes;
+        entries_.erase(it);
+    }
+    fs::remove_all(entry_dir_(key));
+}
+
+auto ResultCache::entry_dir_(const std::string& key) const -> fs::path
+{
+    return root_ / ENTRIES_DIR / key;
+}
+
+void ResultCache::evict_()
+{
+    while (size_ > capacity_) {
+        // Find the least recently used, unpinned entry
+        auto lru = entries_.end();
+        for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+            if (pinned_.count(it->first) > 0) {
+                continue;
+            }
+            if (lru == entries_.end() or
+                it->second.lastUse < lru->second.lastUse) {
+                lru = it;
+            }
+        }
+        if (lru == entries_.end()) {
+            break;
+        }
+        Logger()->debug("Evicting cached result: {}", lru->first);
+        remove_(lru->first);
+    }
+}
+
+///// Lossless mesh files /////
+/** Cached mesh file magic */
+static const std::string MESH_MAGIC{"vc-cached-mesh-v1"};
+
+template <typename T>
+static void WriteValue(std::ofstream& os, const T& v)
+{
+    os.write(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+static auto ReadValue(std::ifstream& is) -> T
+{
+    T v{};
+    is.read(reinterpret_cast<char*>(&v), sizeof(T));
+    if (not is) {
+        throw IOException("Unexpected end of cached mesh file");
+    }
+    return v;
+}
+
+void volcart::WriteCachedMesh(
+    const fs::path& path, const ITKMesh::Pointer& mesh)
+{
+    std::ofstream os(path.string(), std::ios::binary);
+    if (not os.is_open()) {
+        throw IOException("could not open file '" + path.string() + "'");
+    }
+    os.write(MESH_MAGIC.data(), MESH_MAGIC.size());
+
+    // Vertices
+    WriteValue<std::uint64_t>(os, mesh->GetNumberOfPoints());
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        WriteValue<std::uint64_t>(os, pt.Index());
+        os.write(
+            reinterpret_cast<const char*>(pt.Value().GetDataPointer()),
+            3 * sizeof(double));
+    }
+
+    // Vertex normals
+    std::uint64_t numData{0};
+    if (mesh->GetPointData() != nullptr) {
+        numData = mesh->GetPointData()->Size();
+    }
+    WriteValue(os, numData);
+    if (numData > 0) {
+        for (auto d = mesh->GetPointData()->Begin();
+             d != mesh->GetPointData()->End(); ++d) {
+            WriteValue<std::uint64_t>(os, d.Index());
+            os.write(
+                reinterpret_cast<const char*>(d.Value().GetDataPointer()),
+                3 * sizeof(double));
+        }
+    }
+
+    // Faces
+    WriteValue<std::uint64_t>(os, mesh->GetNumberOfCells());
+    for (auto c = mesh->GetCells()->Begin(); c != mesh->GetCells()->End();
+         ++c) {
+        WriteValue<std::uint64_t>(os, c.Index());
+        for (auto id = c.Value()->PointIdsBegin();
+             id != c.Value()->PointIdsEnd(); ++id) {
+            WriteValue<std::uint64_t>(os, *id);
+        }
+    }
+
+    if (not os) {
+        throw IOException("failed to write '" + path.string() + "'");
+    }
+}
+
+auto volcart::ReadCachedMesh(const fs::path& path) -> ITKMesh::Pointer
+{
+    std::ifstream is(path.string(), std::ios::binary);
+    if (not is.is_open()) {
+        throw IOException("could not open file '" + path.string() + "'");
+    }
+    std::string magic(MESH_MAGIC.size(), '\0');
+    is.read(magic.data(), magic.size());
+    if (magic != MESH_MAGIC) {
+        throw IOException("not a cached mesh file: " + path.string());
+    }
+
+    auto mesh = ITKMesh::New();
+    auto numPts = ReadValue<std::uint64_t>(is);
+    ITKPoint pt;
+    for (std::uint64_t i = 0; i < numPts; i++) {
+        auto id = ReadValue<std::uint64_t>(is);
+        is.read(
+            reinterpret_cast<char*>(pt.GetDataPointer()), 3 * sizeof(double));
+        mesh->SetPoint(id, pt);
+    }
+
+    auto numData = ReadValue<std::uint64_t>(is);
+    ITKPixel n;
+    for (std::uint64_t i = 0; i < numData; i++) {
+        auto id = ReadValue<std::uint64_t>(is);
+        is.read(
+            reinterpret_cast<char*>(n.GetDataPointer()), 3 * sizeof(double));
+        mesh->SetPointData(id, n);
+    }
+
+    auto numCells = ReadValue<std::uint64_t>(is);
+    ITKCell::CellAutoPointer cell;
+    for (std::uint64_t i = 0; i < numCells; i++) {
+        auto cid = ReadValue<std::uint64_t>(is);
+        cell.TakeOwnership(new ITKTriangle);
+        for (ITKCell::PointIdentifier v = 0; v < 3; v++) {
+            cell->SetPointId(v, ReadValue<std::uint64_t>(is));
+        }
+        mesh->SetCell(cid, cell);
+    }
+
+    return mesh;
+}
+
+///// Raw image files /////
+/** Cached image file magic */
+static const std::string MAT_MAGIC{"vc-cached-mat-v1"};
+
+void volcart::WriteCachedMat(const fs::path& path, const cv::Mat& img)
+{
+    std::ofstream os(path.string(), std::ios::binary);
+    if (not os.is_open()) {
+        throw IOException("could not open file '" + path.string() + "'");
+    }
+    os.write(MAT_MAGIC.data(), MAT_MAGIC.size());
+    WriteValue<std::int32_t>(os, img.rows);
+    WriteValue<std::int32_t>(os, img.cols);
+    WriteValue<std::int32_t>(os, img.type());
+    auto rowBytes = img.cols * img.elemSize();
+    for (int y = 0; y < img.rows; y++) {
+        os.write(reinterpret_cast<const char*>(img.ptr(y)), rowBytes);
+    }
+    if (not os) {
+        throw IOException("failed to write '" + path.string() + "'");
+    }
+}
+
+auto volcart::ReadCachedMat(const fs::path& path) -> cv::Mat
+{
+    std::ifstream is(path.string(), std::ios::binary);
+    if (not is.is_open()) {
+        throw IOException("could not open file '" + path.string() + "'");
+    }
+    std::string magic(MAT_MAGIC.size(), '\0');
+    is.read(magic.data(), magic.size());
+    if (magic != MAT_MAGIC) {
+        throw IOException("not a cached image file: " + path.string());
+    }
+
+    auto rows = ReadValue<std::int32_t>(is);
+    auto cols = ReadValue<std::int32_t>(is);
+    auto type = ReadValue<std::int32_t>(is);
+    cv::Mat img(rows, cols, type);
+    is.read(reinterpret_cast<char*>(img.data), img.total() * img.elemSize());
+    if (not is) {
+        throw IOException("Unexpected end of cached image file");
+    }
+    return img;
+}
+
+///// Global cache /////
+static std::mutex GLOBAL_CACHE_MUTEX;
+static ResultCache::Pointer GLOBAL_CACHE{nullptr};
+
+void volcart::SetResultCache(ResultCache::Pointer cache)
+{
+    std::unique_lock<std::mutex> lock(GLOBAL_CACHE_MUTEX);
+    GLOBAL_CACHE = std::move(cache);
+}
+
+auto volcart::GetResultCache() -> ResultCache::Pointer
+{
+    std::unique_lock<std::mutex> lock(GLOBAL_CACHE_MUTEX);
+    return GLOBAL_CACHE;
+}
+
+auto volcart::CachedCompute(
+    const std::string& nodeType,
+    const std::function<void(ResultHasher&)>& hashInputs,
+    const std::function<void()>& compute,
+    const ResultCache::EntryCallback& load,
+    const ResultCache::EntryCallback& store) -> std::string
+{
+    ScopedNodeTimer timer(nodeType);
+    auto cache = GetResultCache();
+    if (not cache) {
+        compute();
+        return {};
+    }
+
+    ResultHasher hasher(nodeType);
+    hashInputs(hasher);
+    auto key = hasher.digest();
+
+    if (cache->load(key, load)) {
+        Logger()->info("Loaded cached result for {}: {}", nodeType, key);
+        timer.annotate("cached", true);
+        return key;
+    }
+
+    compute();
+    cache->store(key, store);
+    return key;
+}
@@ -0,0 +1,179 @@
+#include "vc/graph/TaskPool.hpp"
+
+#include <memory>
+#include <sstream>
+
+using namespace volcart;
+
+///// TaskPool /////
+TaskPool::TaskPool(std::size_t numThreads)
+{
+    threads_.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; i++) {
+        threads_.emplace_back(&TaskPool::worker_, this);
+    }
+}
+
+TaskPool::~TaskPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    taskReady_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+auto TaskPool::numThreads() const -> std::size_t { return threads_.size(); }
+
+auto TaskPool::submit(Task task) -> std::shared_future<void>
+{
+    // Synchronous mode: run now and throw errors immediately
+    if (threads_.empty()) {
+        std::packaged_task<void()> now(std::move(task));
+        auto future = now.get_future().share();
+        now();
+        future.get();
+        return future;
+    }
+
+    // Wrap the task so errors are recorded for wait()
+    std::packaged_task<void()> wrapped([this, task = std::move(task)]() {
+        try {
+            task();
+        } catch (...) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (not error_) {
+                error_ = std::current_exception();
+            }
+            throw;
+        }
+    });
+    auto future = wrapped.get_future().share();
+
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        queue_.emplace_back(std::move(wrapped));
+        pending_++;
+    }
+    taskReady_.notify_one();
+    return future;
+}
+
+void TaskPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    allDone_.wait(lock, [this]() { return pending_ == 0; });
+    if (error_) {
+        auto e = error_;
+        error_ = nullptr;
+        std::rethrow_exception(e);
+    }
+}
+
+void TaskPool::worker_()
+{
+    while (true) {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            taskReady_.wait(
+                lock, [this]() { return stop_ or not queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        // Exceptions are stored in the task's future
+        task();
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+            allDone_.notify_all();
+        }
+    }
+}
+
+///// Global pool /////
+static std::mutex GLOBAL_POOL_MUTEX;
+static std::unique_ptr<TaskPool> GLOBAL_POOL;
+
+static auto GlobalPool() -> TaskPool&
+{
+    std::unique_lock<std::mutex> lock(GLOBAL_POOL_MUTEX);
+    if (not GLOBAL_POOL) {
+        GLOBAL_POOL = std::make_unique<TaskPool>();
+    }
+    return *GLOBAL_POOL;
+}
+
+void volcart::SetGraphThreads(std::size_t numThreads)
+{
+    GlobalPool().wait();
+    std::unique_lock<std::mutex> lock(GLOBAL_POOL_MUTEX);
+    GLOBAL_POOL = std::make_unique<TaskPool>(numThreads);
+}
+
+auto volcart::GetGraphThreads() -> std::size_t
+{
+    return GlobalPool().numThreads();
+}
+
+auto volcart::SubmitGraphTask(TaskPool::Task task) -> std::shared_future<void>
+{
+    return GlobalPool().submit(std::move(task));
+}
+
+void volcart::WaitForGraphTasks() { GlobalPool().wait(); }
+
+///// Node timings /////
+static std::mutex TIMINGS_MUTEX;
+static nlohmann::json TIMINGS = nlohmann::json::array();
+static const auto TIMINGS_EPOCH = std::chrono::steady_clock::now();
+
+ScopedNodeTimer::ScopedNodeTimer(std::string nodeType)
+    : nodeType_{std::move(nodeType)}
+    , extra_(nlohmann::json::object())
+    , start_{Clock::now()}
+    , span_{nodeType_, "graph"}
+{
+}
+
+ScopedNodeTimer::~ScopedNodeTimer()
+{
+    using Seconds = std::chrono::duration<double>;
+    auto end = Clock::now();
+
+    std::ostringstream thread;
+    thread << std::this_thread::get_id();
+
+    auto t = extra_;
+    t["node"] = nodeType_;
+    t["start"] = Seconds(start_ - TIMINGS_EPOCH).count();
+    t["duration"] = Seconds(end - start_).count();
+    t["thread"] = thread.str();
+
+    std::unique_lock<std::mutex> lock(TIMINGS_MUTEX);
+    TIMINGS.push_back(std::move(t));
+}
+
+void ScopedNodeTimer::annotate(const std::string& key, nlohmann::json value)
+{
+    extra_[key] = std::move(value);
+}
+
+auto volcart::GetNodeTimings() -> nlohmann::json
+{
+    std::unique_lock<std::mutex> lock(TIMINGS_MUTEX);
+    return TIMINGS;
+}
+
+void volcart::ClearNodeTimings()
+{
+    std::unique_lock<std::mutex> lock(TIMINGS_MUTEX);
+    TIMINGS = nlohmann::json::array();
+}
@@ -6,6 +6,7 @@
 #include "vc/core/io/PointSetIO.hpp"
 #include "vc/core/io/UVMapIO.hpp"
 #include "vc/core/util/FloatComparison.hpp"
+#include "vc/graph/TaskPool.hpp"
 
 using namespace volcart;
 namespace fs = volcart::filesystem;
@@ -203,7 +204,16 @@ WriteMeshNode::WriteMeshNode()
     registerInputPort("uvMap", uvMap);
     registerInputPort("texture", texture);
     registerInputPort("cacheArgs", cacheArgs);
-    compute = [=]() { WriteMesh(path_, mesh_, uv_, texture_); };
+    compute = [=]() {
+        if (pending_.valid()) {
+            pending_.wait();
+        }
+        pending_ = SubmitGraphTask(
+            [path = path_, mesh = mesh_, uv = uv_, texture = texture_]() {
+                ScopedNodeTimer timer("WriteMeshNode");
+                WriteMesh(path, mesh, uv, texture);
+            });
+    };
     usesCacheDir = [this]() { return cacheArgs_; };
 }
 
@@ -311,6 +321,7 @@ PlotUVMapNode::PlotUVMapNode()
     registerOutputPort("plot", plot);
 
     compute = [=]() {
+        ScopedNodeTimer timer("PlotUVMapNode");
         if (uvMap_ and uvMesh_ and not uvMap_->empty()) {
             plot_ = UVMap::Plot(*uvMap_, uvMesh_);
         }
@@ -372,7 +383,15 @@ WriteImageNode::WriteImageNode()
     registerInputPort("path", path);
     registerInputPort("image", image);
     registerInputPort("cacheArgs", cacheArgs);
-    compute = [=]() { WriteImage(path_, image_); };
+    compute = [=]() {
+        if (pending_.valid()) {
+            pending_.wait();
+        }
+        pending_ = SubmitGraphTask([path = path_, image = image_]() {
+            ScopedNodeTimer timer("WriteImageNode");
+            WriteImage(path, image);
+        });
+    };
     usesCacheDir = [this]() { return cacheArgs_; };
 }
 
@@ -431,7 +450,15 @@ WritePPMNode::WritePPMNode()
     registerInputPort("path", path);
     registerInputPort("ppm", ppm);
     registerInputPort("cacheArgs", cacheArgs);
-    compute = [=]() { PerPixelMap::WritePPM(path_, *ppm_); };
+    compute = [=]() {
+        if (pending_.valid()) {
+            pending_.wait();
+        }
+        pending_ = SubmitGraphTask([path = path_, ppm = ppm_]() {
+            ScopedNodeTimer timer("WritePPMNode");
+            PerPixelMap::WritePPM(path, *ppm);
+        });
+    };
     usesCacheDir = [this]() { return cacheArgs_; };
 }
 
@@ -3,6 +3,7 @@
 #include <nlohmann/json.hpp>
 
 #include "vc/core/io/MeshIO.hpp"
+#include "vc/graph/ResultCache.hpp"
 #include "vc/meshing/ScaleMesh.hpp"
 
 using namespace volcart;
@@ -26,7 +27,14 @@ MeshingNode::MeshingNode()
 {
     registerInputPort("points", points);
     registerOutputPort("mesh", mesh);
-    compute = [=]() { mesh_ = mesher_.compute(); };
+    compute = [=]() {
+        CachedCompute(
+            "MeshingNode",
+            [=](ResultHasher& h) { h.update(mesher_.getPointSet()); },
+            [=]() { mesh_ = mesher_.compute(); },
+            [=](const fs::path& dir) { mesh_ = ReadCachedMesh(dir / "mesh"); },
+            [=](const fs::path& dir) { WriteCachedMesh(dir / "mesh", mesh_); });
+    };
 }
 
 auto MeshingNode::serialize_(bool useCache, const fs::path& cacheDir)
@@ -127,7 +135,22 @@ LaplacianSmoothMeshNode::LaplacianSmoothMeshNode()
 {
     registerInputPort("input", input);
     registerOutputPort("output", output);
-    compute = [=]() { mesh_ = smoother_.compute(); };
+    compute = [=]() {
+        CachedCompute(
+            "LaplacianSmoothMeshNode",
+            [=](ResultHasher& h) {
+                h.update(smoother_.getInputMesh());
+                h.update(smoother_.iterations());
+                h.update(smoother_.relaxationFactor());
+                h.update(smoother_.featureEdgeSmoothing());
+                h.update(smoother_.featureAngle());
+                h.update(smoother_.edgeAngle());
+                h.update(smoother_.boundarySmoothing());
+            },
+            [=]() { mesh_ = smoother_.compute(); },
+            [=](const fs::path& dir) { mesh_ = ReadCachedMesh(dir / "mesh"); },
+            [=](const fs::path& dir) { WriteCachedMesh(dir / "mesh", mesh_); });
+    };
 }
 
 auto LaplacianSmoothMeshNode::serialize_(
@@ -180,7 +203,21 @@ ResampleMeshNode::ResampleMeshNode()
     registerInputPort("subsampleThreshold", subsampleThreshold);
     registerInputPort("quadricsOptimizationLevel", quadricsOptimizationLevel);
     registerOutputPort("output", output);
-    compute = [=]() { mesh_ = acvd_.compute(); };
+    compute = [=]() {
+        CachedCompute(
+            "ResampleMeshNode",
+            [=](ResultHasher& h) {
+                h.update(acvd_.getInputMesh());
+                h.update(acvd_.mode());
+                h.update(acvd_.numberOfClusters());
+                h.update(acvd_.gradation());
+                h.update(acvd_.subsampleThreshold());
+                h.update(acvd_.quadricsOptimizationLevel());
+            },
+            [=]() { mesh_ = acvd_.compute(); },
+            [=](const fs::path& dir) { mesh_ = ReadCachedMesh(dir / "mesh"); },
+            [=](const fs::path& dir) { WriteCachedMesh(dir / "mesh", mesh_); });
+    };
 }
 
 auto ResampleMeshNode::serialize_(bool useCache, const fs::path& cacheDir)
@@ -11,11 +11,51 @@
 #include "vc/core/types/PointSet.hpp"
 #include "vc/core/util/FloatComparison.hpp"
 #include "vc/core/util/Logging.hpp"
+#include "vc/graph/ResultCache.hpp"
+#include "vc/graph/TaskPool.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
 namespace fs = volcart::filesystem;
 
+namespace
+{
+/** Load the outputs of a flattening node from a ResultCache entry */
+void LoadFlattening(
+    const fs::path& dir, ITKMesh::Pointer& mesh, UVMap::Pointer& uvMap)
+{
+    mesh = ReadCachedMesh(dir / "uvMesh");
+    uvMap = UVMap::New(io::ReadUVMap(dir / "uvMap.uvm"));
+}
+
+/** Store the outputs of a flattening node in a ResultCache entry */
+void StoreFlattening(
+    const fs::path& dir, const ITKMesh::Pointer& mesh, const UVMap& uvMap)
+{
+    WriteCachedMesh(dir / "uvMesh", mesh);
+    io::WriteUVMap(dir / "uvMap.uvm", uvMap);
+}
+
+/** Hash the inputs shared by all TexturingAlgorithms */
+void HashTexturingInputs(ResultHasher& h, const TexturingAlgorithm& t)
+{
+    h.update(t.getPerPixelMap());
+    h.update(t.getVolume());
+}
+
+/** Load a texture from a ResultCache entry */
+void LoadTexture(const fs::path& dir, cv::Mat& texture)
+{
+    texture = ReadCachedMat(dir / "texture");
+}
+
+/** Store a texture in a ResultCache entry */
+void StoreTexture(const fs::path& dir, const cv::Mat& texture)
+{
+    WriteCachedMat(dir / "texture", texture);
+}
+}  // namespace
+
 // Enum conversions
 namespace volcart
 {
@@ -87,8 +127,19 @@ ABFNode::ABFNode()
     registerOutputPort("uvMap", uvMap);
 
     compute = [=]() {
-        mesh_ = abf_.compute();
-        uvMap_ = abf_.getUVMap();
+        CachedCompute(
+            "ABFNode",
+            [=](ResultHasher& h) {
+                h.update(abf_.getInputMesh());
+                h.update(abf_.useABF());
+                h.update(abf_.abfMaxIterations());
+            },
+            [=]() {
+                mesh_ = abf_.compute();
+                uvMap_ = abf_.getUVMap();
+            },
+            [=](const fs::path& dir) { LoadFlattening(dir, mesh_, uvMap_); },
+            [=](const fs::path& dir) { StoreFlattening(dir, mesh_, *uvMap_); });
     };
 }
 
@@ -135,8 +186,15 @@ OrthographicFlatteningNode::OrthographicFlatteningNode()
     registerOutputPort("uvMap", uvMap);
 
     compute = [=]() {
-        mesh_ = ortho_.compute();
-        uvMap_ = ortho_.getUVMap();
+        CachedCompute(
+            "OrthographicFlatteningNode",
+            [=](ResultHasher& h) { h.update(ortho_.getInputMesh()); },
+            [=]() {
+                mesh_ = ortho_.compute();
+                uvMap_ = ortho_.getUVMap();
+            },
+            [=](const fs::path& dir) { LoadFlattening(dir, mesh_, uvMap_); },
+            [=](const fs::path& dir) { StoreFlattening(dir, mesh_, *uvMap_); });
     };
 }
 
@@ -175,6 +233,7 @@ FlatteningErrorNode::FlatteningErrorNode()
     registerOutputPort("error", error);
 
     compute = [=]() {
+        ScopedNodeTimer timer("FlatteningErrorNode");
         if (mesh3D_ and mesh2D_) {
             error_ = LStretch(mesh3D_, mesh2D_);
             Logger()->info(
@@ -226,6 +285,7 @@ PlotLStretchErrorNode::PlotLStretchErrorNode()
     registerOutputPort("lInfPlot", lInfPlot);
 
     compute = [=]() {
+        ScopedNodeTimer timer("PlotLStretchErrorNode");
         auto p = PlotLStretchError(error_, cellMap_, colorMap_, drawLegend_);
         l2Plot_ = p[0];
         lInfPlot_ = p[1];
@@ -282,7 +342,29 @@ PPMGeneratorNode::PPMGeneratorNode()
     registerInputPort("uvMap", uvMap);
     registerInputPort("shading", shading);
     registerOutputPort("ppm", ppm);
-    compute = [=]() { ppm_ = ppmGen_.compute(); };
+    compute = [=]() {
+        CachedCompute(
+            "PPMGeneratorNode",
+            [=](ResultHasher& h) {
+                h.update(ppmGen_.getInputMesh());
+                h.update(ppmGen_.getInputTriangleMesh());
+                h.update(ppmGen_.getUVMap());
+                h.update(ppmGen_.width());
+                h.update(ppmGen_.height());
+                h.update(ppmGen_.shading());
+            },
+            [=]() { ppm_ = ppmGen_.compute(); },
+            [=](const fs::path& dir) {
+                ppm_ = PerPixelMap::New(PerPixelMap::ReadPPM(dir / "ppm"));
+                ppm_->setMask(ReadCachedMat(dir / "mask"));
+                ppm_->setCellMap(ReadCachedMat(dir / "cellMap"));
+            },
+            [=](const fs::path& dir) {
+                PerPixelMap::WritePPM(dir / "ppm", *ppm_);
+                WriteCachedMat(dir / "mask", ppm_->mask());
+                WriteCachedMat(dir / "cellMap", ppm_->cellMap());
+            });
+    };
 }
 
 auto PPMGeneratorNode::serialize_(bool useCache, const fs::path& cacheDir)
@@ -403,7 +485,18 @@ CompositeTextureNode::CompositeTextureNode()
     registerInputPort("generator", generator);
     registerInputPort("filter", filter);
     registerOutputPort("texture", texture);
-    compute = [=]() { texture_ = textureGen_.compute().at(0); };
+    compute = [=]() {
+        CachedCompute(
+            "CompositeTextureNode",
+            [=](ResultHasher& h) {
+                HashTexturingInputs(h, textureGen_);
+                h.update(textureGen_.getGenerator());
+                h.update(filter_);
+            },
+            [=]() { texture_ = textureGen_.compute().at(0); },
+            [=](const fs::path& dir) { LoadTexture(dir, texture_); },
+            [=](const fs::path& dir) { StoreTexture(dir, texture_); });
+    };
 }
 
 auto CompositeTextureNode::serialize_(bool useCache, const fs::path& cacheDir)
@@ -438,7 +531,14 @@ IntersectionTextureNode::IntersectionTextureNode()
     registerInputPort("ppm", ppm);
     registerInputPort("volume", volume);
     registerOutputPort("texture", texture);
-    compute = [=]() { texture_ = textureGen_.compute().at(0); };
+    compute = [=]() {
+        CachedCompute(
+            "IntersectionTextureNode",
+            [=](ResultHasher& h) { HashTexturingInputs(h, textureGen_); },
+            [=]() { texture_ = textureGen_.compute().at(0); },
+            [=](const fs::path& dir) { LoadTexture(dir, texture_); },
+            [=](const fs::path& dir) { StoreTexture(dir, texture_); });
+    };
 }
 
 auto IntersectionTextureNode::serialize_(
@@ -490,7 +590,25 @@ IntegralTextureNode::IntegralTextureNode()
         "exponentialDiffSuppressBelowBase", exponentialDiffSuppressBelowBase);
     registerOutputPort("texture", texture);
 
-    compute = [=]() { texture_ = textureGen_.compute().at(0); };
+    compute = [=]() {
+        CachedCompute(
+            "IntegralTextureNode",
+            [=](ResultHasher& h) {
+                HashTexturingInputs(h, textureGen_);
+                h.update(textureGen_.getGenerator());
+                h.update(textureGen_.clampValuesToMax());
+                h.update(textureGen_.clampMax());
+                h.update(textureGen_.weightMethod());
+                h.update(textureGen_.linearWeightDirection());
+                h.update(textureGen_.exponentialDiffExponent());
+                h.update(textureGen_.exponentialDiffBaseMethod());
+                h.update(textureGen_.exponentialDiffBaseValue());
+                h.update(textureGen_.exponentialDiffSuppressBelowBase());
+            },
+            [=]() { texture_ = textureGen_.compute().at(0); },
+            [=](const fs::path& dir) { LoadTexture(dir, texture_); },
+            [=](const fs::path& dir) { StoreTexture(dir, texture_); });
+    };
 }
 
 auto IntegralTextureNode::serialize_(bool useCache, const fs::path& cacheDir)
@@ -549,7 +667,19 @@ ThicknessTextureNode::ThicknessTextureNode()
     registerInputPort("normalizeOutput", normalizeOutput);
     registerOutputPort("texture", texture);
 
-    compute = [=]() { texture_ = textureGen_.compute().at(0); };
+    compute = [=]() {
+        CachedCompute(
+            "ThicknessTextureNode",
+            [=](ResultHasher& h) {
+                HashTexturingInputs(h, textureGen_);
+                h.update(textureGen_.volumetricMask());
+                h.update(textureGen_.samplingInterval());
+                h.update(textureGen_.normalizeOutput());
+            },
+            [=]() { texture_ = textureGen_.compute().at(0); },
+            [=](const fs::path& dir) { LoadTexture(dir, texture_); },
+            [=](const fs::path& dir) { StoreTexture(dir, texture_); });
+    };
 }
 
 auto ThicknessTextureNode::serialize_(
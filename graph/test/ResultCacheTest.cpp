@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/graph/ResultCache.hpp"
+
+using namespace volcart;
+namespace fs = volcart::filesystem;
+
+///// FIXTURES /////
+class ResultCacheFixture : public ::testing::Test
+{
+public:
+    ResultCacheFixture()
+        : root{fs::temp_directory_path() / "vc_ResultCacheTest"}
+    {
+        fs::remove_all(root);
+    }
+
+    ~ResultCacheFixture() override { fs::remove_all(root); }
+
+    /** Store a single file of n bytes under key */
+    static void Store(ResultCache& cache, const std::string& key, int n)
+    {
+        cache.store(key, [n](const fs::path& dir) {
+            std::ofstream f((dir / "data").string(), std::ios::binary);
+            f << std::string(n, 'x');
+        });
+    }
+
+    fs::path root;
+};
+
+///// TEST CASES /////
+TEST(ResultHasher, Deterministic)
+{
+    ResultHasher a("node");
+    a.update(1.5);
+    a.update(std::string("param"));
+    ResultHasher b("node");
+    b.update(1.5);
+    b.update(std::string("param"));
+    EXPECT_EQ(a.digest(), b.digest());
+    EXPECT_EQ(a.digest().size(), 32);
+
+    ResultHasher c("node");
+    c.update(1.5000001);
+    c.update(std::string("param"));
+    EXPECT_NE(a.digest(), c.digest());
+
+    ResultHasher d("other");
+    d.update(1.5);
+    d.update(std::string("param"));
+    EXPECT_NE(a.digest(), d.digest());
+}
+
+TEST(ResultHasher, Mesh)
+{
+    auto mesh = ITKMesh::New();
+    ITKPoint pt;
+    pt[0] = 1;
+    pt[1] = 2;
+    pt[2] = 3;
+    mesh->SetPoint(0, pt);
+
+    ResultHasher a;
+    a.update(mesh);
+    auto before = a.digest();
+
+    pt[2] = 4;
+    mesh->SetPoint(0, pt);
+    ResultHasher b;
+    b.update(mesh);
+    EXPECT_NE(before, b.digest());
+}
+
+TEST_F(ResultCacheFixture, StoreAndLoad)
+{
+    ResultCache cache(root);
+    EXPECT_FALSE(cache.contains("a"));
+    EXPECT_FALSE(cache.load("a", [](const fs::path&) {}));
+
+    Store(cache, "a", 100);
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_EQ(cache.numEntries(), 1);
+    EXPECT_EQ(cache.size(), 100);
+
+    std::size_t loaded{0};
+    EXPECT_TRUE(cache.load("a", [&loaded](const fs::path& dir) {
+        loaded = fs::file_size(dir / "data");
+    }));
+    EXPECT_EQ(loaded, 100);
+}
+
+TEST_F(ResultCacheFixture, Persistent)
+{
+    {
+        ResultCache cache(root);
+        Store(cache, "a", 100);
+    }
+    ResultCache cache(root);
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_EQ(cache.size(), 100);
+}
+
+TEST_F(ResultCacheFixture, EvictLRU)
+{
+    ResultCache cache(root, 250);
+    Store(cache, "a", 100);
+    Store(cache, "b", 100);
+    EXPECT_TRUE(cache.load("a", [](const fs::path&) {}));
+    Store(cache, "c", 100);
+
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_FALSE(cache.contains("b"));
+    EXPECT_TRUE(cache.contains("c"));
+    EXPECT_LE(cache.size(), 250);
+}
+
+TEST_F(ResultCacheFixture, FailedLoadRemovesEntry)
+{
+    ResultCache cache(root);
+    Store(cache, "a", 10);
+    EXPECT_FALSE(cache.load("a", [](const fs::path&) {
+        throw std::runtime_error("corrupt");
+    }));
+    EXPECT_FALSE(cache.contains("a"));
+}
+
+TEST_F(ResultCacheFixture, SharedBetweenInstances)
+{
+    // Each instance stands in for a separate process
+    ResultCache a(root);
+    ResultCache b(root);
+    Store(a, "a", 100);
+    Store(b, "b", 100);
+    EXPECT_TRUE(b.load("a", [](const fs::path&) {}));
+    Store(a, "c", 100);
+
+    ResultCache c(root);
+    EXPECT_TRUE(c.contains("a"));
+    EXPECT_TRUE(c.contains("b"));
+    EXPECT_TRUE(c.contains("c"));
+    EXPECT_EQ(c.size(), 300);
+}
+
+TEST_F(ResultCacheFixture, UnindexedEntriesAreEvicted)
+{
+    {
+        ResultCache cache(root);
+        Store(cache, "a", 100);
+    }
+
+    // An entry directory which never made it into the index
+    const std::string orphan{"0123456789abcdef0123456789abcdef"};
+    auto orphanDir = root / "entries" / orphan;
+    fs::create_directories(orphanDir);
+    {
+        std::ofstream f((orphanDir / "data").string());
+        f << std::string(100, 'x');
+    }
+
+    // Directories which are not named like a digest are never adopted
+    auto other = root / "entries" / "not-an-entry";
+    fs::create_directories(other);
+
+    ResultCache cache(root);
+    EXPECT_TRUE(cache.contains(orphan));
+    EXPECT_FALSE(cache.contains("not-an-entry"));
+    EXPECT_EQ(cache.size(), 200);
+
+    // Unindexed entries are evicted first
+    cache.setCapacity(150);
+    EXPECT_TRUE(cache.contains("a"));
+    EXPECT_FALSE(cache.contains(orphan));
+    EXPECT_FALSE(fs::exists(orphanDir));
+    EXPECT_TRUE(fs::exists(other));
+}
+
+TEST_F(ResultCacheFixture, RefusesNonCacheDirectory)
+{
+    // A directory with unrelated contents
+    fs::create_directories(root / "0123456789abcdef0123456789abcdef");
+    {
+        std::ofstream f((root / "notes.txt").string());
+        f << "user data";
+    }
+
+    EXPECT_THROW(ResultCache cache(root), std::invalid_argument);
+    EXPECT_TRUE(fs::exists(root / "notes.txt"));
+    EXPECT_TRUE(fs::exists(root / "0123456789abcdef0123456789abcdef"));
+}
+
+TEST_F(ResultCacheFixture, CachedMeshIsLossless)
+{
+    fs::create_directories(root);
+    auto mesh = ITKMesh::New();
+    ITKPoint pt;
+    pt[0] = 0.1;
+    pt[1] = 1.0 / 3.0;
+    pt[2] = 1e-17;
+    mesh->SetPoint(0, pt);
+    pt[0] = 2.0 / 7.0;
+    mesh->SetPoint(1, pt);
+    pt[1] = 12345.6789012345;
+    mesh->SetPoint(2, pt);
+    ITKCell::CellAutoPointer cell;
+    cell.TakeOwnership(new ITKTriangle);
+    cell->SetPointId(0, 0);
+    cell->SetPointId(1, 1);
+    cell->SetPointId(2, 2);
+    mesh->SetCell(0, cell);
+
+    WriteCachedMesh(root / "mesh", mesh);
+    auto result = ReadCachedMesh(root / "mesh");
+
+    ResultHasher a;
+    a.update(mesh);
+    ResultHasher b;
+    b.update(result);
+    EXPECT_EQ(a.digest(), b.digest());
+}
@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "vc/graph/TaskPool.hpp"
+
+using namespace volcart;
+
+TEST(TaskPool, RunsAllTasks)
+{
+    TaskPool pool(4);
+    std::atomic<int> count{0};
+    for (int i = 0; i < 100; i++) {
+        pool.submit([&count]() { count++; });
+    }
+    pool.wait();
+    EXPECT_EQ(count, 100);
+}
+
+TEST(TaskPool, Synchronous)
+{
+    TaskPool pool;
+    int count{0};
+    pool.submit([&count]() { count++; });
+    EXPECT_EQ(count, 1);
+    EXPECT_THROW(
+        pool.submit([]() { throw std::runtime_error("error"); }),
+        std::runtime_error);
+}
+
+TEST(TaskPool, WaitRethrows)
+{
+    TaskPool pool(2);
+    auto f = pool.submit([]() { throw std::runtime_error("error"); });
+    EXPECT_THROW(pool.wait(), std::runtime_error);
+    EXPECT_THROW(f.get(), std::runtime_error);
+
+    // Errors are only reported once
+    EXPECT_NO_THROW(pool.wait());
+}
+
+TEST(ScopedNodeTimer, RecordsTimings)
+{
+    ClearNodeTimings();
+    {
+        ScopedNodeTimer timer("TestNode");
+        timer.annotate("cached", true);
+    }
+    auto timings = GetNodeTimings();
+    ASSERT_EQ(timings.size(), 1);
+    EXPECT_EQ(timings[0]["node"].get<std::string>(), "TestNode");
+    EXPECT_TRUE(timings[0]["cached"].get<bool>());
+    EXPECT_GE(timings[0]["duration"].get<double>(), 0.0);
+}
@@ -38,6 +38,9 @@ public:
     /** @brief Set the input mesh */
     void setInputMesh(ITKMesh::Pointer input);
 
+    /** @brief Get the input mesh */
+    [[nodiscard]] auto getInputMesh() const -> ITKMesh::Pointer;
+
     /** @brief Isotropy mode */
     void setMode(Mode m);
 
@@ -7,6 +7,7 @@
 #include <opencv2/core.hpp>
 
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/meshing/DeepCopy.hpp"
 
 namespace volcart::meshing
@@ -19,7 +20,7 @@ namespace volcart::meshing
  * @brief Calculate vertex normals for ITK Meshes.
  *
  * Given an ITK mesh, generates a copy of that mesh with embedded vertex
- * normals.
+ * normals. Normals are computed in parallel using a VertexFaceAdjacency.
  *
  * @ingroup Meshing
  */
@@ -59,6 +60,29 @@ public:
      */
     ITKMesh::Pointer compute();
 
+    /**
+     * @brief Compute vertex normals for a TriangleMesh in place.
+     *
+     * Uses the same area-weighted face normal sum as compute(), but operates
+     * directly on the mesh's flat vertex and face arrays. Replaces any
+     * existing normals in the mesh.
+     */
+    static void Compute(TriangleMesh& mesh);
+
+    /**
+     * @copybrief Compute(TriangleMesh&)
+     *
+     * Uses a prebuilt vertex-face adjacency for the mesh, so that repeated
+     * calls on a mesh with unchanged faces do not rebuild it. Face normals
+     * are computed in parallel and then summed at each vertex in order of
+     * face ID, so the result does not depend on the number of threads.
+     *
+     * @throws std::invalid_argument if `adjacency` was not built for a mesh
+     * with the same number of vertices
+     */
+    static void Compute(
+        TriangleMesh& mesh, const VertexFaceAdjacency& adjacency);
+
 private:
     /**
      * @brief Compute normals for each vertex.
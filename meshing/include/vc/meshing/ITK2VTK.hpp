@@ -6,6 +6,7 @@
 #include <vtkSmartPointer.h>
 
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 
 namespace volcart::meshing
 {
@@ -38,4 +39,31 @@ void VTK2ITK(vtkSmartPointer<vtkPolyData> input, ITKMesh::Pointer output);
 
 /** @copydoc VTK2ITK */
 auto VTK2ITK(vtkSmartPointer<vtkPolyData> input) -> ITKMesh::Pointer;
+
+/**
+ * @brief Convert from a TriangleMesh to VTK PolyData.
+ *
+ * Vertices, vertex normals, and faces are converted with bulk array copies.
+ * If `shareVertices` is true, the output's point and normal arrays reference
+ * the input mesh's vertex and normal buffers rather than copying them. In this
+ * case, the input mesh must outlive the output and must not be resized while
+ * the output is in use. Faces are always copied, since VTK stores them as
+ * vtkIdType.
+ *
+ * @ingroup Meshing
+ */
+auto TriangleMesh2VTK(TriangleMesh& input, bool shareVertices = false)
+    -> vtkSmartPointer<vtkPolyData>;
+
+/**
+ * @brief Convert from VTK PolyData to a TriangleMesh.
+ *
+ * Copies vertices, vertex normals, and faces (cells) from input to output.
+ *
+ * @throws std::invalid_argument if the input contains a non-triangular face
+ *
+ * @ingroup Meshing
+ */
+auto VTK2TriangleMesh(vtkSmartPointer<vtkPolyData> input)
+    -> TriangleMesh::Pointer;
 }  // namespace volcart::meshing
@@ -16,6 +16,9 @@ public:
     /** @brief Set the input mesh */
     void setInputMesh(const ITKMesh::Pointer& m);
 
+    /** @brief Get the input mesh */
+    [[nodiscard]] auto getInputMesh() const -> ITKMesh::Pointer;
+
     /** @copydoc iterations() const */
     void setIterations(std::size_t i);
     /** @copydoc relaxationFactor() const */
@@ -0,0 +1,127 @@
+#pragma once
+
+/** @file */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/ITKMesh.hpp"
+
+namespace volcart::meshing
+{
+/**
+ * @class MeshSlicer
+ * @brief Intersects triangle meshes with planes of constant z
+ *
+ * Triangles are bucketed by the unit z-intervals which they span, so
+ * intersecting the mesh with a slice plane only visits the faces which can
+ * overlap that slice. Intersections are read-only and may be run from many
+ * threads at once.
+ *
+ * A vertex which lies exactly on the slice plane is treated as being above
+ * it. As a result, each edge crossing is reported by exactly one face on
+ * either side of the edge, and faces which lie in the slice plane produce no
+ * segments. An edge which lies in the slice plane is reported by the face
+ * below it or, if there is no such face (e.g. the bottom row of a mesh at
+ * zMin()), by the face above it.
+ *
+ * @ingroup Meshing
+ */
+class MeshSlicer
+{
+public:
+    /** Point type */
+    using Point = cv::Vec3d;
+    /** Triangle type. Vertex IDs index the point list. */
+    using Face = std::array<std::size_t, 3>;
+
+    /** Line segment where a face crosses the slice plane */
+    struct Segment {
+        /** Start point */
+        Point p0;
+        /** End point */
+        Point p1;
+        /** Vertex normal interpolated at the start point */
+        Point n0;
+        /** Vertex normal interpolated at the end point */
+        Point n1;
+    };
+
+    /** @brief Default constructor */
+    MeshSlicer() = default;
+
+    /**
+     * @brief Build the index from a list of points and triangles
+     *
+     * `normals` must either be empty or have one entry per point.
+     *
+     * @throws std::invalid_argument if a face references a missing vertex or
+     * the number of normals does not match the number of points
+     */
+    MeshSlicer(
+        std::vector<Point> points,
+        std::vector<Point> normals,
+        std::vector<Face> faces);
+
+    /**
+     * @brief Build the index from the triangles of one or more meshes
+     *
+     * Vertex normals are only kept if every vertex of every mesh has one.
+     * Non-triangular cells are ignored. Point IDs do not need to be
+     * contiguous.
+     *
+     * @throws std::invalid_argument if a face references a missing vertex
+     */
+    explicit MeshSlicer(const std::vector<ITKMesh::Pointer>& meshes);
+
+    /** @brief Get the number of indexed faces */
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /** @brief Whether the intersections have interpolated vertex normals */
+    [[nodiscard]] auto hasNormals() const -> bool;
+
+    /** @brief Get the minimum z value of the indexed faces */
+    [[nodiscard]] auto zMin() const -> double;
+
+    /** @brief Get the maximum z value of the indexed faces */
+    [[nodiscard]] auto zMax() const -> double;
+
+    /**
+     * @brief Intersect the mesh with the plane at `z`
+     *
+     * Segments are reported in the order of the faces which produced them.
+     * If the mesh has no normals, the segment normals are zero.
+     */
+    [[nodiscard]] auto intersect(double z) const -> std::vector<Segment>;
+
+private:
+    /** Build the bucket index */
+    void build_();
+
+    /** Points */
+    std::vector<Point> points_;
+    /** Vertex normals. Empty if the mesh has no normals. */
+    std::vector<Point> normals_;
+    /** Faces */
+    std::vector<Face> faces_;
+    /** z value of the first bucket's lower bound */
+    double origin_{0};
+    /** Minimum z value */
+    double zMin_{0};
+    /** Maximum z value */
+    double zMax_{0};
+    /** Start of each bucket's faces. Has one entry per bucket plus one. */
+    std::vector<std::size_t> offsets_;
+    /** Face IDs, in bucket order */
+    std::vector<std::size_t> ids_;
+    /**
+     * Per-face mask of the edges of constant z which the face reports. Bit e
+     * is the edge from vertex e to vertex (e + 1) % 3.
+     */
+    std::vector<std::uint8_t> lowerEdges_;
+};
+}  // namespace volcart::meshing
@@ -49,6 +49,9 @@ public:
     /** @brief Set the input OrderedPointSet */
     void setPointSet(const PointSet& points) { input_ = points; }
 
+    /** @brief Get the input point set */
+    const PointSet& getPointSet() const { return input_; }
+
     /**
      * @brief Set whether to compute a triangulation from point ordering
      *
@@ -3,6 +3,7 @@
 /** @file */
 
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 
 namespace volcart::meshing
 {
@@ -32,4 +33,12 @@ void ScaleMesh(
  * factor). Initializes a new ITKMesh.
  */
 ITKMesh::Pointer ScaleMesh(const ITKMesh::Pointer& input, double scaleFactor);
+
+/**
+ * @brief Scale a TriangleMesh in place by a linear scale factor.
+ *
+ * Uniform scaling of the mesh's vertex positions by a linear scale factor
+ * (not an area scale factor).
+ */
+void ScaleMesh(TriangleMesh& mesh, double scaleFactor);
 }  // namespace volcart::meshing
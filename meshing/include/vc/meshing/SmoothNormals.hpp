@@ -3,6 +3,7 @@
 /** @file */
 
 #include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 
 namespace volcart::meshing
 {
@@ -12,13 +13,26 @@ namespace volcart::meshing
  *
  * @brief Smooth vertex normals within a specified radius.
  *
- * Uses ITK's neighborhood locator to get the list of neighboring vertices
- * within the provided spherical radius. Returns a DeepCopy of the
- * original mesh, with smoothed vertex normals.
+ * Each vertex normal is averaged with the normals of the vertices within the
+ * provided spherical radius. Neighbors are found with a UniformGrid sized to
+ * the radius, and vertices are processed in parallel. Returns a DeepCopy of
+ * the original mesh, with smoothed vertex normals.
  *
  * @ingroup Meshing
  *
  * @param radius Size of the spherical neighborhood
  */
 ITKMesh::Pointer SmoothNormals(const ITKMesh::Pointer& input, double radius);
+
+/**
+ * @brief Smooth the vertex normals of a TriangleMesh within a specified
+ * radius.
+ *
+ * Produces the same result as the ITKMesh version. Returns a copy of the
+ * original mesh with smoothed vertex normals.
+ *
+ * @throws std::invalid_argument if the input mesh does not have normals
+ */
+auto SmoothNormals(const TriangleMesh& input, double radius)
+    -> TriangleMesh::Pointer;
 }  // namespace volcart::meshing
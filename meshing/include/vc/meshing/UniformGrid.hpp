@@ -0,0 +1,124 @@
+#pragma once
+
+/** @file */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+namespace volcart::meshing
+{
+/**
+ * @class UniformGrid
+ * @brief Spatial hash of 3D points for fixed-radius neighbor queries
+ *
+ * Buckets points into a uniform grid of cubic cells. Points are stored
+ * contiguously in cell order, so a radius query only scans the cells which
+ * overlap the query sphere. Queries are read-only and may be run from many
+ * threads at once.
+ *
+ * Queries are fastest when the cell size is close to the query radius. To
+ * bound memory use, the cell size is increased if the requested size would
+ * produce many more cells than points.
+ *
+ * Within a cell, points are visited in increasing order of their ID, and cells
+ * are always visited in the same order, so the neighbors of a point are
+ * reported in a deterministic order.
+ *
+ * @ingroup Meshing
+ */
+class UniformGrid
+{
+public:
+    /** Point type */
+    using Point = cv::Vec3d;
+
+    /** @brief Default constructor */
+    UniformGrid() = default;
+
+    /**
+     * @brief Build a grid over a list of points
+     *
+     * The ID of each point is its index in `points`.
+     *
+     * @throws std::invalid_argument if `cellSize` is not a positive, finite
+     * value
+     */
+    UniformGrid(const std::vector<Point>& points, double cellSize);
+
+    /** @brief Get the number of points in the grid */
+    [[nodiscard]] auto size() const -> std::size_t;
+
+    /** @brief Get the edge length of a grid cell */
+    [[nodiscard]] auto cellSize() const -> double;
+
+    /**
+     * @brief Call `fn(id)` for every point within `radius` of `p`
+     *
+     * Points exactly `radius` away from `p` are included. If `p` is itself in
+     * the grid, its own ID is reported.
+     */
+    template <typename Fn>
+    void forEachWithinRadius(const Point& p, double radius, Fn&& fn) const
+    {
+        if (ids_.empty() or not(radius >= 0)) {
+            return;
+        }
+
+        // Range of cells overlapping the query sphere's bounding box
+        std::array<std::size_t, 3> lo{};
+        std::array<std::size_t, 3> hi{};
+        for (int d = 0; d < 3; d++) {
+            auto l = std::floor((p[d] - radius - min_[d]) / cellSize_);
+            auto h = std::floor((p[d] + radius - min_[d]) / cellSize_);
+            auto maxCell = static_cast<double>(dims_[d] - 1);
+            if (h < 0 or l > maxCell) {
+                return;
+            }
+            lo[d] = static_cast<std::size_t>(std::max(l, 0.0));
+            hi[d] = static_cast<std::size_t>(std::min(h, maxCell));
+        }
+
+        auto r2 = radius * radius;
+        for (auto z = lo[2]; z <= hi[2]; z++) {
+            for (auto y = lo[1]; y <= hi[1]; y++) {
+                auto row = (z * dims_[1] + y) * dims_[0];
+                auto first = offsets_[row + lo[0]];
+                auto last = offsets_[row + hi[0] + 1];
+                for (auto i = first; i < last; i++) {
+                    auto diff = points_[i] - p;
+                    if (diff.dot(diff) <= r2) {
+                        fn(ids_[i]);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Get the IDs of all points within `radius` of `p`
+     *
+     * Clears `ids` before adding the neighbors of `p`.
+     */
+    void findWithinRadius(
+        const Point& p, double radius, std::vector<std::size_t>& ids) const;
+
+private:
+    /** Minimum corner of the grid */
+    Point min_;
+    /** Cell edge length */
+    double cellSize_{1};
+    /** Number of cells in each dimension */
+    std::array<std::size_t, 3> dims_{0, 0, 0};
+    /** Start of each cell's points. Has one entry per cell plus one. */
+    std::vector<std::size_t> offsets_;
+    /** Point positions, in cell order */
+    std::vector<Point> points_;
+    /** Point IDs, in cell order */
+    std::vector<std::size_t> ids_;
+};
+}  // namespace volcart::meshing
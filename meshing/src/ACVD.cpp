@@ -30,6 +30,8 @@ void ACVD::setSubsampleThreshold(size_t t) { subsampleThreshold_ = t; }
 
 void ACVD::setQuadricsOptimizationLevel(size_t l) { quadricsOptLevel_ = l; }
 
+ITKMesh::Pointer ACVD::getInputMesh() const { return inputMesh_; }
+
 ITKMesh::Pointer ACVD::getOutputMesh() const { return outputMesh_; }
 
 ITKMesh::Pointer ACVD::compute()
@@ -1,8 +1,56 @@
 #include "vc/meshing/CalculateNormals.hpp"
 
+#include <stdexcept>
+
+#include "vc/core/util/Parallel.hpp"
+
 using namespace volcart;
 using namespace volcart::meshing;
 
+/** Number of vertices or faces handed to a worker thread at a time */
+constexpr static std::size_t GRAIN_SIZE = 1024;
+
+// Sum the area-weighted normals of the faces incident to each vertex. Each
+// vertex sums its faces in order of face ID, so the result is identical to a
+// serial loop over the faces, regardless of the number of threads.
+static void SumFaceNormals(
+    const TriangleMesh& mesh,
+    const VertexFaceAdjacency& adj,
+    std::vector<cv::Vec3d>& normals)
+{
+    const auto& verts = mesh.vertices();
+    const auto& faces = mesh.faces();
+    if (adj.numVertices() != verts.size()) {
+        throw std::invalid_argument("Adjacency does not match mesh");
+    }
+
+    // Face normals
+    std::vector<cv::Vec3d> faceNormals(faces.size());
+    ParallelFor(
+        faces.size(),
+        [&](auto f) {
+            const auto& v0 = verts[faces[f][0]];
+            auto e0 = verts[faces[f][2]] - v0;
+            auto e1 = verts[faces[f][1]] - v0;
+            faceNormals[f] = e1.cross(e0);
+        },
+        0, GRAIN_SIZE);
+
+    // Gather the face normals at each vertex
+    normals.resize(verts.size());
+    ParallelFor(
+        verts.size(),
+        [&](auto v) {
+            auto vId = static_cast<TriangleMesh::Index>(v);
+            cv::Vec3d n(0, 0, 0);
+            for (auto f = adj.begin(vId); f != adj.end(vId); f++) {
+                n += faceNormals[*f];
+            }
+            normals[v] = n;
+        },
+        0, GRAIN_SIZE);
+}
+
 ///// Input/Output /////
 void CalculateNormals::setMesh(const ITKMesh::Pointer& mesh) { input_ = mesh; }
 
@@ -20,62 +68,35 @@ ITKMesh::Pointer CalculateNormals::compute()
 
 void CalculateNormals::compute_normals_()
 {
-    vertexNormals_ = std::vector<cv::Vec3d>(output_->GetNumberOfPoints(), 0);
-
-    for (auto cellIt = input_->GetCells()->Begin();
-         cellIt != input_->GetCells()->End(); ++cellIt) {
-
-        // Empty vectors for the vertex and edge info
-        cv::Vec3d v0, v1, v2, e0, e1;
-
-        // Collect the point id's for this cell
-        std::vector<uint64_t> pointIds;
-        ITKPoint vert;
-        for (auto p = cellIt->Value()->PointIdsBegin();
-             p != cellIt->Value()->PointIdsEnd(); ++p) {
-            pointIds.push_back(*p);
-        }
-
-        // To-Do: #185
-
-        // Collect the vertex info for each point
-        vert = input_->GetPoint(pointIds[0]);
-        v0(0) = vert[0];
-        v0(1) = vert[1];
-        v0(2) = vert[2];
-
-        vert = input_->GetPoint(pointIds[1]);
-        v1(0) = vert[0];
-        v1(1) = vert[1];
-        v1(2) = vert[2];
-
-        vert = input_->GetPoint(pointIds[2]);
-        v2(0) = vert[0];
-        v2(1) = vert[1];
-        v2(2) = vert[2];
-
-        // Get the edge vectors
-        e0 = v2 - v0;
-        e1 = v1 - v0;
-
-        // Take the cross-product
-        cv::Vec3d normals;
-        normals = e1.cross(e0);
-
-        // Add the norm for this face to the running sum for each vertex
-        vertexNormals_[pointIds[0]] += normals;
-        vertexNormals_[pointIds[1]] += normals;
-        vertexNormals_[pointIds[2]] += normals;
-    }
+    // Copy the vertices and faces into flat arrays. Vertices are in the order
+    // of the points container.
+    auto mesh = FromITKMesh(input_);
+    SumFaceNormals(*mesh, VertexFaceAdjacency(*mesh), vertexNormals_);
 }
 
 void CalculateNormals::assign_to_mesh_()
 {
+    std::size_t v{0};
     for (auto point = input_->GetPoints()->Begin();
-         point != input_->GetPoints()->End(); ++point) {
-        cv::Vec3d norm = vertexNormals_[point.Index()];
+         point != input_->GetPoints()->End(); ++point, ++v) {
+        cv::Vec3d norm = vertexNormals_[v];
         cv::normalize(norm, norm);
 
         output_->SetPointData(point.Index(), norm.val);
     }
 }
+
+void CalculateNormals::Compute(TriangleMesh& mesh)
+{
+    Compute(mesh, VertexFaceAdjacency(mesh));
+}
+
+void CalculateNormals::Compute(
+    TriangleMesh& mesh, const VertexFaceAdjacency& adjacency)
+{
+    auto& normals = mesh.normals();
+    SumFaceNormals(mesh, adjacency, normals);
+    ParallelFor(
+        normals.size(), [&](auto v) { cv::normalize(normals[v], normals[v]); },
+        0, GRAIN_SIZE);
+}
@@ -1,4 +1,9 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include <vtkCellArray.h>
 #include <vtkDoubleArray.h>
+#include <vtkIdTypeArray.h>
 #include <vtkPointData.h>
 
 #include "vc/meshing/ITK2VTK.hpp"
@@ -98,4 +103,105 @@ auto VTK2ITK(vtkSmartPointer<vtkPolyData> input) -> ITKMesh::Pointer
     return result;
 }
 
+///// TriangleMesh -> VTK Polydata /////
+// Wrap or copy an array of 3D vectors in a vtkDoubleArray
+static auto ToVTKArray(std::vector<cv::Vec3d>& v, bool share)
+    -> vtkSmartPointer<vtkDoubleArray>
+{
+    static_assert(
+        sizeof(cv::Vec3d) == 3 * sizeof(double), "cv::Vec3d is not packed");
+    auto array = vtkSmartPointer<vtkDoubleArray>::New();
+    array->SetNumberOfComponents(3);
+    auto size = static_cast<vtkIdType>(3 * v.size());
+    if (share) {
+        // save = 1: VTK does not take ownership of the buffer
+        array->SetArray(v.front().val, size, 1);
+    } else {
+        array->SetNumberOfTuples(static_cast<vtkIdType>(v.size()));
+        std::copy_n(v.front().val, size, array->GetPointer(0));
+    }
+    return array;
+}
+
+auto TriangleMesh2VTK(TriangleMesh& input, bool shareVertices)
+    -> vtkSmartPointer<vtkPolyData>
+{
+    auto output = vtkSmartPointer<vtkPolyData>::New();
+    if (input.empty()) {
+        return output;
+    }
+
+    // points + normals
+    auto points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(ToVTKArray(input.vertices(), shareVertices));
+    output->SetPoints(points);
+    if (input.hasNormals()) {
+        output->GetPointData()->SetNormals(
+            ToVTKArray(input.normals(), shareVertices));
+    }
+
+    // cells
+    const auto& faces = input.faces();
+    auto numFaces = static_cast<vtkIdType>(faces.size());
+    auto offsets = vtkSmartPointer<vtkIdTypeArray>::New();
+    offsets->SetNumberOfValues(numFaces + 1);
+    auto conn = vtkSmartPointer<vtkIdTypeArray>::New();
+    conn->SetNumberOfValues(3 * numFaces);
+    auto* o = offsets->GetPointer(0);
+    auto* c = conn->GetPointer(0);
+    for (vtkIdType f = 0; f < numFaces; f++) {
+        o[f] = 3 * f;
+        c[3 * f] = faces[f][0];
+        c[3 * f + 1] = faces[f][1];
+        c[3 * f + 2] = faces[f][2];
+    }
+    o[numFaces] = 3 * numFaces;
+    auto polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetData(offsets, conn);
+    output->SetPolys(polys);
+
+    return output;
+}
+
+///// VTK Polydata -> TriangleMesh /////
+auto VTK2TriangleMesh(vtkSmartPointer<vtkPolyData> input)
+    -> TriangleMesh::Pointer
+{
+    auto output = TriangleMesh::New();
+
+    // points + normals
+    auto numPts = input->GetNumberOfPoints();
+    auto& verts = output->vertices();
+    verts.resize(numPts);
+    for (vtkIdType i = 0; i < numPts; i++) {
+        input->GetPoint(i, verts[i].val);
+    }
+    auto pointNormals = input->GetPointData()->GetNormals();
+    if (pointNormals != nullptr) {
+        auto& normals = output->normals();
+        normals.resize(numPts);
+        for (vtkIdType i = 0; i < numPts; i++) {
+            pointNormals->GetTuple(i, normals[i].val);
+        }
+    }
+
+    // cells
+    auto polys = input->GetPolys();
+    auto& faces = output->faces();
+    faces.reserve(polys->GetNumberOfCells());
+    vtkIdType npts{0};
+    const vtkIdType* pts{nullptr};
+    for (polys->InitTraversal(); polys->GetNextCell(npts, pts) != 0;) {
+        if (npts != 3) {
+            throw std::invalid_argument("PolyData has a non-triangular face");
+        }
+        faces.push_back(
+            {static_cast<TriangleMesh::Index>(pts[0]),
+             static_cast<TriangleMesh::Index>(pts[1]),
+             static_cast<TriangleMesh::Index>(pts[2])});
+    }
+
+    return output;
+}
+
 }  // namespace volcart::meshing
@@ -52,3 +52,8 @@ auto LaplacianSmooth::compute() -> ITKMesh::Pointer
 }
 
 auto LaplacianSmooth::getOutputMesh() -> ITKMesh::Pointer { return output_; }
+
+auto LaplacianSmooth::getInputMesh() const -> ITKMesh::Pointer
+{
+    return input_;
+}
@@ -0,0 +1,250 @@
+#include "vc/meshing/MeshSlicer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+using namespace volcart;
+using namespace volcart::meshing;
+
+// Throw if a face references a vertex which is not in the point list
+static void CheckFaces(
+    const std::vector<MeshSlicer::Face>& faces, std::size_t numPoints)
+{
+    for (const auto& f : faces) {
+        for (auto v : f) {
+            if (v >= numPoints) {
+                throw std::invalid_argument("Face references missing vertex");
+            }
+        }
+    }
+}
+
+MeshSlicer::MeshSlicer(
+    std::vector<Point> points,
+    std::vector<Point> normals,
+    std::vector<Face> faces)
+    : points_{std::move(points)}
+    , normals_{std::move(normals)}
+    , faces_{std::move(faces)}
+{
+    if (not normals_.empty() and normals_.size() != points_.size()) {
+        throw std::invalid_argument("Number of normals != number of points");
+    }
+    CheckFaces(faces_, points_.size());
+    build_();
+}
+
+MeshSlicer::MeshSlicer(const std::vector<ITKMesh::Pointer>& meshes)
+{
+    auto haveNormals = true;
+    for (const auto& mesh : meshes) {
+        // Points are stored in container order. If the point IDs are not 0 to
+        // N-1 in that order, map them to their position in the point list.
+        auto base = points_.size();
+        auto contiguous = true;
+        std::unordered_map<ITKMesh::PointIdentifier, std::size_t> positions;
+        const auto& meshPoints = mesh->GetPoints();
+        for (auto pt = meshPoints->Begin(); pt != meshPoints->End(); ++pt) {
+            auto pos = points_.size();
+            contiguous = contiguous and pt.Index() == pos - base;
+            positions[pt.Index()] = pos;
+            const auto& p = pt.Value();
+            points_.emplace_back(p[0], p[1], p[2]);
+
+            ITKPixel n;
+            if (haveNormals and mesh->GetPointData(pt.Index(), &n)) {
+                normals_.emplace_back(n[0], n[1], n[2]);
+            } else {
+                haveNormals = false;
+            }
+        }
+
+        const auto& cells = mesh->GetCells();
+        for (auto c = cells->Begin(); c != cells->End(); ++c) {
+            auto* cell = c.Value();
+            if (cell->GetNumberOfPoints() != 3) {
+                continue;
+            }
+            const auto* ids = cell->GetPointIds();
+            Face f;
+            for (std::size_t v = 0; v < 3; v++) {
+                if (contiguous) {
+                    f[v] = base + ids[v];
+                    continue;
+                }
+                auto it = positions.find(ids[v]);
+                if (it == positions.end()) {
+                    throw std::invalid_argument(
+                        "Face references missing vertex");
+                }
+                f[v] = it->second;
+            }
+            faces_.push_back(f);
+        }
+    }
+    if (not haveNormals) {
+        normals_.clear();
+    }
+    CheckFaces(faces_, points_.size());
+    build_();
+}
+
+auto MeshSlicer::size() const -> std::size_t { return faces_.size(); }
+
+auto MeshSlicer::hasNormals() const -> bool { return not normals_.empty(); }
+
+auto MeshSlicer::zMin() const -> double { return zMin_; }
+
+auto MeshSlicer::zMax() const -> double { return zMax_; }
+
+void MeshSlicer::build_()
+{
+    offsets_.clear();
+    ids_.clear();
+    lowerEdges_.clear();
+    if (faces_.empty()) {
+        return;
+    }
+
+    // z-range of each face
+    std::vector<std::array<double, 2>> ranges(faces_.size());
+    zMin_ = std::numeric_limits<double>::max();
+    zMax_ = std::numeric_limits<double>::lowest();
+    for (std::size_t i = 0; i < faces_.size(); i++) {
+        const auto& f = faces_[i];
+        auto z0 = points_[f[0]][2];
+        auto z1 = points_[f[1]][2];
+        auto z2 = points_[f[2]][2];
+        auto lo = std::min({z0, z1, z2});
+        auto hi = std::max({z0, z1, z2});
+        ranges[i] = {lo, hi};
+        zMin_ = std::min(zMin_, lo);
+        zMax_ = std::max(zMax_, hi);
+    }
+    origin_ = std::floor(zMin_);
+
+    // Buckets spanned by a face
+    auto bucket = [this](double z) {
+        return static_cast<std::size_t>(std::floor(z) - origin_);
+    };
+
+    // Count the faces in each bucket, then prefix sum into offsets
+    offsets_.assign(bucket(zMax_) + 2, 0);
+    for (const auto& r : ranges) {
+        for (auto b = bucket(r[0]); b <= bucket(r[1]); b++) {
+            offsets_[b + 1]++;
+        }
+    }
+    for (std::size_t b = 1; b < offsets_.size(); b++) {
+        offsets_[b] += offsets_[b - 1];
+    }
+
+    // Fill the buckets in face order
+    ids_.resize(offsets_.back());
+    std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        for (auto b = bucket(ranges[i][0]); b <= bucket(ranges[i][1]); b++) {
+            ids_[next[b]++] = i;
+        }
+    }
+
+    // Find the edges of constant z which have an adjacent face below them.
+    // Those edges are reported by the face below.
+    using Edge = std::pair<std::size_t, std::size_t>;
+    auto edge = [](std::size_t a, std::size_t b) -> Edge {
+        return {std::min(a, b), std::max(a, b)};
+    };
+    std::map<Edge, bool> hasFaceBelow;
+    for (const auto& f : faces_) {
+        for (std::size_t e = 0; e < 3; e++) {
+            auto z0 = points_[f[e]][2];
+            auto z1 = points_[f[(e + 1) % 3]][2];
+            auto z2 = points_[f[(e + 2) % 3]][2];
+            if (z0 == z1) {
+                auto& below = hasFaceBelow[edge(f[e], f[(e + 1) % 3])];
+                below = below or z2 < z0;
+            }
+        }
+    }
+
+    // The remaining edges are reported by the face above them
+    lowerEdges_.assign(faces_.size(), 0);
+    for (std::size_t i = 0; i < faces_.size(); i++) {
+        const auto& f = faces_[i];
+        for (std::size_t e = 0; e < 3; e++) {
+            auto z0 = points_[f[e]][2];
+            auto z1 = points_[f[(e + 1) % 3]][2];
+            auto z2 = points_[f[(e + 2) % 3]][2];
+            if (z0 == z1 and z2 > z0 and
+                not hasFaceBelow[edge(f[e], f[(e + 1) % 3])]) {
+                lowerEdges_[i] |= static_cast<std::uint8_t>(1U << e);
+            }
+        }
+    }
+}
+
+auto MeshSlicer::intersect(double z) const -> std::vector<Segment>
+{
+    std::vector<Segment> segments;
+    if (faces_.empty() or not(z >= zMin_ and z <= zMax_)) {
+        return segments;
+    }
+
+    auto b = static_cast<std::size_t>(std::floor(z) - origin_);
+    for (auto i = offsets_[b]; i < offsets_[b + 1]; i++) {
+        auto faceID = ids_[i];
+        const auto& f = faces_[faceID];
+
+        // Find the edges which cross the plane
+        std::array<double, 3> d{
+            points_[f[0]][2] - z, points_[f[1]][2] - z, points_[f[2]][2] - z};
+        std::array<Point, 2> pts;
+        std::array<Point, 2> nrms;
+        std::size_t found{0};
+        for (std::size_t e = 0; e < 3; e++) {
+            auto v0 = e;
+            auto v1 = (e + 1) % 3;
+            if ((d[v0] >= 0) == (d[v1] >= 0)) {
+                continue;
+            }
+            auto t = d[v0] / (d[v0] - d[v1]);
+            const auto& a = points_[f[v0]];
+            const auto& c = points_[f[v1]];
+            pts[found] = a + t * (c - a);
+            if (not normals_.empty()) {
+                const auto& na = normals_[f[v0]];
+                const auto& nc = normals_[f[v1]];
+                nrms[found] = na + t * (nc - na);
+            }
+            found++;
+        }
+
+        // A plane crosses either none or two edges of a triangle
+        if (found == 2) {
+            segments.push_back({pts[0], pts[1], nrms[0], nrms[1]});
+            continue;
+        }
+
+        // Report an edge in the plane if there is no face below it
+        for (std::size_t e = 0; e < 3 and lowerEdges_[faceID] != 0; e++) {
+            auto v0 = e;
+            auto v1 = (e + 1) % 3;
+            if ((lowerEdges_[faceID] & (1U << e)) == 0 or d[v0] != 0 or
+                d[v1] != 0) {
+                continue;
+            }
+            Segment s{points_[f[v0]], points_[f[v1]], {}, {}};
+            if (not normals_.empty()) {
+                s.n0 = normals_[f[v0]];
+                s.n1 = normals_[f[v1]];
+            }
+            segments.push_back(s);
+        }
+    }
+    return segments;
+}
@@ -29,4 +29,11 @@ ITKMesh::Pointer ScaleMesh(const ITKMesh::Pointer& input, double scaleFactor)
     ScaleMesh(input, output, scaleFactor);
     return output;
 }
+
+void ScaleMesh(TriangleMesh& mesh, double scaleFactor)
+{
+    for (auto& v : mesh.vertices()) {
+        v *= scaleFactor;
+    }
+}
 }  // namespace volcart::meshing
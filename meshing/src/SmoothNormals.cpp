@@ -2,75 +2,104 @@
 // Abigail Coleman June 2015
 
 /** @file SmoothNormals.cpp*/
-#include <fstream>
-#include <iostream>
+#include <stdexcept>
 #include <vector>
 
 #include <opencv2/core.hpp>
 
+#include "vc/core/util/Parallel.hpp"
 #include "vc/meshing/DeepCopy.hpp"
 #include "vc/meshing/SmoothNormals.hpp"
+#include "vc/meshing/UniformGrid.hpp"
+
+/** Number of vertices handed to a worker thread at a time */
+constexpr static std::size_t GRAIN_SIZE = 256;
 
 namespace volcart::meshing
 {
 
-ITKMesh::Pointer SmoothNormals(const ITKMesh::Pointer& input, double radius)
+// Average each normal with the normals of the vertices within radius
+static auto SmoothNormalsImpl(
+    const std::vector<cv::Vec3d>& verts,
+    const std::vector<cv::Vec3d>& normals,
+    double radius) -> std::vector<cv::Vec3d>
 {
-    // declare pointer to new Mesh object to be returned
-    auto outputMesh = ITKMesh::New();
-    volcart::meshing::DeepCopy(input, outputMesh);
+    std::vector<cv::Vec3d> output(normals.size());
+    if (verts.empty()) {
+        return output;
+    }
 
-    // Variables for normal smoothing
-    cv::Vec3d neighborAvg;
-    double neighborCount;
+    // Size the grid to the radius so each query scans few cells
+    auto cellSize = (radius > 0) ? radius : 1.0;
+    UniformGrid grid(verts, cellSize);
 
-    // Use pointsLocator to find neighborhood within given radius
-    auto pointsLocator = ITKPointsLocator::New();
-    pointsLocator->SetPoints(input->GetPoints());
-    pointsLocator->Initialize();
-    typename ITKPointsLocator::NeighborsIdentifierType neighborhood;
+    // Each vertex is averaged independently, so the result does not depend on
+    // the number of threads
+    ParallelFor(
+        verts.size(),
+        [&](auto i) {
+            // Start with the current normal. The neighborhood also contains
+            // this vertex, matching ITKPointsLocator.
+            auto neighborAvg = normals[i];
+            double neighborCount{1};
 
-    // Iterate over all of the cells to lay out the faces in the output texture
+            // Sum the normals of the neighbors
+            grid.forEachWithinRadius(verts[i], radius, [&](auto nb) {
+                neighborAvg += normals[nb];
+                ++neighborCount;
+            });
+
+            // Average the sum normal
+            output[i] = neighborAvg / neighborCount;
+        },
+        0, GRAIN_SIZE);
+
+    return output;
+}
+
+ITKMesh::Pointer SmoothNormals(const ITKMesh::Pointer& input, double radius)
+{
+    // Copy the vertices and normals into flat arrays, in the order of the
+    // points container
+    auto numPts = input->GetNumberOfPoints();
+    std::vector<cv::Vec3d> verts;
+    std::vector<cv::Vec3d> normals;
+    verts.reserve(numPts);
+    normals.reserve(numPts);
     for (auto point = input->GetPoints()->Begin();
          point != input->GetPoints()->End(); ++point) {
+        const auto& p = point.Value();
+        verts.emplace_back(p[0], p[1], p[2]);
 
-        // Empty our averaging variables
-        if (!neighborhood.empty()) {
-            neighborhood.clear();
-        }
-        neighborCount = 0;
-        neighborAvg = cv::Vec3d(0, 0, 0);
-
-        // Get the current normal and add it to the summed normal
-        ITKPixel currentNormal;
-        input->GetPointData(point.Index(), &currentNormal);
-        neighborAvg[0] += currentNormal[0];
-        neighborAvg[1] += currentNormal[1];
-        neighborAvg[2] += currentNormal[2];
-        ++neighborCount;
-
-        // find neighborhood for current point within radius
-        pointsLocator->FindPointsWithinRadius(
-            point->Value(), radius, neighborhood);
-
-        // Sum the normals of the neighbors
-        for (auto nb : neighborhood) {
-            ITKPixel neighborNormal;
-            input->GetPointData(nb, &neighborNormal);
-
-            neighborAvg[0] += neighborNormal[0];
-            neighborAvg[1] += neighborNormal[1];
-            neighborAvg[2] += neighborNormal[2];
-            ++neighborCount;
-        }
-
-        // Average the sum normal
-        currentNormal[0] = neighborAvg[0] / neighborCount;
-        currentNormal[1] = neighborAvg[1] / neighborCount;
-        currentNormal[2] = neighborAvg[2] / neighborCount;
-        outputMesh->SetPointData(point.Index(), currentNormal);
+        ITKPixel n;
+        input->GetPointData(point.Index(), &n);
+        normals.emplace_back(n[0], n[1], n[2]);
+    }
+
+    auto smoothed = SmoothNormalsImpl(verts, normals, radius);
+
+    // declare pointer to new Mesh object to be returned
+    auto outputMesh = ITKMesh::New();
+    volcart::meshing::DeepCopy(input, outputMesh);
+    std::size_t i{0};
+    for (auto point = input->GetPoints()->Begin();
+         point != input->GetPoints()->End(); ++point, ++i) {
+        outputMesh->SetPointData(point.Index(), smoothed[i].val);
     }
 
     return outputMesh;
 }
+
+auto SmoothNormals(const TriangleMesh& input, double radius)
+    -> TriangleMesh::Pointer
+{
+    if (not input.hasNormals()) {
+        throw std::invalid_argument("Input mesh does not have normals");
+    }
+
+    auto output = TriangleMesh::New(input);
+    output->normals() =
+        SmoothNormalsImpl(input.vertices(), input.normals(), radius);
+    return output;
+}
 }  // namespace volcart::meshing
@@ -0,0 +1,88 @@
+#include "vc/meshing/UniformGrid.hpp"
+
+#include <stdexcept>
+
+using namespace volcart::meshing;
+
+/** Upper bound on the number of grid cells per point */
+constexpr static double MAX_CELLS_PER_POINT = 4;
+
+UniformGrid::UniformGrid(const std::vector<Point>& points, double cellSize)
+    : cellSize_{cellSize}
+{
+    if (not(cellSize > 0) or not std::isfinite(cellSize)) {
+        throw std::invalid_argument("Grid cell size must be positive");
+    }
+    if (points.empty()) {
+        return;
+    }
+
+    // Bounding box
+    min_ = points[0];
+    auto max = points[0];
+    for (const auto& p : points) {
+        for (int d = 0; d < 3; d++) {
+            min_[d] = std::min(min_[d], p[d]);
+            max[d] = std::max(max[d], p[d]);
+        }
+    }
+
+    // Grow the cells until the grid is a reasonable size
+    auto maxCells = MAX_CELLS_PER_POINT * static_cast<double>(points.size());
+    std::array<double, 3> dims{};
+    while (true) {
+        for (int d = 0; d < 3; d++) {
+            dims[d] = std::floor((max[d] - min_[d]) / cellSize_) + 1;
+        }
+        if (dims[0] * dims[1] * dims[2] <= std::max(maxCells, 1.0)) {
+            break;
+        }
+        cellSize_ *= 2;
+    }
+    for (int d = 0; d < 3; d++) {
+        dims_[d] = static_cast<std::size_t>(dims[d]);
+    }
+
+    // Cell of each point
+    auto cellOf = [this](const Point& p) {
+        std::array<std::size_t, 3> c{};
+        for (int d = 0; d < 3; d++) {
+            auto i = static_cast<std::size_t>((p[d] - min_[d]) / cellSize_);
+            c[d] = std::min(i, dims_[d] - 1);
+        }
+        return (c[2] * dims_[1] + c[1]) * dims_[0] + c[0];
+    };
+    std::vector<std::size_t> cells(points.size());
+    offsets_.assign(dims_[0] * dims_[1] * dims_[2] + 1, 0);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        cells[i] = cellOf(points[i]);
+        offsets_[cells[i] + 1]++;
+    }
+
+    // Prefix sum into offsets
+    for (std::size_t c = 1; c < offsets_.size(); c++) {
+        offsets_[c] += offsets_[c - 1];
+    }
+
+    // Counting sort the points into cell order. Stable, so IDs within a cell
+    // are in increasing order.
+    points_.resize(points.size());
+    ids_.resize(points.size());
+    std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        auto pos = next[cells[i]]++;
+        points_[pos] = points[i];
+        ids_[pos] = i;
+    }
+}
+
+auto UniformGrid::size() const -> std::size_t { return ids_.size(); }
+
+auto UniformGrid::cellSize() const -> double { return cellSize_; }
+
+void UniformGrid::findWithinRadius(
+    const Point& p, double radius, std::vector<std::size_t>& ids) const
+{
+    ids.clear();
+    forEachWithinRadius(p, radius, [&ids](auto id) { ids.push_back(id); });
+}
@@ -30,3 +30,24 @@ TEST_F(PlaneFixture, ComputePlaneNormalsTest)
         EXPECT_DOUBLE_EQ(outNormal[2], inNormal[2]);
     }
 }
+
+TEST_F(PlaneFixture, ComputeTriangleMeshNormalsTest)
+{
+    volcart::meshing::CalculateNormals calcNorm(inMesh);
+    outMesh = calcNorm.compute();
+
+    auto flat = volcart::FromITKMesh(inMesh);
+    flat->normals().clear();
+    volcart::meshing::CalculateNormals::Compute(*flat);
+    ASSERT_TRUE(flat->hasNormals());
+
+    for (std::size_t i = 0; i < flat->numVertices(); i++) {
+        volcart::ITKPixel expected;
+        outMesh->GetPointData(i, &expected);
+        const auto& actual = flat->normals()[i];
+
+        EXPECT_DOUBLE_EQ(actual[0], expected[0]);
+        EXPECT_DOUBLE_EQ(actual[1], expected[1]);
+        EXPECT_DOUBLE_EQ(actual[2], expected[2]);
+    }
+}
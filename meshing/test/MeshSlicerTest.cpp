@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/shapes/Plane.hpp"
+#include "vc/meshing/MeshSlicer.hpp"
+
+using namespace volcart;
+using namespace volcart::meshing;
+
+// Number of faces which cross the plane at z
+static auto CountCrossings(
+    const std::vector<cv::Vec3d>& pts,
+    const std::vector<MeshSlicer::Face>& faces,
+    double z) -> std::size_t
+{
+    std::size_t count{0};
+    for (const auto& f : faces) {
+        auto above = 0;
+        for (auto v : f) {
+            above += pts[v][2] >= z ? 1 : 0;
+        }
+        count += (above == 1 or above == 2) ? 1 : 0;
+    }
+    return count;
+}
+
+TEST(MeshSlicer, MatchesBruteForce)
+{
+    // Random small triangles spread over a tall volume
+    cv::RNG rng(12345);
+    std::vector<cv::Vec3d> pts;
+    std::vector<MeshSlicer::Face> faces;
+    for (std::size_t i = 0; i < 1000; i++) {
+        cv::Vec3d c{
+            rng.uniform(0., 100.), rng.uniform(0., 100.),
+            rng.uniform(0., 200.)};
+        for (auto v = 0; v < 3; v++) {
+            pts.push_back(
+                c + cv::Vec3d{
+                        rng.uniform(-3., 3.), rng.uniform(-3., 3.),
+                        rng.uniform(-3., 3.)});
+        }
+        faces.push_back({3 * i, 3 * i + 1, 3 * i + 2});
+    }
+    MeshSlicer slicer(pts, {}, faces);
+    EXPECT_EQ(slicer.size(), faces.size());
+    EXPECT_FALSE(slicer.hasNormals());
+
+    for (auto z = -5.0; z < 210.0; z += 0.75) {
+        auto segments = slicer.intersect(z);
+        EXPECT_EQ(segments.size(), CountCrossings(pts, faces, z));
+        for (const auto& s : segments) {
+            EXPECT_NEAR(s.p0[2], z, 1e-9);
+            EXPECT_NEAR(s.p1[2], z, 1e-9);
+        }
+    }
+}
+
+TEST(MeshSlicer, VerticalPlane)
+{
+    // Plane in XZ from x = [0, 4] and z = [0, 4]
+    shapes::Plane plane(5, 5);
+    MeshSlicer slicer(std::vector<ITKMesh::Pointer>{plane.itkMesh()});
+    EXPECT_DOUBLE_EQ(slicer.zMin(), 0);
+    EXPECT_DOUBLE_EQ(slicer.zMax(), 4);
+
+    // Every slice crosses the full width of the plane, including the slices
+    // which lie on the bottom and top rows of vertices
+    for (auto z : {slicer.zMin(), 0.5, 2.0, 2.5, slicer.zMax()}) {
+        double length{0};
+        for (const auto& s : slicer.intersect(z)) {
+            EXPECT_DOUBLE_EQ(s.p0[1], 0);
+            EXPECT_DOUBLE_EQ(s.p1[1], 0);
+            length += cv::norm(s.p1 - s.p0);
+        }
+        EXPECT_NEAR(length, 4, 1e-9);
+    }
+
+    // Outside of the mesh
+    EXPECT_TRUE(slicer.intersect(-0.5).empty());
+    EXPECT_TRUE(slicer.intersect(4.5).empty());
+}
+
+TEST(MeshSlicer, InterpolatesNormals)
+{
+    std::vector<cv::Vec3d> pts{{0, 0, 0}, {2, 0, 2}, {0, 2, 2}};
+    std::vector<cv::Vec3d> normals{{1, 0, 0}, {0, 1, 0}, {0, 1, 0}};
+    MeshSlicer slicer(pts, normals, {{0, 1, 2}});
+    ASSERT_TRUE(slicer.hasNormals());
+
+    auto segments = slicer.intersect(1);
+    ASSERT_EQ(segments.size(), 1U);
+    for (const auto& n : {segments[0].n0, segments[0].n1}) {
+        EXPECT_DOUBLE_EQ(n[0], 0.5);
+        EXPECT_DOUBLE_EQ(n[1], 0.5);
+        EXPECT_DOUBLE_EQ(n[2], 0);
+    }
+}
+
+TEST(MeshSlicer, InvalidInput)
+{
+    std::vector<cv::Vec3d> pts{{0, 0, 0}, {1, 0, 1}, {0, 1, 1}};
+    EXPECT_THROW(MeshSlicer(pts, {}, {{0, 1, 3}}), std::invalid_argument);
+    EXPECT_THROW(MeshSlicer(pts, {{0, 0, 1}}, {}), std::invalid_argument);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <opencv2/core.hpp>
+
+#include "vc/meshing/UniformGrid.hpp"
+
+using namespace volcart::meshing;
+
+// Brute-force radius search
+static auto FindWithinRadius(
+    const std::vector<cv::Vec3d>& pts, const cv::Vec3d& p, double radius)
+    -> std::vector<std::size_t>
+{
+    std::vector<std::size_t> ids;
+    for (std::size_t i = 0; i < pts.size(); i++) {
+        auto diff = pts[i] - p;
+        if (diff.dot(diff) <= radius * radius) {
+            ids.push_back(i);
+        }
+    }
+    return ids;
+}
+
+TEST(UniformGrid, MatchesBruteForce)
+{
+    cv::RNG rng(12345);
+    std::vector<cv::Vec3d> pts(2000);
+    for (auto& p : pts) {
+        p = {rng.uniform(-10., 10.), rng.uniform(-10., 10.),
+             rng.uniform(0., 2.)};
+    }
+
+    for (auto radius : {0.0, 0.5, 2.0, 50.0}) {
+        UniformGrid grid(pts, std::max(radius, 1.0));
+        EXPECT_EQ(grid.size(), pts.size());
+
+        std::vector<std::size_t> result;
+        for (std::size_t i = 0; i < pts.size(); i += 7) {
+            grid.findWithinRadius(pts[i], radius, result);
+            std::sort(result.begin(), result.end());
+            EXPECT_EQ(result, FindWithinRadius(pts, pts[i], radius));
+        }
+
+        // Query points outside of the grid
+        grid.findWithinRadius({25, 0, 0}, radius, result);
+        std::sort(result.begin(), result.end());
+        EXPECT_EQ(result, FindWithinRadius(pts, {25, 0, 0}, radius));
+    }
+}
+
+TEST(UniformGrid, LimitsNumberOfCells)
+{
+    std::vector<cv::Vec3d> pts{{0, 0, 0}, {1000, 1000, 1000}};
+    UniformGrid grid(pts, 0.001);
+    EXPECT_GT(grid.cellSize(), 0.001);
+
+    std::vector<std::size_t> result;
+    grid.findWithinRadius({1000, 1000, 1000}, 0.001, result);
+    EXPECT_EQ(result, std::vector<std::size_t>{1});
+}
+
+TEST(UniformGrid, EmptyAndInvalid)
+{
+    UniformGrid grid({}, 1.0);
+    std::vector<std::size_t> result{0};
+    grid.findWithinRadius({0, 0, 0}, 1.0, result);
+    EXPECT_TRUE(result.empty());
+
+    EXPECT_THROW(UniformGrid({{0, 0, 0}}, 0.0), std::invalid_argument);
+}
@@ -2,11 +2,20 @@
 
 /** @file */
 
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include <opencv2/core.hpp>
 #include <pybind11/numpy.h>
 
 /**
  * cv::Mat -> Numpy array caster
+ *
+ * The returned array is a view of the Mat's data and does not copy it.
+ * Bindings which return Mats that share memory with the state of a C++ object
+ * (e.g. cached slices) should mark the array read-only with
+ * ReadOnlyArray().
  * Inspired by: https://github.com/pybind/pybind11/issues/538
  */
 namespace pybind11
@@ -19,61 +28,72 @@ struct type_caster<cv::Mat> {
 public:
     PYBIND11_TYPE_CASTER(cv::Mat, _("array"));
 
-    static handle cast(cv::Mat src, return_value_policy, handle)
+    static handle cast(const cv::Mat& src, return_value_policy, handle)
     {
-        size_t size;
         std::string format;
-        auto dims = src.dims;
-
-        switch (src.type()) {
+        switch (src.depth()) {
             case CV_8U:
-                size = sizeof(uint8_t);
                 format = format_descriptor<uint8_t>::format();
                 break;
             case CV_8S:
-                size = sizeof(int8_t);
                 format = format_descriptor<int8_t>::format();
                 break;
             case CV_16U:
-                size = sizeof(uint16_t);
                 format = format_descriptor<uint16_t>::format();
                 break;
             case CV_16S:
-                size = sizeof(int16_t);
                 format = format_descriptor<int16_t>::format();
                 break;
+            case CV_32S:
+                format = format_descriptor<int32_t>::format();
+                break;
             case CV_32F:
-                size = sizeof(float);
                 format = format_descriptor<float>::format();
                 break;
+            case CV_64F:
+                format = format_descriptor<double>::format();
+                break;
             default:
                 throw std::runtime_error("unsupported image type");
         }
 
-        std::vector<size_t> extents;
-        std::vector<size_t> strides;
-
-        if (dims == 2) {
-            extents = {
-                static_cast<unsigned long>(src.rows),
-                static_cast<unsigned long>(src.cols)};
-            strides = {size * src.cols, size};
-        } else if (dims == 3) {
-            extents = {
-                static_cast<unsigned long>(src.rows),
-                static_cast<unsigned long>(src.cols),
-                static_cast<unsigned long>(src.channels())};
-            strides = {
-                size * src.cols * src.channels(), size * src.channels(), size};
-        } else {
-            throw std::runtime_error("unsupported number of dims");
+        // Use the Mat's own strides so that ROIs are not copied. Channels
+        // are the last dimension.
+        std::vector<ssize_t> extents;
+        std::vector<ssize_t> strides;
+        for (int i = 0; i < src.dims; i++) {
+            extents.push_back(src.size[i]);
+            strides.push_back(static_cast<ssize_t>(src.step[i]));
+        }
+        if (src.channels() > 1) {
+            extents.push_back(src.channels());
+            strides.push_back(static_cast<ssize_t>(src.elemSize1()));
         }
 
-        return array(buffer_info{
-                         src.data, static_cast<ssize_t>(size), format, dims,
-                         extents, strides})
+        // Share the Mat's reference-counted buffer instead of copying it. The
+        // capsule holds a Mat header, which keeps the buffer alive for as
+        // long as the array exists.
+        auto* owner = new cv::Mat(src);
+        capsule base(owner, [](void* m) { delete static_cast<cv::Mat*>(m); });
+        return array(dtype(format), extents, strides, owner->data, base)
             .release();
     }
 };
 }  // namespace detail
 }  // namespace pybind11
+
+namespace volcart::python
+{
+/**
+ * @brief Convert a cv::Mat to a read-only Numpy array view
+ *
+ * Use for Mats which share memory with C++ object state, so that Python code
+ * cannot modify that state through the array.
+ */
+inline auto ReadOnlyArray(const cv::Mat& m) -> pybind11::object
+{
+    auto array = pybind11::cast(m);
+    array.attr("setflags")(pybind11::arg("write") = false);
+    return array;
+}
+}  // namespace volcart::python
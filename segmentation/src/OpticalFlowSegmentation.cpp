@@ -16,6 +16,7 @@
 
 #include "vc/core/filesystem.hpp"
 #include "vc/core/math/StructureTensor.hpp"
+#include "vc/core/util/Trace.hpp"
 #include "vc/segmentation/OpticalFlowSegmentation.hpp"
 #include "vc/segmentation/lrps/Common.hpp"
 #include "vc/segmentation/lrps/Derivative.hpp"
@@ -170,6 +171,7 @@ std::vector<Voxel> OpticalFlowSegmentationClass::computeCurve(
     int zIndex,
     bool backwards) 
 {
+    volcart::trace::Span span("OpticalFlowSegmentation::computeCurve", "segmentation");
     bool visualize = false;
     // Extract 2D image slices at zIndex and zIndex+1
     // cv::Mat slice1 = vol_->getSliceDataCopy(zIndex);
@@ -620,6 +622,7 @@ std::vector<Voxel> OpticalFlowSegmentationClass::computeCurve(
 
 OpticalFlowSegmentationClass::PointSet OpticalFlowSegmentationClass::compute()
 {
+    volcart::trace::Span span("OpticalFlowSegmentation::compute", "segmentation");
     // Max cache size
     if (nr_cache_slices_ >= 0 && vol_->getCacheCapacity() != nr_cache_slices_) {
         std::cout << "[Info]: Setting Cache Size to " << nr_cache_slices_ << " Slices" << std::endl;
@@ -690,6 +693,7 @@ OpticalFlowSegmentationClass::PointSet OpticalFlowSegmentationClass::compute()
     // for loop with adjustments for backwards direction, to smoothen adjustments out and have a nice flat smooth sheet surface
     for (int zIndex = startIndex; !backwards ? zIndex > backwards_endIndex : zIndex < backwards_endIndex;
          zIndex += !backwards ? -stepSize_ : stepSize_) {
+        volcart::trace::Span stepSpan("OpticalFlowSegmentation::Step", "segmentation");
         // Update progress
         progressUpdated(iteration++);
         // Directory to dump vis
@@ -830,6 +834,7 @@ OpticalFlowSegmentationClass::PointSet OpticalFlowSegmentationClass::compute()
     // for loop with adjustments for direction
     for (int zIndex = startIndex; backwards ? zIndex > endIndex_ : zIndex < endIndex_;
          zIndex += backwards ? -stepSize_ : stepSize_) {
+        volcart::trace::Span stepSpan("OpticalFlowSegmentation::Step", "segmentation");
         // Update progress
         progressUpdated(iteration++);
 
@@ -0,0 +1,176 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <memory>
+
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/UVMap.hpp"
+#include "vc/texturing/AngleBasedFlattening.hpp"
+#include "vc/texturing/FlatteningAlgorithm.hpp"
+
+namespace volcart::texturing
+{
+/**
+ * @brief Parameterize a very large mesh by flattening overlapping charts
+ *
+ * Flattening a mesh with millions of faces as a single ABF++/LSCM system is
+ * slow and memory hungry. This algorithm instead:
+ *
+ * 1. Partitions the faces into connected charts of approximately
+ * chartSize() faces by region growing. Charts which are much smaller than
+ * the target size are merged into a neighboring chart.
+ * 2. Grows each chart by chartOverlap() rings of neighboring faces so that
+ * adjacent charts share a band of vertices.
+ * 3. Flattens the charts in parallel with AngleBasedFlattening.
+ * 4. Stitches the charts by placing each one with a rigid fit to its
+ * already-placed neighbors, then relaxing all placements against each other
+ * for alignmentIterations() iterations.
+ * 5. Averages the UV coordinates of vertices shared by more than one chart.
+ *
+ * If an initial UV map is provided with setInitialUVMap(), any chart whose
+ * vertices all have an initial UV coordinate skips ABF++/LSCM. Instead, it
+ * starts from the initial coordinates and runs warmStartIterations()
+ * iterations of an as-rigid-as-possible (ARAP) solver. This makes
+ * re-flattening a mesh after a small edit much cheaper than starting over.
+ * Charts which cannot be flattened by ABF++/LSCM (e.g. because they are not
+ * manifold) fall back to the same solver, starting from a planar projection
+ * and running a fixed number of iterations.
+ *
+ * Connected components of the mesh are laid out side by side along the U
+ * axis.
+ *
+ * @ingroup UV
+ */
+class ChartedFlattening : public FlatteningAlgorithm
+{
+public:
+    /** Default target number of faces per chart */
+    static constexpr std::size_t DEFAULT_CHART_SIZE{50000};
+    /** Default number of overlapping face rings between charts */
+    static constexpr std::size_t DEFAULT_CHART_OVERLAP{2};
+    /** Default number of chart alignment iterations */
+    static constexpr std::size_t DEFAULT_ALIGNMENT_ITERATIONS{10};
+    /** Default number of ARAP iterations for warm-started charts */
+    static constexpr std::size_t DEFAULT_WARM_START_ITERATIONS{5};
+
+    /** Pointer */
+    using Pointer = std::shared_ptr<ChartedFlattening>;
+
+    /**@{*/
+    /** @brief Default constructor */
+    ChartedFlattening() = default;
+
+    /** @brief Construct and set the input mesh */
+    explicit ChartedFlattening(const ITKMesh::Pointer& m);
+
+    /** Make a new shared instance */
+    template <typename... Args>
+    static auto New(Args... args) -> Pointer
+    {
+        return std::make_shared<ChartedFlattening>(
+            std::forward<Args>(args)...);
+    }
+
+    /** Default destructor */
+    ~ChartedFlattening() override = default;
+    /**@}*/
+
+    /**@{*/
+    /** @brief Set the target number of faces per chart */
+    void setChartSize(std::size_t n);
+
+    /** @copydoc setChartSize(std::size_t) */
+    [[nodiscard]] auto chartSize() const -> std::size_t;
+
+    /** @brief Set the number of face rings shared by neighboring charts */
+    void setChartOverlap(std::size_t n);
+
+    /** @copydoc setChartOverlap(std::size_t) */
+    [[nodiscard]] auto chartOverlap() const -> std::size_t;
+
+    /** @copydoc AngleBasedFlattening::setUseABF(bool) */
+    void setUseABF(bool a);
+
+    /** @copydoc AngleBasedFlattening::useABF() */
+    [[nodiscard]] auto useABF() const -> bool;
+
+    /** @copydoc AngleBasedFlattening::setABFMaxIterations(std::size_t) */
+    void setABFMaxIterations(std::size_t i);
+
+    /** @copydoc AngleBasedFlattening::abfMaxIterations() */
+    [[nodiscard]] auto abfMaxIterations() const -> std::size_t;
+
+    /** @brief Set the number of global chart alignment iterations */
+    void setAlignmentIterations(std::size_t i);
+
+    /** @copydoc setAlignmentIterations(std::size_t) */
+    [[nodiscard]] auto alignmentIterations() const -> std::size_t;
+
+    /**
+     * @brief Set an initial UV map to warm-start from
+     *
+     * The UV map should have been generated for the input mesh or for an
+     * earlier version of it with the same vertex IDs. Set to `nullptr` to
+     * disable warm starting.
+     */
+    void setInitialUVMap(const UVMap::Pointer& uvMap);
+
+    /** @copydoc setInitialUVMap(const UVMap::Pointer&) */
+    [[nodiscard]] auto initialUVMap() const -> UVMap::Pointer;
+
+    /** @brief Set the number of ARAP iterations for warm-started charts */
+    void setWarmStartIterations(std::size_t i);
+
+    /** @copydoc setWarmStartIterations(std::size_t) */
+    [[nodiscard]] auto warmStartIterations() const -> std::size_t;
+
+    /**
+     * @brief Set the number of threads used to flatten and align charts
+     *
+     * If 0 (default), uses DefaultThreadCount().
+     */
+    void setNumThreads(std::size_t n);
+
+    /** @copydoc setNumThreads(std::size_t) */
+    [[nodiscard]] auto numThreads() const -> std::size_t;
+    /**@}*/
+
+    /**@{*/
+    /** @brief Compute the parameterization */
+    auto compute() -> ITKMesh::Pointer override;
+
+    /** @brief Get the number of charts used by the last call to compute() */
+    [[nodiscard]] auto numCharts() const -> std::size_t;
+
+    /**
+     * @brief Get the number of charts which were warm-started by the last
+     * call to compute()
+     */
+    [[nodiscard]] auto numWarmStartedCharts() const -> std::size_t;
+    /**@}*/
+
+private:
+    /** Target number of faces per chart */
+    std::size_t chartSize_{DEFAULT_CHART_SIZE};
+    /** Number of overlapping face rings */
+    std::size_t chartOverlap_{DEFAULT_CHART_OVERLAP};
+    /** Whether to use ABF minimization */
+    bool useABF_{true};
+    /** Maximum number of ABF minimization iterations */
+    std::size_t maxABFIterations_{AngleBasedFlattening::DEFAULT_ITERATIONS};
+    /** Number of alignment iterations */
+    std::size_t alignIters_{DEFAULT_ALIGNMENT_ITERATIONS};
+    /** Initial UV map */
+    UVMap::Pointer initialUV_;
+    /** Number of ARAP iterations for warm-started charts */
+    std::size_t warmStartIters_{DEFAULT_WARM_START_ITERATIONS};
+    /** Number of worker threads */
+    std::size_t numThreads_{0};
+    /** Number of charts in the last result */
+    std::size_t numCharts_{0};
+    /** Number of warm-started charts in the last result */
+    std::size_t numWarmStarted_{0};
+};
+}  // namespace volcart::texturing
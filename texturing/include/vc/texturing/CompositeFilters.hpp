@@ -0,0 +1,59 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace volcart::texturing
+{
+/**
+ * @name Composite filters
+ * @brief Reduce a buffer of 16-bit intensity values to a single value
+ *
+ * These are the reductions used by CompositeTexture. They read the values in
+ * place and never copy or reorder them. Minimum, maximum, and mean are single
+ * passes over the contiguous buffer, which the compiler vectorizes. The median
+ * and trimmed mean select values by rank with a two-pass radix select over
+ * the high and low bytes of each value, so their cost is linear in the number
+ * of values rather than `O(n log n)`. Small buffers, where a sort is cheaper
+ * than filling the radix histograms, are handled with a sort on a stack copy.
+ *
+ * All functions return 0 if `n` is 0.
+ *
+ * @ingroup Texture
+ */
+/**@{*/
+/** @brief Minimum value */
+auto CompositeMinimum(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t;
+
+/** @brief Maximum value */
+auto CompositeMaximum(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t;
+
+/** @brief Mean value, rounded to the nearest integer */
+auto CompositeMean(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t;
+
+/**
+ * @brief Median value
+ *
+ * Returns the value at rank `n / 2` of the sorted values. For an even number
+ * of values, this is the upper of the two middle values.
+ */
+auto CompositeMedian(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t;
+
+/**
+ * @brief Mean of the median `range` of values
+ *
+ * `range` is in [0, 1] and is the fraction of the values to average. The
+ * averaged values are the `ceil(n * range)` values centered on the median of
+ * the sorted values. If `range` is 1, this is the mean. If `range` is 0, the
+ * result is 0.
+ */
+auto CompositeMedianAverage(
+    const std::uint16_t* values, std::size_t n, double range) -> std::uint16_t;
+/**@}*/
+}  // namespace volcart::texturing
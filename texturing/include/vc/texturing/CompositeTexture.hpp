@@ -2,6 +2,7 @@
 
 /** @file */
 
+#include "vc/texturing/NeighborhoodReducer.hpp"
 #include "vc/texturing/TexturingAlgorithm.hpp"
 
 namespace volcart::texturing
@@ -21,7 +22,8 @@ namespace volcart::texturing
  *
  * @ingroup Texture
  */
-class CompositeTexture : public TexturingAlgorithm
+class CompositeTexture : public TexturingAlgorithm,
+                         public NeighborhoodReducer
 {
 public:
     /** Pointer type */
@@ -55,6 +57,9 @@ public:
      */
     void setGenerator(NeighborhoodGenerator::Pointer g) { gen_ = std::move(g); }
 
+    /** @brief Get the Neighborhood generator */
+    NeighborhoodGenerator::Pointer getGenerator() const { return gen_; }
+
     /**
      * @brief Set the filtering method
      *
@@ -68,27 +73,32 @@ public:
     Texture compute() override;
     /**@}*/
 
+    /**@{*/
+    /** @copydoc NeighborhoodReducer::reduceStarted() */
+    void reduceStarted(
+        const PerPixelMap::Pointer& ppm,
+        const Volume::Pointer& vol,
+        const NeighborhoodGenerator::Pointer& gen) override;
+
+    /** @copydoc NeighborhoodReducer::reduce() */
+    void reduce(
+        const PerPixelMap::PixelMap& pixel, const Neighborhood& n) override;
+
+    /** @copydoc NeighborhoodReducer::reduceComplete() */
+    auto reduceComplete() -> Texture override;
+    /**@}*/
+
 private:
     /** Neighborhood shape */
     NeighborhoodGenerator::Pointer gen_;
-    /** Get neighborhood */
-    Neighborhood get_neighborhood_(const cv::Vec3d& p, const cv::Vec3d& n);
 
     /** Filter method */
     Filter filter_{Filter::Maximum};
 
-    /** Filter a neighborhood based on filter_ */
+    /**
+     * Filter a neighborhood based on filter_. The neighborhood is read in
+     * place.
+     */
     uint16_t filter_neighborhood_(const Neighborhood& n);
-    /** Return the minimum value */
-    uint16_t min_(Neighborhood n);
-    /** Return the maximum value */
-    uint16_t max_(Neighborhood n);
-    /** Return the median value */
-    uint16_t median_(Neighborhood n);
-    /** Return the average value */
-    uint16_t mean_(Neighborhood n);
-    /** Return the average of the median `range`. `range` is [0, 1] and is
-     * a percent of the neighborhood. */
-    uint16_t median_mean_(Neighborhood n, double range);
 };
 }  // namespace volcart::texturing
@@ -20,6 +20,9 @@ public:
     /**@{*/
     /** @brief Set the input Mesh */
     void setMesh(const ITKMesh::Pointer& m) { mesh_ = m; }
+
+    /** @brief Get the input Mesh */
+    ITKMesh::Pointer getInputMesh() const { return mesh_; }
     /**@}*/
 
     /**@{*/
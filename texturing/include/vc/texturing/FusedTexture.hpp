@@ -0,0 +1,102 @@
+#pragma once
+
+/** @file */
+
+#include <memory>
+#include <vector>
+
+#include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
+#include "vc/texturing/NeighborhoodReducer.hpp"
+#include "vc/texturing/TexturingAlgorithm.hpp"
+
+namespace volcart::texturing
+{
+/**
+ * @class FusedTexture
+ * @brief Generate several textures with a single pass over a PerPixelMap
+ *
+ * Running several texturing algorithms on the same PerPixelMap samples the
+ * same neighborhoods once per algorithm. This class visits the mapped pixels
+ * of the PerPixelMap once, samples each pixel's neighborhood once with a
+ * shared generator, and passes the neighborhood to every added
+ * NeighborhoodReducer. The cost of generating several textures is then close
+ * to the cost of generating one.
+ *
+ * The returned Texture contains the images of every reducer, in the order
+ * the reducers were added. Use reducerTextures() to get the images of each
+ * reducer separately.
+ *
+ * @code
+ * auto max = CompositeTexture::New();
+ * max->setFilter(CompositeTexture::Filter::Maximum);
+ * auto mean = CompositeTexture::New();
+ * mean->setFilter(CompositeTexture::Filter::Mean);
+ *
+ * FusedTexture fused;
+ * fused.setPerPixelMap(ppm);
+ * fused.setVolume(volume);
+ * fused.setGenerator(line);
+ * fused.addReducer(max);
+ * fused.addReducer(mean);
+ * fused.compute();
+ * auto textures = fused.reducerTextures();
+ * @endcode
+ *
+ * @ingroup Texture
+ */
+class FusedTexture : public TexturingAlgorithm
+{
+public:
+    /** Pointer type */
+    using Pointer = std::shared_ptr<FusedTexture>;
+
+    /** Make shared pointer */
+    static auto New() -> Pointer;
+
+    /** Default destructor */
+    ~FusedTexture() override = default;
+
+    /**@{*/
+    /** @brief Set the Neighborhood generator shared by all reducers */
+    void setGenerator(NeighborhoodGenerator::Pointer g);
+
+    /** @brief Get the Neighborhood generator */
+    [[nodiscard]] auto getGenerator() const -> NeighborhoodGenerator::Pointer;
+
+    /** @brief Add a reducer */
+    void addReducer(NeighborhoodReducer::Pointer r);
+
+    /** @brief Get the list of reducers */
+    [[nodiscard]] auto reducers() const
+        -> const std::vector<NeighborhoodReducer::Pointer>&;
+
+    /** @brief Remove all reducers */
+    void clearReducers();
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Compute the Texture
+     *
+     * @throws std::invalid_argument if the PPM, Volume, or generator are not
+     * set or no reducers have been added
+     */
+    auto compute() -> Texture override;
+
+    /**
+     * @brief Get the images of each reducer from the last call to compute()
+     *
+     * Indexed by the order in which the reducers were added.
+     */
+    [[nodiscard]] auto reducerTextures() const -> std::vector<Texture>;
+    /**@}*/
+
+private:
+    /** Neighborhood generator */
+    NeighborhoodGenerator::Pointer gen_;
+    /** Reducers */
+    std::vector<NeighborhoodReducer::Pointer> reducers_;
+    /** Outputs of each reducer */
+    std::vector<Texture> reducerResults_;
+};
+}  // namespace volcart::texturing
@@ -0,0 +1,206 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/types/ITKMesh.hpp"
+#include "vc/core/types/Mixins.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/texturing/PPMGenerator.hpp"
+#include "vc/texturing/TexturingAlgorithm.hpp"
+#include "vc/texturing/TiledRenderer.hpp"
+
+namespace volcart::texturing
+{
+/**
+ * @class IncrementalRenderer
+ * @brief Update a previously rendered Texture after a local change to its
+ * segmentation
+ *
+ * When a segmentation is fixed locally, most of its surface is unchanged.
+ * Rendering again from scratch re-textures every pixel, even though only a
+ * small part of the output is different. This class compares the new inputs
+ * with the inputs of the previous render, splits the output into square
+ * tiles, and runs a texturing function only on the tiles with a changed
+ * pixel. The new tile images are copied into the previous Texture, and every
+ * other pixel is kept from the previous render.
+ *
+ * The changed pixels are found in one of two ways:
+ * - __PerPixelMap diff:__ If the new PerPixelMap is provided with
+ * setPerPixelMap(), a pixel is changed if its mapping status differs between
+ * the two PerPixelMaps, or if any element of its mapping differs by more than
+ * the tolerance.
+ * - __Mesh diff:__ If the previous mesh is provided with setPreviousMesh() and
+ * the new mesh is provided in a PPMGenerator with setPPMGenerator(), a pixel
+ * is changed if the face assigned to it in the previous PerPixelMap's cell map
+ * has a vertex that moved by more than the tolerance. Only the changed tiles
+ * of the new PerPixelMap are computed, so the new PerPixelMap never has to
+ * exist in memory. This method requires the two meshes to have the same faces
+ * and the same UV map, which is the case when vertices are moved without
+ * re-flattening. If the meshes have different numbers of vertices or faces,
+ * or if the previous PerPixelMap has no cell map, every tile is changed.
+ *
+ * If the previous Texture is not set, or if its dimensions or the previous
+ * PerPixelMap's dimensions differ from the new dimensions, every tile is
+ * changed and the full Texture is rendered.
+ *
+ * The texturing function has the same requirements as for TiledRenderer.
+ * Additionally, the value of each output pixel must only depend on that
+ * pixel's mapping. Algorithms which normalize the whole image, such as
+ * IntegralTexture, do not produce the same result when rendered by tiles.
+ *
+ * @code
+ * IncrementalRenderer renderer;
+ * renderer.setPreviousPerPixelMap(oldPPM);
+ * renderer.setPreviousTexture(oldTexture);
+ * renderer.setPerPixelMap(newPPM);
+ * renderer.setTileFunction([&](const PerPixelMap::Pointer& ppm) {
+ *     CompositeTexture composite;
+ *     composite.setPerPixelMap(ppm);
+ *     composite.setVolume(volume);
+ *     composite.setGenerator(line);
+ *     return composite.compute();
+ * });
+ * auto texture = renderer.compute();
+ * @endcode
+ *
+ * @ingroup Texture
+ */
+class IncrementalRenderer : public IterationsProgress
+{
+public:
+    /** Texturing function type */
+    using TileFunction = TiledRenderer::TileFunction;
+
+    /** Default tile edge length */
+    static constexpr std::uint32_t DEFAULT_TILE_SIZE{128};
+
+    /**@{*/
+    /** @brief Set the PerPixelMap of the previous render */
+    void setPreviousPerPixelMap(PerPixelMap::Pointer ppm);
+
+    /**
+     * @brief Set the Texture of the previous render
+     *
+     * The images are updated in place.
+     */
+    void setPreviousTexture(TexturingAlgorithm::Texture texture);
+
+    /**
+     * @brief Set the mesh of the previous render
+     *
+     * Only used when the new mesh is provided with setPPMGenerator().
+     */
+    void setPreviousMesh(ITKMesh::Pointer mesh);
+
+    /** @brief Find changed pixels by comparing with a new PerPixelMap */
+    void setPerPixelMap(PerPixelMap::Pointer ppm);
+
+    /**
+     * @brief Find changed pixels by comparing with the mesh of a PPMGenerator
+     *
+     * The changed tiles of the new PerPixelMap are computed with the
+     * generator.
+     */
+    void setPPMGenerator(std::shared_ptr<PPMGenerator> gen);
+
+    /** @brief Set the texturing function */
+    void setTileFunction(TileFunction fn);
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Set the tile edge length
+     *
+     * Smaller tiles re-texture fewer unchanged pixels. Default: 128
+     */
+    void setTileSize(std::uint32_t size);
+
+    /**
+     * @brief Set the tolerance used to compare positions and normals
+     *
+     * Default: 0
+     */
+    void setTolerance(double t);
+
+    /**
+     * @brief Set the number of worker threads
+     *
+     * If 0, DefaultThreadCount() threads are used. Default: 0
+     */
+    void setNumThreads(std::size_t n);
+
+    /** @brief Get the output width */
+    [[nodiscard]] auto width() const -> std::size_t;
+
+    /** @brief Get the output height */
+    [[nodiscard]] auto height() const -> std::size_t;
+    /**@}*/
+
+    /**
+     * @brief Get the regions of the output tiles which must be re-textured
+     *
+     * @throws std::invalid_argument if the inputs are not set
+     */
+    [[nodiscard]] auto dirtyTiles() const -> std::vector<cv::Rect>;
+
+    /**
+     * @brief Re-texture the changed tiles and return the updated Texture
+     *
+     * @throws std::invalid_argument if the inputs are not set or the tile
+     * size is invalid
+     * @throws std::runtime_error if the tile outputs do not match each other
+     * or the previous Texture
+     */
+    auto compute() -> TexturingAlgorithm::Texture;
+
+    /** @brief Returns the maximum progress value */
+    [[nodiscard]] auto progressIterations() const -> std::size_t override;
+
+private:
+    /** Whether the previous Texture can be updated in place */
+    [[nodiscard]] auto can_reuse_() const -> bool;
+
+    /**
+     * Get a flag for each face of the new mesh with a moved vertex. Empty if
+     * the meshes cannot be compared.
+     */
+    [[nodiscard]] auto moved_faces_() const -> std::vector<bool>;
+
+    /** Whether any pixel in a tile changed */
+    [[nodiscard]] auto tile_changed_(
+        const cv::Rect& region, const std::vector<bool>& movedFaces) const
+        -> bool;
+
+    /** Get the new PerPixelMap for a tile */
+    auto tile_ppm_(const cv::Rect& region) const -> PerPixelMap::Pointer;
+
+    /** Previous PPM */
+    PerPixelMap::Pointer prevPPM_;
+    /** Previous Texture */
+    TexturingAlgorithm::Texture prevTexture_;
+    /** Previous mesh */
+    ITKMesh::Pointer prevMesh_;
+    /** New PPM */
+    PerPixelMap::Pointer ppm_;
+    /** New PPM generator */
+    std::shared_ptr<PPMGenerator> ppmGen_;
+    /** Texturing function */
+    TileFunction tileFn_;
+    /** Tile edge length */
+    std::uint32_t tileSize_{DEFAULT_TILE_SIZE};
+    /** Comparison tolerance */
+    double tolerance_{0};
+    /** Number of worker threads */
+    std::size_t numThreads_{0};
+    /** Number of tiles being re-textured */
+    std::size_t numDirty_{0};
+};
+
+}  // namespace volcart::texturing
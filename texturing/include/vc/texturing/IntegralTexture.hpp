@@ -2,6 +2,7 @@
 
 /** @file */
 
+#include "vc/texturing/NeighborhoodReducer.hpp"
 #include "vc/texturing/TexturingAlgorithm.hpp"
 
 #include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
@@ -14,7 +15,8 @@ namespace volcart::texturing
  *
  * @ingroup Texture
  */
-class IntegralTexture : public TexturingAlgorithm
+class IntegralTexture : public TexturingAlgorithm,
+                        public NeighborhoodReducer
 {
 public:
     /**
@@ -72,6 +74,9 @@ public:
      */
     void setGenerator(NeighborhoodGenerator::Pointer g);
 
+    /** @brief Get the Neighborhood generator */
+    [[nodiscard]] auto getGenerator() const -> NeighborhoodGenerator::Pointer;
+
     /**
      * @brief When enabled, clamp neighborhood intensities to the value
      * specified by setClampMax()
@@ -161,6 +166,21 @@ public:
     auto compute() -> Texture override;
     /**@}*/
 
+    /**@{*/
+    /** @copydoc NeighborhoodReducer::reduceStarted() */
+    void reduceStarted(
+        const PerPixelMap::Pointer& ppm,
+        const Volume::Pointer& vol,
+        const NeighborhoodGenerator::Pointer& gen) override;
+
+    /** @copydoc NeighborhoodReducer::reduce() */
+    void reduce(
+        const PerPixelMap::PixelMap& pixel, const Neighborhood& n) override;
+
+    /** @copydoc NeighborhoodReducer::reduceComplete() */
+    auto reduceComplete() -> Texture override;
+    /**@}*/
+
 private:
     /** Neighborhood generator */
     NeighborhoodGenerator::Pointer gen_;
@@ -175,7 +195,7 @@ private:
     WeightMethod weight_{WeightMethod::None};
 
     /** Setup the selected weighting method */
-    void setup_weights_();
+    void setup_weights_(const NeighborhoodGenerator& gen);
 
     /** Apply the selected weighting method */
     auto apply_weights_(NDArray<double>& n) -> NDArray<double>;
@@ -187,7 +207,7 @@ private:
     NDArray<double> linearWeights_{1};
 
     /** Setup the linear weights vector */
-    void setup_linear_weights_();
+    void setup_linear_weights_(const NeighborhoodGenerator& gen);
 
     /** Apply the linear weights vector to a neighborhood */
     auto apply_linear_weights_(NDArray<double>& n) -> NDArray<double>;
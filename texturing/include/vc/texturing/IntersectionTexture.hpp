@@ -2,6 +2,7 @@
 
 /** @file */
 
+#include "vc/texturing/NeighborhoodReducer.hpp"
 #include "vc/texturing/TexturingAlgorithm.hpp"
 
 namespace volcart::texturing
@@ -14,9 +15,13 @@ namespace volcart::texturing
  *
  * @brief Generate a Texture by intersection with a Volume
  *
+ * When used as a NeighborhoodReducer, the sampled neighborhood is ignored and
+ * the Volume is sampled at each pixel's mapped position.
+ *
  * @ingroup Texture
  */
-class IntersectionTexture : public TexturingAlgorithm
+class IntersectionTexture : public TexturingAlgorithm,
+                            public NeighborhoodReducer
 {
 public:
     /** Pointer type */
@@ -32,5 +37,20 @@ public:
     /** @brief Compute the Texture */
     Texture compute() override;
     /**@}*/
+
+    /**@{*/
+    /** @copydoc NeighborhoodReducer::reduceStarted() */
+    void reduceStarted(
+        const PerPixelMap::Pointer& ppm,
+        const Volume::Pointer& vol,
+        const NeighborhoodGenerator::Pointer& gen) override;
+
+    /** @copydoc NeighborhoodReducer::reduce() */
+    void reduce(
+        const PerPixelMap::PixelMap& pixel, const Neighborhood& n) override;
+
+    /** @copydoc NeighborhoodReducer::reduceComplete() */
+    auto reduceComplete() -> Texture override;
+    /**@}*/
 };
 }  // namespace volcart::texturing
@@ -2,6 +2,7 @@
 
 /** @file */
 
+#include "vc/texturing/NeighborhoodReducer.hpp"
 #include "vc/texturing/TexturingAlgorithm.hpp"
 
 #include "vc/core/neighborhood/LineGenerator.hpp"
@@ -21,9 +22,13 @@ namespace volcart::texturing
  * this amounts to resampling the Volume into a flattened subvolume with the
  * segmentation mesh forming a straight line at its center.
  *
+ * When used as a NeighborhoodReducer, the neighborhood generator must be
+ * one-dimensional (e.g. LineGenerator). One image is produced per
+ * neighborhood sample.
+ *
  * @ingroup Texture
  */
-class LayerTexture : public TexturingAlgorithm
+class LayerTexture : public TexturingAlgorithm, public NeighborhoodReducer
 {
 public:
     /** Pointer type */
@@ -46,6 +51,21 @@ public:
     /** @brief Compute the Texture */
     Texture compute() override;
     /**@}*/
+
+    /**@{*/
+    /** @copydoc NeighborhoodReducer::reduceStarted() */
+    void reduceStarted(
+        const PerPixelMap::Pointer& ppm,
+        const Volume::Pointer& vol,
+        const NeighborhoodGenerator::Pointer& gen) override;
+
+    /** @copydoc NeighborhoodReducer::reduce() */
+    void reduce(
+        const PerPixelMap::PixelMap& pixel, const Neighborhood& n) override;
+
+    /** @copydoc NeighborhoodReducer::reduceComplete() */
+    auto reduceComplete() -> Texture override;
+    /**@}*/
 private:
     /** Neighborhood Generator */
     LineGenerator::Pointer gen_;
@@ -0,0 +1,69 @@
+#pragma once
+
+/** @file */
+
+#include <memory>
+
+#include "vc/core/neighborhood/NeighborhoodGenerator.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/Volume.hpp"
+#include "vc/texturing/TexturingAlgorithm.hpp"
+
+namespace volcart::texturing
+{
+/**
+ * @class NeighborhoodReducer
+ * @brief Interface for texturing algorithms which reduce one sampled
+ * neighborhood to the output pixels of a single PPM pixel
+ *
+ * Most texturing algorithms sample a neighborhood around each mapped PPM
+ * pixel and reduce it to one or more output values. This interface separates
+ * the reduction from the sampling so that FusedTexture can sample each
+ * neighborhood once and pass it to many algorithms.
+ *
+ * A reduction starts with reduceStarted(), which allocates the outputs. Then,
+ * reduce() is called at most once for every mapped pixel of the PPM. Finally,
+ * reduceComplete() finishes the outputs and returns them. Algorithms which
+ * implement this interface use reduceStarted() to set their input PPM and
+ * Volume, so their compute() and reduce passes share the same inputs.
+ *
+ * CompositeTexture, IntegralTexture, and LayerTexture implement this
+ * interface, so any combination of them can share sampled neighborhoods in a
+ * FusedTexture.
+ *
+ * @ingroup Texture
+ */
+class NeighborhoodReducer
+{
+public:
+    /** Pointer type */
+    using Pointer = std::shared_ptr<NeighborhoodReducer>;
+
+    /** Default destructor for virtual base class */
+    virtual ~NeighborhoodReducer() = default;
+
+    /**
+     * @brief Start a reduction over the mapped pixels of `ppm`
+     *
+     * `gen` is the generator which samples the neighborhoods passed to
+     * reduce().
+     *
+     * @throws std::invalid_argument if the algorithm does not support `gen`
+     */
+    virtual void reduceStarted(
+        const PerPixelMap::Pointer& ppm,
+        const Volume::Pointer& vol,
+        const NeighborhoodGenerator::Pointer& gen) = 0;
+
+    /** @brief Reduce the neighborhood sampled at a single PPM pixel */
+    virtual void reduce(
+        const PerPixelMap::PixelMap& pixel, const Neighborhood& n) = 0;
+
+    /** @brief Finish the reduction and return the output images */
+    virtual auto reduceComplete() -> TexturingAlgorithm::Texture = 0;
+
+protected:
+    /** Default constructor */
+    NeighborhoodReducer() = default;
+};
+}  // namespace volcart::texturing
@@ -2,9 +2,15 @@
 
 /** @file */
 
+#include <memory>
+#include <mutex>
+
+#include <opencv2/core.hpp>
+
 #include "vc/core/types/ITKMesh.hpp"
 #include "vc/core/types/Mixins.hpp"
 #include "vc/core/types/PerPixelMap.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/types/UVMap.hpp"
 
 namespace volcart::texturing
@@ -17,6 +23,14 @@ namespace volcart::texturing
  * correspond to the 3D position and normal vector associated with that pixel:
  * `{x, y, z, nx, ny, nz}`
  *
+ * The input mesh may be either an ITKMesh or a TriangleMesh. ITKMesh inputs
+ * are converted to a TriangleMesh before rasterization. If a TriangleMesh has
+ * UV coordinates, the UV map is optional.
+ *
+ * Large PPMs can be generated one region at a time with
+ * compute(const cv::Rect&), which only allocates memory for the requested
+ * region.
+ *
  * This class uses raytracing functionality provided by the
  * [bvh library](https://github.com/madmann91/bvh).
  *
@@ -49,8 +63,28 @@ public:
     /** @brief Set the input mesh */
     void setMesh(const ITKMesh::Pointer& m);
 
+    /** @copydoc setMesh(const ITKMesh::Pointer&) */
+    void setMesh(const TriangleMesh::Pointer& m);
+
     /** @brief Set the input UV map */
     void setUVMap(const UVMap::Pointer& u);
+
+    /**
+     * @brief Get the input mesh
+     *
+     * Returns `nullptr` if the mesh was set as a TriangleMesh.
+     */
+    [[nodiscard]] auto getInputMesh() const -> ITKMesh::Pointer;
+
+    /**
+     * @brief Get the input TriangleMesh
+     *
+     * Returns `nullptr` if the mesh was set as an ITKMesh.
+     */
+    [[nodiscard]] auto getInputTriangleMesh() const -> TriangleMesh::Pointer;
+
+    /** @brief Get the input UV map */
+    [[nodiscard]] auto getUVMap() const -> UVMap::Pointer;
     /**@}*/
 
     /**@{*/
@@ -59,11 +93,56 @@ public:
 
     /** @brief Set the normal shading method */
     void setShading(Shading s);
+
+    /** @brief Get the output PPM width */
+    [[nodiscard]] auto width() const -> size_t;
+
+    /** @brief Get the output PPM height */
+    [[nodiscard]] auto height() const -> size_t;
+
+    /** @brief Get the normal shading method */
+    [[nodiscard]] auto shading() const -> Shading;
     /**@}*/
 
     /**@{*/
-    /** @brief Compute the PerPixelMap */
+    /**
+     * @brief Compute the PerPixelMap
+     *
+     * Releases the cached search structure when finished. See clearCache().
+     */
     auto compute() -> PerPixelMap::Pointer;
+
+    /**
+     * @brief Compute a region of the PerPixelMap
+     *
+     * Returns a PerPixelMap with the dimensions of `region`. Pixel (y, x) of
+     * the result, including its mask and cell map values, is equal to pixel
+     * (`region.y` + y, `region.x` + x) of the PerPixelMap returned by
+     * compute(). Does not change the result of getPPM() and does not report
+     * progress.
+     *
+     * The search structure used to rasterize the mesh is built on first use
+     * and is cached for later region requests. See clearCache() for the
+     * rules on when it is rebuilt. This function may be called from multiple
+     * threads at once, as long as the generator's parameters are not changed
+     * at the same time.
+     *
+     * @throws std::invalid_argument if the input parameters are invalid or
+     * `region` is not inside of the output dimensions
+     */
+    auto compute(const cv::Rect& region) -> PerPixelMap::Pointer;
+
+    /**
+     * @brief Release the cached rasterization search structure
+     *
+     * The cache holds a copy of the input mesh and a search tree over its UV
+     * faces. It is released automatically by compute() and by setMesh(),
+     * setUVMap(), and setShading(). The cache does not track changes made
+     * in-place to the mesh or UV map that are already set. Call this function
+     * after modifying either so that the next call to compute(const
+     * cv::Rect&) sees the changes.
+     */
+    void clearCache();
     /**@}*/
 
     /**@{*/
@@ -75,13 +154,33 @@ public:
     [[nodiscard]] auto progressIterations() const -> size_t override;
 
 private:
+    /** Rasterization search structure */
+    struct Rasterizer;
+
+    /** Get the cached search structure, building it if needed */
+    auto get_rasterizer_() -> std::shared_ptr<const Rasterizer>;
+
+    /** Build a new search structure from the current inputs */
+    [[nodiscard]] auto build_rasterizer_() const
+        -> std::shared_ptr<const Rasterizer>;
+
+    /** Rasterize `region` into a new PerPixelMap */
+    auto rasterize_(
+        const Rasterizer& r, const cv::Rect& region, bool reportProgress)
+        -> PerPixelMap::Pointer;
+
     /** Input mesh */
     ITKMesh::Pointer inputMesh_;
     /** Input UV Map */
     UVMap::Pointer uvMap_;
 
-    /** Working mesh */
-    ITKMesh::Pointer workingMesh_;
+    /** Input mesh */
+    TriangleMesh::Pointer inputTriMesh_;
+
+    /** Cached search structure */
+    std::shared_ptr<const Rasterizer> rasterizer_;
+    /** Guards construction of the search structure */
+    std::mutex rasterizerMutex_;
     /** Output PerPixelMap */
     PerPixelMap::Pointer ppm_;
     /** Output shading */
@@ -32,6 +32,9 @@ namespace volcart::texturing
  * By default, the last mesh intersection point is used for each ray, optionally
  * this may be changed to the first intersection point.
  *
+ * The image is projected in parallel in square tiles of pixels. The mesh must
+ * be a triangle mesh with vertex normals.
+ *
  * This class uses raytracing functionality provided by the
  * [bvh library](https://github.com/madmann91/bvh).
  *
@@ -29,6 +29,12 @@ public:
     /** @brief Set the input Volume */
     void setVolume(Volume::Pointer vol) { vol_ = std::move(vol); }
 
+    /** @brief Get the input PerPixelMap */
+    PerPixelMap::Pointer getPerPixelMap() const { return ppm_; }
+
+    /** @brief Get the input Volume */
+    Volume::Pointer getVolume() const { return vol_; }
+
     /** @brief Compute the Texture */
     virtual Texture compute() = 0;
 
@@ -0,0 +1,172 @@
+#pragma once
+
+/** @file */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/io/TIFFIO.hpp"
+#include "vc/core/types/Mixins.hpp"
+#include "vc/core/types/PerPixelMap.hpp"
+#include "vc/texturing/PPMGenerator.hpp"
+#include "vc/texturing/TexturingAlgorithm.hpp"
+
+namespace volcart::texturing
+{
+/**
+ * @class TiledRenderer
+ * @brief Render a Texture tile-by-tile directly to tiled TIFF files
+ *
+ * Texturing algorithms allocate their full output images at the resolution of
+ * the PerPixelMap, and the PerPixelMap itself stores six doubles per pixel, so
+ * very large renders quickly exhaust memory. This class splits the output into
+ * square tiles. For every tile, it gets the tile's region of the PerPixelMap,
+ * runs a texturing function on that region, and writes the resulting images
+ * into tiled BigTIFF files with tiffio::TiledTIFFWriter. Tiles are processed
+ * in parallel, and each worker thread only holds a single tile at a time, so
+ * peak memory is bounded by a few tiles regardless of the output size.
+ *
+ * The PerPixelMap regions are computed by a PPMGenerator, so the full
+ * PerPixelMap never has to exist in memory. An existing PerPixelMap may also
+ * be provided, in which case it is cropped for each tile.
+ *
+ * The texturing function receives a tile PerPixelMap and returns the tile's
+ * images. Every tile must return the same number of images with the same
+ * image type. The number of images and the type are taken from the first
+ * finished tile. The function is called from multiple threads at once.
+ *
+ * @code
+ * TiledRenderer renderer;
+ * renderer.setPPMGenerator(ppmGen);
+ * renderer.setTileFunction([&](const PerPixelMap::Pointer& ppm) {
+ *     LayerTexture layers;
+ *     layers.setPerPixelMap(ppm);
+ *     layers.setVolume(volume);
+ *     layers.setGenerator(line);
+ *     return layers.compute();
+ * });
+ * renderer.setOutputPath("layers.tif");
+ * renderer.compute();
+ * @endcode
+ *
+ * @ingroup Texture
+ */
+class TiledRenderer : public IterationsProgress
+{
+public:
+    /** Texturing function type */
+    using TileFunction = std::function<TexturingAlgorithm::Texture(
+        const PerPixelMap::Pointer&)>;
+
+    /** Default tile edge length */
+    static constexpr std::uint32_t DEFAULT_TILE_SIZE{1024};
+
+    /**@{*/
+    /**
+     * @brief Compute PerPixelMap tiles with a PPMGenerator
+     *
+     * The generator's dimensions determine the dimensions of the output.
+     */
+    void setPPMGenerator(std::shared_ptr<PPMGenerator> gen);
+
+    /**
+     * @brief Crop PerPixelMap tiles from an existing PerPixelMap
+     *
+     * The PerPixelMap's dimensions determine the dimensions of the output.
+     */
+    void setPerPixelMap(PerPixelMap::Pointer ppm);
+
+    /** @brief Set the texturing function */
+    void setTileFunction(TileFunction fn);
+    /**@}*/
+
+    /**@{*/
+    /**
+     * @brief Set the tile edge length
+     *
+     * Must be a multiple of 16. Default: 1024
+     */
+    void setTileSize(std::uint32_t size);
+
+    /**
+     * @brief Set the output path
+     *
+     * If multi-page output is enabled, this is the path of the output TIFF
+     * file. Otherwise, it is a directory, and texture image `i` is written to
+     * `i.tif` in that directory, where `i` is zero-padded to the width of the
+     * number of images.
+     */
+    void setOutputPath(const filesystem::path& path);
+
+    /**
+     * @brief Write all texture images as pages of a single TIFF file
+     *
+     * Default: true
+     */
+    void setMultiPage(bool b);
+
+    /**
+     * @brief Set the output compression
+     *
+     * Default: tiffio::Compression::ADOBE_DEFLATE
+     */
+    void setCompression(tiffio::Compression c);
+
+    /**
+     * @brief Set the number of worker threads
+     *
+     * If 0, DefaultThreadCount() threads are used. Default: 0
+     */
+    void setNumThreads(std::size_t n);
+
+    /** @brief Get the output width */
+    [[nodiscard]] auto width() const -> std::size_t;
+
+    /** @brief Get the output height */
+    [[nodiscard]] auto height() const -> std::size_t;
+
+    /** @brief Get the number of tiles */
+    [[nodiscard]] auto numTiles() const -> std::size_t;
+    /**@}*/
+
+    /**
+     * @brief Render all tiles and write the output files
+     *
+     * @throws std::invalid_argument if the inputs are not set or the tile
+     * size is invalid
+     * @throws std::runtime_error if the tile outputs are inconsistent or the
+     * output cannot be written
+     */
+    void compute();
+
+    /** @brief Returns the maximum progress value */
+    [[nodiscard]] auto progressIterations() const -> std::size_t override;
+
+private:
+    /** Get the PerPixelMap for a tile */
+    auto tile_ppm_(const cv::Rect& region) const -> PerPixelMap::Pointer;
+
+    /** PPM generator */
+    std::shared_ptr<PPMGenerator> ppmGen_;
+    /** In-memory PPM */
+    PerPixelMap::Pointer ppm_;
+    /** Texturing function */
+    TileFunction tileFn_;
+    /** Tile edge length */
+    std::uint32_t tileSize_{DEFAULT_TILE_SIZE};
+    /** Output path */
+    filesystem::path outputPath_;
+    /** Multi-page output */
+    bool multiPage_{true};
+    /** Output compression */
+    tiffio::Compression compression_{tiffio::Compression::ADOBE_DEFLATE};
+    /** Number of worker threads */
+    std::size_t numThreads_{0};
+};
+
+}  // namespace volcart::texturing
@@ -4,6 +4,7 @@
 
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MeshMath.hpp"
+#include "vc/core/util/Trace.hpp"
 #include "vc/meshing/DeepCopy.hpp"
 #include "vc/meshing/ScaleMesh.hpp"
 
@@ -31,6 +32,7 @@ void AngleBasedFlattening::setABFMaxIterations(std::size_t i)
 ///// Process //////
 ITKMesh::Pointer AngleBasedFlattening::compute()
 {
+    trace::Span span("AngleBasedFlattening::compute", "texturing");
     // Construct HEM
     auto hem = HalfEdgeMesh::New();
 
@@ -0,0 +1,843 @@
+#include "vc/texturing/ChartedFlattening.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <Eigen/Eigenvalues>
+#include <Eigen/SparseCholesky>
+
+#include "vc/core/types/TriangleMesh.hpp"
+#include "vc/core/util/Logging.hpp"
+#include "vc/core/util/MeshMath.hpp"
+#include "vc/core/util/Parallel.hpp"
+#include "vc/core/util/Trace.hpp"
+#include "vc/meshing/DeepCopy.hpp"
+#include "vc/meshing/ScaleMesh.hpp"
+
+using namespace volcart;
+using namespace volcart::meshmath;
+using namespace volcart::meshing;
+using namespace volcart::texturing;
+
+namespace
+{
+using Index = TriangleMesh::Index;
+using Face = TriangleMesh::Face;
+using UV = cv::Vec2d;
+
+// Charts smaller than chartSize / MIN_CHART_DIVISOR faces are merged
+constexpr std::size_t MIN_CHART_DIVISOR{4};
+// Bounds on the ARAP cotangent weights. Keeps the system positive definite
+// in the presence of obtuse and degenerate triangles.
+constexpr double MIN_COT_WEIGHT{1e-4};
+constexpr double MAX_COT_WEIGHT{1e4};
+// ARAP iterations for charts started from a planar projection
+constexpr std::size_t MIN_FALLBACK_ITERATIONS{20};
+// Gap between connected components, relative to their UV extent
+constexpr double COMPONENT_GAP{0.05};
+// Marker for faces which are not assigned to a chart
+constexpr Index UNASSIGNED{std::numeric_limits<Index>::max()};
+
+// Rotation and translation in the UV plane
+struct Rigid {
+    double cos{1};
+    double sin{0};
+    UV t{0, 0};
+
+    auto operator()(const UV& p) const -> UV
+    {
+        return {
+            cos * p[0] - sin * p[1] + t[0], sin * p[0] + cos * p[1] + t[1]};
+    }
+};
+
+// Flattened chart
+struct Chart {
+    // Mesh face IDs. Core faces come first.
+    std::vector<Index> faces;
+    // Number of core faces
+    std::size_t numCore{0};
+    // Mesh vertex IDs, indexed by chart vertex ID
+    std::vector<Index> vertices;
+    // Whether each chart vertex belongs to a core face
+    std::vector<bool> core;
+    // Chart-space UV coordinates, indexed by chart vertex ID
+    std::vector<UV> uvs;
+    // Placement of the chart in the output UV space
+    Rigid xform;
+};
+
+// Chart which contains a mesh vertex
+struct Incidence {
+    Index chart;
+    Index local;
+};
+
+// Call fn(g) for each face g which shares an edge with face f
+template <typename Fn>
+void ForEachEdgeNeighbor(
+    const TriangleMesh& mesh, const VertexFaceAdjacency& adj, Index f, Fn fn)
+{
+    const auto& face = mesh.faces()[f];
+    for (std::size_t e = 0; e < 3; e++) {
+        auto a = face[e];
+        auto b = face[(e + 1) % 3];
+        for (auto g = adj.begin(a); g != adj.end(a); g++) {
+            const auto& other = mesh.faces()[*g];
+            if (*g != f and
+                std::find(other.begin(), other.end(), b) != other.end()) {
+                fn(*g);
+            }
+        }
+    }
+}
+
+// Partition the faces into edge-connected charts of about `target` faces
+auto PartitionFaces(
+    const TriangleMesh& mesh,
+    const VertexFaceAdjacency& adj,
+    std::size_t target) -> std::vector<std::vector<Index>>
+{
+    const auto numFaces = static_cast<Index>(mesh.numFaces());
+    std::vector<Index> labels(numFaces, UNASSIGNED);
+    std::vector<std::vector<Index>> charts;
+
+    // Grow charts breadth-first. Faces left on the frontier of a full chart
+    // seed the next charts, which keeps the charts compact.
+    std::vector<Index> seeds;
+    std::vector<Index> frontier;
+    Index scan{0};
+    while (true) {
+        auto seed = UNASSIGNED;
+        while (seed == UNASSIGNED and not seeds.empty()) {
+            if (labels[seeds.back()] == UNASSIGNED) {
+                seed = seeds.back();
+            }
+            seeds.pop_back();
+        }
+        for (; seed == UNASSIGNED and scan < numFaces; scan++) {
+            if (labels[scan] == UNASSIGNED) {
+                seed = scan;
+            }
+        }
+        if (seed == UNASSIGNED) {
+            break;
+        }
+
+        auto label = static_cast<Index>(charts.size());
+        frontier.assign(1, seed);
+        labels[seed] = label;
+        std::size_t head{0};
+        while (head < frontier.size() and head < target) {
+            ForEachEdgeNeighbor(mesh, adj, frontier[head++], [&](Index g) {
+                if (labels[g] == UNASSIGNED) {
+                    labels[g] = label;
+                    frontier.push_back(g);
+                }
+            });
+        }
+        for (auto i = head; i < frontier.size(); i++) {
+            labels[frontier[i]] = UNASSIGNED;
+            seeds.push_back(frontier[i]);
+        }
+        frontier.resize(head);
+        charts.push_back(frontier);
+    }
+
+    // Merge small charts into a neighbor
+    auto minSize = std::max<std::size_t>(target / MIN_CHART_DIVISOR, 1);
+    for (std::size_t c = 0; c < charts.size(); c++) {
+        if (charts[c].empty() or charts[c].size() >= minSize) {
+            continue;
+        }
+        auto neighbor = UNASSIGNED;
+        for (auto f : charts[c]) {
+            ForEachEdgeNeighbor(mesh, adj, f, [&](Index g) {
+                if (neighbor == UNASSIGNED and labels[g] != c) {
+                    neighbor = labels[g];
+                }
+            });
+        }
+        if (neighbor == UNASSIGNED) {
+            continue;
+        }
+        for (auto f : charts[c]) {
+            labels[f] = neighbor;
+        }
+        auto& dst = charts[neighbor];
+        dst.insert(dst.end(), charts[c].begin(), charts[c].end());
+        charts[c].clear();
+    }
+    charts.erase(
+        std::remove_if(
+            charts.begin(), charts.end(),
+            [](const auto& c) { return c.empty(); }),
+        charts.end());
+    return charts;
+}
+
+// Grow a chart by `rings` rings of neighboring faces, assign chart vertex
+// IDs, and return the chart's faces in chart vertex IDs
+auto BuildChart(
+    const TriangleMesh& mesh,
+    const VertexFaceAdjacency& adj,
+    std::size_t rings,
+    Chart& chart) -> std::vector<Face>
+{
+    std::unordered_map<Index, Index> local;
+    auto addVertices = [&](Index f) {
+        for (auto v : mesh.faces()[f]) {
+            auto id = static_cast<Index>(chart.vertices.size());
+            if (local.emplace(v, id).second) {
+                chart.vertices.push_back(v);
+            }
+        }
+    };
+
+    for (auto f : chart.faces) {
+        addVertices(f);
+    }
+    chart.core.assign(chart.vertices.size(), true);
+
+    // Each ring adds the faces incident to the previous ring's vertices
+    std::unordered_set<Index> inChart(chart.faces.begin(), chart.faces.end());
+    std::size_t ringBegin{0};
+    for (std::size_t r = 0; r < rings; r++) {
+        auto ringEnd = chart.vertices.size();
+        for (auto i = ringBegin; i < ringEnd; i++) {
+            auto v = chart.vertices[i];
+            for (auto f = adj.begin(v); f != adj.end(v); f++) {
+                if (inChart.insert(*f).second) {
+                    chart.faces.push_back(*f);
+                    addVertices(*f);
+                }
+            }
+        }
+        ringBegin = ringEnd;
+    }
+    chart.core.resize(chart.vertices.size(), false);
+
+    std::vector<Face> faces;
+    faces.reserve(chart.faces.size());
+    for (auto f : chart.faces) {
+        const auto& face = mesh.faces()[f];
+        faces.push_back({local[face[0]], local[face[1]], local[face[2]]});
+    }
+    return faces;
+}
+
+// Sum of the signed areas of the faces in UV space
+auto SignedArea(const std::vector<Face>& faces, const std::vector<UV>& uvs)
+    -> double
+{
+    double area{0};
+    for (const auto& f : faces) {
+        auto a = uvs[f[1]] - uvs[f[0]];
+        auto b = uvs[f[2]] - uvs[f[0]];
+        area += a[0] * b[1] - a[1] * b[0];
+    }
+    return 0.5 * area;
+}
+
+// Mirror the UV coordinates if their orientation does not match `sign`
+void FixOrientation(
+    const std::vector<Face>& faces, std::vector<UV>& uvs, double sign)
+{
+    if (SignedArea(faces, uvs) * sign < 0) {
+        for (auto& uv : uvs) {
+            uv[0] = -uv[0];
+        }
+    }
+}
+
+// Per-axis scale which best maps the UV edge lengths of the faces onto their
+// 3D edge lengths. Returns zero if the fit is degenerate.
+auto FitUVScale(
+    const std::vector<cv::Vec3d>& pts,
+    const std::vector<Face>& faces,
+    const std::vector<UV>& uvs) -> UV
+{
+    // Least-squares fit of |e|^2 = a * du^2 + b * dv^2
+    double xx{0};
+    double xy{0};
+    double yy{0};
+    double xt{0};
+    double yt{0};
+    for (const auto& f : faces) {
+        for (std::size_t e = 0; e < 3; e++) {
+            auto i = f[e];
+            auto j = f[(e + 1) % 3];
+            auto d = uvs[i] - uvs[j];
+            auto x = d[0] * d[0];
+            auto y = d[1] * d[1];
+            auto l = pts[i] - pts[j];
+            auto t = l.dot(l);
+            xx += x * x;
+            xy += x * y;
+            yy += y * y;
+            xt += x * t;
+            yt += y * t;
+        }
+    }
+    auto det = xx * yy - xy * xy;
+    if (not(det > 1e-12 * xx * yy)) {
+        return {0, 0};
+    }
+    auto a = (yy * xt - xy * yt) / det;
+    auto b = (xx * yt - xy * xt) / det;
+    if (a <= 0 or b <= 0) {
+        return {0, 0};
+    }
+    return {std::sqrt(a), std::sqrt(b)};
+}
+
+// Project points onto their least-squares plane
+auto ProjectToPlane(const std::vector<cv::Vec3d>& pts) -> std::vector<UV>
+{
+    Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+    for (const auto& p : pts) {
+        mean += Eigen::Vector3d(p[0], p[1], p[2]);
+    }
+    mean /= static_cast<double>(pts.size());
+
+    Eigen::Matrix3d cov = Eigen::Matrix3d::Zero();
+    for (const auto& p : pts) {
+        Eigen::Vector3d d = Eigen::Vector3d(p[0], p[1], p[2]) - mean;
+        cov += d * d.transpose();
+    }
+
+    // Eigenvalues are sorted in increasing order
+    Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(cov);
+    Eigen::Vector3d u = solver.eigenvectors().col(2);
+    Eigen::Vector3d v = solver.eigenvectors().col(1);
+    std::vector<UV> uvs;
+    uvs.reserve(pts.size());
+    for (const auto& p : pts) {
+        Eigen::Vector3d d = Eigen::Vector3d(p[0], p[1], p[2]) - mean;
+        uvs.emplace_back(d.dot(u), d.dot(v));
+    }
+    return uvs;
+}
+
+// Relax the UV coordinates towards an isometry of the 3D faces with the
+// local/global as-rigid-as-possible solver of Liu et al. (2008). The first
+// vertex is held in place.
+void SolveARAP(
+    const std::vector<cv::Vec3d>& pts,
+    const std::vector<Face>& faces,
+    std::vector<UV>& uvs,
+    std::size_t iterations)
+{
+    if (iterations == 0 or pts.empty()) {
+        return;
+    }
+
+    // Lay out each face isometrically in its own plane and weight each edge
+    // by the cotangent of its opposite angle. Edge e is (e, e + 1).
+    struct Frame {
+        std::array<UV, 3> x;
+        std::array<double, 3> w;
+    };
+    std::vector<Frame> frames(faces.size());
+    std::vector<Eigen::Triplet<double>> triplets;
+    triplets.reserve(12 * faces.size() + 1);
+    for (std::size_t t = 0; t < faces.size(); t++) {
+        const auto& f = faces[t];
+        auto e1 = pts[f[1]] - pts[f[0]];
+        auto e2 = pts[f[2]] - pts[f[0]];
+        auto l1 = cv::norm(e1);
+        cv::Vec3d axis = l1 > 0 ? e1 * (1.0 / l1) : cv::Vec3d{1, 0, 0};
+        auto a = e2.dot(axis);
+        auto& frame = frames[t];
+        frame.x = {UV{0, 0}, UV{l1, 0}, UV{a, cv::norm(e2 - a * axis)}};
+
+        for (std::size_t e = 0; e < 3; e++) {
+            auto i = e;
+            auto j = (e + 1) % 3;
+            auto k = (e + 2) % 3;
+            auto di = frame.x[i] - frame.x[k];
+            auto dj = frame.x[j] - frame.x[k];
+            auto cross = std::abs(di[0] * dj[1] - di[1] * dj[0]);
+            auto cot = cross > 0 ? di.dot(dj) / cross : 0.0;
+            auto w = std::clamp(cot, MIN_COT_WEIGHT, MAX_COT_WEIGHT);
+            frame.w[e] = w;
+            triplets.emplace_back(f[i], f[i], w);
+            triplets.emplace_back(f[j], f[j], w);
+            triplets.emplace_back(f[i], f[j], -w);
+            triplets.emplace_back(f[j], f[i], -w);
+        }
+    }
+
+    // Anchor the first vertex to remove the translational null space
+    triplets.emplace_back(0, 0, 1.0);
+    auto n = static_cast<Eigen::Index>(pts.size());
+    Eigen::SparseMatrix<double> lhs(n, n);
+    lhs.setFromTriplets(triplets.begin(), triplets.end());
+    Eigen::SimplicialLDLT<Eigen::SparseMatrix<double>> solver(lhs);
+    if (solver.info() != Eigen::Success) {
+        throw std::runtime_error("Failed to factor ARAP system");
+    }
+
+    auto anchor = uvs[0];
+    Eigen::MatrixXd rhs(n, 2);
+    for (std::size_t it = 0; it < iterations; it++) {
+        rhs.setZero();
+        rhs(0, 0) = anchor[0];
+        rhs(0, 1) = anchor[1];
+        for (std::size_t t = 0; t < faces.size(); t++) {
+            const auto& f = faces[t];
+            const auto& frame = frames[t];
+
+            // Local step: Best-fit rotation from the frame to the UVs
+            double c{0};
+            double s{0};
+            for (std::size_t e = 0; e < 3; e++) {
+                auto i = e;
+                auto j = (e + 1) % 3;
+                auto du = uvs[f[i]] - uvs[f[j]];
+                auto dx = frame.x[i] - frame.x[j];
+                c += frame.w[e] * (du[0] * dx[0] + du[1] * dx[1]);
+                s += frame.w[e] * (du[1] * dx[0] - du[0] * dx[1]);
+            }
+            auto len = std::hypot(c, s);
+            c = len > 0 ? c / len : 1.0;
+            s = len > 0 ? s / len : 0.0;
+
+            // Global step right-hand side
+            for (std::size_t e = 0; e < 3; e++) {
+                auto i = e;
+                auto j = (e + 1) % 3;
+                auto dx = frame.x[i] - frame.x[j];
+                auto rx = frame.w[e] * (c * dx[0] - s * dx[1]);
+                auto ry = frame.w[e] * (s * dx[0] + c * dx[1]);
+                rhs(f[i], 0) += rx;
+                rhs(f[i], 1) += ry;
+                rhs(f[j], 0) -= rx;
+                rhs(f[j], 1) -= ry;
+            }
+        }
+
+        // Global step
+        Eigen::MatrixXd x = solver.solve(rhs);
+        for (Eigen::Index v = 0; v < n; v++) {
+            uvs[v] = {x(v, 0), x(v, 1)};
+        }
+    }
+}
+
+// Least-squares rotation and translation which maps `src` onto `dst`
+auto FitRigid(const std::vector<UV>& src, const std::vector<UV>& dst) -> Rigid
+{
+    UV srcMean{0, 0};
+    UV dstMean{0, 0};
+    for (std::size_t i = 0; i < src.size(); i++) {
+        srcMean += src[i];
+        dstMean += dst[i];
+    }
+    srcMean *= 1.0 / static_cast<double>(src.size());
+    dstMean *= 1.0 / static_cast<double>(dst.size());
+
+    double c{0};
+    double s{0};
+    for (std::size_t i = 0; i < src.size(); i++) {
+        auto p = src[i] - srcMean;
+        auto q = dst[i] - dstMean;
+        c += p[0] * q[0] + p[1] * q[1];
+        s += p[0] * q[1] - p[1] * q[0];
+    }
+    auto len = std::hypot(c, s);
+
+    Rigid r;
+    r.cos = len > 0 ? c / len : 1.0;
+    r.sin = len > 0 ? s / len : 0.0;
+    r.t = dstMean - r(srcMean);
+    return r;
+}
+
+// Flatten a chart with ABF++/LSCM, falling back to ARAP
+auto FlattenChart(
+    const TriangleMesh& chart,
+    bool useABF,
+    std::size_t abfIterations) -> std::vector<UV>
+{
+    std::vector<UV> uvs;
+    try {
+        AngleBasedFlattening abf(ToITKMesh(chart));
+        abf.setUseABF(useABF);
+        abf.setABFMaxIterations(abfIterations);
+        auto flat = abf.compute();
+        uvs.reserve(chart.numVertices());
+        for (std::size_t v = 0; v < chart.numVertices(); v++) {
+            auto p = flat->GetPoint(v);
+            uvs.emplace_back(p[0], p[2]);
+        }
+    } catch (const std::exception& e) {
+        Logger()->debug("Chart ABF failed, falling back to ARAP: {}", e.what());
+        uvs = ProjectToPlane(chart.vertices());
+        SolveARAP(
+            chart.vertices(), chart.faces(), uvs, MIN_FALLBACK_ITERATIONS);
+    }
+    return uvs;
+}
+
+// Place the charts in a common UV space and average the UV coordinates of
+// the vertices which they share
+auto StitchCharts(
+    std::vector<Chart>& charts,
+    std::size_t numVertices,
+    std::size_t iterations,
+    std::size_t numThreads) -> std::vector<UV>
+{
+    // Index the charts which contain each vertex
+    std::vector<std::size_t> offsets(numVertices + 1, 0);
+    for (const auto& chart : charts) {
+        for (auto v : chart.vertices) {
+            offsets[v + 1]++;
+        }
+    }
+    for (std::size_t v = 0; v < numVertices; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    std::vector<Incidence> incidence(offsets.back());
+    {
+        std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+        for (std::size_t c = 0; c < charts.size(); c++) {
+            const auto& verts = charts[c].vertices;
+            for (std::size_t i = 0; i < verts.size(); i++) {
+                incidence[next[verts[i]]++] = {
+                    static_cast<Index>(c), static_cast<Index>(i)};
+            }
+        }
+    }
+
+    // Fit a chart to the mean positions of its shared vertices in the charts
+    // accepted by `use`
+    auto fit = [&](std::size_t c, auto use) {
+        const auto& chart = charts[c];
+        std::vector<UV> src;
+        std::vector<UV> dst;
+        for (std::size_t i = 0; i < chart.vertices.size(); i++) {
+            auto v = chart.vertices[i];
+            UV sum{0, 0};
+            std::size_t count{0};
+            for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+                const auto& inc = incidence[e];
+                if (inc.chart != c and use(inc.chart)) {
+                    const auto& other = charts[inc.chart];
+                    sum += other.xform(other.uvs[inc.local]);
+                    count++;
+                }
+            }
+            if (count > 0) {
+                src.push_back(chart.uvs[i]);
+                dst.push_back(sum * (1.0 / static_cast<double>(count)));
+            }
+        }
+        return src.size() < 2 ? chart.xform : FitRigid(src, dst);
+    };
+
+    // Place the charts breadth-first from a root chart in each connected
+    // component. Components are laid out left to right.
+    std::vector<bool> placed(charts.size(), false);
+    std::vector<std::size_t> queue;
+    std::vector<bool> queued(charts.size(), false);
+    auto uMax = std::numeric_limits<double>::lowest();
+    for (std::size_t root = 0; root < charts.size(); root++) {
+        if (placed[root]) {
+            continue;
+        }
+        placed[root] = queued[root] = true;
+        queue.assign(1, root);
+        for (std::size_t head = 0; head < queue.size(); head++) {
+            auto c = queue[head];
+            if (not placed[c]) {
+                charts[c].xform = fit(c, [&](auto o) { return placed[o]; });
+                placed[c] = true;
+            }
+            for (auto v : charts[c].vertices) {
+                for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+                    auto n = incidence[e].chart;
+                    if (not queued[n]) {
+                        queued[n] = true;
+                        queue.push_back(n);
+                    }
+                }
+            }
+        }
+
+        // Shift the component to the right of the previous ones
+        cv::Vec4d bounds{
+            std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::lowest(),
+            std::numeric_limits<double>::max(),
+            std::numeric_limits<double>::lowest()};
+        for (auto c : queue) {
+            for (const auto& uv : charts[c].uvs) {
+                auto p = charts[c].xform(uv);
+                bounds[0] = std::min(bounds[0], p[0]);
+                bounds[1] = std::max(bounds[1], p[0]);
+                bounds[2] = std::min(bounds[2], p[1]);
+                bounds[3] = std::max(bounds[3], p[1]);
+            }
+        }
+        if (root > 0) {
+            auto gap = COMPONENT_GAP *
+                       std::max(bounds[1] - bounds[0], bounds[3] - bounds[2]);
+            auto shift = uMax + gap - bounds[0];
+            for (auto c : queue) {
+                charts[c].xform.t[0] += shift;
+            }
+            bounds[1] += shift;
+        }
+        uMax = std::max(uMax, bounds[1]);
+    }
+
+    // Relax all placements against each other
+    for (std::size_t it = 0; it < iterations; it++) {
+        std::vector<Rigid> xforms(charts.size());
+        ParallelFor(
+            charts.size(),
+            [&](std::size_t c) {
+                xforms[c] = fit(c, [](auto) { return true; });
+            },
+            numThreads);
+        for (std::size_t c = 0; c < charts.size(); c++) {
+            charts[c].xform = xforms[c];
+        }
+    }
+
+    // Average the placed UVs of each vertex over the charts whose core
+    // contains it
+    std::vector<UV> uvs(numVertices, UV{0, 0});
+    std::vector<bool> covered(numVertices, false);
+    UV centroid{0, 0};
+    std::size_t numCovered{0};
+    for (std::size_t v = 0; v < numVertices; v++) {
+        UV sum{0, 0};
+        std::size_t count{0};
+        for (auto e = offsets[v]; e < offsets[v + 1]; e++) {
+            const auto& chart = charts[incidence[e].chart];
+            if (chart.core[incidence[e].local]) {
+                sum += chart.xform(chart.uvs[incidence[e].local]);
+                count++;
+            }
+        }
+        if (count > 0) {
+            uvs[v] = sum * (1.0 / static_cast<double>(count));
+            covered[v] = true;
+            centroid += uvs[v];
+            numCovered++;
+        }
+    }
+
+    // Vertices without faces are placed at the centroid
+    if (numCovered > 0) {
+        centroid *= 1.0 / static_cast<double>(numCovered);
+    }
+    for (std::size_t v = 0; v < numVertices; v++) {
+        if (not covered[v]) {
+            uvs[v] = centroid;
+        }
+    }
+
+    return uvs;
+}
+}  // namespace
+
+ChartedFlattening::ChartedFlattening(const ITKMesh::Pointer& m)
+    : FlatteningAlgorithm(m)
+{
+}
+
+void ChartedFlattening::setChartSize(std::size_t n) { chartSize_ = n; }
+
+auto ChartedFlattening::chartSize() const -> std::size_t { return chartSize_; }
+
+void ChartedFlattening::setChartOverlap(std::size_t n) { chartOverlap_ = n; }
+
+auto ChartedFlattening::chartOverlap() const -> std::size_t
+{
+    return chartOverlap_;
+}
+
+void ChartedFlattening::setUseABF(bool a) { useABF_ = a; }
+
+auto ChartedFlattening::useABF() const -> bool { return useABF_; }
+
+void ChartedFlattening::setABFMaxIterations(std::size_t i)
+{
+    maxABFIterations_ = i;
+}
+
+auto ChartedFlattening::abfMaxIterations() const -> std::size_t
+{
+    return maxABFIterations_;
+}
+
+void ChartedFlattening::setAlignmentIterations(std::size_t i)
+{
+    alignIters_ = i;
+}
+
+auto ChartedFlattening::alignmentIterations() const -> std::size_t
+{
+    return alignIters_;
+}
+
+void ChartedFlattening::setInitialUVMap(const UVMap::Pointer& uvMap)
+{
+    initialUV_ = uvMap;
+}
+
+auto ChartedFlattening::initialUVMap() const -> UVMap::Pointer
+{
+    return initialUV_;
+}
+
+void ChartedFlattening::setWarmStartIterations(std::size_t i)
+{
+    warmStartIters_ = i;
+}
+
+auto ChartedFlattening::warmStartIterations() const -> std::size_t
+{
+    return warmStartIters_;
+}
+
+void ChartedFlattening::setNumThreads(std::size_t n) { numThreads_ = n; }
+
+auto ChartedFlattening::numThreads() const -> std::size_t
+{
+    return numThreads_;
+}
+
+auto ChartedFlattening::numCharts() const -> std::size_t { return numCharts_; }
+
+auto ChartedFlattening::numWarmStartedCharts() const -> std::size_t
+{
+    return numWarmStarted_;
+}
+
+auto ChartedFlattening::compute() -> ITKMesh::Pointer
+{
+    trace::Span span("ChartedFlattening::compute", "texturing");
+    auto mesh = FromITKMesh(mesh_, initialUV_);
+    VertexFaceAdjacency adj(*mesh);
+    const auto numVertices = mesh->numVertices();
+
+    // Initial UVs
+    std::vector<UV> initial;
+    std::vector<bool> mapped;
+    auto orientation = 1.0;
+    if (initialUV_ and mesh->hasUVs()) {
+        initial = mesh->uvs();
+        mapped.resize(numVertices);
+        for (std::size_t v = 0; v < numVertices; v++) {
+            mapped[v] = initial[v] != NULL_MAPPING;
+        }
+        std::vector<Face> faces;
+        for (const auto& f : mesh->faces()) {
+            if (mapped[f[0]] and mapped[f[1]] and mapped[f[2]]) {
+                faces.push_back(f);
+            }
+        }
+
+        // Convert to mesh units. The stored ratio is only a fallback, since
+        // it is not saved by every mesh format.
+        auto scale = FitUVScale(mesh->vertices(), faces, initial);
+        if (scale[0] <= 0) {
+            auto ratio = initialUV_->ratio();
+            scale = {ratio.width, ratio.height};
+        }
+        for (auto& uv : initial) {
+            uv[0] *= scale[0];
+            uv[1] *= scale[1];
+        }
+
+        // Flattened charts should match the orientation of the initial map
+        orientation = SignedArea(faces, initial) < 0 ? -1.0 : 1.0;
+    }
+
+    // Partition
+    Logger()->info("Partitioning mesh into charts");
+    auto parts =
+        PartitionFaces(*mesh, adj, std::max<std::size_t>(chartSize_, 1));
+    numCharts_ = parts.size();
+
+    // Flatten each chart
+    Logger()->info("Flattening {} charts", numCharts_);
+    std::vector<Chart> charts(parts.size());
+    std::atomic<std::size_t> numWarm{0};
+    ParallelFor(
+        charts.size(),
+        [&](std::size_t c) {
+            trace::Span chartSpan("ChartedFlattening::chart", "texturing");
+            auto& chart = charts[c];
+            chart.faces = std::move(parts[c]);
+            chart.numCore = chart.faces.size();
+            auto faces = BuildChart(*mesh, adj, chartOverlap_, chart);
+
+            TriangleMesh local;
+            local.reserve(chart.vertices.size(), faces.size());
+            for (auto v : chart.vertices) {
+                local.addVertex(mesh->vertices()[v]);
+            }
+            local.faces() = std::move(faces);
+
+            // Warm start if every vertex has an initial UV
+            auto warm = not mapped.empty() and
+                        std::all_of(
+                            chart.vertices.begin(), chart.vertices.end(),
+                            [&](auto v) { return mapped[v]; });
+            if (warm) {
+                chart.uvs.reserve(chart.vertices.size());
+                for (auto v : chart.vertices) {
+                    chart.uvs.push_back(initial[v]);
+                }
+                SolveARAP(
+                    local.vertices(), local.faces(), chart.uvs,
+                    warmStartIters_);
+                numWarm++;
+            } else {
+                chart.uvs = FlattenChart(local, useABF_, maxABFIterations_);
+            }
+            FixOrientation(local.faces(), chart.uvs, orientation);
+        },
+        numThreads_);
+    numWarmStarted_ = numWarm;
+    Logger()->debug("Warm-started {} charts", numWarmStarted_);
+
+    // Stitch the charts
+    Logger()->info("Aligning charts");
+    auto uvs = StitchCharts(charts, numVertices, alignIters_, numThreads_);
+
+    // Fill output
+    auto flatMesh = ITKMesh::New();
+    DeepCopy(mesh_, flatMesh);
+    // Vertices are in the order of the input's points container
+    ITKPoint pt;
+    cv::Vec3d norm{0.0, 1.0, 0.0};
+    std::size_t v{0};
+    for (auto p = mesh_->GetPoints()->Begin(); p != mesh_->GetPoints()->End();
+         ++p, ++v) {
+        pt[0] = uvs[v][0];
+        pt[1] = 0.0;
+        pt[2] = uvs[v][1];
+        flatMesh->SetPoint(p.Index(), pt);
+        flatMesh->SetPointData(p.Index(), norm.val);
+    }
+
+    // Scale mesh surface area to same as original
+    auto scale = std::sqrt(SurfaceArea(mesh_) / SurfaceArea(flatMesh));
+    Logger()->debug("Scaling output mesh by scale factor {:.5g}", scale);
+    output_ = ITKMesh::New();
+    ScaleMesh(flatMesh, output_, scale);
+
+    return output_;
+}
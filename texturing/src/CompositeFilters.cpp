@@ -0,0 +1,195 @@
+#include "vc/texturing/CompositeFilters.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "vc/core/util/FloatComparison.hpp"
+
+using namespace volcart;
+using namespace volcart::texturing;
+
+/**
+ * Buffers at or below this size are sorted rather than radix selected. Below
+ * this size, clearing and scanning the 256-bin histograms costs more than the
+ * sort.
+ */
+static constexpr std::size_t SMALL_BUFFER_SIZE{64};
+
+namespace
+{
+/** Histogram of one byte of each value */
+using Histogram = std::array<std::uint32_t, 256>;
+
+/** Sum of the values in a histogram bin */
+using BinSums = std::array<std::uint64_t, 256>;
+
+/** Find the bin containing rank `k`. On return, `k` is the rank in the bin. */
+auto FindBin(const Histogram& h, std::size_t& k) -> std::size_t
+{
+    std::size_t bin{0};
+    while (k >= h[bin]) {
+        k -= h[bin];
+        bin++;
+    }
+    return bin;
+}
+
+/** Value at rank `k` of the sorted values */
+auto RadixSelect(const std::uint16_t* v, std::size_t n, std::size_t k)
+    -> std::uint16_t
+{
+    Histogram high{};
+    for (std::size_t i = 0; i < n; i++) {
+        high[v[i] >> 8]++;
+    }
+    auto hi = FindBin(high, k);
+
+    Histogram low{};
+    for (std::size_t i = 0; i < n; i++) {
+        if ((v[i] >> 8) == hi) {
+            low[v[i] & 0xFF]++;
+        }
+    }
+    auto lo = FindBin(low, k);
+    return static_cast<std::uint16_t>((hi << 8) | lo);
+}
+
+/** Sum of the `r` smallest values, given the high byte histogram and sums */
+auto PrefixSum(
+    const std::uint16_t* v,
+    std::size_t n,
+    const Histogram& high,
+    const BinSums& highSums,
+    std::size_t r) -> std::uint64_t
+{
+    // Whole high bins below the bin containing rank r
+    std::uint64_t sum{0};
+    std::size_t hi{0};
+    while (hi < high.size() and r >= high[hi]) {
+        r -= high[hi];
+        sum += highSums[hi];
+        hi++;
+    }
+    if (r == 0) {
+        return sum;
+    }
+
+    // The r smallest values of the partial bin
+    Histogram low{};
+    for (std::size_t i = 0; i < n; i++) {
+        if ((v[i] >> 8) == hi) {
+            low[v[i] & 0xFF]++;
+        }
+    }
+    for (std::size_t lo = 0; r > 0; lo++) {
+        auto count = std::min<std::size_t>(r, low[lo]);
+        sum += count * ((hi << 8) | lo);
+        r -= count;
+    }
+    return sum;
+}
+
+/** Sum of the values at ranks [first, last) of the sorted values */
+auto RankRangeSum(
+    const std::uint16_t* v, std::size_t n, std::size_t first, std::size_t last)
+    -> std::uint64_t
+{
+    Histogram high{};
+    BinSums highSums{};
+    for (std::size_t i = 0; i < n; i++) {
+        high[v[i] >> 8]++;
+        highSums[v[i] >> 8] += v[i];
+    }
+    return PrefixSum(v, n, high, highSums, last) -
+           PrefixSum(v, n, high, highSums, first);
+}
+}  // namespace
+
+auto texturing::CompositeMinimum(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t
+{
+    if (n == 0) {
+        return 0;
+    }
+    auto result = values[0];
+    for (std::size_t i = 1; i < n; i++) {
+        result = std::min(result, values[i]);
+    }
+    return result;
+}
+
+auto texturing::CompositeMaximum(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t
+{
+    if (n == 0) {
+        return 0;
+    }
+    auto result = values[0];
+    for (std::size_t i = 1; i < n; i++) {
+        result = std::max(result, values[i]);
+    }
+    return result;
+}
+
+auto texturing::CompositeMean(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t
+{
+    if (n == 0) {
+        return 0;
+    }
+    std::uint64_t sum{0};
+    for (std::size_t i = 0; i < n; i++) {
+        sum += values[i];
+    }
+    return static_cast<std::uint16_t>(
+        std::round(static_cast<double>(sum) / static_cast<double>(n)));
+}
+
+auto texturing::CompositeMedian(const std::uint16_t* values, std::size_t n)
+    -> std::uint16_t
+{
+    if (n == 0) {
+        return 0;
+    }
+    if (n <= SMALL_BUFFER_SIZE) {
+        std::array<std::uint16_t, SMALL_BUFFER_SIZE> copy;
+        std::copy(values, values + n, copy.begin());
+        std::nth_element(copy.begin(), copy.begin() + n / 2, copy.begin() + n);
+        return copy[n / 2];
+    }
+    return RadixSelect(values, n, n / 2);
+}
+
+auto texturing::CompositeMedianAverage(
+    const std::uint16_t* values, std::size_t n, double range) -> std::uint16_t
+{
+    // If the range is 1.0, it's just a normal mean operation
+    if (AlmostEqual<double>(range, 1.0)) {
+        return CompositeMean(values, n);
+    } else if (AlmostEqual<double>(range, 0.0) or n == 0) {
+        return 0;
+    }
+
+    // The number of things we're going to sum
+    auto count = std::min(n, static_cast<std::size_t>(std::ceil(n * range)));
+    // The number of things before we start summing
+    auto offset = static_cast<std::size_t>(std::floor((n - count) / 2.0));
+
+    // Sum
+    std::uint64_t sum{0};
+    if (n <= SMALL_BUFFER_SIZE) {
+        std::array<std::uint16_t, SMALL_BUFFER_SIZE> copy;
+        std::copy(values, values + n, copy.begin());
+        std::sort(copy.begin(), copy.begin() + n);
+        for (auto i = offset; i < offset + count; i++) {
+            sum += copy[i];
+        }
+    } else {
+        sum = RankRangeSum(values, n, offset, offset + count);
+    }
+
+    // Average
+    return static_cast<std::uint16_t>(
+        std::round(static_cast<double>(sum) / static_cast<double>(count)));
+}
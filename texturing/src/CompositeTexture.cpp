@@ -2,7 +2,8 @@
 
 #include <algorithm>
 
-#include "vc/core/util/FloatComparison.hpp"
+#include "vc/core/util/Trace.hpp"
+#include "vc/texturing/CompositeFilters.hpp"
 
 static constexpr double MEDIAN_MEAN_PERCENT_RANGE = 0.70;
 
@@ -13,17 +14,9 @@ using Texture = CompositeTexture::Texture;
 
 Texture CompositeTexture::compute()
 {
-    if (gen_->dim() < 1) {
-        throw std::runtime_error("Generator dimension below required");
-    }
-
+    trace::Span span("CompositeTexture::compute", "texturing");
     // Setup
-    result_.clear();
-    auto height = static_cast<int>(ppm_->height());
-    auto width = static_cast<int>(ppm_->width());
-
-    // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_16UC1);
+    reduceStarted(ppm_, vol_, gen_);
 
     // Get the mappings
     auto mappings = ppm_->getMappings();
@@ -41,89 +34,57 @@ Texture CompositeTexture::compute()
         progressUpdated(counter++);
 
         // Generate the neighborhood
-        auto neighborhood = get_neighborhood_(pixel.pos, pixel.normal);
-
-        // Assign the intensity value at the UV position
-        image.at<uint16_t>(
-            static_cast<int>(pixel.y), static_cast<int>(pixel.x)) =
-            filter_neighborhood_(neighborhood);
+        reduce(pixel, gen_->compute(vol_, pixel.pos, {pixel.normal}));
     }
     progressComplete();
 
-    // Set output
-    result_.push_back(image);
-
-    return result_;
+    return reduceComplete();
 }
 
-uint16_t CompositeTexture::filter_neighborhood_(const Neighborhood& n)
+void CompositeTexture::reduceStarted(
+    const PerPixelMap::Pointer& ppm,
+    const Volume::Pointer& vol,
+    const NeighborhoodGenerator::Pointer& gen)
 {
-    switch (filter_) {
-        case Filter::Minimum:
-            return min_(n);
-        case Filter::Maximum:
-            return max_(n);
-        case Filter::Median:
-            return median_(n);
-        case Filter::Mean:
-            return mean_(n);
-        case Filter::MedianAverage:
-            return median_mean_(n, MEDIAN_MEAN_PERCENT_RANGE);
+    if (gen->dim() < 1) {
+        throw std::runtime_error("Generator dimension below required");
     }
-}
 
-uint16_t CompositeTexture::min_(Neighborhood n)
-{
-    return *std::min_element(n.begin(), n.end());
-}
+    // Setup
+    ppm_ = ppm;
+    vol_ = vol;
+    result_.clear();
+    auto height = static_cast<int>(ppm_->height());
+    auto width = static_cast<int>(ppm_->width());
 
-uint16_t CompositeTexture::max_(Neighborhood n)
-{
-    return *std::max_element(n.begin(), n.end());
+    // Output image
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
 }
 
-uint16_t CompositeTexture::median_(Neighborhood n)
+void CompositeTexture::reduce(
+    const PerPixelMap::PixelMap& pixel, const Neighborhood& n)
 {
-    std::nth_element(n.begin(), n.begin() + n.size() / 2, n.end());
-    return n(n.size() / 2);
+    // Assign the intensity value at the UV position
+    result_[0].at<uint16_t>(
+        static_cast<int>(pixel.y), static_cast<int>(pixel.x)) =
+        filter_neighborhood_(n);
 }
 
-uint16_t CompositeTexture::mean_(Neighborhood n)
-{
-    auto sum = std::accumulate(std::begin(n), std::end(n), double{0});
-    return static_cast<uint16_t>(std::round(sum / n.size()));
-}
+auto CompositeTexture::reduceComplete() -> Texture { return result_; }
 
-uint16_t CompositeTexture::median_mean_(Neighborhood n, double range)
+uint16_t CompositeTexture::filter_neighborhood_(const Neighborhood& n)
 {
-    // If the range is 1.0, it's just a normal mean operation
-    if (AlmostEqual<double>(range, 1.0)) {
-        return mean_(n);
-    } else if (AlmostEqual<double>(range, 0.0)) {
-        return 0;
+    switch (filter_) {
+        case Filter::Minimum:
+            return CompositeMinimum(n.data(), n.size());
+        case Filter::Maximum:
+            return CompositeMaximum(n.data(), n.size());
+        case Filter::Median:
+            return CompositeMedian(n.data(), n.size());
+        case Filter::Mean:
+            return CompositeMean(n.data(), n.size());
+        case Filter::MedianAverage:
+            return CompositeMedianAverage(
+                n.data(), n.size(), MEDIAN_MEAN_PERCENT_RANGE);
     }
-
-    // Sort
-    std::sort(n.begin(), n.end());
-
-    // The number of things we're going to sum
-    auto count = static_cast<size_t>(std::ceil(n.size() * range));
-    // The number of things before we start summing
-    auto offset = static_cast<size_t>(std::floor((n.size() - count) / 2.0));
-
-    // Sum
-    auto sum = std::accumulate(
-        n.begin() + offset, n.begin() + offset + count, double{0});
-
-    // Average
-    return static_cast<uint16_t>(std::round(sum / count));
 }
-
-Neighborhood CompositeTexture::get_neighborhood_(
-    const cv::Vec3d& p, const cv::Vec3d& n)
-{
-    auto neighborhood = gen_->compute(vol_, p, {n});
-    Neighborhood::Flatten(neighborhood, 1);
-
-    return neighborhood;
-}
\ No newline at end of file
@@ -30,15 +30,14 @@ UVMap::Pointer FlatteningAlgorithm::getUVMap()
     uvMap->ratio(aspectWidth * scale, aspectHeight * scale);
 
     // Calculate uv coordinates
-    cv::Vec2d uv;
+    std::vector<cv::Vec2d> uvs(output_->GetNumberOfPoints());
     for (auto it = output_->GetPoints()->Begin();
          it != output_->GetPoints()->End(); ++it) {
+        auto& uv = uvs[it->Index()];
         uv[0] = (it->Value()[0] - uMin) / (uMax - uMin);
         uv[1] = (it->Value()[2] - vMin) / (vMax - vMin);
-
-        // Add the uv coordinates into our map at the point index specified
-        uvMap->set(it->Index(), uv);
     }
+    uvMap->setAll(uvs);
 
     return uvMap;
 }
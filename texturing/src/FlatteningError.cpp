@@ -5,31 +5,19 @@
 #include <opencv2/imgproc.hpp>
 
 #include "vc/core/types/Color.hpp"
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/util/ApplyLUT.hpp"
 #include "vc/core/util/FloatComparison.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MeshMath.hpp"
+#include "vc/core/util/Parallel.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
 namespace vct = volcart::texturing;
 
-std::vector<cv::Vec3d> GetCellVertices(
-    const ITKMesh::Pointer& mesh,
-    const ITKCell::PointIdentifierContainerType& ids)
-{
-
-    // Output vector
-    std::vector<cv::Vec3d> pts;
-
-    // For each id, add a new vec3d
-    for (const auto& id : ids) {
-        auto p = mesh->GetPoint(id);
-        pts.emplace_back(p[0], p[1], p[2]);
-    }
-
-    return pts;
-}
+/** Number of faces handed to a worker thread at a time */
+static constexpr std::size_t GRAIN_SIZE{1024};
 
 static std::tuple<double, double, double, double, double> CalculateGammas(
     const cv::Vec3d& p1,
@@ -96,39 +84,55 @@ LStretchMetrics vct::LStretch(
             "Original and flattened meshes have mismatched number of vertices");
     }
 
-    // Iterate over the faces
-    auto cell = mesh3D->GetCells()->Begin();
-    auto end = mesh3D->GetCells()->End();
+    // Copy the vertices and faces into flat arrays. Both meshes share point
+    // IDs, so their vertices are in the same order.
+    auto flat3D = FromITKMesh(mesh3D);
+    auto flat2D = FromITKMesh(mesh2D);
+    const auto& verts3D = flat3D->vertices();
+    const auto& verts2D = flat2D->vertices();
+    const auto& faces = flat3D->faces();
 
-    // Calculate metrics
+    // Calculate the per-face metrics
     LStretchMetrics metrics;
+    metrics.faceL2.resize(faces.size());
+    metrics.faceLInf.resize(faces.size());
+    std::vector<double> faceArea3D(faces.size());
+    ParallelFor(
+        faces.size(),
+        [&](auto f) {
+            // Get the vertices
+            const auto& [i0, i1, i2] = faces[f];
+            const auto& q0 = verts3D[i0];
+            const auto& q1 = verts3D[i1];
+            const auto& q2 = verts3D[i2];
+
+            // Calculate LStretch(T) for this face
+            const auto& [l2, lInf] =
+                TriLStretch(verts2D[i0], verts2D[i1], verts2D[i2], q0, q1, q2);
+            metrics.faceL2[f] = l2;
+            metrics.faceLInf[f] = lInf;
+
+            // A'(T)
+            auto a = cv::norm(q1 - q0);
+            auto b = cv::norm(q2 - q0);
+            auto c = cv::norm(q2 - q1);
+            faceArea3D[f] = meshmath::TriangleArea(a, b, c);
+        },
+        0, GRAIN_SIZE);
+
+    // Reduce in face order so the sums do not depend on the thread count
     double sumL2{0};
     double area3DTotal{0};
-    for (; cell != end; ++cell) {
-        // Get the vertices
-        auto vIds = cell.Value()->GetPointIdsContainer();
-        auto p = GetCellVertices(mesh2D, vIds);
-        auto q = GetCellVertices(mesh3D, vIds);
-
-        // Calculate LStretch(T) for this face
-        const auto& [l2, lInf] =
-            TriLStretch(p[0], p[1], p[2], q[0], q[1], q[2]);
-        metrics.faceL2.push_back(l2);
-        metrics.faceLInf.push_back(lInf);
+    for (std::size_t f = 0; f < faces.size(); f++) {
+        const auto& l2 = metrics.faceL2[f];
 
         // Update global LInf
-        metrics.lInf = std::max(metrics.lInf, lInf);
-
-        // A'(T)
-        auto a = cv::norm(q[1] - q[0]);
-        auto b = cv::norm(q[2] - q[0]);
-        auto c = cv::norm(q[2] - q[1]);
-        auto area3D = meshmath::TriangleArea(a, b, c);
+        metrics.lInf = std::max(metrics.lInf, metrics.faceLInf[f]);
 
         // sum L2Stretch(T)^2 * A'(T)
-        sumL2 += l2 * l2 * area3D;
+        sumL2 += l2 * l2 * faceArea3D[f];
         // sum A'(T)
-        area3DTotal += area3D;
+        area3DTotal += faceArea3D[f];
     }
 
     // Calculate global L2
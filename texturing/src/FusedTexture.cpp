@@ -0,0 +1,88 @@
+#include "vc/texturing/FusedTexture.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "vc/core/util/Trace.hpp"
+
+using namespace volcart;
+using namespace volcart::texturing;
+
+using Texture = FusedTexture::Texture;
+
+auto FusedTexture::New() -> Pointer { return std::make_shared<FusedTexture>(); }
+
+void FusedTexture::setGenerator(NeighborhoodGenerator::Pointer g)
+{
+    gen_ = std::move(g);
+}
+
+auto FusedTexture::getGenerator() const -> NeighborhoodGenerator::Pointer
+{
+    return gen_;
+}
+
+void FusedTexture::addReducer(NeighborhoodReducer::Pointer r)
+{
+    reducers_.emplace_back(std::move(r));
+}
+
+auto FusedTexture::reducers() const
+    -> const std::vector<NeighborhoodReducer::Pointer>&
+{
+    return reducers_;
+}
+
+void FusedTexture::clearReducers() { reducers_.clear(); }
+
+auto FusedTexture::reducerTextures() const -> std::vector<Texture>
+{
+    return reducerResults_;
+}
+
+auto FusedTexture::compute() -> Texture
+{
+    trace::Span span("FusedTexture::compute", "texturing");
+    if (not ppm_ or not vol_ or not gen_ or reducers_.empty()) {
+        throw std::invalid_argument("Invalid input parameters");
+    }
+
+    // Setup
+    result_.clear();
+    reducerResults_.clear();
+    for (const auto& r : reducers_) {
+        r->reduceStarted(ppm_, vol_, gen_);
+    }
+
+    // Get the mappings
+    auto mappings = ppm_->getMappings();
+
+    // Sort the mappings by Z-value
+    std::sort(
+        mappings.begin(), mappings.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.pos[2] < rhs.pos[2];
+        });
+
+    // Iterate through the mappings
+    size_t counter = 0;
+    progressStarted();
+    for (const auto& pixel : mappings) {
+        progressUpdated(counter++);
+
+        // Sample the neighborhood once for all reducers
+        auto neighborhood = gen_->compute(vol_, pixel.pos, {pixel.normal});
+        for (const auto& r : reducers_) {
+            r->reduce(pixel, neighborhood);
+        }
+    }
+    progressComplete();
+
+    // Collect the outputs
+    for (const auto& r : reducers_) {
+        auto texture = r->reduceComplete();
+        result_.insert(result_.end(), texture.begin(), texture.end());
+        reducerResults_.emplace_back(std::move(texture));
+    }
+
+    return result_;
+}
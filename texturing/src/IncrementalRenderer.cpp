@@ -0,0 +1,335 @@
+#include "vc/texturing/IncrementalRenderer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "vc/core/util/Parallel.hpp"
+
+using namespace volcart;
+using namespace volcart::texturing;
+
+void IncrementalRenderer::setPreviousPerPixelMap(PerPixelMap::Pointer ppm)
+{
+    prevPPM_ = std::move(ppm);
+}
+
+void IncrementalRenderer::setPreviousTexture(
+    TexturingAlgorithm::Texture texture)
+{
+    prevTexture_ = std::move(texture);
+}
+
+void IncrementalRenderer::setPreviousMesh(ITKMesh::Pointer mesh)
+{
+    prevMesh_ = std::move(mesh);
+}
+
+void IncrementalRenderer::setPerPixelMap(PerPixelMap::Pointer ppm)
+{
+    ppm_ = std::move(ppm);
+    ppmGen_ = nullptr;
+}
+
+void IncrementalRenderer::setPPMGenerator(std::shared_ptr<PPMGenerator> gen)
+{
+    ppmGen_ = std::move(gen);
+    ppm_ = nullptr;
+}
+
+void IncrementalRenderer::setTileFunction(TileFunction fn)
+{
+    tileFn_ = std::move(fn);
+}
+
+void IncrementalRenderer::setTileSize(std::uint32_t size) { tileSize_ = size; }
+
+void IncrementalRenderer::setTolerance(double t) { tolerance_ = t; }
+
+void IncrementalRenderer::setNumThreads(std::size_t n) { numThreads_ = n; }
+
+auto IncrementalRenderer::width() const -> std::size_t
+{
+    if (ppmGen_) {
+        return ppmGen_->width();
+    }
+    return ppm_ ? ppm_->width() : 0;
+}
+
+auto IncrementalRenderer::height() const -> std::size_t
+{
+    if (ppmGen_) {
+        return ppmGen_->height();
+    }
+    return ppm_ ? ppm_->height() : 0;
+}
+
+auto IncrementalRenderer::progressIterations() const -> std::size_t
+{
+    return numDirty_;
+}
+
+auto IncrementalRenderer::can_reuse_() const -> bool
+{
+    if (prevPPM_->width() != width() or prevPPM_->height() != height() or
+        prevTexture_.empty()) {
+        return false;
+    }
+    cv::Size size{static_cast<int>(width()), static_cast<int>(height())};
+    for (const auto& img : prevTexture_) {
+        if (img.size() != size) {
+            return false;
+        }
+    }
+    return true;
+}
+
+auto IncrementalRenderer::moved_faces_() const -> std::vector<bool>
+{
+    auto mesh = ppmGen_->getInputMesh();
+    if (not prevMesh_ or not mesh or
+        prevMesh_->GetNumberOfPoints() != mesh->GetNumberOfPoints() or
+        prevMesh_->GetNumberOfCells() != mesh->GetNumberOfCells()) {
+        return {};
+    }
+
+    // Find the vertices which moved or whose normal changed
+    std::vector<bool> movedPts(mesh->GetNumberOfPoints(), false);
+    for (auto pt = mesh->GetPoints()->Begin(); pt != mesh->GetPoints()->End();
+         ++pt) {
+        auto prevPt = prevMesh_->GetPoint(pt.Index());
+        ITKPixel normal;
+        ITKPixel prevNormal;
+        auto normalChanged =
+            mesh->GetPointData(pt.Index(), &normal) and
+            prevMesh_->GetPointData(pt.Index(), &prevNormal) and
+            (normal - prevNormal).GetNorm() > tolerance_;
+        movedPts[pt.Index()] =
+            pt.Value().EuclideanDistanceTo(prevPt) > tolerance_ or
+            normalChanged;
+    }
+
+    // Find the faces with a moved vertex. Faces whose vertex IDs changed are
+    // also marked as moved.
+    std::vector<bool> moved(mesh->GetNumberOfCells(), false);
+    auto prevCell = prevMesh_->GetCells()->Begin();
+    for (auto cell = mesh->GetCells()->Begin();
+         cell != mesh->GetCells()->End(); ++cell, ++prevCell) {
+        const auto* c = cell.Value();
+        const auto* prev = prevCell.Value();
+        if (c->GetNumberOfPoints() != prev->GetNumberOfPoints()) {
+            moved[cell.Index()] = true;
+            continue;
+        }
+        auto prevId = prev->PointIdsBegin();
+        for (auto id = c->PointIdsBegin(); id != c->PointIdsEnd();
+             ++id, ++prevId) {
+            if (*id != *prevId or movedPts[*id]) {
+                moved[cell.Index()] = true;
+                break;
+            }
+        }
+    }
+
+    // Smooth shading interpolates vertex normals, which change on every face
+    // adjacent to a moved face
+    if (ppmGen_->shading() == PPMGenerator::Shading::Smooth) {
+        std::vector<bool> changedNormals(mesh->GetNumberOfPoints(), false);
+        for (auto cell = mesh->GetCells()->Begin();
+             cell != mesh->GetCells()->End(); ++cell) {
+            if (not moved[cell.Index()]) {
+                continue;
+            }
+            const auto* c = cell.Value();
+            for (auto id = c->PointIdsBegin(); id != c->PointIdsEnd(); ++id) {
+                changedNormals[*id] = true;
+            }
+        }
+        for (auto cell = mesh->GetCells()->Begin();
+             cell != mesh->GetCells()->End(); ++cell) {
+            const auto* c = cell.Value();
+            for (auto id = c->PointIdsBegin(); id != c->PointIdsEnd(); ++id) {
+                if (changedNormals[*id]) {
+                    moved[cell.Index()] = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    return moved;
+}
+
+auto IncrementalRenderer::tile_changed_(
+    const cv::Rect& region, const std::vector<bool>& movedFaces) const -> bool
+{
+    auto y0 = static_cast<std::size_t>(region.y);
+    auto x0 = static_cast<std::size_t>(region.x);
+    auto y1 = y0 + static_cast<std::size_t>(region.height);
+    auto x1 = x0 + static_cast<std::size_t>(region.width);
+
+    // Compare the PPM mappings
+    if (ppm_) {
+        for (auto y = y0; y < y1; y++) {
+            for (auto x = x0; x < x1; x++) {
+                auto mapped = ppm_->hasMapping(y, x);
+                if (mapped != prevPPM_->hasMapping(y, x)) {
+                    return true;
+                }
+                if (not mapped) {
+                    continue;
+                }
+                const auto& a = ppm_->getMapping(y, x);
+                const auto& b = prevPPM_->getMapping(y, x);
+                for (int i = 0; i < 6; i++) {
+                    if (std::abs(a[i] - b[i]) > tolerance_) {
+                        return true;
+                    }
+                }
+            }
+        }
+        return false;
+    }
+
+    // Check the faces assigned to each pixel
+    auto cellMap = prevPPM_->cellMap();
+    for (auto y = y0; y < y1; y++) {
+        const auto* cells = cellMap.ptr<std::int32_t>(static_cast<int>(y));
+        for (auto x = x0; x < x1; x++) {
+            auto cell = cells[x];
+            if (cell < 0) {
+                continue;
+            }
+            if (static_cast<std::size_t>(cell) >= movedFaces.size() or
+                movedFaces[static_cast<std::size_t>(cell)]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+auto IncrementalRenderer::tile_ppm_(const cv::Rect& region) const
+    -> PerPixelMap::Pointer
+{
+    if (ppmGen_) {
+        return ppmGen_->compute(region);
+    }
+    return PerPixelMap::New(ppm_->crop(region));
+}
+
+auto IncrementalRenderer::dirtyTiles() const -> std::vector<cv::Rect>
+{
+    // Validate the inputs
+    if (not prevPPM_ or (not ppm_ and not ppmGen_) or width() == 0 or
+        height() == 0) {
+        throw std::invalid_argument("Invalid input parameters");
+    }
+    if (tileSize_ == 0) {
+        throw std::invalid_argument("Tile size must be greater than 0");
+    }
+
+    // Split the output into tiles
+    auto w = static_cast<std::uint32_t>(width());
+    auto h = static_cast<std::uint32_t>(height());
+    std::vector<cv::Rect> tiles;
+    for (std::uint32_t y = 0; y < h; y += tileSize_) {
+        for (std::uint32_t x = 0; x < w; x += tileSize_) {
+            tiles.emplace_back(
+                static_cast<int>(x), static_cast<int>(y),
+                static_cast<int>(std::min(tileSize_, w - x)),
+                static_cast<int>(std::min(tileSize_, h - y)));
+        }
+    }
+
+    // Everything is dirty if the previous render can't be reused
+    if (not can_reuse_()) {
+        return tiles;
+    }
+    std::vector<bool> movedFaces;
+    if (ppmGen_) {
+        movedFaces = moved_faces_();
+        if (movedFaces.empty() or prevPPM_->cellMap().empty()) {
+            return tiles;
+        }
+    }
+
+    // Check each tile
+    std::vector<std::uint8_t> dirty(tiles.size(), 0);
+    ParallelFor(
+        tiles.size(),
+        [&](auto i) { dirty[i] = tile_changed_(tiles[i], movedFaces) ? 1 : 0; },
+        numThreads_);
+
+    std::vector<cv::Rect> result;
+    for (std::size_t i = 0; i < tiles.size(); i++) {
+        if (dirty[i] != 0) {
+            result.push_back(tiles[i]);
+        }
+    }
+    return result;
+}
+
+auto IncrementalRenderer::compute() -> TexturingAlgorithm::Texture
+{
+    if (not tileFn_) {
+        throw std::invalid_argument("Invalid input parameters");
+    }
+    auto tiles = dirtyTiles();
+
+    // Update the previous texture in place, or allocate a new texture once the
+    // first tile reports its image count and type
+    auto reuse = can_reuse_();
+    auto texture = reuse ? prevTexture_ : TexturingAlgorithm::Texture{};
+    auto rows = static_cast<int>(height());
+    auto cols = static_cast<int>(width());
+    std::mutex textureMutex;
+    auto allocate = [&](const TexturingAlgorithm::Texture& tile) {
+        std::unique_lock<std::mutex> lock(textureMutex);
+        if (not texture.empty()) {
+            return;
+        }
+        if (tile.empty()) {
+            throw std::runtime_error("Texturing function returned no images");
+        }
+        for (const auto& img : tile) {
+            texture.emplace_back(cv::Mat::zeros(rows, cols, img.type()));
+        }
+    };
+
+    // Re-texture each dirty tile
+    numDirty_ = tiles.size();
+    std::mutex progressMutex;
+    std::size_t finished{0};
+    progressStarted();
+    ParallelFor(
+        tiles.size(),
+        [&](auto t) {
+            const auto& region = tiles[t];
+            auto result = tileFn_(tile_ppm_(region));
+            if (not reuse) {
+                allocate(result);
+            }
+            if (result.size() != texture.size()) {
+                throw std::runtime_error(
+                    "Tile returned an inconsistent number of images");
+            }
+            for (std::size_t i = 0; i < result.size(); i++) {
+                if (result[i].type() != texture[i].type() or
+                    result[i].size() != region.size()) {
+                    throw std::runtime_error(
+                        "Tile returned an image of the wrong size or type");
+                }
+                result[i].copyTo(texture[i](region));
+            }
+
+            std::unique_lock<std::mutex> lock(progressMutex);
+            progressUpdated(finished++);
+        },
+        numThreads_);
+    progressComplete();
+
+    return texture;
+}
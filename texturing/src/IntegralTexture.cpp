@@ -6,6 +6,8 @@
 
 #include <opencv2/core.hpp>
 
+#include "vc/core/util/Trace.hpp"
+
 using namespace volcart;
 using namespace volcart::texturing;
 
@@ -13,17 +15,9 @@ using Texture = IntegralTexture::Texture;
 
 auto IntegralTexture::compute() -> Texture
 {
+    trace::Span span("IntegralTexture::compute", "texturing");
     // Setup
-    result_.clear();
-
-    auto height = static_cast<int>(ppm_->height());
-    auto width = static_cast<int>(ppm_->width());
-
-    // Setup the weights
-    setup_weights_();
-
-    // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_32FC1);
+    reduceStarted(ppm_, vol_, gen_);
 
     // Get the mappings
     auto mappings = ppm_->getMappings();
@@ -41,46 +35,70 @@ auto IntegralTexture::compute() -> Texture
         progressUpdated(counter++);
 
         // Generate the neighborhood
-        auto n = gen_->compute(vol_, pixel.pos, {pixel.normal});
+        reduce(pixel, gen_->compute(vol_, pixel.pos, {pixel.normal}));
+    }
+    progressComplete();
 
-        // Clamp values
-        if (clampToMax_) {
-            std::replace_if(
-                n.begin(), n.end(),
-                [this](uint16_t v) { return v > clampMax_; }, clampMax_);
-        }
+    return reduceComplete();
+}
+
+void IntegralTexture::reduceStarted(
+    const PerPixelMap::Pointer& ppm,
+    const Volume::Pointer& vol,
+    const NeighborhoodGenerator::Pointer& gen)
+{
+    // Setup
+    ppm_ = ppm;
+    vol_ = vol;
+    result_.clear();
+
+    auto height = static_cast<int>(ppm_->height());
+    auto width = static_cast<int>(ppm_->width());
 
-        // Convert to double and weight the neighborhood
-        NDArray<double> neighborhoodD(
-            n.dims(), n.extents(), n.begin(), n.end());
-        auto weighted = apply_weights_(neighborhoodD);
+    // Setup the weights
+    setup_weights_(*gen);
 
-        // Sum the neighborhood
-        auto value = std::accumulate(weighted.begin(), weighted.end(), 0.0);
+    // Output image
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_32FC1));
+}
 
-        // Assign the intensity value at the UV position
-        auto x = static_cast<int>(pixel.x);
-        auto y = static_cast<int>(pixel.y);
-        image.at<float>(y, x) = static_cast<float>(value);
+void IntegralTexture::reduce(
+    const PerPixelMap::PixelMap& pixel, const Neighborhood& n)
+{
+    // Convert to double and weight the neighborhood
+    NDArray<double> neighborhoodD(n.dims(), n.extents(), n.begin(), n.end());
+
+    // Clamp values
+    if (clampToMax_) {
+        std::replace_if(
+            neighborhoodD.begin(), neighborhoodD.end(),
+            [this](double v) { return v > clampMax_; }, clampMax_);
     }
-    progressComplete();
+    auto weighted = apply_weights_(neighborhoodD);
 
-    cv::normalize(image, image, 0.0, 1.0, cv::NORM_MINMAX);
+    // Sum the neighborhood
+    auto value = std::accumulate(weighted.begin(), weighted.end(), 0.0);
 
-    // Set output
-    result_.push_back(image);
+    // Assign the intensity value at the UV position
+    auto x = static_cast<int>(pixel.x);
+    auto y = static_cast<int>(pixel.y);
+    result_[0].at<float>(y, x) = static_cast<float>(value);
+}
 
+auto IntegralTexture::reduceComplete() -> Texture
+{
+    cv::normalize(result_[0], result_[0], 0.0, 1.0, cv::NORM_MINMAX);
     return result_;
 }
 
 ///// Setup and Apply weights generally /////
-void IntegralTexture::setup_weights_()
+void IntegralTexture::setup_weights_(const NeighborhoodGenerator& gen)
 {
     switch (weight_) {
         case WeightMethod::None:
             return;
         case WeightMethod::Linear:
-            return setup_linear_weights_();
+            return setup_linear_weights_(gen);
         case WeightMethod::ExpoDiff:
             return setup_expodiff_weights_();
     }
@@ -99,11 +117,11 @@ auto IntegralTexture::apply_weights_(NDArray<double>& n) -> NDArray<double>
 }
 
 ///// Linear weighting /////
-void IntegralTexture::setup_linear_weights_()
+void IntegralTexture::setup_linear_weights_(const NeighborhoodGenerator& gen)
 {
     // Neighborhood size
-    auto extents = gen_->extents();
-    linearWeights_ = NDArray<double>(gen_->dim(), extents);
+    auto extents = gen.extents();
+    linearWeights_ = NDArray<double>(gen.dim(), extents);
 
     // Linear Weighted Sum Setup
     double weight;
@@ -232,6 +250,11 @@ void IntegralTexture::setGenerator(NeighborhoodGenerator::Pointer g)
     gen_ = std::move(g);
 }
 
+auto IntegralTexture::getGenerator() const -> NeighborhoodGenerator::Pointer
+{
+    return gen_;
+}
+
 void IntegralTexture::setClampValuesToMax(bool b) { clampToMax_ = b; }
 
 auto IntegralTexture::clampValuesToMax() const -> bool { return clampToMax_; }
@@ -2,6 +2,8 @@
 
 #include <algorithm>
 
+#include "vc/core/util/Trace.hpp"
+
 using namespace volcart;
 using namespace volcart::texturing;
 
@@ -9,13 +11,9 @@ using Texture = IntersectionTexture::Texture;
 
 Texture IntersectionTexture::compute()
 {
+    trace::Span span("IntersectionTexture::compute", "texturing");
     // Setup
-    result_.clear();
-    auto height = static_cast<int>(ppm_->height());
-    auto width = static_cast<int>(ppm_->width());
-
-    // Output image
-    cv::Mat image = cv::Mat::zeros(height, width, CV_16UC1);
+    reduceStarted(ppm_, vol_, nullptr);
 
     // Get the mappings
     auto mappings = ppm_->getMappings();
@@ -31,16 +29,36 @@ Texture IntersectionTexture::compute()
     progressStarted();
     for (const auto& pixel : mappings) {
         progressUpdated(counter++);
-
-        // Assign the intensity value at the XY position
-        image.at<uint16_t>(
-            static_cast<int>(pixel.y), static_cast<int>(pixel.x)) =
-            vol_->interpolateAt(pixel.pos);
+        reduce(pixel, Neighborhood(1));
     }
     progressComplete();
 
-    // Set output
-    result_.push_back(image);
+    return reduceComplete();
+}
+
+void IntersectionTexture::reduceStarted(
+    const PerPixelMap::Pointer& ppm,
+    const Volume::Pointer& vol,
+    const NeighborhoodGenerator::Pointer& /*gen*/)
+{
+    // Setup
+    ppm_ = ppm;
+    vol_ = vol;
+    result_.clear();
+    auto height = static_cast<int>(ppm_->height());
+    auto width = static_cast<int>(ppm_->width());
+
+    // Output image
+    result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
+}
+
+void IntersectionTexture::reduce(
+    const PerPixelMap::PixelMap& pixel, const Neighborhood& /*n*/)
+{
+    // Assign the intensity value at the XY position
+    result_[0].at<uint16_t>(
+        static_cast<int>(pixel.y), static_cast<int>(pixel.x)) =
+        vol_->interpolateAt(pixel.pos);
+}
 
-    return result_;
-}
\ No newline at end of file
+auto IntersectionTexture::reduceComplete() -> Texture { return result_; }
@@ -1,6 +1,12 @@
 #include "vc/texturing/LayerTexture.hpp"
+
+#include <stdexcept>
+
 #include <opencv2/core.hpp>
 
+#include "vc/core/util/Logging.hpp"
+#include "vc/core/util/Trace.hpp"
+
 using namespace volcart;
 using namespace volcart::texturing;
 
@@ -45,39 +51,69 @@ using Texture = LayerTexture::Texture;
 
 Texture LayerTexture::compute()
 {
+    trace::Span span("LayerTexture::compute", "texturing");
     // Setup
-    result_.clear();
-    auto height = static_cast<int>(ppm_->height());
-    auto width = static_cast<int>(ppm_->width());
-    std::cout << "Generating " << gen_->extents()[0] << " layers" << std::endl;
-    // Setup output images
-    for (size_t i = 0; i < gen_->extents()[0]; i++) {
-        result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
-    }
-    std::cout << "Sorting mappings" << std::endl;
+    reduceStarted(ppm_, vol_, gen_);
+    Logger()->debug("Generating {} layers", gen_->extents()[0]);
+
     // Get the sorted mappings
     auto sortedMappings = ppm_->getSortedMappings();
-    std::cout << "Starting texture generation" << std::endl;
+
     // Iterate through the sorted mappings
+    std::size_t badNormals{0};
     for (const auto& mappedPixel : sortedMappings) {
-        const size_t x = mappedPixel.x;
-        const size_t y = mappedPixel.y;
         const cv::Vec6d& pixelData = *(mappedPixel.mapping);
-
-        // Generate the neighborhood
-        auto neighborhood = gen_->compute(vol_, {pixelData[0], pixelData[1], pixelData[2]}, {{pixelData[3], pixelData[4], pixelData[5]}});
+        PerPixelMap::PixelMap pixel(mappedPixel.x, mappedPixel.y, pixelData);
 
         // check if pixel data normal norm is close to 1
-        if (std::abs(cv::norm(cv::Vec3d(pixelData[3], pixelData[4], pixelData[5])) - 1) > 0.01) {
-            std::cout << "Pixel data normal norm is not close to 1" << std::endl;
+        if (std::abs(cv::norm(pixel.normal) - 1) > 0.01) {
+            badNormals++;
         }
 
-        // Assign to the output images
-        size_t it = 0;
-        for (const auto& v : neighborhood) {
-            result_.at(it++).at<uint16_t>(static_cast<int>(y), static_cast<int>(x)) = v;
-        }
+        // Generate the neighborhood
+        reduce(pixel, gen_->compute(vol_, pixel.pos, {pixel.normal}));
+    }
+    if (badNormals > 0) {
+        Logger()->warn(
+            "{} pixels have a surface normal which is not unit length",
+            badNormals);
+    }
+
+    return reduceComplete();
+}
+
+void LayerTexture::reduceStarted(
+    const PerPixelMap::Pointer& ppm,
+    const Volume::Pointer& vol,
+    const NeighborhoodGenerator::Pointer& gen)
+{
+    if (gen->dim() != 1) {
+        throw std::invalid_argument("Layers require a line neighborhood");
+    }
+
+    // Setup
+    ppm_ = ppm;
+    vol_ = vol;
+    result_.clear();
+    auto height = static_cast<int>(ppm_->height());
+    auto width = static_cast<int>(ppm_->width());
+
+    // Setup output images
+    for (size_t i = 0; i < gen->extents()[0]; i++) {
+        result_.emplace_back(cv::Mat::zeros(height, width, CV_16UC1));
+    }
+}
+
+void LayerTexture::reduce(
+    const PerPixelMap::PixelMap& pixel, const Neighborhood& n)
+{
+    // Assign to the output images
+    auto x = static_cast<int>(pixel.x);
+    auto y = static_cast<int>(pixel.y);
+    size_t it = 0;
+    for (const auto& v : n) {
+        result_.at(it++).at<uint16_t>(y, x) = v;
     }
+}
 
-    return result_;
-}
\ No newline at end of file
+auto LayerTexture::reduceComplete() -> Texture { return result_; }
@@ -1,6 +1,9 @@
 #include "vc/texturing/PPMGenerator.hpp"
 
+#include <array>
 #include <exception>
+#include <memory>
+#include <mutex>
 
 #include <bvh/bvh.hpp>
 #include <bvh/primitive_intersectors.hpp>
@@ -13,8 +16,8 @@
 
 #include "vc/core/util/BarycentricCoordinates.hpp"
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Trace.hpp"
 #include "vc/meshing/CalculateNormals.hpp"
-#include "vc/meshing/DeepCopy.hpp"
 
 using namespace volcart;
 using namespace texturing;
@@ -34,9 +37,25 @@ using Traverser = bvh::SingleRayTraverser<Bvh>;
 
 PPMGenerator::PPMGenerator(size_t h, size_t w) : width_{w}, height_{h} {}
 
-void PPMGenerator::setMesh(const ITKMesh::Pointer& m) { inputMesh_ = m; }
+void PPMGenerator::setMesh(const ITKMesh::Pointer& m)
+{
+    inputMesh_ = m;
+    inputTriMesh_ = nullptr;
+    rasterizer_ = nullptr;
+}
 
-void PPMGenerator::setUVMap(const UVMap::Pointer& u) { uvMap_ = u; }
+void PPMGenerator::setMesh(const TriangleMesh::Pointer& m)
+{
+    inputTriMesh_ = m;
+    inputMesh_ = nullptr;
+    rasterizer_ = nullptr;
+}
+
+void PPMGenerator::setUVMap(const UVMap::Pointer& u)
+{
+    uvMap_ = u;
+    rasterizer_ = nullptr;
+}
 
 // Parameters
 void PPMGenerator::setDimensions(size_t h, size_t w)
@@ -45,7 +64,29 @@ void PPMGenerator::setDimensions(size_t h, size_t w)
     width_ = w;
 }
 
-void PPMGenerator::setShading(PPMGenerator::Shading s) { shading_ = s; }
+void PPMGenerator::setShading(PPMGenerator::Shading s)
+{
+    shading_ = s;
+    rasterizer_ = nullptr;
+}
+
+auto PPMGenerator::width() const -> size_t { return width_; }
+
+auto PPMGenerator::height() const -> size_t { return height_; }
+
+auto PPMGenerator::shading() const -> Shading { return shading_; }
+
+auto PPMGenerator::getInputMesh() const -> ITKMesh::Pointer
+{
+    return inputMesh_;
+}
+
+auto PPMGenerator::getInputTriangleMesh() const -> TriangleMesh::Pointer
+{
+    return inputTriMesh_;
+}
+
+auto PPMGenerator::getUVMap() const -> UVMap::Pointer { return uvMap_; }
 
 auto PPMGenerator::getPPM() const -> PerPixelMap::Pointer { return ppm_; }
 
@@ -54,64 +95,158 @@ auto PPMGenerator::progressIterations() const -> size_t
     return width_ * height_;
 }
 
-// Compute
-auto PPMGenerator::compute() -> PerPixelMap::Pointer
+struct PPMGenerator::Rasterizer {
+    /** Working mesh */
+    TriangleMesh::Pointer mesh;
+    /** Vertex UV coordinates */
+    std::vector<cv::Vec2d> uvs;
+    /** UV-space triangles */
+    std::vector<Triangle> triangles;
+    /** Search tree over triangles */
+    Bvh bvh;
+};
+
+void PPMGenerator::clearCache()
+{
+    std::unique_lock<std::mutex> lock(rasterizerMutex_);
+    rasterizer_ = nullptr;
+}
+
+auto PPMGenerator::get_rasterizer_() -> std::shared_ptr<const Rasterizer>
 {
-    if (inputMesh_.IsNull() || inputMesh_->GetNumberOfPoints() == 0 ||
-        inputMesh_->GetNumberOfCells() == 0 || not uvMap_ || uvMap_->empty() ||
-        width_ == 0 || height_ == 0) {
+    std::unique_lock<std::mutex> lock(rasterizerMutex_);
+    if (not rasterizer_) {
+        rasterizer_ = build_rasterizer_();
+    }
+    return rasterizer_;
+}
+
+auto PPMGenerator::build_rasterizer_() const
+    -> std::shared_ptr<const Rasterizer>
+{
+    // Get a flat copy of the input mesh
+    auto r = std::make_shared<Rasterizer>();
+    if (inputTriMesh_) {
+        r->mesh = inputTriMesh_;
+    } else if (inputMesh_.IsNotNull()) {
+        r->mesh = FromITKMesh(inputMesh_);
+    }
+
+    auto hasUVMap = uvMap_ and not uvMap_->empty();
+    if (not r->mesh or r->mesh->empty() || r->mesh->numFaces() == 0 ||
+        (not hasUVMap and not r->mesh->hasUVs())) {
         const auto* msg = "Invalid input parameters";
         throw std::invalid_argument(msg);
     }
 
     // Generate normals
-    if (shading_ == Shading::Smooth &&
-        inputMesh_->GetPointData()->Size() != inputMesh_->GetNumberOfPoints()) {
-        vcm::CalculateNormals normCalc(inputMesh_);
-        workingMesh_ = normCalc.compute();
-    } else {
-        workingMesh_ = inputMesh_;
+    if (shading_ == Shading::Smooth and not r->mesh->hasNormals()) {
+        if (r->mesh == inputTriMesh_) {
+            r->mesh = TriangleMesh::New(*inputTriMesh_);
+        }
+        vcm::CalculateNormals::Compute(*r->mesh);
     }
+    const auto& faces = r->mesh->faces();
 
-    // Setup the output
-    ppm_ = PerPixelMap::New(height_, width_);
-    cv::Mat mask = cv::Mat::zeros(height_, width_, CV_8UC1);
-    cv::Mat cellMap = cv::Mat(height_, width_, CV_32SC1);
-    cellMap = cv::Scalar::all(-1);
+    // UV coordinates. The UV map takes precedence over the mesh's UVs.
+    if (hasUVMap) {
+        r->uvs = uvMap_->getAll();
+        r->uvs.resize(r->mesh->numVertices(), NULL_MAPPING);
+    } else {
+        r->uvs = r->mesh->uvs();
+    }
 
     // Create BVH for mesh
-    std::vector<Triangle> triangles;
-    for (auto cell = workingMesh_->GetCells()->Begin();
-         cell != workingMesh_->GetCells()->End(); ++cell) {
-        // Get the vertex IDs
-        auto a = cell->Value()->GetPointIdsContainer().GetElement(0);
-        auto b = cell->Value()->GetPointIdsContainer().GetElement(1);
-        auto c = cell->Value()->GetPointIdsContainer().GetElement(2);
-
-        auto uvA = uvMap_->get(a);
-        auto uvB = uvMap_->get(b);
-        auto uvC = uvMap_->get(c);
+    r->triangles.reserve(faces.size());
+    for (const auto& f : faces) {
+        const auto& uvA = r->uvs[f[0]];
+        const auto& uvB = r->uvs[f[1]];
+        const auto& uvC = r->uvs[f[2]];
 
         // Add the face to the BVH tree
-        triangles.emplace_back(
+        r->triangles.emplace_back(
             Vector3(uvA[0], uvA[1], 0), Vector3(uvB[0], uvB[1], 0),
             Vector3(uvC[0], uvC[1], 0));
     }
-    Bvh bvh;
-    bvh::SweepSahBuilder<Bvh> builder(bvh);
+    bvh::SweepSahBuilder<Bvh> builder(r->bvh);
     auto [bboxes, centers] = bvh::compute_bounding_boxes_and_centers(
-        triangles.data(), triangles.size());
+        r->triangles.data(), r->triangles.size());
     auto meshBBox =
-        bvh::compute_bounding_boxes_union(bboxes.get(), triangles.size());
-    builder.build(meshBBox, bboxes.get(), centers.get(), triangles.size());
-    Intersector intersector(bvh, triangles.data());
-    Traverser traverser(bvh);
+        bvh::compute_bounding_boxes_union(bboxes.get(), r->triangles.size());
+    builder.build(meshBBox, bboxes.get(), centers.get(), r->triangles.size());
+
+    return r;
+}
+
+// Compute
+auto PPMGenerator::compute() -> PerPixelMap::Pointer
+{
+    trace::Span span("PPMGenerator::compute", "texturing");
+    if (width_ == 0 || height_ == 0) {
+        const auto* msg = "Invalid input parameters";
+        throw std::invalid_argument(msg);
+    }
+
+    // Reuse a search structure built for region requests, but don't keep one
+    // alive after the full PPM has been generated
+    std::shared_ptr<const Rasterizer> r;
+    {
+        std::unique_lock<std::mutex> lock(rasterizerMutex_);
+        r = rasterizer_;
+    }
+    if (not r) {
+        r = build_rasterizer_();
+    }
+    cv::Rect region{0, 0, static_cast<int>(width_), static_cast<int>(height_)};
+    ppm_ = rasterize_(*r, region, true);
+    clearCache();
+    return ppm_;
+}
+
+auto PPMGenerator::compute(const cv::Rect& region) -> PerPixelMap::Pointer
+{
+    cv::Rect full{0, 0, static_cast<int>(width_), static_cast<int>(height_)};
+    if (region.empty() or (region & full) != region) {
+        const auto* msg = "Region is outside of the output dimensions";
+        throw std::invalid_argument(msg);
+    }
+
+    auto r = get_rasterizer_();
+    return rasterize_(*r, region, false);
+}
+
+auto PPMGenerator::rasterize_(
+    const Rasterizer& r, const cv::Rect& region, bool reportProgress)
+    -> PerPixelMap::Pointer
+{
+    const auto& verts = r.mesh->vertices();
+    const auto& normals = r.mesh->normals();
+    const auto& faces = r.mesh->faces();
+    const auto& uvs = r.uvs;
+
+    // Setup the output
+    auto rows = static_cast<std::size_t>(region.height);
+    auto cols = static_cast<std::size_t>(region.width);
+    auto ppm = PerPixelMap::New(rows, cols);
+    cv::Mat mask = cv::Mat::zeros(region.size(), CV_8UC1);
+    cv::Mat cellMap = cv::Mat(region.size(), CV_32SC1);
+    cellMap = cv::Scalar::all(-1);
+
+    Intersector intersector(r.bvh, r.triangles.data());
+    Traverser traverser(r.bvh);
 
     // Iterate over all of the pixels
-    progressStarted();
-    ITKCell::CellAutoPointer cell;
-    for (const auto [y, x] : range2D(height_, width_)) {
-        progressUpdated(y * width_ + x);
+    if (reportProgress) {
+        progressStarted();
+    }
+    for (const auto [py, px] : range2D(rows, cols)) {
+        // Position in the full PPM
+        auto y = py + static_cast<std::size_t>(region.y);
+        auto x = px + static_cast<std::size_t>(region.x);
+        if (reportProgress) {
+            progressUpdated(y * width_ + x);
+        }
+
         // This pixel's uv coordinate
         cv::Vec3d uv{0, 0, 0};
         uv[0] = static_cast<double>(x) / static_cast<double>(width_ - 1);
@@ -126,20 +261,16 @@ auto PPMGenerator::compute() -> PerPixelMap::Pointer
 
         // Cell info
         auto cellId = hit->primitive_index;
-        cell.TakeOwnership(new ITKTriangle);
-        workingMesh_->GetCell(cellId, cell);
-        auto a = cell->GetPointIdsContainer().GetElement(0);
-        auto b = cell->GetPointIdsContainer().GetElement(1);
-        auto c = cell->GetPointIdsContainer().GetElement(2);
+        const auto& [a, b, c] = faces[cellId];
 
         // Get the 2D and 3D pts
-        std::vector<cv::Vec3d> uvPts;
-        std::vector<cv::Vec3d> xyzPts;
+        std::array<cv::Vec3d, 3> uvPts;
+        std::array<cv::Vec3d, 3> xyzPts;
+        std::size_t i{0};
         for (const auto& idx : {a, b, c}) {
-            auto uvPt = uvMap_->get(idx);
-            auto xyzPt = workingMesh_->GetPoint(idx);
-            uvPts.emplace_back(uvPt[0], uvPt[1], 0.0);
-            xyzPts.emplace_back(xyzPt[0], xyzPt[1], xyzPt[2]);
+            uvPts[i] = {uvs[idx][0], uvs[idx][1], 0.0};
+            xyzPts[i] = verts[idx];
+            i++;
         }
 
         // Find the xyz coordinate of the original point
@@ -155,40 +286,31 @@ auto PPMGenerator::compute() -> PerPixelMap::Pointer
             auto v2v0 = xyzPts[2] - xyzPts[0];
             xyzNorm = cv::normalize(v1v0.cross(v2v0));
         } else {
-            ITKPixel nA;
-            ITKPixel nB;
-            ITKPixel nC;
-            auto found = workingMesh_->GetPointData(a, &nA);
-            found &= workingMesh_->GetPointData(b, &nB);
-            found &= workingMesh_->GetPointData(c, &nC);
-            if (not found) {
-                throw std::runtime_error(
-                    "Performing smooth shading but missing vertex normal");
-            }
             xyzNorm = BarycentricNormalInterpolation(
-                baryCoord, {nA[0], nA[1], nA[2]}, {nB[0], nB[1], nB[2]},
-                {nC[0], nC[1], nC[2]});
+                baryCoord, normals[a], normals[b], normals[c]);
         }
 
         // Assign the cell index to the cell map
-        auto intX = static_cast<int>(x);
-        auto intY = static_cast<int>(y);
-        cellMap.at<int32_t>(intY, intX) = cellId;
+        auto intX = static_cast<int>(px);
+        auto intY = static_cast<int>(py);
+        cellMap.at<int32_t>(intY, intX) = static_cast<int32_t>(cellId);
 
         // Assign the intensity value at the UV position
         mask.at<uint8_t>(intY, intX) = MASK_TRUE;
 
         // Assign 3D position to the lookup map
-        ppm_->getMapping(y, x) = cv::Vec6d(
+        ppm->getMapping(py, px) = cv::Vec6d(
             xyz(0), xyz(1), xyz(2), xyzNorm(0), xyzNorm(1), xyzNorm(2));
     }
-    progressComplete();
+    if (reportProgress) {
+        progressComplete();
+    }
 
     // Finish setting up the output
-    ppm_->setMask(mask);
-    ppm_->setCellMap(cellMap);
+    ppm->setMask(mask);
+    ppm->setCellMap(cellMap);
 
-    return ppm_;
+    return ppm;
 }
 
 auto vct::GenerateCellMap(
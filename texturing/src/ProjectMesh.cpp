@@ -1,5 +1,6 @@
 #include "vc/texturing/ProjectMesh.hpp"
 
+#include <algorithm>
 #include <utility>
 
 #include <bvh/bvh.hpp>
@@ -10,13 +11,15 @@
 #include <bvh/triangle.hpp>
 #include <bvh/vector.hpp>
 #include <vtkOBBTree.h>
-#include <vtkPointData.h>
 
+#include "vc/core/types/TriangleMesh.hpp"
 #include "vc/core/util/BarycentricCoordinates.hpp"
-#include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Parallel.hpp"
 #include "vc/meshing/ITK2VTK.hpp"
 
 static constexpr uint8_t MASK_TRUE{255};
+/** Edge length of the square pixel tiles handed to each thread */
+static constexpr int TILE_SIZE{64};
 
 using Scalar = double;
 using Vector3 = bvh::Vector3<Scalar>;
@@ -83,17 +86,21 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
         }
     }
 
-    // Convert input mesh to VTK
-    auto vtkMesh = vtkSmartPointer<vtkPolyData>::New();
-    vcm::ITK2VTK(inputMesh_, vtkMesh);
+    // Copy the mesh into flat vertex, normal, and face arrays
+    auto mesh = FromITKMesh(inputMesh_);
+    if (not mesh->hasNormals()) {
+        throw std::runtime_error("Input mesh does not have vertex normals");
+    }
+    const auto& verts = mesh->vertices();
+    const auto& normals = mesh->normals();
+    const auto& faces = mesh->faces();
 
     // Computes the OBB and returns the 3 axes relative to the box
+    auto vtkMesh = vcm::TriangleMesh2VTK(*mesh, true);
     cv::Vec3d origin, b0, b1, b2;
     double size[3];
     auto obbTree = vtkSmartPointer<vtkOBBTree>::New();
     obbTree->ComputeOBB(vtkMesh, origin.val, b0.val, b1.val, b2.val, size);
-    obbTree->SetDataSet(vtkMesh);
-    obbTree->BuildLocator();
 
     // Set the marching parameters
     if (mode_ == SampleMode::Rate) {
@@ -118,15 +125,11 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
 
     // Create BVH for mesh
     std::vector<Triangle> triangles;
-    for (auto cell = inputMesh_->GetCells()->Begin();
-         cell != inputMesh_->GetCells()->End(); ++cell) {
-        auto aIdx = cell.Value()->GetPointIdsContainer()[0];
-        auto bIdx = cell.Value()->GetPointIdsContainer()[1];
-        auto cIdx = cell.Value()->GetPointIdsContainer()[2];
-
-        auto a = inputMesh_->GetPoint(aIdx);
-        auto b = inputMesh_->GetPoint(bIdx);
-        auto c = inputMesh_->GetPoint(cIdx);
+    triangles.reserve(faces.size());
+    for (const auto& f : faces) {
+        const auto& a = verts[f[0]];
+        const auto& b = verts[f[1]];
+        const auto& c = verts[f[2]];
 
         // Add the face to the BVH tree
         triangles.emplace_back(
@@ -140,8 +143,6 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
     auto meshBBox =
         bvh::compute_bounding_boxes_union(bboxes.get(), triangles.size());
     builder.build(meshBBox, bboxes.get(), centers.get(), triangles.size());
-    Intersector intersector(bvh, triangles.data());
-    Traverser traverser(bvh);
 
     auto tfm = tfm_;
     if (useInverse_) {
@@ -149,11 +150,9 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
             tfm_->GetInverseTransform().GetPointer());
     }
 
-    // Loop over every pixel of the image
-    for (const auto uv : vc::range2D(ppmHeight_, ppmWidth_)) {
-        const auto& u = uv.second;
-        const auto& v = uv.first;
-
+    // Project a single pixel of the image
+    auto projectPixel = [&](int v, int u, Traverser& traverser,
+                            Intersector& intersector) {
         cv::Vec3d uOffset;
         cv::Vec3d vOffset;
         if (tfm) {
@@ -182,24 +181,17 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
         Ray ray(start, dir, 0.0, cv::norm(b2) * 2);
         auto hit = traverser.traverse(ray, intersector);
         if (not hit) {
-            continue;
+            return;
         }
 
         // Cell info
-        auto cellId = static_cast<vtkIdType>(hit->primitive_index);
-        auto pointIds = vtkSmartPointer<vtkIdList>::New();
-        vtkMesh->GetCellPoints(cellId, pointIds);
-
-        // Make sure we only have three vertices
-        assert(pointIds->GetNumberOfIds() == 3);
-        auto v_id0 = pointIds->GetId(0);
-        auto v_id1 = pointIds->GetId(1);
-        auto v_id2 = pointIds->GetId(2);
+        auto cellId = hit->primitive_index;
+        const auto& face = faces[cellId];
 
         // Get the 3D positions of each vertex
-        cv::Vec3d A{vtkMesh->GetPoint(v_id0)};
-        cv::Vec3d B{vtkMesh->GetPoint(v_id1)};
-        cv::Vec3d C{vtkMesh->GetPoint(v_id2)};
+        const auto& A = verts[face[0]];
+        const auto& B = verts[face[1]];
+        const auto& C = verts[face[2]];
 
         // Intersection point UV coords
         auto inter = hit->intersection;
@@ -209,23 +201,38 @@ auto vct::ProjectMesh::compute() -> vc::PerPixelMap
         auto xyz = BarycentricToCartesian(bCoord, A, B, C);
 
         // Interpolate the vertex normal for this point
-        cv::Vec3d n0, n1, n2;
         auto bary = CartesianToBarycentric(xyz, A, B, C);
-        vtkMesh->GetPointData()->GetNormals()->GetTuple(v_id0, n0.val);
-        vtkMesh->GetPointData()->GetNormals()->GetTuple(v_id1, n1.val);
-        vtkMesh->GetPointData()->GetNormals()->GetTuple(v_id2, n2.val);
-        auto xyzNorm = BarycentricNormalInterpolation(bary, n0, n1, n2);
+        auto xyzNorm = BarycentricNormalInterpolation(
+            bary, normals[face[0]], normals[face[1]], normals[face[2]]);
 
         // Assign the cell index to the cell map
-        auto intU = static_cast<int>(u);
-        auto intV = static_cast<int>(v);
-        cellMap.at<int32_t>(intV, intU) = static_cast<int>(cellId);
+        cellMap.at<int32_t>(v, u) = static_cast<int>(cellId);
 
         // Assign 3D position to the lookup map and update the mask
         outputPPM_(v, u) = cv::Vec6d{xyz(0),     xyz(1),     xyz(2),
                                      xyzNorm(0), xyzNorm(1), xyzNorm(2)};
         mask.at<uint8_t>(v, u) = MASK_TRUE;
-    }
+    };
+
+    // Loop over every pixel of the image in tiles. Each pixel is written by
+    // exactly one thread, so the output does not depend on the thread count.
+    auto tilesX = (ppmWidth_ + TILE_SIZE - 1) / TILE_SIZE;
+    auto tilesY = (ppmHeight_ + TILE_SIZE - 1) / TILE_SIZE;
+    ParallelFor(static_cast<std::size_t>(tilesX * tilesY), [&](auto tile) {
+        // Thread-local traversal state
+        Intersector intersector(bvh, triangles.data());
+        Traverser traverser(bvh);
+
+        auto tileY = static_cast<int>(tile) / tilesX;
+        auto tileX = static_cast<int>(tile) % tilesX;
+        auto vEnd = std::min((tileY + 1) * TILE_SIZE, ppmHeight_);
+        auto uEnd = std::min((tileX + 1) * TILE_SIZE, ppmWidth_);
+        for (auto v = tileY * TILE_SIZE; v < vEnd; v++) {
+            for (auto u = tileX * TILE_SIZE; u < uEnd; u++) {
+                projectPixel(v, u, traverser, intersector);
+            }
+        }
+    });
 
     outputPPM_.setMask(mask);
     outputPPM_.setCellMap(cellMap);
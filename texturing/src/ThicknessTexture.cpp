@@ -1,6 +1,7 @@
 #include "vc/texturing/ThicknessTexture.hpp"
 
 #include "vc/core/util/Iteration.hpp"
+#include "vc/core/util/Trace.hpp"
 
 using namespace volcart;
 using namespace volcart::texturing;
@@ -18,6 +19,7 @@ void ThicknessTexture::setVolumetricMask(const VolumetricMask::Pointer& m)
 
 auto ThicknessTexture::compute() -> Texture
 {
+    trace::Span span("ThicknessTexture::compute", "texturing");
     // Setup
     result_.clear();
     auto height = static_cast<int>(ppm_->height());
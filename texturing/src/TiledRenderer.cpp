@@ -0,0 +1,179 @@
+#include "vc/texturing/TiledRenderer.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "vc/core/io/TiledTIFFWriter.hpp"
+#include "vc/core/util/Parallel.hpp"
+#include "vc/core/util/String.hpp"
+
+using namespace volcart;
+using namespace volcart::texturing;
+
+namespace fs = volcart::filesystem;
+namespace tio = volcart::tiffio;
+
+void TiledRenderer::setPPMGenerator(std::shared_ptr<PPMGenerator> gen)
+{
+    ppmGen_ = std::move(gen);
+    ppm_ = nullptr;
+}
+
+void TiledRenderer::setPerPixelMap(PerPixelMap::Pointer ppm)
+{
+    ppm_ = std::move(ppm);
+    ppmGen_ = nullptr;
+}
+
+void TiledRenderer::setTileFunction(TileFunction fn)
+{
+    tileFn_ = std::move(fn);
+}
+
+void TiledRenderer::setTileSize(std::uint32_t size) { tileSize_ = size; }
+
+void TiledRenderer::setOutputPath(const fs::path& path)
+{
+    outputPath_ = path;
+}
+
+void TiledRenderer::setMultiPage(bool b) { multiPage_ = b; }
+
+void TiledRenderer::setCompression(tio::Compression c) { compression_ = c; }
+
+void TiledRenderer::setNumThreads(std::size_t n) { numThreads_ = n; }
+
+auto TiledRenderer::width() const -> std::size_t
+{
+    if (ppmGen_) {
+        return ppmGen_->width();
+    }
+    return ppm_ ? ppm_->width() : 0;
+}
+
+auto TiledRenderer::height() const -> std::size_t
+{
+    if (ppmGen_) {
+        return ppmGen_->height();
+    }
+    return ppm_ ? ppm_->height() : 0;
+}
+
+auto TiledRenderer::numTiles() const -> std::size_t
+{
+    if (tileSize_ == 0) {
+        return 0;
+    }
+    auto across = (width() + tileSize_ - 1) / tileSize_;
+    auto down = (height() + tileSize_ - 1) / tileSize_;
+    return across * down;
+}
+
+auto TiledRenderer::progressIterations() const -> std::size_t
+{
+    return numTiles();
+}
+
+auto TiledRenderer::tile_ppm_(const cv::Rect& region) const
+    -> PerPixelMap::Pointer
+{
+    if (ppmGen_) {
+        return ppmGen_->compute(region);
+    }
+
+    return PerPixelMap::New(ppm_->crop(region));
+}
+
+void TiledRenderer::compute()
+{
+    // Validate the inputs
+    if ((not ppmGen_ and not ppm_) or not tileFn_ or width() == 0 or
+        height() == 0 or outputPath_.empty()) {
+        throw std::invalid_argument("Invalid input parameters");
+    }
+    if (tileSize_ == 0 or tileSize_ % 16 != 0) {
+        throw std::invalid_argument("Tile size must be a multiple of 16");
+    }
+
+    auto w = static_cast<std::uint32_t>(width());
+    auto h = static_cast<std::uint32_t>(height());
+    auto across = (w + tileSize_ - 1) / tileSize_;
+    auto tiles = numTiles();
+
+    // Writers are created once the first tile reports its image count and type
+    std::vector<std::unique_ptr<tio::TiledTIFFWriter>> writers;
+    std::size_t numImages{0};
+    int type{-1};
+    std::mutex writersMutex;
+    auto openWriters = [&](const TexturingAlgorithm::Texture& texture) {
+        std::unique_lock<std::mutex> lock(writersMutex);
+        if (not writers.empty()) {
+            return;
+        }
+        if (texture.empty()) {
+            throw std::runtime_error("Texturing function returned no images");
+        }
+        numImages = texture.size();
+        type = texture.front().type();
+        if (multiPage_) {
+            writers.emplace_back(std::make_unique<tio::TiledTIFFWriter>(
+                outputPath_, w, h, type, numImages, tileSize_, tileSize_,
+                compression_));
+            return;
+        }
+        auto numChars = static_cast<int>(std::to_string(numImages).size());
+        for (std::size_t i = 0; i < numImages; i++) {
+            auto name = to_padded_string(i, numChars) + ".tif";
+            writers.emplace_back(std::make_unique<tio::TiledTIFFWriter>(
+                outputPath_ / name, w, h, type, 1, tileSize_, tileSize_,
+                compression_));
+        }
+    };
+
+    // Render and write each tile
+    std::mutex progressMutex;
+    std::size_t finished{0};
+    progressStarted();
+    ParallelFor(
+        tiles,
+        [&](auto t) {
+            auto x = static_cast<std::uint32_t>(t % across) * tileSize_;
+            auto y = static_cast<std::uint32_t>(t / across) * tileSize_;
+            cv::Rect region{
+                static_cast<int>(x), static_cast<int>(y),
+                static_cast<int>(std::min(tileSize_, w - x)),
+                static_cast<int>(std::min(tileSize_, h - y))};
+
+            auto texture = tileFn_(tile_ppm_(region));
+            openWriters(texture);
+            if (texture.size() != numImages) {
+                throw std::runtime_error(
+                    "Tile returned an inconsistent number of images");
+            }
+            for (std::size_t i = 0; i < texture.size(); i++) {
+                if (texture[i].type() != type or
+                    texture[i].size() != region.size()) {
+                    throw std::runtime_error(
+                        "Tile returned an image of the wrong size or type");
+                }
+                if (multiPage_) {
+                    writers.front()->writeTile(i, x, y, texture[i]);
+                } else {
+                    writers[i]->writeTile(0, x, y, texture[i]);
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(progressMutex);
+            progressUpdated(finished++);
+        },
+        numThreads_);
+    progressComplete();
+
+    // Write the directories
+    for (auto& writer : writers) {
+        writer->close();
+    }
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include "vc/core/shapes/Arch.hpp"
+#include "vc/core/shapes/Plane.hpp"
+#include "vc/texturing/AngleBasedFlattening.hpp"
+#include "vc/texturing/ChartedFlattening.hpp"
+#include "vc/texturing/FlatteningError.hpp"
+
+using namespace volcart;
+using namespace volcart::shapes;
+using namespace volcart::texturing;
+
+TEST(ChartedFlattening, SingleChart)
+{
+    Plane plane;
+    auto mesh3D = plane.itkMesh();
+
+    ChartedFlattening flattening(mesh3D);
+    auto mesh2D = flattening.compute();
+    EXPECT_EQ(flattening.numCharts(), 1U);
+    EXPECT_EQ(mesh2D->GetNumberOfPoints(), mesh3D->GetNumberOfPoints());
+    EXPECT_EQ(mesh2D->GetNumberOfCells(), mesh3D->GetNumberOfCells());
+
+    // Plane should flatten without distortion
+    auto metrics = LStretch(mesh3D, mesh2D);
+    EXPECT_NEAR(metrics.l2, 1.0, 1e-5);
+    EXPECT_NEAR(metrics.lInf, 1.0, 1e-5);
+}
+
+TEST(ChartedFlattening, ArchMultipleCharts)
+{
+    Arch arch;
+    auto mesh3D = arch.itkMesh();
+
+    ChartedFlattening flattening(mesh3D);
+    flattening.setChartSize(40);
+    flattening.setNumThreads(2);
+    auto mesh2D = flattening.compute();
+    EXPECT_GT(flattening.numCharts(), 1U);
+    EXPECT_EQ(flattening.numWarmStartedCharts(), 0U);
+
+    // Stitched charts should be nearly isometric
+    auto metrics = LStretch(mesh3D, mesh2D);
+    EXPECT_NEAR(metrics.l2, 1.0, 1e-2);
+
+    auto uvMap = flattening.getUVMap();
+    EXPECT_EQ(uvMap->size(), mesh3D->GetNumberOfPoints());
+}
+
+TEST(ChartedFlattening, WarmStart)
+{
+    Arch arch;
+    auto mesh3D = arch.itkMesh();
+
+    // Initial parameterization
+    AngleBasedFlattening abf(mesh3D);
+    abf.compute();
+    auto initial = abf.getUVMap();
+
+    ChartedFlattening flattening(mesh3D);
+    flattening.setChartSize(40);
+    flattening.setInitialUVMap(initial);
+    auto mesh2D = flattening.compute();
+    EXPECT_GT(flattening.numCharts(), 1U);
+    EXPECT_EQ(flattening.numWarmStartedCharts(), flattening.numCharts());
+
+    auto metrics = LStretch(mesh3D, mesh2D);
+    EXPECT_NEAR(metrics.l2, 1.0, 1e-2);
+}
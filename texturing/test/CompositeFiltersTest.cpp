@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "vc/texturing/CompositeFilters.hpp"
+
+using namespace volcart::texturing;
+
+// Reference implementations: sort and reduce
+static auto ReferenceMedian(std::vector<std::uint16_t> v) -> std::uint16_t
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+static auto ReferenceMedianAverage(std::vector<std::uint16_t> v, double range)
+    -> std::uint16_t
+{
+    std::sort(v.begin(), v.end());
+    auto count = static_cast<std::size_t>(std::ceil(v.size() * range));
+    auto offset = static_cast<std::size_t>(std::floor((v.size() - count) / 2.0));
+    auto sum = std::accumulate(
+        v.begin() + offset, v.begin() + offset + count, double{0});
+    return static_cast<std::uint16_t>(std::round(sum / count));
+}
+
+TEST(CompositeFilters, MatchesReference)
+{
+    std::mt19937 rng(1234);
+    for (auto size : {1, 2, 7, 64, 65, 100, 513, 2000}) {
+        for (auto maxValue : {3, 255, 4095, 65535}) {
+            std::uniform_int_distribution<int> dist(0, maxValue);
+            std::vector<std::uint16_t> v(size);
+            for (auto& val : v) {
+                val = static_cast<std::uint16_t>(dist(rng));
+            }
+            auto n = v.size();
+
+            EXPECT_EQ(
+                CompositeMinimum(v.data(), n),
+                *std::min_element(v.begin(), v.end()));
+            EXPECT_EQ(
+                CompositeMaximum(v.data(), n),
+                *std::max_element(v.begin(), v.end()));
+            auto sum = std::accumulate(v.begin(), v.end(), double{0});
+            EXPECT_EQ(
+                CompositeMean(v.data(), n),
+                static_cast<std::uint16_t>(std::round(sum / n)));
+            EXPECT_EQ(CompositeMedian(v.data(), n), ReferenceMedian(v));
+            for (auto range : {0.1, 0.5, 0.7, 0.99}) {
+                EXPECT_EQ(
+                    CompositeMedianAverage(v.data(), n, range),
+                    ReferenceMedianAverage(v, range));
+            }
+        }
+    }
+}
+
+TEST(CompositeFilters, DoesNotModifyInput)
+{
+    std::vector<std::uint16_t> v(500);
+    std::iota(v.rbegin(), v.rend(), 0);
+    auto copy = v;
+    EXPECT_EQ(CompositeMedian(v.data(), v.size()), 250);
+    EXPECT_EQ(CompositeMedianAverage(v.data(), v.size(), 0.5), 250);
+    EXPECT_EQ(v, copy);
+}
+
+TEST(CompositeFilters, EmptyAndEdgeRanges)
+{
+    std::vector<std::uint16_t> v{1, 2, 3, 4};
+    EXPECT_EQ(CompositeMedian(v.data(), 0), 0);
+    EXPECT_EQ(CompositeMean(v.data(), 0), 0);
+    EXPECT_EQ(CompositeMedianAverage(v.data(), v.size(), 0.0), 0);
+    EXPECT_EQ(CompositeMedianAverage(v.data(), v.size(), 1.0), 3);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include <opencv2/core.hpp>
+
+#include "vc/core/filesystem.hpp"
+#include "vc/core/neighborhood/CuboidGenerator.hpp"
+#include "vc/core/neighborhood/LineGenerator.hpp"
+#include "vc/texturing/CompositeTexture.hpp"
+#include "vc/texturing/FusedTexture.hpp"
+#include "vc/texturing/IntegralTexture.hpp"
+#include "vc/texturing/IntersectionTexture.hpp"
+#include "vc/texturing/LayerTexture.hpp"
+
+using namespace volcart;
+using namespace volcart::texturing;
+namespace fs = volcart::filesystem;
+
+///// FIXTURES /////
+class FusedTextureFixture : public ::testing::Test
+{
+public:
+    FusedTextureFixture()
+        : root{fs::temp_directory_path() / "vc_FusedTextureTest.volume"}
+    {
+        // Random volume
+        fs::remove_all(root);
+        fs::create_directories(root);
+        {
+            auto v = Volume::New(root, "fused", "Fused");
+            v->setSliceWidth(SIZE);
+            v->setSliceHeight(SIZE);
+            v->setNumberOfSlices(SIZE);
+            v->setVoxelSize(1);
+            v->setMin(0);
+            v->setMax(65535);
+            cv::RNG rng(0x5eed);
+            cv::Mat slice(SIZE, SIZE, CV_16UC1);
+            for (int z = 0; z < SIZE; z++) {
+                rng.fill(slice, cv::RNG::UNIFORM, 0, 65536);
+                v->setSliceData(z, slice, false);
+            }
+            v->saveMetadata();
+        }
+        volume = Volume::New(root);
+
+        // Slightly curved sheet through the middle of the volume, with a
+        // hole in the mask
+        ppm = PerPixelMap::New(PPM_SIZE, PPM_SIZE);
+        cv::Mat mask(PPM_SIZE, PPM_SIZE, CV_8UC1, cv::Scalar(255));
+        mask(cv::Rect(4, 6, 5, 3)).setTo(0);
+        ppm->setMask(mask);
+        for (int y = 0; y < PPM_SIZE; y++) {
+            for (int x = 0; x < PPM_SIZE; x++) {
+                auto t = 0.2 * std::sin(0.3 * x);
+                cv::Vec3d n{-t, 1, 0};
+                n /= cv::norm(n);
+                ppm->getMapping(y, x) = {
+                    8 + 0.5 * x, 16 + 2 * std::cos(0.3 * x), 8 + 0.5 * y,
+                    n[0],        n[1],                       n[2]};
+            }
+        }
+
+        line = LineGenerator::New();
+        line->setSamplingRadius(3);
+        line->setSamplingInterval(0.5);
+        line->setSamplingDirection(Direction::Bidirectional);
+    }
+
+    ~FusedTextureFixture() override { fs::remove_all(root); }
+
+    /** Volume dimensions */
+    static constexpr int SIZE{32};
+    /** PPM dimensions */
+    static constexpr int PPM_SIZE{24};
+
+    fs::path root;
+    Volume::Pointer volume;
+    PerPixelMap::Pointer ppm;
+    LineGenerator::Pointer line;
+};
+
+// Expect two textures to be identical
+static void ExpectIdentical(
+    const TexturingAlgorithm::Texture& a, const TexturingAlgorithm::Texture& b)
+{
+    ASSERT_EQ(a.size(), b.size());
+    for (std::size_t i = 0; i < a.size(); i++) {
+        ASSERT_EQ(a[i].size(), b[i].size());
+        ASSERT_EQ(a[i].type(), b[i].type());
+        EXPECT_EQ(cv::norm(a[i], b[i], cv::NORM_INF), 0) << "Image " << i;
+    }
+}
+
+///// TEST CASES /////
+TEST_F(FusedTextureFixture, MatchesStandaloneAlgorithms)
+{
+    auto max = CompositeTexture::New();
+    max->setFilter(CompositeTexture::Filter::Maximum);
+    auto median = CompositeTexture::New();
+    median->setFilter(CompositeTexture::Filter::Median);
+    auto integral = IntegralTexture::New();
+    auto layers = LayerTexture::New();
+    auto intersection = IntersectionTexture::New();
+
+    FusedTexture fused;
+    fused.setPerPixelMap(ppm);
+    fused.setVolume(volume);
+    fused.setGenerator(line);
+    fused.addReducer(max);
+    fused.addReducer(median);
+    fused.addReducer(integral);
+    fused.addReducer(layers);
+    fused.addReducer(intersection);
+    auto result = fused.compute();
+    auto textures = fused.reducerTextures();
+    ASSERT_EQ(textures.size(), 5U);
+    ASSERT_EQ(result.size(), 4 + line->extents()[0]);
+
+    // Standalone
+    for (const auto& composite : {max, median}) {
+        composite->setPerPixelMap(ppm);
+        composite->setVolume(volume);
+        composite->setGenerator(line);
+    }
+    ExpectIdentical(max->compute(), textures[0]);
+    ExpectIdentical(median->compute(), textures[1]);
+
+    integral->setPerPixelMap(ppm);
+    integral->setVolume(volume);
+    integral->setGenerator(line);
+    ExpectIdentical(integral->compute(), textures[2]);
+
+    layers->setPerPixelMap(ppm);
+    layers->setVolume(volume);
+    layers->setGenerator(line);
+    ExpectIdentical(layers->compute(), textures[3]);
+
+    intersection->setPerPixelMap(ppm);
+    intersection->setVolume(volume);
+    ExpectIdentical(intersection->compute(), textures[4]);
+}
+
+TEST_F(FusedTextureFixture, LayersRequireLineGenerator)
+{
+    auto cuboid = CuboidGenerator::New();
+    cuboid->setSamplingRadius(1, 1, 1);
+
+    FusedTexture fused;
+    fused.setPerPixelMap(ppm);
+    fused.setVolume(volume);
+    fused.setGenerator(cuboid);
+    fused.addReducer(LayerTexture::New());
+    EXPECT_THROW(fused.compute(), std::invalid_argument);
+}
+
+TEST_F(FusedTextureFixture, InvalidInputs)
+{
+    FusedTexture fused;
+    fused.setPerPixelMap(ppm);
+    fused.setVolume(volume);
+    fused.setGenerator(line);
+    EXPECT_THROW(fused.compute(), std::invalid_argument);
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "vc/core/shapes/Plane.hpp"
+#include "vc/core/util/Iteration.hpp"
+#include "vc/meshing/DeepCopy.hpp"
+#include "vc/texturing/IncrementalRenderer.hpp"
+
+namespace vc = volcart;
+namespace vcm = volcart::meshing;
+namespace vct = volcart::texturing;
+
+// Texture each pixel with a value derived from its mapping
+static auto RenderMappings(const vc::PerPixelMap::Pointer& ppm)
+    -> vct::TexturingAlgorithm::Texture
+{
+    auto rows = static_cast<int>(ppm->height());
+    auto cols = static_cast<int>(ppm->width());
+    cv::Mat img = cv::Mat::zeros(rows, cols, CV_64FC1);
+    for (const auto& pixel : ppm->getMappings()) {
+        img.at<double>(static_cast<int>(pixel.y), static_cast<int>(pixel.x)) =
+            pixel.pos[0] + 10 * pixel.pos[1] + 100 * pixel.pos[2] +
+            pixel.normal[1];
+    }
+    return {img};
+}
+
+static auto PlaneUVMap() -> vc::UVMap::Pointer
+{
+    auto uvMap = vc::UVMap::New();
+    std::size_t id{0};
+    for (const auto uv : vc::range2D(9, 9)) {
+        auto u = double(uv.first) / 8.0;
+        auto v = double(uv.second) / 8.0;
+        uvMap->set(id++, {u, v});
+    }
+    return uvMap;
+}
+
+TEST(IncrementalRenderer, PPMDiffUpdatesChangedTiles)
+{
+    // Previous render
+    vc::shapes::Plane plane(9, 9);
+    vct::PPMGenerator ppmGen(128, 128);
+    ppmGen.setMesh(plane.itkMesh());
+    ppmGen.setUVMap(PlaneUVMap());
+    auto prevPPM = ppmGen.compute();
+    auto prevTexture = RenderMappings(prevPPM);
+
+    // Change a single pixel
+    auto ppm = vc::PerPixelMap::New(*prevPPM);
+    ppm->getMapping(70, 20)[1] += 1;
+
+    std::atomic<int> calls{0};
+    vct::IncrementalRenderer renderer;
+    renderer.setPreviousPerPixelMap(prevPPM);
+    renderer.setPreviousTexture(prevTexture);
+    renderer.setPerPixelMap(ppm);
+    renderer.setTileSize(32);
+    renderer.setTileFunction([&](const vc::PerPixelMap::Pointer& tile) {
+        calls++;
+        return RenderMappings(tile);
+    });
+
+    auto dirty = renderer.dirtyTiles();
+    ASSERT_EQ(dirty.size(), 1U);
+    EXPECT_EQ(dirty[0], cv::Rect(0, 64, 32, 32));
+
+    auto result = renderer.compute();
+    EXPECT_EQ(calls.load(), 1);
+    ASSERT_EQ(result.size(), 1U);
+    auto expected = RenderMappings(ppm);
+    EXPECT_EQ(cv::norm(result[0], expected[0], cv::NORM_INF), 0);
+
+    // The previous texture was updated in place
+    EXPECT_EQ(result[0].data, prevTexture[0].data);
+}
+
+TEST(IncrementalRenderer, MeshDiffUpdatesChangedTiles)
+{
+    // Previous render
+    vc::shapes::Plane plane(9, 9);
+    auto prevMesh = plane.itkMesh();
+    auto uvMap = PlaneUVMap();
+    vct::PPMGenerator prevGen(128, 128);
+    prevGen.setMesh(prevMesh);
+    prevGen.setUVMap(uvMap);
+    auto prevPPM = prevGen.compute();
+    auto prevTexture = RenderMappings(prevPPM);
+
+    // Move a single vertex out of the plane
+    auto mesh = vc::ITKMesh::New();
+    vcm::DeepCopy(prevMesh, mesh);
+    auto pt = mesh->GetPoint(40);
+    pt[1] += 0.5;
+    mesh->SetPoint(40, pt);
+
+    auto ppmGen = std::make_shared<vct::PPMGenerator>(128, 128);
+    ppmGen->setMesh(mesh);
+    ppmGen->setUVMap(uvMap);
+
+    vct::IncrementalRenderer renderer;
+    renderer.setPreviousPerPixelMap(prevPPM);
+    renderer.setPreviousTexture(prevTexture);
+    renderer.setPreviousMesh(prevMesh);
+    renderer.setPPMGenerator(ppmGen);
+    renderer.setTileSize(16);
+    renderer.setTileFunction(RenderMappings);
+
+    // Only part of the output is dirty
+    auto dirty = renderer.dirtyTiles();
+    EXPECT_GT(dirty.size(), 0U);
+    EXPECT_LT(dirty.size(), 64U);
+
+    // The result matches a full render with the new mesh
+    auto result = renderer.compute();
+    ASSERT_EQ(result.size(), 1U);
+    auto expected = RenderMappings(ppmGen->compute());
+    EXPECT_EQ(cv::norm(result[0], expected[0], cv::NORM_INF), 0);
+}
+
+TEST(IncrementalRenderer, FullRenderWithoutPreviousTexture)
+{
+    vc::shapes::Plane plane(9, 9);
+    vct::PPMGenerator ppmGen(100, 60);
+    ppmGen.setMesh(plane.itkMesh());
+    ppmGen.setUVMap(PlaneUVMap());
+    auto ppm = ppmGen.compute();
+
+    vct::IncrementalRenderer renderer;
+    renderer.setPreviousPerPixelMap(ppm);
+    renderer.setPerPixelMap(ppm);
+    renderer.setTileSize(32);
+    renderer.setTileFunction(RenderMappings);
+    EXPECT_EQ(renderer.dirtyTiles().size(), 8U);
+
+    auto result = renderer.compute();
+    ASSERT_EQ(result.size(), 1U);
+    auto expected = RenderMappings(ppm);
+    EXPECT_EQ(cv::norm(result[0], expected[0], cv::NORM_INF), 0);
+
+    // Missing inputs are invalid
+    vct::IncrementalRenderer invalid;
+    invalid.setPerPixelMap(ppm);
+    EXPECT_THROW(invalid.dirtyTiles(), std::invalid_argument);
+}
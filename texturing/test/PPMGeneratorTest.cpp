@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <stdexcept>
 
 #include "vc/core/shapes/Plane.hpp"
 #include "vc/core/util/Iteration.hpp"
@@ -53,6 +54,91 @@ TEST(PPMGeneratorTest, RegressionTest)
     }
 }
 
+TEST(PPMGeneratorTest, RegionMatchesFullPPM)
+{
+    // Build Plane UVMap
+    vc::shapes::Plane plane(5, 5);
+    auto mesh = plane.itkMesh();
+    auto uvMap = vc::UVMap::New();
+    std::size_t id{0};
+    for (const auto uv : vc::range2D(5, 5)) {
+        auto u = double(uv.first) / 4.0;
+        auto v = double(uv.second) / 4.0;
+        uvMap->set(id++, {u, v});
+    }
+
+    // Setup PPM Generator
+    vct::PPMGenerator ppmGenerator;
+    ppmGenerator.setDimensions(100, 100);
+    ppmGenerator.setMesh(mesh);
+    ppmGenerator.setUVMap(uvMap);
+    auto ppm = ppmGenerator.compute();
+
+    // Compare a region against the full PPM
+    cv::Rect region{32, 48, 64, 52};
+    auto tile = ppmGenerator.compute(region);
+    EXPECT_EQ(tile->width(), 64U);
+    EXPECT_EQ(tile->height(), 52U);
+    for (const auto [y, x] : vc::range2D(52, 64)) {
+        auto fullY = y + 48;
+        auto fullX = x + 32;
+        EXPECT_EQ(tile->hasMapping(y, x), ppm->hasMapping(fullY, fullX));
+        EXPECT_EQ(tile->getMapping(y, x), ppm->getMapping(fullY, fullX));
+        EXPECT_EQ(
+            tile->cellMap().at<int32_t>(y, x),
+            ppm->cellMap().at<int32_t>(fullY, fullX));
+    }
+    EXPECT_EQ(ppmGenerator.getPPM(), ppm);
+
+    // Regions outside of the image are invalid
+    EXPECT_THROW(
+        ppmGenerator.compute(cv::Rect{64, 64, 64, 64}), std::invalid_argument);
+}
+
+TEST(PPMGeneratorTest, ClearCacheSeesInPlaceEdits)
+{
+    // Build Plane UVMap
+    vc::shapes::Plane plane(5, 5);
+    auto mesh = plane.itkMesh();
+    auto uvMap = vc::UVMap::New();
+    std::size_t id{0};
+    for (const auto uv : vc::range2D(5, 5)) {
+        auto u = double(uv.first) / 4.0;
+        auto v = double(uv.second) / 4.0;
+        uvMap->set(id++, {u, v});
+    }
+
+    // Setup PPM Generator
+    vct::PPMGenerator ppmGenerator;
+    ppmGenerator.setDimensions(100, 100);
+    ppmGenerator.setMesh(mesh);
+    ppmGenerator.setUVMap(uvMap);
+    cv::Rect region{0, 0, 100, 100};
+    auto before = ppmGenerator.compute(region);
+
+    // Shrink the UV map in-place
+    for (std::size_t i = 0; i < id; i++) {
+        uvMap->set(i, uvMap->get(i) * 0.5);
+    }
+
+    // The cached search structure still uses the old UVs
+    auto cached = ppmGenerator.compute(region);
+    EXPECT_TRUE(cached->hasMapping(90, 90));
+
+    // Clearing the cache picks up the change
+    ppmGenerator.clearCache();
+    auto after = ppmGenerator.compute(region);
+    EXPECT_TRUE(before->hasMapping(90, 90));
+    EXPECT_FALSE(after->hasMapping(90, 90));
+    EXPECT_TRUE(after->hasMapping(10, 10));
+
+    // The full PPM matches the region
+    auto full = ppmGenerator.compute();
+    for (const auto [y, x] : vc::range2D(100, 100)) {
+        EXPECT_EQ(full->hasMapping(y, x), after->hasMapping(y, x));
+    }
+}
+
 TEST_P(PPMGeneratorTest, PerformanceTest)
 {
     // Build Plane
@@ -7,6 +7,7 @@
 #include "vc/core/io/OBJWriter.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/texturing/AngleBasedFlattening.hpp"
+#include "vc/texturing/ChartedFlattening.hpp"
 
 namespace fs = volcart::filesystem;
 namespace po = boost::program_options;
@@ -25,7 +26,22 @@ int main(int argc, char** argv)
             "Input mesh file")
         ("output-mesh,o", po::value<std::string>()->required(),
             "Output mesh file")
-        ("method,m", po::value<std::string>()->default_value("ABF"), "Flattening method: [ABF, LSCM]");
+        ("method,m", po::value<std::string>()->default_value("ABF"),
+            "Flattening method: [ABF, LSCM, Charted]")
+        ("chart-size", po::value<std::size_t>()->default_value(
+            vct::ChartedFlattening::DEFAULT_CHART_SIZE), "Charted: Target "
+            "number of faces per chart")
+        ("chart-overlap", po::value<std::size_t>()->default_value(
+            vct::ChartedFlattening::DEFAULT_CHART_OVERLAP), "Charted: Number "
+            "of face rings shared by neighboring charts")
+        ("warm-start", "Charted: Start from the input mesh's UV map where "
+            "available")
+        ("warm-start-iters", po::value<std::size_t>()->default_value(
+            vct::ChartedFlattening::DEFAULT_WARM_START_ITERATIONS),
+            "Charted: Number of solver iterations for warm-started charts")
+        ("threads,j", po::value<std::size_t>()->default_value(0),
+            "Charted: Number of worker threads. If 0, uses all available "
+            "threads");
 
     po::options_description all("Usage");
     all.add(required);
@@ -50,10 +66,13 @@ int main(int argc, char** argv)
     }
 
     bool useABF{true};
+    bool charted{false};
     auto method = parsed["method"].as<std::string>();
     std::transform(method.begin(), method.end(), method.begin(), ::tolower);
     if (method == "lscm") {
         useABF = false;
+    } else if (method == "charted") {
+        charted = true;
     } else if (method != "abf") {
         std::cerr << "ERROR: Unknown flattening method: " << method;
         std::cerr << std::endl;
@@ -71,10 +90,32 @@ int main(int argc, char** argv)
         mesh->GetNumberOfCells());
 
     // Run ABF
-    vct::AngleBasedFlattening abf;
-    abf.setUseABF(useABF);
-    abf.setMesh(mesh);
-    mesh = abf.compute();
+    if (charted) {
+        vct::ChartedFlattening flattening(mesh);
+        flattening.setChartSize(parsed["chart-size"].as<std::size_t>());
+        flattening.setChartOverlap(parsed["chart-overlap"].as<std::size_t>());
+        flattening.setNumThreads(parsed["threads"].as<std::size_t>());
+        if (parsed.count("warm-start") > 0) {
+            auto uvMap = reader.getUVMap();
+            if (uvMap->empty()) {
+                vc::Logger()->warn(
+                    "Input mesh has no UV map. Ignoring '--warm-start'.");
+            } else {
+                flattening.setInitialUVMap(uvMap);
+                flattening.setWarmStartIterations(
+                    parsed["warm-start-iters"].as<std::size_t>());
+            }
+        }
+        mesh = flattening.compute();
+        vc::Logger()->info(
+            "Charts: {} || Warm-started: {}", flattening.numCharts(),
+            flattening.numWarmStartedCharts());
+    } else {
+        vct::AngleBasedFlattening abf;
+        abf.setUseABF(useABF);
+        abf.setMesh(mesh);
+        mesh = abf.compute();
+    }
 
     vc::Logger()->info("Writing mesh...");
     fs::path outputPath = parsed["output-mesh"].as<std::string>();
@@ -1,14 +1,19 @@
+#include <algorithm>
 #include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <iomanip>
 #include <limits>
-#include <map>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <vector>
 
 #include <boost/program_options.hpp>
 #include <opencv2/core.hpp>
 #include <opencv2/imgcodecs.hpp>
 
-#include "vc/app_support/GetMemorySize.hpp"
 #include "vc/core/filesystem.hpp"
 #include "vc/core/io/TIFFIO.hpp"
 #include "vc/core/types/PerPixelMap.hpp"
@@ -16,6 +21,7 @@
 #include "vc/core/types/VolumePkg.hpp"
 #include "vc/core/util/Logging.hpp"
 #include "vc/core/util/MemorySizeStringParser.hpp"
+#include "vc/core/util/Parallel.hpp"
 
 namespace po = boost::program_options;
 namespace fs = volcart::filesystem;
@@ -24,11 +30,57 @@ namespace vc = volcart;
 // Volpkg version required by this app
 static constexpr int VOLPKG_SUPPORTED_VERSION = 6;
 static const double MAX_16BPC = std::numeric_limits<uint16_t>::max();
+// Default number of finished slices which may wait to be written
+static constexpr std::size_t DEFAULT_WRITE_QUEUE = 16;
 
 fs::path g_outputDir;
 size_t g_numSliceChars;
+bool g_updateExisting{false};
 
-void WriteBumpedSlice(const cv::Mat& slice, int index);
+// A single voxel's bump
+struct Bump {
+    int x;
+    int y;
+    double value;
+};
+
+// A bumped slice and the region which was modified
+struct BumpedSlice {
+    int index;
+    cv::Mat slice;
+    cv::Rect roi;
+};
+
+// Bounded pool of threads which write bumped slices. push() blocks while the
+// queue is full, so at most `capacity` finished slices wait in memory and
+// slow writes throttle the compute threads rather than piling up.
+class SliceWriter
+{
+public:
+    SliceWriter(std::size_t numThreads, std::size_t capacity);
+    ~SliceWriter();
+
+    // Queue a slice for writing
+    void push(BumpedSlice s);
+
+    // Write the queued slices and stop the writer threads. Rethrows the first
+    // write error.
+    void finish();
+
+private:
+    void run_();
+
+    std::size_t capacity_;
+    std::deque<BumpedSlice> queue_;
+    std::vector<std::thread> threads_;
+    std::exception_ptr error_;
+    bool stop_{false};
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::condition_variable space_;
+};
+
+void WriteBumpedSlice(const BumpedSlice& s);
 
 int main(int argc, char* argv[])
 {
@@ -44,7 +96,19 @@ int main(int argc, char* argv[])
         ("output-dir,o", po::value<std::string>()->required(),"Output directory")
         ("cache-memory-limit", po::value<std::string>(), "Maximum size of the "
             "slice cache in bytes. Accepts the suffixes: (K|M|G|T)(B). "
-            "Default: 50% of the total system memory.");
+            "Default: Slices are not cached, since each is read once.")
+        ("threads,j", po::value<std::size_t>()->default_value(0),
+            "Number of slices to bump in parallel. If 0, uses the number of "
+            "hardware threads.")
+        ("writer-threads", po::value<std::size_t>()->default_value(2),
+            "Number of threads which write bumped slices")
+        ("write-queue",
+            po::value<std::size_t>()->default_value(DEFAULT_WRITE_QUEUE),
+            "Maximum number of bumped slices waiting to be written")
+        ("update-existing", "If an output slice already exists with the same "
+            "dimensions and type, only rewrite the strips or tiles which "
+            "contain bumped voxels. Use when the output directory holds a "
+            "copy of the volume's slices.");
 
 
     po::options_description visOptions("Visualization Options");
@@ -98,20 +162,21 @@ int main(int argc, char* argv[])
     g_numSliceChars = std::to_string(volume->numSlices()).size();
 
     // Set the cache size
-    size_t cacheBytes;
     if (parsed.count("cache-memory-limit")) {
         auto cacheSizeOpt = parsed["cache-memory-limit"].as<std::string>();
-        cacheBytes = vc::MemorySizeStringParser(cacheSizeOpt);
+        auto cacheBytes = vc::MemorySizeStringParser(cacheSizeOpt);
+        volume->setCacheMemoryInBytes(cacheBytes);
+        vc::Logger()->info(
+            "Volume Cache :: Capacity: {} || Size: {}",
+            volume->getCacheCapacity(),
+            vc::BytesToMemorySizeString(cacheBytes));
     } else {
-        cacheBytes = SystemMemorySize() / 2;
+        volume->setCacheSlices(false);
     }
-    volume->setCacheMemoryInBytes(cacheBytes);
-    vc::Logger()->info(
-        "Volume Cache :: Capacity: {} || Size: {}", volume->getCacheCapacity(),
-        vc::BytesToMemorySizeString(cacheBytes));
 
     ///// Load the output directory /////
     g_outputDir = parsed["output-dir"].as<std::string>();
+    g_updateExisting = parsed.count("update-existing") > 0;
 
     ///// Load the PPM and the bump mask /////
     vc::Logger()->info("Loading PPM: {}", parsed["ppm"].as<std::string>());
@@ -125,20 +190,12 @@ int main(int argc, char* argv[])
     auto bumpVal = (volume->max() - volume->min()) * bumpPerc;
 
     ///// Perform the bump /////
-    // Get the mappings
-    auto mappings = ppm.getMappings();
-
-    // Sort the mappings by Z-value
-    std::sort(
-        mappings.begin(), mappings.end(), [](const auto& lhs, const auto& rhs) {
-            return lhs.pos[2] < rhs.pos[2];
-        });
-
-    // Iterate through the mappings
-    int currentZ = -1;
-    cv::Mat currentSlice;
-    std::map<int, cv::Mat> bumpedSlices;
-    for (const auto& pixel : mappings) {
+    // Bucket the mappings by slice with a counting sort, so each slice's
+    // bumps are contiguous
+    std::vector<Bump> bumps;
+    std::vector<int> bumpSlices;
+    std::vector<std::size_t> offsets(volume->numSlices() + 1, 0);
+    for (const auto& pixel : ppm.getMappings()) {
         // Get integer coordinates
         auto x = static_cast<int>(std::floor(pixel.pos[0]));
         auto y = static_cast<int>(std::floor(pixel.pos[1]));
@@ -149,42 +206,137 @@ int main(int argc, char* argv[])
             continue;
         }
 
-        // Check if our slice index has changed
-        if (z != currentZ) {
-            if (!currentSlice.empty()) {
-                // Add this to our image writing queue
-                bumpedSlices[currentZ] = currentSlice;
-
-                // Clear the queue if it's big enough
-                if (bumpedSlices.size() == 100) {
-                    for (const auto& s : bumpedSlices) {
-                        WriteBumpedSlice(s.second, s.first);
-                    }
-                    bumpedSlices.clear();
-                }
-            }
+        // Use the bump mask as an opacity function on the bumpVal
+        auto bumpOpacity = bumpMask.at<uint16_t>(pixel.y, pixel.x) / MAX_16BPC;
+        bumps.push_back({x, y, bumpOpacity * bumpVal});
+        bumpSlices.push_back(z);
+        offsets[z + 1]++;
+    }
+    std::vector<int> slices;
+    for (std::size_t z = 0; z + 1 < offsets.size(); z++) {
+        if (offsets[z + 1] > 0) {
+            slices.push_back(static_cast<int>(z));
+        }
+        offsets[z + 1] += offsets[z];
+    }
+    std::vector<Bump> sorted(bumps.size());
+    std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < bumps.size(); i++) {
+        sorted[next[bumpSlices[i]]++] = bumps[i];
+    }
+    bumps = std::vector<Bump>();
+    bumpSlices = std::vector<int>();
+    vc::Logger()->info("Bumping {} slices", slices.size());
 
-            // Get the slice image for this PPM mapping
-            currentZ = z;
-            currentSlice = volume->getSliceDataCopy(currentZ);
+    // Bump the slices in parallel and hand them to the writers
+    SliceWriter writer(
+        std::max<std::size_t>(parsed["writer-threads"].as<std::size_t>(), 1),
+        std::max<std::size_t>(parsed["write-queue"].as<std::size_t>(), 1));
+    auto bumpSlice = [&](std::size_t i) {
+        auto z = slices[i];
+        auto slice = volume->getSliceDataCopy(z);
+        cv::Rect roi;
+        for (auto b = offsets[z]; b < offsets[z + 1]; b++) {
+            const auto& bump = sorted[b];
+            auto& v = slice.at<uint16_t>(bump.y, bump.x);
+            v = static_cast<uint16_t>(std::min(v + bump.value, MAX_16BPC));
+            roi |= cv::Rect(bump.x, bump.y, 1, 1);
         }
+        writer.push({z, std::move(slice), roi});
+    };
+    vc::ParallelFor(
+        slices.size(), bumpSlice, parsed["threads"].as<std::size_t>());
+    writer.finish();
+}
 
-        // Use the bump mask as an opacity function on the bumpVal
-        auto bumpOpacity = bumpMask.at<uint16_t>(pixel.y, pixel.x) / MAX_16BPC;
-        auto bumped = currentSlice.at<uint16_t>(y, x) + bumpOpacity * bumpVal;
-        currentSlice.at<uint16_t>(y, x) =
-            static_cast<uint16_t>(std::min(bumped, MAX_16BPC));
+SliceWriter::SliceWriter(std::size_t numThreads, std::size_t capacity)
+    : capacity_{capacity}
+{
+    for (std::size_t i = 0; i < numThreads; i++) {
+        threads_.emplace_back(&SliceWriter::run_, this);
     }
+}
 
-    // Write the last slice image
-    WriteBumpedSlice(currentSlice, currentZ);
+SliceWriter::~SliceWriter()
+{
+    try {
+        finish();
+    } catch (...) {
+    }
 }
 
-void WriteBumpedSlice(const cv::Mat& slice, int index)
+void SliceWriter::push(BumpedSlice s)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_.wait(lock, [this]() {
+        return queue_.size() < capacity_ || error_ != nullptr;
+    });
+    if (error_) {
+        std::rethrow_exception(error_);
+    }
+    queue_.push_back(std::move(s));
+    ready_.notify_one();
+}
+
+void SliceWriter::finish()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_all();
+    for (auto& t : threads_) {
+        if (t.joinable()) {
+            t.join();
+        }
+    }
+    threads_.clear();
+    if (error_) {
+        auto error = error_;
+        error_ = nullptr;
+        std::rethrow_exception(error);
+    }
+}
+
+void SliceWriter::run_()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        ready_.wait(lock, [this]() { return stop_ || !queue_.empty(); });
+        if (queue_.empty()) {
+            return;
+        }
+        auto s = std::move(queue_.front());
+        queue_.pop_front();
+        space_.notify_one();
+
+        // Write without holding the lock
+        lock.unlock();
+        try {
+            WriteBumpedSlice(s);
+        } catch (...) {
+            lock.lock();
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+            space_.notify_all();
+            continue;
+        }
+        lock.lock();
+    }
+}
+
+void WriteBumpedSlice(const BumpedSlice& s)
 {
     std::stringstream ss;
-    ss << std::setw(g_numSliceChars) << std::setfill('0') << index << ".tif";
+    ss << std::setw(g_numSliceChars) << std::setfill('0') << s.index << ".tif";
     fs::path p = g_outputDir / ss.str();
+
+    // Only rewrite the modified part of an existing copy of the slice
+    if (g_updateExisting && vc::tiffio::UpdateTIFF(p, s.slice, s.roi)) {
+        vc::Logger()->info("Updated slice {}", p.string());
+        return;
+    }
     vc::Logger()->info("Writing slice {}", p.string());
-    vc::tiffio::WriteTIFF(p, slice);
-}
\ No newline at end of file
+    vc::tiffio::WriteTIFF(p, s.slice);
+}